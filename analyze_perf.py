@@ -0,0 +1,445 @@
+#!/usr/bin/env uv run
+# /// script
+# requires-python = ">=3.8"
+# dependencies = [
+#     "matplotlib>=3.5.0",
+# ]
+# ///
+"""
+Script to track performance metrics per commit in git history.
+Builds every commit of a range in a temporary worktree, runs the benchmark tools
+and stores frame time, allocation and startup metrics in a JSON history.
+Shows a graph of every metric over time and flags regressions beyond a threshold.
+
+Metrics:
+    frame_time_ms      - moss_replay frame time of the given capture
+    startup_ms         - moss_replay wall time minus the replayed frames
+    malloc_calls       - static malloc/calloc/realloc count, as in analyze_malloc.py
+    <benchmark>_ns     - moss_microbench median time of every benchmark
+
+moss_replay opens a window, so frame_time_ms and startup_ms need a display. On
+headless machines use a virtual one, e.g. xvfb-run, otherwise replay fails.
+Replay also needs SPIR-V shaders, which aren't tracked in git, so with --capture
+every commit's shaders are compiled with glslc through example/rebuild_shaders.sh.
+
+Commits that predate the tools or fail to build only record malloc_calls.
+Build and tool failures are printed and stored as errors of the entry together
+with the environment they happened in: whether glslc and a display were
+available. Failed commits are measured again once that environment changes, or
+on every run with --retry-failed. The rest of the history is reused.
+
+Usage with uv:
+    uv run analyze_perf.py [range] [--capture FILE] [--threshold PERCENT]
+
+Usage with standard Python:
+    python3 analyze_perf.py HEAD~20..HEAD --capture frames.mosscap
+    (requires: pip install matplotlib)
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from datetime import datetime
+import matplotlib.pyplot as plt
+import matplotlib.dates as mdates
+
+from analyze_malloc import count_malloc_in_commit
+
+
+def get_git_commits(revision_range):
+    """Get list of commits of the range with their dates and hashes."""
+    command = ["git", "log", "--pretty=format:%H|%ai", "--reverse"]
+    if revision_range:
+        command.append(revision_range)
+
+    result = subprocess.run(command, capture_output=True, text=True, check=True)
+
+    commits = []
+    for line in result.stdout.strip().split("\n"):
+        if not line:
+            continue
+        parts = line.split("|")
+        if len(parts) == 2:
+            commit_hash, date_str = parts
+            # Parse date string (format: 2025-01-15 10:30:45 +0000)
+            date = datetime.strptime(date_str.split(" ")[0], "%Y-%m-%d")
+            commits.append((commit_hash, date))
+
+    return commits
+
+
+def load_history(path):
+    """Load history from the JSON file, keyed by commit hash."""
+    if not os.path.exists(path):
+        return {}
+
+    with open(path, "r") as file:
+        return {entry["commit"]: entry for entry in json.load(file)}
+
+
+def save_history(path, history, commits):
+    """Save history to the JSON file in commit order."""
+    order = {commit_hash: i for i, (commit_hash, _) in enumerate(commits)}
+    entries = sorted(
+        history.values(), key=lambda entry: order.get(entry["commit"], -1)
+    )
+
+    with open(path, "w") as file:
+        json.dump(entries, file, indent=2)
+        file.write("\n")
+
+
+def get_environment():
+    """Get availability of everything tools need beyond the build itself."""
+    return {
+        "glslc": shutil.which("glslc") is not None,
+        "display": bool(os.environ.get("DISPLAY") or os.environ.get("WAYLAND_DISPLAY")),
+    }
+
+
+def describe_step_failure(step, result):
+    """Describe failed build step with the last line it printed."""
+    lines = (result.stdout + result.stderr).strip().splitlines()
+    reason = lines[-1] if lines else "no output"
+    return f"{step} failed: {reason}"
+
+
+def compile_shaders(worktree_dir):
+    """Compile shaders of the checked out commit, returns an error or None."""
+    script = os.path.join(worktree_dir, "example", "rebuild_shaders.sh")
+    if not os.path.exists(script):
+        return "commit has no example/rebuild_shaders.sh to compile shaders with"
+
+    if shutil.which("glslc") is None:
+        return "glslc not found, install the Vulkan SDK to compile shaders for replay"
+
+    result = subprocess.run(["bash", script], capture_output=True, text=True)
+    if result.returncode != 0:
+        return describe_step_failure("shader compilation", result)
+    return None
+
+
+def build_commit(worktree_dir, build_dir, jobs, is_shader_needed):
+    """Configure and build tools of the checked out commit, returns an error or None."""
+    # Tools copy compiled shaders at configure time, so they must exist by then
+    if is_shader_needed:
+        error = compile_shaders(worktree_dir)
+        if error:
+            return error
+
+    configure = subprocess.run(
+        [
+            "cmake",
+            "-S",
+            worktree_dir,
+            "-B",
+            build_dir,
+            "-DCMAKE_BUILD_TYPE=Release",
+            "-DMOSS_BUILD_TOOLS=ON",
+            "-DMOSS_BUILD_EXAMPLE=OFF",
+            "-DMOSS_BUILD_TESTS=OFF",
+        ],
+        capture_output=True,
+        text=True,
+    )
+    if configure.returncode != 0:
+        return describe_step_failure("configure", configure)
+
+    build = subprocess.run(
+        ["cmake", "--build", build_dir, "-j", str(jobs)],
+        capture_output=True,
+        text=True,
+    )
+    if build.returncode != 0:
+        return describe_step_failure("build", build)
+    return None
+
+
+def find_tool(build_dir, name):
+    """Find built tool executable, returns None when the commit has no such tool."""
+    for root, _, files in os.walk(build_dir):
+        if name in files:
+            return os.path.join(root, name)
+    return None
+
+
+def describe_failure(name, result):
+    """Describe failed tool run with its exit code and last line of stderr."""
+    lines = result.stderr.strip().splitlines()
+    reason = lines[-1] if lines else "no output"
+    return f"{name} exited with {result.returncode}: {reason}"
+
+
+def run_microbench(executable):
+    """Run moss_microbench, returns median time of every benchmark and an error."""
+    try:
+        result = subprocess.run(
+            [executable], capture_output=True, text=True, timeout=600
+        )
+    except subprocess.TimeoutExpired:
+        return {}, "moss_microbench timed out"
+
+    if result.returncode != 0:
+        return {}, describe_failure("moss_microbench", result)
+
+    try:
+        report = json.loads(result.stdout)
+        return {
+            f"{benchmark['name']}_ns": benchmark["median_ns"]
+            for benchmark in report["benchmarks"]
+        }, None
+    except (json.JSONDecodeError, KeyError, TypeError) as error:
+        return {}, f"moss_microbench printed an invalid report: {error}"
+
+
+def run_replay(executable, capture_path):
+    """Run moss_replay on the capture, returns frame time, startup and an error."""
+    # Replay loads shaders relative to the working directory
+    start = time.perf_counter()
+    try:
+        result = subprocess.run(
+            [executable, os.path.abspath(capture_path)],
+            cwd=os.path.dirname(executable),
+            capture_output=True,
+            text=True,
+            timeout=600,
+        )
+    except subprocess.TimeoutExpired:
+        return {}, "moss_replay timed out"
+
+    wall_seconds = time.perf_counter() - start
+    if result.returncode != 0:
+        # Usually the window can't be created, see the display note above
+        return {}, describe_failure("moss_replay", result)
+
+    total = re.search(r"total:\s+([0-9.]+) s", result.stdout)
+    frame_time = re.search(r"frame time:\s+([0-9.]+) ms", result.stdout)
+    if not total or not frame_time:
+        return {}, "moss_replay printed no frame time"
+
+    return {
+        "frame_time_ms": float(frame_time.group(1)),
+        "startup_ms": (wall_seconds - float(total.group(1))) * 1000.0,
+    }, None
+
+
+def measure_commit(commit_hash, capture_path, jobs):
+    """Build commit in a temporary worktree, returns metrics, build state and errors."""
+    metrics = {"malloc_calls": count_malloc_in_commit(commit_hash)}
+    errors = []
+
+    temp_dir = tempfile.mkdtemp(prefix="moss_perf_")
+    worktree_dir = os.path.join(temp_dir, "src")
+    build_dir = os.path.join(temp_dir, "build")
+
+    try:
+        subprocess.run(
+            ["git", "worktree", "add", "--detach", worktree_dir, commit_hash],
+            capture_output=True,
+            check=True,
+        )
+        subprocess.run(
+            ["git", "submodule", "update", "--init", "--recursive"],
+            cwd=worktree_dir,
+            capture_output=True,
+        )
+
+        error = build_commit(worktree_dir, build_dir, jobs, bool(capture_path))
+        if error:
+            errors.append(error)
+            return metrics, False, errors
+
+        runs = []
+        microbench = find_tool(build_dir, "moss_microbench")
+        if microbench:
+            runs.append(run_microbench(microbench))
+
+        replay = find_tool(build_dir, "moss_replay")
+        if replay and capture_path:
+            runs.append(run_replay(replay, capture_path))
+
+        for tool_metrics, error in runs:
+            metrics.update(tool_metrics)
+            if error:
+                errors.append(error)
+
+        return metrics, True, errors
+
+    except subprocess.CalledProcessError:
+        errors.append(f"failed to check out {commit_hash[:10]} into a worktree")
+        return metrics, False, errors
+
+    finally:
+        subprocess.run(
+            ["git", "worktree", "remove", "--force", worktree_dir],
+            capture_output=True,
+        )
+        shutil.rmtree(temp_dir, ignore_errors=True)
+
+
+def find_regressions(entries, threshold):
+    """Find metrics that grew beyond threshold percent since their last measurement."""
+    regressions = []
+    previous = {}
+
+    for entry in entries:
+        for name, value in entry["metrics"].items():
+            if name in previous and previous[name] > 0:
+                change = (value - previous[name]) / previous[name] * 100.0
+                if change > threshold:
+                    regressions.append(
+                        (entry["commit"], name, previous[name], value, change)
+                    )
+            previous[name] = value
+
+    return regressions
+
+
+def main():
+    """Main function to measure, store and plot performance metrics."""
+    parser = argparse.ArgumentParser(
+        description="Track moss performance metrics across git history."
+    )
+    parser.add_argument(
+        "range", nargs="?", default=None, help="git revision range, all by default"
+    )
+    parser.add_argument("--capture", help="capture file for moss_replay frame time")
+    parser.add_argument(
+        "--history", default="perf_history.json", help="JSON history file path"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5.0,
+        help="regression threshold in percent",
+    )
+    parser.add_argument(
+        "--jobs", type=int, default=os.cpu_count() or 1, help="parallel build jobs"
+    )
+    parser.add_argument(
+        "--retry-failed",
+        action="store_true",
+        help="measure failed commits again even if the environment didn't change",
+    )
+    parser.add_argument("--output", help="save plot to file instead of showing it")
+    args = parser.parse_args()
+
+    print("Analyzing git history for performance metrics...")
+
+    commits = get_git_commits(args.range)
+    print(f"Found {len(commits)} commits")
+
+    if not commits:
+        print("No commits found!")
+        return
+
+    history = load_history(args.history)
+    dates = {commit_hash: date for commit_hash, date in commits}
+    environment = get_environment()
+
+    if args.capture and not environment["glslc"]:
+        print("glslc not found, replay metrics can't be measured", file=sys.stderr)
+    if args.capture and not environment["display"]:
+        print("No display found, replay metrics can't be measured", file=sys.stderr)
+
+    print("Measuring commits...")
+    for i, (commit_hash, date) in enumerate(commits):
+        # Failures repeat until glslc or a display shows up, unless asked to retry
+        entry = history.get(commit_hash)
+        if entry:
+            is_failed = not entry["built"] or entry.get("errors")
+            if not is_failed:
+                continue
+            if not args.retry_failed and entry.get("environment") == environment:
+                continue
+
+        metrics, is_built, errors = measure_commit(
+            commit_hash, args.capture, args.jobs
+        )
+        for error in errors:
+            print(f"  {commit_hash[:10]}: {error}", file=sys.stderr)
+
+        history[commit_hash] = {
+            "commit": commit_hash,
+            "date": date.strftime("%Y-%m-%d"),
+            "built": is_built,
+            "errors": errors,
+            "environment": environment,
+            "metrics": metrics,
+        }
+
+        # Save after every commit so an interrupted run keeps its progress
+        save_history(args.history, history, commits)
+        print(f"Measured {i + 1}/{len(commits)} commits...")
+
+    entries = [history[commit_hash] for commit_hash, _ in commits]
+    names = sorted({name for entry in entries for name in entry["metrics"]})
+
+    if not names:
+        print("No metrics measured!")
+        return
+
+    # Create plot
+    print("Creating plot...")
+    fig, axes = plt.subplots(
+        len(names), 1, figsize=(12, 3 * len(names)), sharex=True, squeeze=False
+    )
+
+    for ax, name in zip(axes[:, 0], names):
+        points = [
+            (dates[entry["commit"]], entry["metrics"][name])
+            for entry in entries
+            if name in entry["metrics"]
+        ]
+        ax.plot(
+            [point[0] for point in points],
+            [point[1] for point in points],
+            marker="o",
+            markersize=3,
+            linewidth=1,
+            alpha=0.7,
+        )
+        ax.set_ylabel(name, fontsize=10)
+        ax.grid(True, alpha=0.3)
+
+    axes[0, 0].set_title(
+        "Performance Metrics per Commit Over Time", fontsize=14, fontweight="bold"
+    )
+    axes[-1, 0].set_xlabel("Date", fontsize=12)
+
+    # Format x-axis dates
+    axes[-1, 0].xaxis.set_major_formatter(mdates.DateFormatter("%Y-%m-%d"))
+    axes[-1, 0].xaxis.set_major_locator(mdates.AutoDateLocator())
+    plt.setp(axes[-1, 0].get_xticklabels(), rotation=45, ha="right")
+
+    # Adjust layout
+    plt.tight_layout()
+
+    # Print statistics
+    regressions = find_regressions(entries, args.threshold)
+
+    print("\nStatistics:")
+    print(f"  Total commits analyzed: {len(entries)}")
+    print(f"  Commits built: {sum(1 for entry in entries if entry['built'])}")
+    failed_count = sum(1 for entry in entries if entry.get("errors"))
+    print(f"  Commits with errors: {failed_count}")
+    print(f"  Regressions beyond {args.threshold:.1f}%: {len(regressions)}")
+    for commit_hash, name, before, after, change in regressions:
+        print(f"    {commit_hash[:10]} {name}: {before:.2f} -> {after:.2f}", end="")
+        print(f" (+{change:.1f}%)")
+
+    # Show plot
+    if args.output:
+        plt.savefig(args.output)
+    else:
+        plt.show()
+
+
+if __name__ == "__main__":
+    main()
@@ -23,6 +23,7 @@
 
 #include <moss/engine.h>
 #include <moss/result.h>
+#include <moss/run_loop.h>
 #include <moss/window_config.h>
 
 static const MossAppInfo moss_app_info = {
@@ -36,6 +37,18 @@ static const MossWindowConfig window_config = {
   .height = 360,
 };
 
+/*
+  @brief Submits frame contents.
+  @details Nothing animates, so frames are only drawn on resize.
+*/
+static float draw_frame (void *user_data, float delta_seconds)
+{
+  (void)(user_data);
+  (void)(delta_seconds);
+
+  return MOSS_WAIT_FOREVER;
+}
+
 int main (void)
 {
   const MossEngineConfig moss_engine_config = {
@@ -48,12 +61,13 @@ int main (void)
     return EXIT_FAILURE;
   }
 
-  while (!moss_engine_should_close ( ))
-  {
-    if (moss_engine_draw_frame ( ) != MOSS_RESULT_SUCCESS) { break; }
-  }
+  const MossRunConfig run_config = {
+    .frame_callback = draw_frame,
+  };
+
+  const MossResult result = moss_engine_run (&run_config);
 
   moss_engine_deinit ( );
 
-  return EXIT_SUCCESS;
+  return result == MOSS_RESULT_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -39,6 +39,81 @@ fi
 glslc "${FRAG_SRC}" -o "${FRAG_SPV}"
 echo "  ✓ Compiled ${FRAG_SRC} -> ${FRAG_SPV}"
 
+# Compile upscale shaders
+for UPSCALE_NAME in upscale.vert upscale.frag; do
+    UPSCALE_SRC="${SHADERS_DIR}/${UPSCALE_NAME}"
+    UPSCALE_SPV="${SHADERS_DIR}/${UPSCALE_NAME}.spv"
+    if [ ! -f "${UPSCALE_SRC}" ]; then
+        echo "Error: Upscale shader source not found: ${UPSCALE_SRC}"
+        exit 1
+    fi
+
+    glslc "${UPSCALE_SRC}" -o "${UPSCALE_SPV}"
+    echo "  ✓ Compiled ${UPSCALE_SRC} -> ${UPSCALE_SPV}"
+done
+
+# Compile skinning vertex shader
+SKINNING_SRC="${SHADERS_DIR}/skinning.vert"
+SKINNING_SPV="${SHADERS_DIR}/skinning.vert.spv"
+if [ ! -f "${SKINNING_SRC}" ]; then
+    echo "Error: Skinning shader source not found: ${SKINNING_SRC}"
+    exit 1
+fi
+
+glslc "${SKINNING_SRC}" -o "${SKINNING_SPV}"
+echo "  ✓ Compiled ${SKINNING_SRC} -> ${SKINNING_SPV}"
+
+# Compile virtual texture shaders
+for VIRTUAL_TEXTURE_NAME in virtual_texture.vert virtual_texture.frag; do
+    VIRTUAL_TEXTURE_SRC="${SHADERS_DIR}/${VIRTUAL_TEXTURE_NAME}"
+    VIRTUAL_TEXTURE_SPV="${SHADERS_DIR}/${VIRTUAL_TEXTURE_NAME}.spv"
+    if [ ! -f "${VIRTUAL_TEXTURE_SRC}" ]; then
+        echo "Error: Virtual texture shader source not found: ${VIRTUAL_TEXTURE_SRC}"
+        exit 1
+    fi
+
+    glslc "${VIRTUAL_TEXTURE_SRC}" -o "${VIRTUAL_TEXTURE_SPV}"
+    echo "  ✓ Compiled ${VIRTUAL_TEXTURE_SRC} -> ${VIRTUAL_TEXTURE_SPV}"
+done
+
+# Compile layer composite fragment shader
+LAYER_COMPOSITE_SRC="${SHADERS_DIR}/layer_composite.frag"
+LAYER_COMPOSITE_SPV="${SHADERS_DIR}/layer_composite.frag.spv"
+if [ ! -f "${LAYER_COMPOSITE_SRC}" ]; then
+    echo "Error: Layer composite shader source not found: ${LAYER_COMPOSITE_SRC}"
+    exit 1
+fi
+
+glslc "${LAYER_COMPOSITE_SRC}" -o "${LAYER_COMPOSITE_SPV}"
+echo "  ✓ Compiled ${LAYER_COMPOSITE_SRC} -> ${LAYER_COMPOSITE_SPV}"
+
+# Compile video shaders
+for VIDEO_NAME in video.vert video.frag; do
+    VIDEO_SRC="${SHADERS_DIR}/${VIDEO_NAME}"
+    VIDEO_SPV="${SHADERS_DIR}/${VIDEO_NAME}.spv"
+    if [ ! -f "${VIDEO_SRC}" ]; then
+        echo "Error: Video shader source not found: ${VIDEO_SRC}"
+        exit 1
+    fi
+
+    glslc "${VIDEO_SRC}" -o "${VIDEO_SPV}"
+    echo "  ✓ Compiled ${VIDEO_SRC} -> ${VIDEO_SPV}"
+done
+
+# Compile compute shaders
+for COMP_NAME in radix_sort_histogram radix_sort_scan radix_sort_scatter radix_sort_indices \
+                 light_culling shadow_map; do
+    COMP_SRC="${SHADERS_DIR}/${COMP_NAME}.comp"
+    COMP_SPV="${SHADERS_DIR}/${COMP_NAME}.comp.spv"
+    if [ ! -f "${COMP_SRC}" ]; then
+        echo "Error: Compute shader source not found: ${COMP_SRC}"
+        exit 1
+    fi
+
+    glslc "${COMP_SRC}" -o "${COMP_SPV}"
+    echo "  ✓ Compiled ${COMP_SRC} -> ${COMP_SPV}"
+done
+
 echo "  ✓ Updated ${ENGINE_SHADERS}"
 echo ""
 echo "Shader rebuild complete!"
@@ -0,0 +1,10 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D layerImage;
+
+layout(location = 0) out vec4 outColor;
+
+// Layers are rendered at the scene's resolution, so pixels map one to one.
+void main() {
+    outColor = texelFetch(layerImage, ivec2(gl_FragCoord.xy), 0);
+}
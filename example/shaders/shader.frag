@@ -1,10 +1,104 @@
 #version 450
 
+#define TILE_SIZE 16
+#define TILE_STRIDE 128
+#define SHADOW_MAP_RESOLUTION 256
+#define SHADOW_BIAS 0.002
+#define PI 3.14159265358979
+
+struct Light {
+    vec2 position;
+    float radius;
+    float intensity;
+    vec4 color;
+    vec2 direction;
+    float cosCone;
+    float height;
+};
+
 layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureIndex;
+layout(location = 3) in vec2 fragPosition;
+layout(location = 4) flat in uint fragPickId;
+
+layout(push_constant) uniform PushConstants {
+    vec4 ambient;
+    uint tileCountX;
+    uint lightCount;
+    uint occluderCount;
+    float renderScale;
+} pc;
+
+layout(std430, set = 0, binding = 0) readonly buffer Lights { Light lights[]; };
+layout(std430, set = 0, binding = 1) readonly buffer Tiles { uint tiles[]; };
+layout(std430, set = 1, binding = 1) readonly buffer ShadowMaps { float shadowMaps[]; };
 
 layout(location = 0) out vec4 outColor;
+// Discarded unless the scene pass has the pick ID attachment
+layout(location = 1) out uint outPickId;
 
-void main() {
-    outColor = vec4(fragColor, 1.0);
+// Blends two nearest shadow map bins, so shadow edges don't follow bin steps.
+float shadowVisibility(const uint lightIndex, const vec2 toFragment, const float distance) {
+    const float angle = atan(toFragment.y, toFragment.x);
+    const float bin = (angle + PI) / (2.0 * PI) * float(SHADOW_MAP_RESOLUTION) - 0.5;
+    const float firstBin = floor(bin);
+
+    const uint row = lightIndex * SHADOW_MAP_RESOLUTION;
+    const uint first = uint(firstBin + SHADOW_MAP_RESOLUTION) % SHADOW_MAP_RESOLUTION;
+    const uint second = (first + 1) % SHADOW_MAP_RESOLUTION;
+
+    const float firstVisibility = step(distance, shadowMaps[row + first] + SHADOW_BIAS);
+    const float secondVisibility = step(distance, shadowMaps[row + second] + SHADOW_BIAS);
+    return mix(firstVisibility, secondVisibility, bin - firstBin);
+}
+
+vec3 shadeLight(const uint lightIndex, const vec3 normal) {
+    const Light light = lights[lightIndex];
+    const vec2 toFragment = fragPosition - light.position;
+    const float distance = length(toFragment);
+    if (distance >= light.radius) {
+        return vec3(0.0);
+    }
+
+    float attenuation = 1.0 - distance / light.radius;
+    attenuation *= attenuation;
+
+    if (light.cosCone > -1.0 && distance > 0.0) {
+        const float cosAngle = dot(toFragment / distance, light.direction);
+        attenuation *= smoothstep(light.cosCone, mix(light.cosCone, 1.0, 0.1), cosAngle);
+    }
+
+    if (light.height > 0.0) {
+        const vec3 toLight = normalize(vec3(-toFragment, light.height));
+        attenuation *= max(dot(normal, toLight), 0.0);
+    }
+
+    if (pc.occluderCount > 0) {
+        attenuation *= shadowVisibility(lightIndex, toFragment, distance);
+    }
+
+    return light.color.rgb * light.intensity * attenuation;
 }
 
+void main() {
+    vec3 lighting = pc.ambient.rgb;
+
+    if (pc.lightCount > 0) {
+        // Sprites don't sample textures yet, so every sprite faces the viewer
+        const vec3 normal = vec3(0.0, 0.0, 1.0);
+
+        // Tiles are laid out over the full extent, dynamic resolution renders less
+        uvec2 tile = uvec2(gl_FragCoord.xy / pc.renderScale) / TILE_SIZE;
+        tile.x = min(tile.x, pc.tileCountX - 1);
+        const uint base = (tile.y * pc.tileCountX + tile.x) * TILE_STRIDE;
+        const uint count = tiles[base];
+
+        for (uint i = 0; i < count; ++i) {
+            lighting += shadeLight(tiles[base + 1 + i], normal);
+        }
+    }
+
+    outColor = vec4(fragColor * lighting, 1.0);
+    outPickId = fragPickId;
+}
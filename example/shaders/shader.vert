@@ -1,12 +1,104 @@
 #version 450
 
+#define ANIMATION_CLIP_NONE 0xFFFFFFFFu
+#define LOOP_MODE_ONCE 0u
+#define LOOP_MODE_REPEAT 1u
+
+struct AnimationClip {
+    uint firstFrame;
+    uint frameCount;
+    uint loopMode;
+    float duration;
+};
+
+struct AnimationFrame {
+    vec4 uv;
+    float endTime;
+};
+
+struct SpriteAnimation {
+    uint clip;
+    float startTime;
+};
+
 layout(location = 0) in vec2 inPosition;
 layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in uint inTextureIndex;
+
+layout(push_constant) uniform PushConstants {
+    layout(offset = 32) float time;
+    uint isAnimated;
+    uint isPickable;
+} pc;
+
+layout(std430, set = 2, binding = 0) readonly buffer Clips { AnimationClip clips[]; };
+layout(std430, set = 2, binding = 1) readonly buffer Frames { AnimationFrame frames[]; };
+layout(std430, set = 2, binding = 2) readonly buffer Sprites { SpriteAnimation sprites[]; };
 
 layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
+layout(location = 3) out vec2 fragPosition;
+layout(location = 4) flat out uint fragPickId;
+
+// Maps time since the clip start into [0, duration] according to the loop mode.
+float clipTime(const AnimationClip clip, const float elapsed) {
+    if (clip.duration <= 0.0) {
+        return 0.0;
+    }
+
+    if (clip.loopMode == LOOP_MODE_ONCE) {
+        return clamp(elapsed, 0.0, clip.duration);
+    }
+
+    if (clip.loopMode == LOOP_MODE_REPEAT) {
+        return mod(elapsed, clip.duration);
+    }
+
+    const float cycle = mod(elapsed, 2.0 * clip.duration);
+    return cycle < clip.duration ? cycle : 2.0 * clip.duration - cycle;
+}
+
+// Binary search for the first frame that ends after the given time.
+vec4 frameUv(const AnimationClip clip, const float time) {
+    uint low = clip.firstFrame;
+    uint high = clip.firstFrame + clip.frameCount - 1u;
+
+    while (low < high) {
+        const uint middle = (low + high) / 2u;
+        if (frames[middle].endTime > time) {
+            high = middle;
+        } else {
+            low = middle + 1u;
+        }
+    }
+
+    return frames[low].uv;
+}
 
 void main() {
+    vec2 texCoord = inTexCoord;
+
+    if (pc.isAnimated != 0u) {
+        const SpriteAnimation sprite = sprites[gl_VertexIndex / 4];
+
+        if (sprite.clip != ANIMATION_CLIP_NONE) {
+            const AnimationClip clip = clips[sprite.clip];
+            const vec4 uv = frameUv(clip, clipTime(clip, pc.time - sprite.startTime));
+
+            // Corners go top left, top right, bottom right, bottom left
+            const uint corner = uint(gl_VertexIndex) & 3u;
+            texCoord = vec2(corner == 0u || corner == 3u ? uv.x : uv.z,
+                            corner < 2u ? uv.y : uv.w);
+        }
+    }
+
     gl_Position = vec4(inPosition, 0.0, 1.0);
     fragColor = inColor;
+    fragTexCoord = texCoord;
+    fragTextureIndex = inTextureIndex;
+    fragPosition = inPosition;
+    // Pick ID 0 is reserved for pixels nothing pickable covers
+    fragPickId = pc.isPickable != 0u ? uint(gl_VertexIndex) / 4u + 1u : 0u;
 }
-
@@ -0,0 +1,50 @@
+#version 450
+
+#define PICK_SKINNED_MESH_BIT 0x80000000u
+
+struct Bone {
+    vec4 row0;
+    vec4 row1;
+};
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in uint inTextureIndex;
+layout(location = 4) in uvec4 inBoneIndices;
+layout(location = 5) in vec4 inBoneWeights;
+
+layout(push_constant) uniform PushConstants {
+    layout(offset = 32) uint firstBone;
+    uint drawIndex;
+} pc;
+
+layout(std430, set = 2, binding = 0) readonly buffer Bones { Bone bones[]; };
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
+layout(location = 3) out vec2 fragPosition;
+layout(location = 4) flat out uint fragPickId;
+
+void main() {
+    const vec3 bindPosition = vec3(inPosition, 1.0);
+
+    // Blending rows of affine matrices is the same as blending transformed positions
+    vec4 row0 = vec4(0.0);
+    vec4 row1 = vec4(0.0);
+    for (int i = 0; i < 4; ++i) {
+        const Bone bone = bones[pc.firstBone + inBoneIndices[i]];
+        row0 += bone.row0 * inBoneWeights[i];
+        row1 += bone.row1 * inBoneWeights[i];
+    }
+
+    const vec2 position = vec2(dot(row0.xyz, bindPosition), dot(row1.xyz, bindPosition));
+
+    gl_Position = vec4(position, 0.0, 1.0);
+    fragColor = inColor.rgb;
+    fragTexCoord = inTexCoord;
+    fragTextureIndex = inTextureIndex;
+    fragPosition = position;
+    fragPickId = PICK_SKINNED_MESH_BIT | (pc.drawIndex + 1u);
+}
@@ -0,0 +1,42 @@
+#version 450
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(push_constant) uniform PushConstants {
+    vec2 uvScale;
+    vec2 texelSize;
+    float sharpness;
+} pc;
+
+layout(set = 0, binding = 0) uniform sampler2D scene;
+
+layout(location = 0) out vec4 outColor;
+
+// Keeps bilinear taps inside of the rendered sub-rectangle.
+vec3 sampleScene(const vec2 uv) {
+    const vec2 maxUv = pc.uvScale - 0.5 * pc.texelSize;
+    return texture(scene, min(uv, maxUv)).rgb;
+}
+
+void main() {
+    const vec2 uv = fragTexCoord * pc.uvScale;
+    const vec3 center = sampleScene(uv);
+
+    if (pc.sharpness <= 0.0) {
+        outColor = vec4(center, 1.0);
+        return;
+    }
+
+    const vec3 left = sampleScene(uv - vec2(pc.texelSize.x, 0.0));
+    const vec3 right = sampleScene(uv + vec2(pc.texelSize.x, 0.0));
+    const vec3 top = sampleScene(uv - vec2(0.0, pc.texelSize.y));
+    const vec3 bottom = sampleScene(uv + vec2(0.0, pc.texelSize.y));
+
+    // Unsharp mask, clamped to the neighbourhood so edges don't ring
+    const vec3 blurred = (left + right + top + bottom) * 0.25;
+    const vec3 sharpened = center + (center - blurred) * pc.sharpness;
+    const vec3 lowest = min(center, min(min(left, right), min(top, bottom)));
+    const vec3 highest = max(center, max(max(left, right), max(top, bottom)));
+
+    outColor = vec4(clamp(sharpened, lowest, highest), 1.0);
+}
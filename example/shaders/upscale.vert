@@ -0,0 +1,10 @@
+#version 450
+
+layout(location = 0) out vec2 fragTexCoord;
+
+// Covers the screen with a single triangle, no vertex buffer needed.
+void main() {
+    const vec2 position = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    fragTexCoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
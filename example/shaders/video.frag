@@ -0,0 +1,14 @@
+#version 450
+
+layout(location = 0) in vec2 fragTexCoord;
+
+// Immutable sampler converts YUV planes to RGB on sampling.
+layout(set = 0, binding = 0) uniform sampler2D video;
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out uint outPickId;
+
+void main() {
+    outColor = texture(video, fragTexCoord);
+    outPickId = 0u;
+}
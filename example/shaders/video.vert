@@ -0,0 +1,14 @@
+#version 450
+
+layout(push_constant) uniform PushConstants {
+    vec4 rect;
+} pc;
+
+layout(location = 0) out vec2 fragTexCoord;
+
+// Emits a quad as a 4 vertex strip, no vertex buffer needed.
+void main() {
+    const vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    fragTexCoord = corner;
+    gl_Position = vec4(pc.rect.xy + corner * pc.rect.zw, 0.0, 1.0);
+}
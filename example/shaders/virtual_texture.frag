@@ -0,0 +1,84 @@
+#version 450
+
+#define MAX_LEVEL_COUNT 16
+#define PAGE_SIZE 128
+#define ATLAS_PAGES_PER_ROW 16
+#define FEEDBACK_STRIDE 8
+
+struct Level {
+    uint tileCountX;
+    uint tileCountY;
+    uint firstTile;
+    uint reserved;
+};
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(push_constant) uniform PushConstants {
+    vec4 rect;
+    vec4 uvRect;
+    uvec2 imageSize;
+    uint levelCount;
+    uint feedbackWidth;
+    uint feedbackHeight;
+    uint feedbackPhase;
+} pc;
+
+// Entries are atlas pages plus one, 0 for tiles that aren't resident
+layout(std430, set = 0, binding = 0) readonly buffer PageTable {
+    Level levels[MAX_LEVEL_COUNT];
+    uint entries[];
+};
+layout(set = 0, binding = 1) uniform sampler2D atlas;
+layout(std430, set = 0, binding = 2) writeonly buffer Feedback { uint feedback[]; };
+
+layout(location = 0) out vec4 outColor;
+// Discarded unless the scene pass has the pick ID attachment
+layout(location = 1) out uint outPickId;
+
+vec2 levelTexel(const uint level) {
+    return fragTexCoord * vec2(max(pc.imageSize >> level, uvec2(1)));
+}
+
+uint levelTile(const uint level, const vec2 texel) {
+    const Level info = levels[level];
+    const uvec2 tile = min(uvec2(texel) / PAGE_SIZE, uvec2(info.tileCountX, info.tileCountY) - 1u);
+    return info.firstTile + tile.y * info.tileCountX + tile.x;
+}
+
+void main() {
+    const vec2 texel = fragTexCoord * vec2(pc.imageSize);
+    const vec2 dx = dFdx(texel);
+    const vec2 dy = dFdy(texel);
+    const float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1.0));
+    const uint wantedLevel = min(uint(lod), pc.levelCount - 1u);
+
+    // One pixel of every block reports the tile it wants, rotating every frame
+    const uvec2 pixel = uvec2(gl_FragCoord.xy);
+    const uvec2 blockPixel = pixel % FEEDBACK_STRIDE;
+    const uvec2 feedbackTexel = pixel / FEEDBACK_STRIDE;
+    if (blockPixel.y * FEEDBACK_STRIDE + blockPixel.x == pc.feedbackPhase &&
+        feedbackTexel.x < pc.feedbackWidth && feedbackTexel.y < pc.feedbackHeight) {
+        const uint wantedTile = levelTile(wantedLevel, levelTexel(wantedLevel));
+        feedback[feedbackTexel.y * pc.feedbackWidth + feedbackTexel.x] = wantedTile + 1u;
+    }
+
+    // Falls back to coarser levels until a resident tile is found
+    for (uint level = wantedLevel; level < pc.levelCount; ++level) {
+        const vec2 localTexel = levelTexel(level);
+        const uint entry = entries[levelTile(level, localTexel)];
+        if (entry == 0u) {
+            continue;
+        }
+
+        // Half a texel inset keeps linear filtering inside the page
+        const uint page = entry - 1u;
+        const vec2 pageOrigin = vec2(page % ATLAS_PAGES_PER_ROW, page / ATLAS_PAGES_PER_ROW) * PAGE_SIZE;
+        const vec2 inPage = clamp(mod(localTexel, float(PAGE_SIZE)), vec2(0.5), vec2(PAGE_SIZE - 0.5));
+        outColor = textureLod(atlas, (pageOrigin + inPage) / float(ATLAS_PAGES_PER_ROW * PAGE_SIZE), 0.0);
+        outPickId = 0u;
+        return;
+    }
+
+    discard;
+}
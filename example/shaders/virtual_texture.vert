@@ -0,0 +1,20 @@
+#version 450
+
+layout(push_constant) uniform PushConstants {
+    vec4 rect;
+    vec4 uvRect;
+    uvec2 imageSize;
+    uint levelCount;
+    uint feedbackWidth;
+    uint feedbackHeight;
+    uint feedbackPhase;
+} pc;
+
+layout(location = 0) out vec2 fragTexCoord;
+
+// Emits a quad as a 4 vertex strip, no vertex buffer needed.
+void main() {
+    const vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    fragTexCoord = mix(pc.uvRect.xy, pc.uvRect.zw, corner);
+    gl_Position = vec4(pc.rect.xy + corner * pc.rect.zw, 0.0, 1.0);
+}
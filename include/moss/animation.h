@@ -0,0 +1,64 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/animation.h
+  @brief Sprite sheet animation clip declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Max number of animation clips that can be uploaded. */
+#define MOSS_MAX_ANIMATION_CLIP_COUNT (uint32_t)(4096)
+
+/* Max number of frames of all uploaded animation clips. */
+#define MOSS_MAX_ANIMATION_FRAME_COUNT (uint32_t)(65536)
+
+/* Clip ID of a sprite that isn't animated. */
+#define MOSS_ANIMATION_CLIP_NONE (uint32_t)(0xFFFFFFFF)
+
+/*
+  @brief What a clip does once its last frame is over.
+*/
+typedef enum
+{
+  MOSS_ANIMATION_LOOP_MODE_ONCE,      /* Stops at the last frame. */
+  MOSS_ANIMATION_LOOP_MODE_REPEAT,    /* Starts over from the first frame. */
+  MOSS_ANIMATION_LOOP_MODE_PING_PONG, /* Plays backwards, then forwards again. */
+} MossAnimationLoopMode;
+
+/*
+  @brief Single frame of a sprite sheet animation.
+*/
+typedef struct
+{
+  float uv_left;   /* Left texture coordinate of the frame rectangle. */
+  float uv_top;    /* Top texture coordinate of the frame rectangle. */
+  float uv_right;  /* Right texture coordinate of the frame rectangle. */
+  float uv_bottom; /* Bottom texture coordinate of the frame rectangle. */
+  float duration;  /* Time the frame is shown for, in seconds. */
+} MossAnimationFrame;
+
+/*
+  @brief Sprite sheet animation clip.
+*/
+typedef struct
+{
+  const MossAnimationFrame *frames;      /* Frames in playback order. */
+  uint32_t                  frame_count; /* Number of frames, at least one. */
+  MossAnimationLoopMode     loop_mode;   /* Playback behaviour after the last frame. */
+} MossAnimationClip;
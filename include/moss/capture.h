@@ -0,0 +1,58 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/capture.h
+  @brief API capture and replay declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "moss/apidef.h"
+#include "moss/result.h"
+
+/* First bytes of every capture file, "MOSSCAPT" read as little-endian. */
+#define MOSS_CAPTURE_MAGIC (uint64_t)(0x5450414353534F4DULL)
+
+/* Version of the capture file format. */
+#define MOSS_CAPTURE_VERSION (uint32_t)(1)
+
+/*
+  @brief Results of a capture replay.
+*/
+typedef struct
+{
+  uint32_t frame_count; /* Number of frames replayed. */
+  double   seconds;     /* Wall time from the first replayed call until the GPU
+                           finished the last frame. */
+} MossReplayStats;
+
+/*
+  @brief Replays a capture file.
+  @details Initializes the engine the way it was initialized when the capture
+           began, issues every captured call in order without waiting between
+           frames and deinitializes the engine. Calls that failed while being
+           captured fail again. Files captured calls refer to, like virtual
+           textures, must be present at the same paths. Must be called while
+           the engine isn't initialized.
+  @param path Path to the capture file.
+  @param out_stats Output replay results. May be NULL.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the file is
+          malformed, the engine fails to initialize or a frame fails to draw.
+*/
+__MOSS_API__ MossResult
+moss_replay_capture (const char *path, MossReplayStats *out_stats);
@@ -0,0 +1,41 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/draw_command.h
+  @brief Draw command struct declaration.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+  @brief Sprite draw command.
+  @details Commands submitted during a frame are drawn in ascending @c sort_key order.
+           Commands with equal keys keep the order they were submitted in by the
+           same thread.
+*/
+typedef struct
+{
+  uint64_t sort_key;      /* Draw order key. */
+  float    x;             /* Sprite center X coordinate. */
+  float    y;             /* Sprite center Y coordinate. */
+  float    rotation;      /* Rotation in radians. */
+  float    scale_x;       /* Sprite width. */
+  float    scale_y;       /* Sprite height. */
+  uint32_t texture_index; /* Texture index. */
+  uint32_t color;         /* RGBA8 color, red in the least significant byte. */
+} MossDrawCommand;
@@ -22,9 +22,24 @@
 
 #include <stdbool.h>
 
+#include "moss/animation.h"
 #include "moss/apidef.h"
 #include "moss/app_info.h"
+#include "moss/capture.h"
+#include "moss/draw_command.h"
+#include "moss/job.h"
+#include "moss/layer.h"
+#include "moss/light.h"
+#include "moss/occluder.h"
+#include "moss/offscreen.h"
+#include "moss/picking.h"
 #include "moss/result.h"
+#include "moss/run_loop.h"
+#include "moss/skeleton.h"
+#include "moss/sprite.h"
+#include "moss/video.h"
+#include "moss/virtual_texture.h"
+#include "moss/vram.h"
 #include "moss/window_config.h"
 
 /*
@@ -32,8 +47,13 @@
 */
 typedef struct
 {
-  const MossAppInfo      *app_info;      /* Application info. */
-  const MossWindowConfig *window_config; /* Window configuration. */
+  const MossAppInfo         *app_info;          /* Application info. */
+  const MossWindowConfig    *window_config;     /* Window configuration. */
+  const MossJobSystemConfig *job_system_config; /* Job system configuration.
+                                                   May be NULL to use defaults. */
+  bool                       enable_picking;    /* Whether the scene pass writes
+                                                   pick IDs, see
+                                                   @ref moss_engine_request_pick. */
 } MossEngineConfig;
 
 /*
@@ -56,8 +76,289 @@ __MOSS_API__ void moss_engine_deinit (void);
 */
 __MOSS_API__ MossResult moss_engine_draw_frame (void);
 
+/*
+  @brief Submits sprites to draw during the next frame.
+  @details Vertices are generated right away, so arrays may be reused once the
+           function returns. Large batches are split between job threads. Once a
+           batch with depths is submitted, all sprites of the frame are sorted back
+           to front on the GPU; sprites without depths get depth 0.
+  @param batch Sprites to draw.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame
+          can't fit the batch within @ref MOSS_MAX_SPRITE_COUNT sprites.
+*/
+__MOSS_API__ MossResult moss_engine_submit_sprites (const MossSpriteBatch *batch);
+
 /*
   @brief Checks if the window should close.
   @return Returns true if window should close, false otherwise.
 */
 __MOSS_API__ bool moss_engine_should_close (void);
+
+/*
+  @brief Runs main loop until the window closes.
+  @details Draws frames only when they're needed: while the frame callback keeps
+           animating, once its timer expires, when the window is resized, after
+           @ref moss_engine_invalidate or while picks, virtual texture tiles or
+           asynchronous reads are outstanding. Otherwise the loop sleeps, waking
+           only to process window events, so idle applications barely use the CPU.
+  @param config Main loop configuration.
+  @return Returns MOSS_RESULT_SUCCESS once the window closes, MOSS_RESULT_ERROR if
+          a frame fails to draw.
+*/
+__MOSS_API__ MossResult moss_engine_run (const MossRunConfig *config);
+
+/*
+  @brief Requests a frame from an idle main loop.
+  @details Can be called from any thread, e.g. once a background load finishes.
+           Wakes the loop right away.
+*/
+__MOSS_API__ void moss_engine_invalidate (void);
+
+/*
+  @brief Submits a sprite draw command for the current frame.
+  @details Can be called from any thread without locking: every thread fills its own
+           chunk of commands. Commands are sorted by key when the frame is drawn,
+           after sprites submitted with @ref moss_engine_submit_sprites. Submissions
+           must finish before @ref moss_engine_draw_frame is called.
+  @param command Draw command.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame has
+          too many commands.
+*/
+__MOSS_API__ MossResult moss_engine_submit_draw (const MossDrawCommand *command);
+
+/*
+  @brief Submits lights for the current frame.
+  @details Lights are binned into screen tiles on the GPU, so every sprite pixel
+           only shades lights that reach its tile. A tile keeps at most 127 lights.
+  @param lights Lights to submit.
+  @param count Number of lights.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame
+          can't fit the lights within @ref MOSS_MAX_LIGHT_COUNT lights.
+*/
+__MOSS_API__ MossResult
+moss_engine_submit_lights (const MossLight *lights, uint32_t count);
+
+/*
+  @brief Submits light occluders for the current frame.
+  @details Every light gets a 1D shadow map built on the GPU from all occluders
+           within its radius, so moving occluders only cost their upload.
+  @param occluders Occluders to submit.
+  @param count Number of occluders.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame
+          can't fit the occluders within @ref MOSS_MAX_OCCLUDER_COUNT occluders.
+*/
+__MOSS_API__ MossResult
+moss_engine_submit_occluders (const MossOccluder *occluders, uint32_t count);
+
+/*
+  @brief Sets ambient light applied to all sprites.
+  @details Defaults to white, which keeps sprite colors unchanged without lights.
+  @param color RGBA8 color, red in the least significant byte.
+*/
+__MOSS_API__ void moss_engine_set_ambient_light (uint32_t color);
+
+/*
+  @brief Sets GPU frame time dynamic resolution aims for.
+  @details Sprites are rendered at a lower resolution when the GPU can't hold the
+           target and upscaled to the window size. Defaults to 1/60 of a second.
+  @param seconds Target GPU frame time. 0 disables dynamic resolution.
+*/
+__MOSS_API__ void moss_engine_set_target_frame_time (float seconds);
+
+/*
+  @brief Returns current render scale.
+  @return Share of the window resolution sprites are rendered at, per axis.
+*/
+__MOSS_API__ float moss_engine_get_render_scale (void);
+
+/*
+  @brief Replaces animation clips sprites can play.
+  @details Clips are uploaded to the GPU once, sprites then only reference them by
+           ID through @ref MossSpriteBatch and frames are picked on the GPU.
+  @param clips Clips to upload, clip IDs are their indices.
+  @param count Number of clips, at most @ref MOSS_MAX_ANIMATION_CLIP_COUNT.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+__MOSS_API__ MossResult
+moss_engine_upload_animation_clips (const MossAnimationClip *clips, uint32_t count);
+
+/*
+  @brief Sets animation time sprite animation clips are evaluated at.
+  @details Usually advanced by the frame delta every frame. Defaults to 0.
+  @param seconds Animation time.
+*/
+__MOSS_API__ void moss_engine_set_animation_time (float seconds);
+
+/*
+  @brief Uploads skinned mesh.
+  @details Meshes live until the engine is deinitialized.
+  @param info Mesh creation information.
+  @param out_mesh Output mesh ID.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+__MOSS_API__ MossResult moss_engine_create_skinned_mesh (
+  const MossSkinnedMeshCreateInfo *info,
+  uint32_t                        *out_mesh
+);
+
+/*
+  @brief Submits skinned mesh to draw during the next frame.
+  @details Bones are evaluated on submission, the GPU only receives one skinning
+           matrix per bone and deforms vertices in the vertex shader.
+  @param mesh Mesh ID.
+  @param pose Local bone transforms, one per mesh bone. Parents are taken from the
+              mesh's bind pose.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+__MOSS_API__ MossResult
+moss_engine_submit_skinned_mesh (uint32_t mesh, const MossBone *pose);
+
+/*
+  @brief Requests pick of the object drawn at a pixel during the next frame.
+  @details The pixel's pick ID is copied out after the frame's scene pass and
+           resolved once the GPU finishes the frame, usually one or two frames
+           later, without stalling. Picking costs the same regardless of how many
+           objects are drawn. A newer request replaces one not recorded yet.
+  @param x X coordinate in swap chain pixels, from the left edge.
+  @param y Y coordinate in swap chain pixels, from the top edge.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if picking
+          isn't enabled in @ref MossEngineConfig.
+*/
+__MOSS_API__ MossResult moss_engine_request_pick (float x, float y);
+
+/*
+  @brief Returns latest resolved pick.
+  @param out_result Output pick result.
+  @return Returns true if a pick resolved since the last call, false otherwise.
+*/
+__MOSS_API__ bool moss_engine_poll_pick (MossPickResult *out_result);
+
+/*
+  @brief Opens tiled image file as the virtual texture.
+  @details Only tiles visible on the screen are streamed into a fixed size page
+           atlas, so images far larger than VRAM can be shown. Coarser levels are
+           shown while finer tiles stream in. Replaces the previously open image.
+           Files are described in moss/virtual_texture.h.
+  @param path Path to the file.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the file is
+          malformed or the GPU can't write from fragment shaders.
+*/
+__MOSS_API__ MossResult moss_engine_open_virtual_texture (const char *path);
+
+/*
+  @brief Closes open virtual texture.
+*/
+__MOSS_API__ void moss_engine_close_virtual_texture (void);
+
+/*
+  @brief Submits virtual texture placement for the current frame.
+  @details The virtual texture is drawn beneath sprites. Nothing is drawn if no
+           image is open.
+  @param view Placement of the virtual texture.
+*/
+__MOSS_API__ void moss_engine_submit_virtual_texture (const MossVirtualTextureView *view);
+
+/*
+  @brief Replaces sprites of a cached layer.
+  @details A layer keeps its sprites across frames and is only redrawn when they
+           are replaced, when it's invalidated or when the render resolution
+           changes. Otherwise its cached render is composited beneath the sprites
+           of the frame, so static content costs the same no matter how many
+           sprites it holds. Layers are composited in index order, over the
+           virtual texture. Depths and animation clips of the batch are ignored,
+           layer sprites are drawn in submission order and aren't pickable.
+           Waits for frames in flight, so layers aren't meant to change every frame.
+  @param layer Layer index, less than @ref MOSS_MAX_LAYER_COUNT.
+  @param batch Sprites of the layer, an empty batch hides the layer.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+__MOSS_API__ MossResult
+moss_engine_set_layer_sprites (uint32_t layer, const MossSpriteBatch *batch);
+
+/*
+  @brief Redraws a cached layer during the next frame.
+  @details Lighting is baked into cached renders, invalidate layers lit by lights
+           that have changed.
+  @param layer Layer index.
+*/
+__MOSS_API__ void moss_engine_invalidate_layer (uint32_t layer);
+
+/*
+  @brief Opens video decoded frames are uploaded to.
+  @details Frames are uploaded as multi-planar YUV images and converted to RGB by
+           the sampler on the GPU, so decoders never convert on the CPU. Replaces
+           the previously open video.
+  @param info Video information.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the size
+          isn't even or the GPU doesn't support sampler Ycbcr conversion or the
+          video format.
+*/
+__MOSS_API__ MossResult moss_engine_open_video (const MossVideoCreateInfo *info);
+
+/*
+  @brief Closes open video.
+*/
+__MOSS_API__ void moss_engine_close_video (void);
+
+/*
+  @brief Uploads decoded video frame during the next frame.
+  @details Planes are packed straight into per-frame upload memory, so they may be
+           reused once the function returns. Waits for the GPU to finish the frame
+           that used the same upload memory last. The latest uploaded frame keeps
+           being shown until a newer one is uploaded.
+  @param frame Decoded video frame.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if no video is
+          open or planes can't be read.
+*/
+__MOSS_API__ MossResult moss_engine_upload_video_frame (const MossVideoFrame *frame);
+
+/*
+  @brief Submits video placement for the current frame.
+  @details The video is drawn over the virtual texture and beneath cached layers.
+           Nothing is drawn until a frame has been uploaded.
+  @param view Placement of the video.
+*/
+__MOSS_API__ void moss_engine_submit_video (const MossVideoView *view);
+
+/*
+  @brief Renders independent scenes offscreen and reads them back.
+  @details All scenes are recorded into one command buffer and submitted at once,
+           each costing a viewport change and a draw. Scenes are read back with
+           one copy per pass of up to 256 scenes. Blocks until the GPU is done.
+           Meant for thumbnails, not for use every frame.
+  @param batch Scenes to render.
+  @param out_pixels Output RGBA8 pixels of all scenes, one after another, rows
+                    top to bottom. Must fit scene_count * width * height * 4 bytes.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+__MOSS_API__ MossResult
+moss_engine_render_offscreen_batch (const MossOffscreenBatch *batch, void *out_pixels);
+
+/*
+  @brief Starts capturing public API calls into a file.
+  @details Every call that changes engine state is written to the file with its
+           data, up to and including the last captured frame, after which the
+           file is closed. Resources created before the capture aren't part of
+           it, so captures meant for @ref moss_replay_capture start right after
+           initialization. Capturing costs a file write per call.
+  @param path Path to the capture file, replaced if it exists.
+  @param frame_count Number of frames to capture, at least one.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if a capture
+          is already running or the file can't be created.
+*/
+__MOSS_API__ MossResult moss_engine_begin_capture (const char *path, uint32_t frame_count);
+
+/*
+  @brief Stops capturing public API calls before the requested frame count.
+  @details Safe to call while not capturing.
+*/
+__MOSS_API__ void moss_engine_end_capture (void);
+
+/*
+  @brief Reports device memory taken by the engine.
+  @details Breaks down every crate and image the engine allocated by category and
+           by heap, along with the bytes lost to alignment within the blocks.
+           Cheap enough to poll every frame.
+  @param out_report Output report.
+*/
+__MOSS_API__ void moss_engine_get_vram_report (MossVramReport *out_report);
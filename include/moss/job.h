@@ -0,0 +1,148 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/job.h
+  @brief Job system functions.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details The engine owns a single pool of worker threads that execute jobs. Every
+           worker has its own job queue and steals jobs from the others when it runs
+           out of work. The engine uses the same pool internally, so applications
+           should submit their parallel work here instead of spawning threads.
+
+  @par Example:
+  @code
+    MossJob *const root = moss_job_create (update_world, world);
+    for (uint32_t i = 0; i < chunk_count; ++i)
+    {
+      moss_job_submit (moss_job_create_child (root, update_chunk, &chunks[ i ]));
+    }
+    moss_job_submit (root);
+    moss_job_wait (root);
+  @endcode
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "moss/apidef.h"
+#include "moss/result.h"
+
+/*
+  @brief Job handle.
+  @details Jobs are allocated from a per-thread pool. A slot is only reused once
+           its job and all of its children finish, so a handle stays valid until
+           then. Don't keep handles across frames.
+*/
+typedef struct MossJob MossJob;
+
+/* Number of unfinished jobs each thread can have at the same time. */
+#define MOSS_JOB_POOL_SIZE (uint32_t)(4096)
+
+/*
+  @brief Job function.
+  @param user_data User data passed on job creation.
+*/
+typedef void (*MossJobFunction) (void *user_data);
+
+/*
+  @brief Parallel for range function.
+  @param user_data User data passed to @ref moss_job_parallel_for.
+  @param begin First index of the range.
+  @param end Index past the last index of the range.
+*/
+typedef void (*MossJobRangeFunction) (void *user_data, uint32_t begin, uint32_t end);
+
+/*
+  @brief Job system configuration.
+*/
+typedef struct
+{
+  /* Total number of threads executing jobs, including the engine thread.
+     Zero means one thread per online CPU. */
+  uint32_t thread_count;
+
+  /* CPU index to pin each thread to, engine thread first. Must contain
+     @c thread_count entries. NULL leaves thread placement to the OS. */
+  const uint32_t *cpu_affinity;
+} MossJobSystemConfig;
+
+/*
+  @brief Creates a job.
+  @param function Function to execute.
+  @param user_data User data to pass to the function.
+  @return Job handle, or NULL if the calling thread already has
+          @ref MOSS_JOB_POOL_SIZE unfinished jobs. The job won't run until it's
+          submitted.
+  @note Must be called from the engine thread or from within a job.
+*/
+__MOSS_API__ MossJob *moss_job_create (MossJobFunction function, void *user_data);
+
+/*
+  @brief Creates a child job.
+  @details Parent job is not considered finished until all of its children finish.
+  @param parent Parent job.
+  @param function Function to execute.
+  @param user_data User data to pass to the function.
+  @return Job handle, or NULL if the job pool of the calling thread is exhausted.
+          The job won't run until it's submitted.
+*/
+__MOSS_API__ MossJob *
+moss_job_create_child (MossJob *parent, MossJobFunction function, void *user_data);
+
+/*
+  @brief Makes a job wait for another job.
+  @details @p job won't start until @p dependency and all of its children finish.
+  @param job Job that depends on the other one. Must not be submitted yet.
+  @param dependency Job to wait for. Must not be submitted yet.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if @p dependency has
+          too many dependent jobs.
+*/
+__MOSS_API__ MossResult moss_job_add_dependency (MossJob *job, MossJob *dependency);
+
+/*
+  @brief Submits a job for execution.
+  @details The job is executed as soon as all of its dependencies finish.
+  @param job Job to submit.
+*/
+__MOSS_API__ void moss_job_submit (MossJob *job);
+
+/*
+  @brief Waits until the job and all of its children finish.
+  @details The calling thread executes other jobs while waiting.
+  @param job Job to wait for.
+*/
+__MOSS_API__ void moss_job_wait (const MossJob *job);
+
+/*
+  @brief Executes range function over [0, count) in parallel and waits for it.
+  @details Batches that don't fit into the job pool run on the calling thread.
+  @param count Number of indices.
+  @param batch_size Number of indices processed by one job. Zero picks it automatically.
+  @param function Function to execute for every batch.
+  @param user_data User data to pass to the function.
+*/
+__MOSS_API__ void moss_job_parallel_for (
+  uint32_t             count,
+  uint32_t             batch_size,
+  MossJobRangeFunction function,
+  void                *user_data
+);
+
+/*
+  @brief Returns number of threads executing jobs, including the engine thread.
+  @return Thread count, or zero if the engine isn't initialized.
+*/
+__MOSS_API__ uint32_t moss_job_get_thread_count (void);
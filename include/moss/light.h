@@ -0,0 +1,43 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/light.h
+  @brief 2D light struct declaration.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Max number of lights that can be submitted during one frame. */
+#define MOSS_MAX_LIGHT_COUNT (uint32_t)(16384)
+
+/*
+  @brief Point or spot light.
+  @details Positions and radii use the same coordinate space as sprites.
+*/
+typedef struct
+{
+  float    x;          /* Light center X coordinate. */
+  float    y;          /* Light center Y coordinate. */
+  float    height;     /* Height above the sprite plane used to shade sprite
+                          normals. 0 lights sprites regardless of normals. */
+  float    radius;     /* Distance at which light fades out completely. */
+  float    intensity;  /* Intensity multiplier. */
+  uint32_t color;      /* RGBA8 color, red in the least significant byte. */
+  float    direction;  /* Spot direction in radians. Ignored by point lights. */
+  float    cone_angle; /* Spot half angle in radians, 0 makes a point light. */
+} MossLight;
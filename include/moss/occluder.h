@@ -0,0 +1,39 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/occluder.h
+  @brief Shadow occluder struct declaration.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Max number of occluders that can be submitted during one frame. */
+#define MOSS_MAX_OCCLUDER_COUNT (uint32_t)(16384)
+
+/*
+  @brief Line segment that blocks light.
+  @details Uses the same coordinate space as sprites. Polygons are submitted as
+           their edges.
+*/
+typedef struct
+{
+  float start_x; /* Segment start X coordinate. */
+  float start_y; /* Segment start Y coordinate. */
+  float end_x;   /* Segment end X coordinate. */
+  float end_y;   /* Segment end Y coordinate. */
+} MossOccluder;
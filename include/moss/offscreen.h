@@ -0,0 +1,46 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/offscreen.h
+  @brief Batched offscreen rendering declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "moss/sprite.h"
+
+/* Size of the offscreen target scenes are packed into, per axis. */
+#define MOSS_OFFSCREEN_TARGET_SIZE (uint32_t)(2048)
+
+/*
+  @brief Independent scenes rendered offscreen at once.
+  @details Scenes are packed into regions of a shared target, each drawn with its
+           own viewport, so a scene costs a single draw instead of a frame.
+           Sprite coordinates span the scene's region the same way they span the
+           window. Depths and animation clips are ignored, sprites are drawn in
+           submission order, unlit.
+*/
+typedef struct
+{
+  const MossSpriteBatch *scenes;      /* Sprites of every scene. */
+  uint32_t               scene_count; /* Number of scenes. */
+  uint32_t               width;       /* Width of every scene in pixels, at most
+                                         @ref MOSS_OFFSCREEN_TARGET_SIZE. */
+  uint32_t               height;      /* Height of every scene in pixels, at most
+                                         @ref MOSS_OFFSCREEN_TARGET_SIZE. */
+} MossOffscreenBatch;
@@ -0,0 +1,49 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/picking.h
+  @brief GPU object picking declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+  @brief Kind of object drawn at a picked pixel.
+*/
+typedef enum
+{
+  MOSS_PICK_TARGET_NONE,         /* Nothing pickable covers the pixel. */
+  MOSS_PICK_TARGET_SPRITE,       /* Sprite. */
+  MOSS_PICK_TARGET_SKINNED_MESH, /* Skinned mesh. */
+} MossPickTarget;
+
+/*
+  @brief Result of a pick request.
+  @details Describes the frame drawn right after the request. Indices count objects
+           of that frame in submission order, so applications map them back to
+           their own objects the same way they submitted them.
+*/
+typedef struct
+{
+  MossPickTarget target; /* Kind of the topmost object at the pixel. */
+  uint32_t       index;  /* Index of the sprite among all sprites of the frame, or of
+                            the skinned mesh among its skinned mesh submissions.
+                            Undefined for @ref MOSS_PICK_TARGET_NONE. */
+  float          x;      /* X coordinate the pick was requested at. */
+  float          y;      /* Y coordinate the pick was requested at. */
+} MossPickResult;
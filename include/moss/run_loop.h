@@ -0,0 +1,60 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/run_loop.h
+  @brief Event-driven main loop declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+/* Frame callback return value that waits for input or invalidation. */
+#define MOSS_WAIT_FOREVER (float)(-1.0F)
+
+/*
+  @brief Callback that submits contents of a frame.
+  @details Called right before the frame is drawn, submissions like
+           @ref moss_engine_submit_sprites go here.
+  @param user_data User data from @ref MossRunConfig.
+  @param delta_seconds Time since the previous frame, 0 for the first frame.
+  @return Seconds until the next frame is needed: 0 while animating, a delay for
+          timers or @ref MOSS_WAIT_FOREVER to sleep until input or invalidation.
+*/
+typedef float (*MossFrameCallback) (void *user_data, float delta_seconds);
+
+/*
+  @brief Callback invoked every time window events are processed.
+  @details Called even while no frames are drawn, so input can be checked here and
+           redraws requested with @ref moss_engine_invalidate.
+  @param user_data User data from @ref MossRunConfig.
+*/
+typedef void (*MossEventCallback) (void *user_data);
+
+/*
+  @brief Main loop configuration.
+  @details Windows give no blocking wait for events, so an idle loop wakes every
+           @c idle_event_interval seconds to process them. The interval bounds the
+           latency of the first input after idling, shorter ones trade CPU time
+           and power for responsiveness. @ref moss_engine_invalidate wakes the
+           loop right away regardless of the interval.
+*/
+typedef struct
+{
+  MossFrameCallback frame_callback;      /* Frame callback, must not be NULL. */
+  MossEventCallback event_callback;      /* Event callback, may be NULL. */
+  void             *user_data;           /* User data passed to callbacks. */
+  float             idle_event_interval; /* Seconds between event checks while
+                                            idle, 0 for 0.1 seconds. */
+} MossRunConfig;
@@ -0,0 +1,86 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/skeleton.h
+  @brief Skeletal mesh declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Max number of skinned meshes that can be created. */
+#define MOSS_MAX_SKINNED_MESH_COUNT (uint32_t)(256)
+
+/* Max number of bones of a single skinned mesh. */
+#define MOSS_MAX_SKINNED_MESH_BONE_COUNT (uint32_t)(256)
+
+/* Max number of skinned meshes that can be submitted during one frame. */
+#define MOSS_MAX_SKINNED_MESH_DRAW_COUNT (uint32_t)(4096)
+
+/* Max number of bones of all skinned meshes submitted during one frame. */
+#define MOSS_MAX_BONE_COUNT (uint32_t)(65536)
+
+/* Number of bones a single vertex may follow. */
+#define MOSS_BONE_INFLUENCE_COUNT (uint32_t)(4)
+
+/* Parent of root bones. */
+#define MOSS_BONE_PARENT_NONE (uint32_t)(0xFFFFFFFF)
+
+/*
+  @brief Bone transform relative to its parent.
+  @details Root bone transforms are relative to the sprite coordinate space.
+*/
+typedef struct
+{
+  uint32_t parent;   /* Parent bone index, smaller than the bone's own index, or
+                        @ref MOSS_BONE_PARENT_NONE. */
+  float    x;        /* X translation. */
+  float    y;        /* Y translation. */
+  float    rotation; /* Rotation in radians. */
+  float    scale_x;  /* X scale. */
+  float    scale_y;  /* Y scale. */
+} MossBone;
+
+/*
+  @brief Skinned mesh vertex.
+  @details Positions are given in the bind pose, weights of a vertex should sum
+           up to 1.
+*/
+typedef struct
+{
+  float    position[ 2 ];                             /* Bind pose position. */
+  float    texture_coordinates[ 2 ];                  /* Texture coordinates. */
+  uint32_t color;                                     /* RGBA8 color, red in the least
+                                                         significant byte. */
+  uint32_t texture_index;                             /* Texture index. */
+  uint8_t  bone_indices[ MOSS_BONE_INFLUENCE_COUNT ]; /* Influencing bones. */
+  float    bone_weights[ MOSS_BONE_INFLUENCE_COUNT ]; /* Influence weights. */
+} MossSkinnedVertex;
+
+/*
+  @brief Skinned mesh creation information.
+*/
+typedef struct
+{
+  const MossSkinnedVertex *vertices;     /* Mesh vertices. */
+  uint32_t                 vertex_count; /* Number of vertices. */
+  const uint32_t          *indices;      /* Triangle list indices. */
+  uint32_t                 index_count;  /* Number of indices. */
+  const MossBone          *bind_pose;    /* Bones in the pose vertices are given in. */
+  uint32_t                 bone_count;   /* Number of bones, at most
+                                            @ref MOSS_MAX_SKINNED_MESH_BONE_COUNT. */
+} MossSkinnedMeshCreateInfo;
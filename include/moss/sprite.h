@@ -0,0 +1,52 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/sprite.h
+  @brief Sprite batch struct declaration.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Max number of sprites that can be submitted during one frame. */
+#define MOSS_MAX_SPRITE_COUNT (uint32_t)(65536)
+
+/*
+  @brief Sprites stored as parallel arrays.
+  @details Matches the way ECS-based applications keep component data, so sprites
+           can be submitted without gathering them into per-sprite structs. Every
+           non-NULL array must contain at least @c count elements.
+*/
+typedef struct
+{
+  const float    *x;                    /* Sprite center X coordinates. */
+  const float    *y;                    /* Sprite center Y coordinates. */
+  const float    *rotation;             /* Rotations in radians. May be NULL. */
+  const float    *scale_x;              /* Sprite widths. */
+  const float    *scale_y;              /* Sprite heights. */
+  const uint32_t *texture_index;        /* Texture indices. May be NULL. */
+  const uint32_t *color;                /* RGBA8 colors, red in the least significant
+                                           byte. May be NULL, which means white. */
+  const float    *depth;                /* Depths, larger depths are drawn first. May be
+                                           NULL, which keeps submission order. */
+  const uint32_t *animation_clip;       /* Animation clip IDs, static sprites use
+                                           @ref MOSS_ANIMATION_CLIP_NONE. May be NULL,
+                                           which means no sprite is animated. */
+  const float    *animation_start_time; /* Animation times clips started playing at.
+                                           Ignored if @c animation_clip is NULL. */
+  uint32_t        count;                /* Number of sprites. */
+} MossSpriteBatch;
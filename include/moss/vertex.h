@@ -32,6 +32,8 @@
 */
 typedef struct
 {
-  vec2 position; /* Vertex position. */
-  vec3 color;    /* Vertex color. */
+  vec2     position;            /* Vertex position. */
+  vec3     color;               /* Vertex color. */
+  vec2     texture_coordinates; /* Texture coordinates. */
+  uint32_t texture_index;       /* Index of the texture to sample. */
 } MossVertex;
@@ -0,0 +1,91 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/video.h
+  @brief YUV video texture declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Max number of planes of a video frame. */
+#define MOSS_MAX_VIDEO_PLANE_COUNT (uint32_t)(3)
+
+/*
+  @brief Layout of decoded video frames.
+  @details Chroma planes of both formats are subsampled by 2 on both axes, so
+           videos must have even width and height.
+*/
+typedef enum
+{
+  MOSS_VIDEO_FORMAT_NV12, /* Y plane followed by an interleaved CbCr plane. */
+  MOSS_VIDEO_FORMAT_I420, /* Y plane followed by Cb and Cr planes. */
+} MossVideoFormat;
+
+/*
+  @brief Color model video frames are encoded with.
+*/
+typedef enum
+{
+  MOSS_VIDEO_COLOR_SPACE_BT601, /* ITU-R BT.601, standard definition video. */
+  MOSS_VIDEO_COLOR_SPACE_BT709, /* ITU-R BT.709, high definition video. */
+} MossVideoColorSpace;
+
+/*
+  @brief Video texture creation information.
+*/
+typedef struct
+{
+  MossVideoFormat     format;        /* Layout of frames. */
+  MossVideoColorSpace color_space;   /* Color model of frames. */
+  bool                is_full_range; /* Whether samples use the full 0-255 range
+                                        instead of the 16-235 video range. */
+  uint32_t            width;         /* Width of the luma plane in texels, even. */
+  uint32_t            height;        /* Height of the luma plane in texels, even. */
+} MossVideoCreateInfo;
+
+/*
+  @brief Decoded video frame.
+  @details Planes are either read from memory or, when @c planes are NULL,
+           straight from a file descriptor into upload memory, e.g. from a
+           shared memory file a decoder writes to. Pipes can't be read from.
+*/
+typedef struct
+{
+  const void *planes[ MOSS_MAX_VIDEO_PLANE_COUNT ]; /* Plane memory, NULL to read
+                                                       the plane from the file
+                                                       descriptor. */
+  uint32_t    strides[ MOSS_MAX_VIDEO_PLANE_COUNT ]; /* Bytes between rows of every
+                                                        plane, 0 for tightly
+                                                        packed rows. */
+  int         file_descriptor; /* File descriptor planes without memory are read
+                                  from. */
+  uint64_t    offsets[ MOSS_MAX_VIDEO_PLANE_COUNT ]; /* Offsets of planes in the
+                                                        file descriptor. */
+} MossVideoFrame;
+
+/*
+  @brief Placement of the video on the screen.
+*/
+typedef struct
+{
+  float x;      /* Left edge in normalized device coordinates. */
+  float y;      /* Top edge in normalized device coordinates. */
+  float width;  /* Width in normalized device coordinates. */
+  float height; /* Height in normalized device coordinates. */
+} MossVideoView;
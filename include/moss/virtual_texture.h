@@ -0,0 +1,69 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/virtual_texture.h
+  @brief Virtual texture file format and view declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Virtual texture file starts with @ref MossVirtualTextureFileHeader and
+           is followed by tiles of every level, from level 0 (full resolution) to
+           the coarsest one. Level @c l is @c max(1, width >> l) by
+           @c max(1, height >> l) texels. Tiles of a level are stored row by row,
+           every tile is @ref MOSS_VIRTUAL_TEXTURE_PAGE_SIZE squared RGBA8 texels,
+           also stored row by row. Edge tiles are padded to the full size.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/* Magic number virtual texture files start with, "MVTX" in little endian. */
+#define MOSS_VIRTUAL_TEXTURE_MAGIC (uint32_t)(0x5854564D)
+
+/* Version of the virtual texture file format. */
+#define MOSS_VIRTUAL_TEXTURE_VERSION (uint32_t)(1)
+
+/* Width and height of a tile in texels. */
+#define MOSS_VIRTUAL_TEXTURE_PAGE_SIZE (uint32_t)(128)
+
+/* Max number of levels of a virtual texture. */
+#define MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT (uint32_t)(16)
+
+/*
+  @brief Header of a virtual texture file.
+*/
+typedef struct
+{
+  uint32_t magic;         /* Must be @ref MOSS_VIRTUAL_TEXTURE_MAGIC. */
+  uint32_t version;       /* Must be @ref MOSS_VIRTUAL_TEXTURE_VERSION. */
+  uint32_t width;         /* Width of level 0 in texels. */
+  uint32_t height;        /* Height of level 0 in texels. */
+  uint32_t level_count;   /* Number of levels stored in the file. */
+  uint32_t reserved[ 3 ]; /* Must be zero. */
+} MossVirtualTextureFileHeader;
+
+/*
+  @brief Placement of the virtual texture on the screen.
+*/
+typedef struct
+{
+  float x;         /* Left edge in normalized device coordinates. */
+  float y;         /* Top edge in normalized device coordinates. */
+  float width;     /* Width in normalized device coordinates. */
+  float height;    /* Height in normalized device coordinates. */
+  float uv_left;   /* Left edge of the shown image region, 0 to 1. */
+  float uv_top;    /* Top edge of the shown image region, 0 to 1. */
+  float uv_right;  /* Right edge of the shown image region, 0 to 1. */
+  float uv_bottom; /* Bottom edge of the shown image region, 0 to 1. */
+} MossVirtualTextureView;
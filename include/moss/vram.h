@@ -0,0 +1,78 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file include/moss/vram.h
+  @brief Device memory usage report declarations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Max number of memory heaps a report describes, matches VK_MAX_MEMORY_HEAPS. */
+#define MOSS_MAX_VRAM_HEAP_COUNT (uint32_t)(16)
+
+/*
+  @brief What device memory is spent on.
+*/
+typedef enum
+{
+  MOSS_VRAM_CATEGORY_GEOMETRY,       /* Vertex and index crates. */
+  MOSS_VRAM_CATEGORY_BUFFERS,        /* Uniform, storage and indirect crates. */
+  MOSS_VRAM_CATEGORY_STAGING,        /* Host visible upload and readback crates. */
+  MOSS_VRAM_CATEGORY_TEXTURES,       /* Sampled images: video and virtual texture. */
+  MOSS_VRAM_CATEGORY_RENDER_TARGETS, /* Scene, layer and offscreen attachments. */
+  MOSS_VRAM_CATEGORY_COUNT,          /* Number of categories. */
+} MossVramCategory;
+
+/*
+  @brief Device memory taken by a group of allocations.
+  @details Reserved bytes are the sizes of device memory blocks, used bytes are the
+           sizes resources asked for. The difference is lost to alignment and
+           padding. Images report their memory requirements as used bytes, since
+           their layout is up to the driver.
+*/
+typedef struct
+{
+  uint32_t allocation_count; /* Number of device memory blocks. */
+  uint64_t used_size;        /* Bytes resources asked for. */
+  uint64_t reserved_size;    /* Bytes of device memory blocks. */
+} MossVramUsage;
+
+/*
+  @brief Device memory heap and engine allocations in it.
+*/
+typedef struct
+{
+  uint64_t      size;            /* Total heap size in bytes. */
+  bool          is_device_local; /* Whether the heap is on the GPU itself. */
+  MossVramUsage usage;           /* Engine allocations in the heap. */
+} MossVramHeap;
+
+/*
+  @brief Device memory usage of the engine.
+  @details Covers every crate and image the engine allocates. Swapchain images
+           belong to the presentation engine and driver internal memory isn't
+           visible to the engine, so neither is reported.
+*/
+typedef struct
+{
+  MossVramUsage total;                                  /* All allocations. */
+  MossVramUsage categories[ MOSS_VRAM_CATEGORY_COUNT ]; /* Usage per category. */
+  uint32_t      heap_count;                             /* Number of heaps. */
+  MossVramHeap  heaps[ MOSS_MAX_VRAM_HEAP_COUNT ];      /* Usage per heap. */
+} MossVramReport;
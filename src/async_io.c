@@ -0,0 +1,619 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/async_io.c
+  @brief Asynchronous file read functions implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#ifdef __linux__
+#  define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#endif
+
+#include "moss/result.h"
+
+#include "src/internal/async_io.h"
+#include "src/internal/log.h"
+
+/* Marks the end of the free slot list. */
+#define MOSS__ASYNC_IO_INVALID_SLOT UINT32_MAX
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Takes a slot from the free list.
+  @return Slot index, or MOSS__ASYNC_IO_INVALID_SLOT if all slots are in use.
+*/
+inline static uint32_t moss__acquire_async_read_slot (Moss__AsyncIo *async_io);
+
+/*
+  @brief Returns a slot to the free list.
+*/
+inline static void moss__release_async_read_slot (Moss__AsyncIo *async_io, uint32_t slot);
+
+/*
+  @brief Reports a completed request and releases its slot.
+*/
+inline static void moss__complete_async_read (Moss__AsyncIo *async_io, uint32_t slot);
+
+/*
+  @brief Reads the whole range of the request with blocking reads.
+*/
+inline static void moss__read_async_request (Moss__AsyncReadRequest *request);
+
+/*
+  @brief I/O thread entry point, reads queued requests until stopped.
+  @param arg Reader.
+*/
+static void *moss__async_io_thread (void *arg);
+
+#ifdef __linux__
+/*
+  @brief Sets up io_uring rings.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__setup_io_uring (Moss__IoUring *ring, uint32_t entries);
+
+/*
+  @brief Checks whether the kernel supports reads on the ring.
+  @details IORING_OP_READ and the probe both appeared in Linux 5.6, so a failing
+           probe means reads aren't supported either.
+  @return True if IORING_OP_READ is supported, false otherwise.
+*/
+inline static bool moss__is_io_uring_read_supported (const Moss__IoUring *ring);
+
+/*
+  @brief Unmaps io_uring rings and closes io_uring file descriptor.
+*/
+inline static void moss__teardown_io_uring (Moss__IoUring *ring);
+
+/*
+  @brief Queues read of the remaining part of the request in the submission ring.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__queue_io_uring_read (Moss__AsyncIo *async_io, uint32_t slot);
+
+/*
+  @brief Reaps io_uring completion ring.
+  @return Number of reported requests.
+*/
+inline static uint32_t moss__reap_io_uring (Moss__AsyncIo *async_io);
+#endif
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__init_async_io (
+  const Moss__AsyncIoCreateInfo *const info,
+  Moss__AsyncIo *const                 out_async_io
+)
+{
+  memset (out_async_io, 0, sizeof (*out_async_io));
+
+  for (uint32_t i = 0; i < MOSS__ASYNC_IO_MAX_REQUESTS; ++i)
+  {
+    out_async_io->requests[ i ].next_free =
+      (i + 1 < MOSS__ASYNC_IO_MAX_REQUESTS) ? i + 1 : MOSS__ASYNC_IO_INVALID_SLOT;
+  }
+  out_async_io->free_head = 0;
+
+#ifdef __linux__
+  out_async_io->ring.ring_fd = -1;
+
+  if (info->allow_io_uring &&
+      moss__setup_io_uring (&out_async_io->ring, MOSS__ASYNC_IO_MAX_REQUESTS) ==
+        MOSS_RESULT_SUCCESS)
+  {
+    if (moss__is_io_uring_read_supported (&out_async_io->ring))
+    {
+      out_async_io->backend    = MOSS__ASYNC_IO_BACKEND_IO_URING;
+      out_async_io->is_running = true;
+      moss__info ("Using io_uring for asynchronous reads.\n");
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    moss__info ("io_uring doesn't support reads on this kernel.\n");
+    moss__teardown_io_uring (&out_async_io->ring);
+  }
+#endif
+
+  out_async_io->backend = MOSS__ASYNC_IO_BACKEND_THREAD;
+
+  pthread_mutex_init (&out_async_io->mutex, NULL);
+  pthread_cond_init (&out_async_io->condition, NULL);
+  pthread_cond_init (&out_async_io->pending_condition, NULL);
+
+  if (pthread_create (&out_async_io->thread, NULL, moss__async_io_thread, out_async_io) !=
+      0)
+  {
+    moss__error ("Failed to create I/O thread.\n");
+    pthread_cond_destroy (&out_async_io->pending_condition);
+    pthread_cond_destroy (&out_async_io->condition);
+    pthread_mutex_destroy (&out_async_io->mutex);
+    return MOSS_RESULT_ERROR;
+  }
+
+  out_async_io->is_running = true;
+  return MOSS_RESULT_SUCCESS;
+}
+
+MossResult moss__submit_async_read (
+  Moss__AsyncIo *const             async_io,
+  const Moss__AsyncReadInfo *const info
+)
+{
+  const uint32_t slot = moss__acquire_async_read_slot (async_io);
+  if (slot == MOSS__ASYNC_IO_INVALID_SLOT)
+  {
+    moss__error ("Too many asynchronous reads in flight.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  Moss__AsyncReadRequest *const request = &async_io->requests[ slot ];
+  request->info       = *info;
+  request->bytes_read = 0;
+  request->result     = MOSS_RESULT_SUCCESS;
+
+#ifdef __linux__
+  if (async_io->backend == MOSS__ASYNC_IO_BACKEND_IO_URING)
+  {
+    if (moss__queue_io_uring_read (async_io, slot) != MOSS_RESULT_SUCCESS)
+    {
+      moss__release_async_read_slot (async_io, slot);
+      return MOSS_RESULT_ERROR;
+    }
+
+    ++async_io->in_flight_count;
+    return MOSS_RESULT_SUCCESS;
+  }
+#endif
+
+  // Slots bound the number of requests, so the pending ring never overflows
+  pthread_mutex_lock (&async_io->mutex);
+  async_io->pending_queue[ async_io->pending_tail % MOSS__ASYNC_IO_MAX_REQUESTS ] = slot;
+  ++async_io->pending_tail;
+  pthread_cond_signal (&async_io->pending_condition);
+  pthread_mutex_unlock (&async_io->mutex);
+
+  ++async_io->in_flight_count;
+  return MOSS_RESULT_SUCCESS;
+}
+
+uint32_t moss__poll_async_io (Moss__AsyncIo *const async_io)
+{
+  if (async_io->in_flight_count == 0) { return 0; }
+
+#ifdef __linux__
+  if (async_io->backend == MOSS__ASYNC_IO_BACKEND_IO_URING)
+  {
+    return moss__reap_io_uring (async_io);
+  }
+#endif
+
+  // Grab completed slots under the lock, report them without it, so callbacks
+  // are free to submit new reads.
+  uint32_t completed[ MOSS__ASYNC_IO_MAX_REQUESTS ];
+  uint32_t completed_count = 0;
+
+  pthread_mutex_lock (&async_io->mutex);
+  while (async_io->completed_head != async_io->completed_tail)
+  {
+    completed[ completed_count++ ] =
+      async_io->completed_queue[ async_io->completed_head % MOSS__ASYNC_IO_MAX_REQUESTS ];
+    ++async_io->completed_head;
+  }
+  pthread_mutex_unlock (&async_io->mutex);
+
+  for (uint32_t i = 0; i < completed_count; ++i)
+  {
+    moss__complete_async_read (async_io, completed[ i ]);
+  }
+
+  return completed_count;
+}
+
+void moss__wait_async_io_idle (Moss__AsyncIo *const async_io)
+{
+  while (async_io->in_flight_count != 0)
+  {
+    if (moss__poll_async_io (async_io) != 0) { continue; }
+
+#ifdef __linux__
+    if (async_io->backend == MOSS__ASYNC_IO_BACKEND_IO_URING)
+    {
+      // Block in the kernel until at least one completion arrives
+      syscall (
+        __NR_io_uring_enter,
+        async_io->ring.ring_fd,
+        0,
+        1,
+        IORING_ENTER_GETEVENTS,
+        NULL,
+        0
+      );
+      continue;
+    }
+#endif
+
+    pthread_mutex_lock (&async_io->mutex);
+    while (async_io->completed_head == async_io->completed_tail)
+    {
+      pthread_cond_wait (&async_io->condition, &async_io->mutex);
+    }
+    pthread_mutex_unlock (&async_io->mutex);
+  }
+}
+
+void moss__deinit_async_io (Moss__AsyncIo *const async_io)
+{
+  if (async_io == NULL || !async_io->is_running) { return; }
+
+  moss__wait_async_io_idle (async_io);
+  async_io->is_running = false;
+
+#ifdef __linux__
+  if (async_io->backend == MOSS__ASYNC_IO_BACKEND_IO_URING)
+  {
+    moss__teardown_io_uring (&async_io->ring);
+    return;
+  }
+#endif
+
+  pthread_mutex_lock (&async_io->mutex);
+  async_io->is_thread_stopping = true;
+  pthread_cond_signal (&async_io->pending_condition);
+  pthread_mutex_unlock (&async_io->mutex);
+
+  pthread_join (async_io->thread, NULL);
+
+  pthread_cond_destroy (&async_io->pending_condition);
+  pthread_cond_destroy (&async_io->condition);
+  pthread_mutex_destroy (&async_io->mutex);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+inline static uint32_t moss__acquire_async_read_slot (Moss__AsyncIo *const async_io)
+{
+  const uint32_t slot = async_io->free_head;
+  if (slot == MOSS__ASYNC_IO_INVALID_SLOT) { return slot; }
+
+  async_io->free_head = async_io->requests[ slot ].next_free;
+  return slot;
+}
+
+inline static void
+moss__release_async_read_slot (Moss__AsyncIo *const async_io, const uint32_t slot)
+{
+  async_io->requests[ slot ].next_free = async_io->free_head;
+  async_io->free_head                  = slot;
+}
+
+inline static void
+moss__complete_async_read (Moss__AsyncIo *const async_io, const uint32_t slot)
+{
+  // Copy request out, so the slot can be reused from within the callback
+  const Moss__AsyncReadRequest request = async_io->requests[ slot ];
+
+  moss__release_async_read_slot (async_io, slot);
+  --async_io->in_flight_count;
+
+  if (request.info.callback != NULL)
+  {
+    request.info.callback (request.info.user_data, request.result, request.bytes_read);
+  }
+}
+
+inline static void moss__read_async_request (Moss__AsyncReadRequest *const request)
+{
+  // Read the whole range, retrying short and interrupted reads
+  while (request->bytes_read < request->info.size)
+  {
+    const ssize_t result = pread (
+      request->info.file_descriptor,
+      (uint8_t *)request->info.destination + request->bytes_read,
+      request->info.size - request->bytes_read,
+      (off_t)(request->info.offset + request->bytes_read)
+    );
+
+    if (result < 0 && errno == EINTR) { continue; }
+    if (result <= 0)
+    {
+      request->result = MOSS_RESULT_ERROR;
+      break;
+    }
+
+    request->bytes_read += (size_t)result;
+  }
+}
+
+static void *moss__async_io_thread (void *const arg)
+{
+  Moss__AsyncIo *const async_io = arg;
+
+  pthread_mutex_lock (&async_io->mutex);
+  while (true)
+  {
+    while (!async_io->is_thread_stopping &&
+           async_io->pending_head == async_io->pending_tail)
+    {
+      pthread_cond_wait (&async_io->pending_condition, &async_io->mutex);
+    }
+
+    // Deinit waits for all reads first, so nothing is pending when stopping
+    if (async_io->is_thread_stopping) { break; }
+
+    const uint32_t slot =
+      async_io->pending_queue[ async_io->pending_head % MOSS__ASYNC_IO_MAX_REQUESTS ];
+    ++async_io->pending_head;
+
+    // Read without the lock, so submits and polls don't wait on the disk
+    pthread_mutex_unlock (&async_io->mutex);
+    moss__read_async_request (&async_io->requests[ slot ]);
+    pthread_mutex_lock (&async_io->mutex);
+
+    async_io->completed_queue[ async_io->completed_tail % MOSS__ASYNC_IO_MAX_REQUESTS ] =
+      slot;
+    ++async_io->completed_tail;
+    pthread_cond_broadcast (&async_io->condition);
+  }
+  pthread_mutex_unlock (&async_io->mutex);
+
+  return NULL;
+}
+
+#ifdef __linux__
+
+inline static MossResult
+moss__setup_io_uring (Moss__IoUring *const ring, const uint32_t entries)
+{
+  struct io_uring_params params;
+  memset (&params, 0, sizeof (params));
+
+  ring->ring_fd = (int)syscall (__NR_io_uring_setup, entries, &params);
+  if (ring->ring_fd < 0)
+  {
+    moss__info ("io_uring is not available (errno %d).\n", errno);
+    return MOSS_RESULT_ERROR;
+  }
+
+  ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof (uint32_t);
+  ring->cq_ring_size =
+    params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+
+  // Newer kernels map both rings with a single mmap call
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+  {
+    if (ring->cq_ring_size > ring->sq_ring_size)
+    {
+      ring->sq_ring_size = ring->cq_ring_size;
+    }
+    ring->cq_ring_size = ring->sq_ring_size;
+  }
+
+  ring->sq_ring = mmap (
+    NULL,
+    ring->sq_ring_size,
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_POPULATE,
+    ring->ring_fd,
+    IORING_OFF_SQ_RING
+  );
+  if (ring->sq_ring == MAP_FAILED)
+  {
+    ring->sq_ring = NULL;
+    moss__teardown_io_uring (ring);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (single_mmap) { ring->cq_ring = ring->sq_ring; }
+  else {
+    ring->cq_ring = mmap (
+      NULL,
+      ring->cq_ring_size,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring->ring_fd,
+      IORING_OFF_CQ_RING
+    );
+    if (ring->cq_ring == MAP_FAILED)
+    {
+      ring->cq_ring = NULL;
+      moss__teardown_io_uring (ring);
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  ring->sqes_size = params.sq_entries * sizeof (struct io_uring_sqe);
+  ring->sqes      = mmap (
+    NULL,
+    ring->sqes_size,
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_POPULATE,
+    ring->ring_fd,
+    IORING_OFF_SQES
+  );
+  if (ring->sqes == MAP_FAILED)
+  {
+    ring->sqes = NULL;
+    moss__teardown_io_uring (ring);
+    return MOSS_RESULT_ERROR;
+  }
+
+  uint8_t *const sq_ring = ring->sq_ring;
+  ring->sq_head          = (uint32_t *)(sq_ring + params.sq_off.head);
+  ring->sq_tail          = (uint32_t *)(sq_ring + params.sq_off.tail);
+  ring->sq_mask          = (uint32_t *)(sq_ring + params.sq_off.ring_mask);
+  ring->sq_array         = (uint32_t *)(sq_ring + params.sq_off.array);
+  ring->sq_entries       = params.sq_entries;
+
+  uint8_t *const cq_ring = ring->cq_ring;
+  ring->cq_head          = (uint32_t *)(cq_ring + params.cq_off.head);
+  ring->cq_tail          = (uint32_t *)(cq_ring + params.cq_off.tail);
+  ring->cq_mask          = (uint32_t *)(cq_ring + params.cq_off.ring_mask);
+  ring->cqes             = (struct io_uring_cqe *)(cq_ring + params.cq_off.cqes);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static bool moss__is_io_uring_read_supported (const Moss__IoUring *const ring)
+{
+  const size_t probe_size =
+    sizeof (struct io_uring_probe) + IORING_OP_LAST * sizeof (struct io_uring_probe_op);
+
+  struct io_uring_probe *const probe = calloc (1, probe_size);
+  if (probe == NULL) { return false; }
+
+  const int result = (int)syscall (
+    __NR_io_uring_register,
+    ring->ring_fd,
+    IORING_REGISTER_PROBE,
+    probe,
+    IORING_OP_LAST
+  );
+
+  const bool is_supported = result >= 0 && probe->last_op >= IORING_OP_READ &&
+                            (probe->ops[ IORING_OP_READ ].flags & IO_URING_OP_SUPPORTED);
+
+  free (probe);
+  return is_supported;
+}
+
+inline static void moss__teardown_io_uring (Moss__IoUring *const ring)
+{
+  if (ring->sqes != NULL) { munmap (ring->sqes, ring->sqes_size); }
+  if (ring->cq_ring != NULL && ring->cq_ring != ring->sq_ring)
+  {
+    munmap (ring->cq_ring, ring->cq_ring_size);
+  }
+  if (ring->sq_ring != NULL) { munmap (ring->sq_ring, ring->sq_ring_size); }
+  if (ring->ring_fd >= 0) { close (ring->ring_fd); }
+
+  memset (ring, 0, sizeof (*ring));
+  ring->ring_fd = -1;
+}
+
+inline static MossResult
+moss__queue_io_uring_read (Moss__AsyncIo *const async_io, const uint32_t slot)
+{
+  Moss__IoUring *const                ring    = &async_io->ring;
+  const Moss__AsyncReadRequest *const request = &async_io->requests[ slot ];
+
+  const uint32_t tail = *ring->sq_tail;
+  const uint32_t head = __atomic_load_n (ring->sq_head, __ATOMIC_ACQUIRE);
+  if (tail - head >= ring->sq_entries)
+  {
+    moss__error ("io_uring submission queue is full.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Length is 32 bits wide, larger reads complete short and queue the rest again
+  const size_t remaining_size = request->info.size - request->bytes_read;
+
+  const uint32_t             index = tail & *ring->sq_mask;
+  struct io_uring_sqe *const sqe   = &ring->sqes[ index ];
+  memset (sqe, 0, sizeof (*sqe));
+  sqe->opcode    = IORING_OP_READ;
+  sqe->fd        = request->info.file_descriptor;
+  sqe->addr      = (uint64_t)(uintptr_t)((uint8_t *)request->info.destination +
+                                    request->bytes_read);
+  sqe->len       = (remaining_size > UINT32_MAX) ? UINT32_MAX : (uint32_t)remaining_size;
+  sqe->off       = request->info.offset + request->bytes_read;
+  sqe->user_data = slot;
+
+  ring->sq_array[ index ] = index;
+  __atomic_store_n (ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+  const int submitted =
+    (int)syscall (__NR_io_uring_enter, ring->ring_fd, 1, 0, 0, NULL, 0);
+  if (submitted < 0)
+  {
+    moss__error ("Failed to submit io_uring read (errno %d).\n", errno);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static uint32_t moss__reap_io_uring (Moss__AsyncIo *const async_io)
+{
+  Moss__IoUring *const ring = &async_io->ring;
+
+  uint32_t reported_count = 0;
+  uint32_t head           = *ring->cq_head;
+  uint32_t tail           = __atomic_load_n (ring->cq_tail, __ATOMIC_ACQUIRE);
+
+  while (head != tail)
+  {
+    const struct io_uring_cqe cqe  = ring->cqes[ head & *ring->cq_mask ];
+    const uint32_t            slot = (uint32_t)cqe.user_data;
+    ++head;
+    __atomic_store_n (ring->cq_head, head, __ATOMIC_RELEASE);
+
+    Moss__AsyncReadRequest *const request = &async_io->requests[ slot ];
+
+    if (cqe.res < 0 && cqe.res != -EINTR && cqe.res != -EAGAIN)
+    {
+      request->result = MOSS_RESULT_ERROR;
+    }
+    else if (cqe.res == 0 && request->bytes_read < request->info.size)
+    {
+      // End of file before the range was read, zero-size reads succeed as with pread
+      request->result = MOSS_RESULT_ERROR;
+    }
+    else if (cqe.res > 0) { request->bytes_read += (size_t)cqe.res; }
+
+    // Short or interrupted read, queue the rest of the range again
+    if (request->result == MOSS_RESULT_SUCCESS &&
+        request->bytes_read < request->info.size &&
+        moss__queue_io_uring_read (async_io, slot) == MOSS_RESULT_SUCCESS)
+    {
+      continue;
+    }
+
+    if (request->bytes_read < request->info.size) { request->result = MOSS_RESULT_ERROR; }
+
+    moss__complete_async_read (async_io, slot);
+    ++reported_count;
+
+    // Callbacks may have submitted new reads that already completed
+    tail = __atomic_load_n (ring->cq_tail, __ATOMIC_ACQUIRE);
+  }
+
+  return reported_count;
+}
+
+#endif
@@ -0,0 +1,543 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/capture.c
+  @brief API call capture implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "moss/capture.h"
+#include "moss/result.h"
+
+#include "src/internal/capture.h"
+#include "src/internal/log.h"
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Locks the capture mutex if calls are being captured.
+  @param capture Capture state.
+  @return Returns true with the mutex locked while capturing, false otherwise.
+*/
+inline static bool moss__lock_capture (Moss__Capture *capture);
+
+/*
+  @brief Closes the capture file.
+  @details Must be called with the capture mutex locked, while capturing.
+  @param capture Capture state.
+*/
+inline static void moss__close_capture_file (Moss__Capture *capture);
+
+/*
+  @brief Starts a record, the caller writes exactly @p size payload bytes next.
+  @details Must be called with the capture mutex locked.
+  @param capture Capture state.
+  @param op Captured call.
+  @param size Payload size.
+*/
+inline static void
+moss__begin_capture_record (Moss__Capture *capture, Moss__CaptureOp op, uint32_t size);
+
+/*
+  @brief Writes payload bytes of the current record.
+  @details Must be called with the capture mutex locked.
+  @param capture Capture state.
+  @param data Bytes to write, may be NULL if size is 0.
+  @param size Number of bytes.
+*/
+inline static void
+moss__write_capture (Moss__Capture *capture, const void *data, uint64_t size);
+
+/*
+  @brief Returns number of payload bytes a sprite batch takes.
+  @param batch Sprite batch.
+  @return Payload size.
+*/
+inline static uint64_t moss__get_captured_sprites_size (const MossSpriteBatch *batch);
+
+/*
+  @brief Writes sprite batch payload of the current record.
+  @param capture Capture state.
+  @param batch Sprite batch.
+*/
+inline static void
+moss__write_captured_sprites (Moss__Capture *capture, const MossSpriteBatch *batch);
+
+/*
+  @brief Returns arrays of a sprite batch in mask bit order.
+  @param batch Sprite batch.
+  @param out_arrays Output arrays, @ref MOSS__CAPTURE_SPRITE_ARRAY_COUNT of them.
+*/
+inline static void
+moss__get_sprite_arrays (const MossSpriteBatch *batch, const void **out_arrays);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__init_capture (Moss__Capture *const out_capture)
+{
+  *out_capture = (Moss__Capture) {0};
+
+  pthread_mutex_init (&out_capture->mutex, NULL);
+  out_capture->is_initialized = true;
+}
+
+void moss__deinit_capture (Moss__Capture *const capture)
+{
+  if (!capture->is_initialized) { return; }
+
+  moss__end_capture (capture);
+  pthread_mutex_destroy (&capture->mutex);
+
+  *capture = (Moss__Capture) {0};
+}
+
+MossResult moss__begin_capture (
+  Moss__Capture *const      capture,
+  const char *const         path,
+  Moss__CaptureHeader       header,
+  const uint32_t            frame_count
+)
+{
+  if (!capture->is_initialized)
+  {
+    moss__error ("Calls can't be captured before the engine is initialized.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (frame_count == 0)
+  {
+    moss__error ("Capture must span at least one frame.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  pthread_mutex_lock (&capture->mutex);
+
+  if (capture->file != NULL)
+  {
+    pthread_mutex_unlock (&capture->mutex);
+    moss__error ("Calls are already being captured.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  FILE *const file = fopen (path, "wb");
+  if (file == NULL)
+  {
+    pthread_mutex_unlock (&capture->mutex);
+    moss__error ("Failed to open capture file \"%s\".\n", path);
+    return MOSS_RESULT_ERROR;
+  }
+
+  header.magic   = MOSS_CAPTURE_MAGIC;
+  header.version = MOSS_CAPTURE_VERSION;
+
+  if (fwrite (&header, sizeof (header), 1, file) != 1)
+  {
+    pthread_mutex_unlock (&capture->mutex);
+    moss__error ("Failed to write capture header.\n");
+    fclose (file);
+    return MOSS_RESULT_ERROR;
+  }
+
+  capture->remaining_frame_count = frame_count;
+  capture->is_failed             = false;
+  __atomic_store_n (&capture->file, file, __ATOMIC_RELEASE);
+
+  pthread_mutex_unlock (&capture->mutex);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__end_capture (Moss__Capture *const capture)
+{
+  if (!moss__lock_capture (capture)) { return; }
+
+  moss__close_capture_file (capture);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_frame (Moss__Capture *const capture)
+{
+  if (!moss__lock_capture (capture)) { return; }
+
+  moss__begin_capture_record (capture, MOSS__CAPTURE_OP_DRAW_FRAME, 0);
+
+  capture->remaining_frame_count -= 1;
+  if (capture->remaining_frame_count == 0 || capture->is_failed)
+  {
+    moss__close_capture_file (capture);
+  }
+
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_call (
+  Moss__Capture *const  capture,
+  const Moss__CaptureOp op,
+  const void *const     payload,
+  const uint32_t        size
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (capture, op, size);
+  moss__write_capture (capture, payload, size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_array_call (
+  Moss__Capture *const  capture,
+  const Moss__CaptureOp op,
+  const void *const     elements,
+  const uint32_t        count,
+  const uint32_t        element_size
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const uint64_t array_size = (uint64_t)count * element_size;
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (capture, op, (uint32_t)(sizeof (count) + array_size));
+  moss__write_capture (capture, &count, sizeof (count));
+  moss__write_capture (capture, elements, array_size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_sprites (
+  Moss__Capture *const         capture,
+  const Moss__CaptureOp        op,
+  const uint32_t               layer,
+  const MossSpriteBatch *const batch
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const bool     is_layer = op == MOSS__CAPTURE_OP_SET_LAYER_SPRITES;
+  const uint64_t size =
+    (is_layer ? sizeof (layer) : 0) + moss__get_captured_sprites_size (batch);
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (capture, op, (uint32_t)size);
+  if (is_layer) { moss__write_capture (capture, &layer, sizeof (layer)); }
+  moss__write_captured_sprites (capture, batch);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_animation_clips (
+  Moss__Capture *const           capture,
+  const MossAnimationClip *const clips,
+  const uint32_t                 count
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  uint64_t size = sizeof (count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    size += 2 * sizeof (uint32_t) +
+            (uint64_t)clips[ i ].frame_count * sizeof (MossAnimationFrame);
+  }
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_UPLOAD_ANIMATION_CLIPS,
+    (uint32_t)size
+  );
+  moss__write_capture (capture, &count, sizeof (count));
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const uint32_t clip_header[ 2 ] = {
+      (uint32_t)clips[ i ].loop_mode,
+      clips[ i ].frame_count,
+    };
+
+    moss__write_capture (capture, clip_header, sizeof (clip_header));
+    moss__write_capture (
+      capture,
+      clips[ i ].frames,
+      (uint64_t)clips[ i ].frame_count * sizeof (MossAnimationFrame)
+    );
+  }
+
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_skinned_mesh (
+  Moss__Capture *const                   capture,
+  const MossSkinnedMeshCreateInfo *const info
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const uint32_t counts[ 3 ] = {
+    info->vertex_count,
+    info->index_count,
+    info->bone_count,
+  };
+
+  const uint64_t vertices_size = (uint64_t)info->vertex_count * sizeof (*info->vertices);
+  const uint64_t indices_size  = (uint64_t)info->index_count * sizeof (*info->indices);
+  const uint64_t bones_size    = (uint64_t)info->bone_count * sizeof (*info->bind_pose);
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_CREATE_SKINNED_MESH,
+    (uint32_t)(sizeof (counts) + vertices_size + indices_size + bones_size)
+  );
+  moss__write_capture (capture, counts, sizeof (counts));
+  moss__write_capture (capture, info->vertices, vertices_size);
+  moss__write_capture (capture, info->indices, indices_size);
+  moss__write_capture (capture, info->bind_pose, bones_size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_skinned_mesh_pose (
+  Moss__Capture *const  capture,
+  const uint32_t        mesh,
+  const MossBone *const pose,
+  const uint32_t        bone_count
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const uint64_t pose_size = (uint64_t)bone_count * sizeof (*pose);
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_SUBMIT_SKINNED_MESH,
+    (uint32_t)(sizeof (mesh) + sizeof (bone_count) + pose_size)
+  );
+  moss__write_capture (capture, &mesh, sizeof (mesh));
+  moss__write_capture (capture, &bone_count, sizeof (bone_count));
+  moss__write_capture (capture, pose, pose_size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_virtual_texture_path (
+  Moss__Capture *const capture,
+  const char *const    path
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  // Path is padded with zeros, which also terminate it
+  const uint32_t path_length  = (uint32_t)strlen (path);
+  const uint32_t padded_size  = (path_length + 4) & ~(uint32_t)3;
+  const uint32_t padding_size = padded_size - path_length;
+  const uint8_t  padding[ 4 ] = {0};
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_OPEN_VIRTUAL_TEXTURE,
+    sizeof (path_length) + padded_size
+  );
+  moss__write_capture (capture, &path_length, sizeof (path_length));
+  moss__write_capture (capture, path, path_length);
+  moss__write_capture (capture, padding, padding_size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_video_frame (
+  Moss__Capture *const capture,
+  const void *const    frame,
+  const uint64_t       size
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const uint64_t padded_size  = (size + 3) & ~(uint64_t)3;
+  const uint8_t  padding[ 4 ] = {0};
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_UPLOAD_VIDEO_FRAME,
+    (uint32_t)padded_size
+  );
+  moss__write_capture (capture, frame, size);
+  moss__write_capture (capture, padding, padded_size - size);
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+void moss__capture_offscreen_batch (
+  Moss__Capture *const            capture,
+  const MossOffscreenBatch *const batch
+)
+{
+  if (!moss__is_capturing (capture)) { return; }
+
+  const uint32_t batch_header[ 3 ] = {
+    batch->scene_count,
+    batch->width,
+    batch->height,
+  };
+
+  uint64_t size = sizeof (batch_header);
+  for (uint32_t i = 0; i < batch->scene_count; ++i)
+  {
+    size += moss__get_captured_sprites_size (&batch->scenes[ i ]);
+  }
+
+  if (!moss__lock_capture (capture)) { return; }
+  moss__begin_capture_record (
+    capture,
+    MOSS__CAPTURE_OP_RENDER_OFFSCREEN_BATCH,
+    (uint32_t)size
+  );
+  moss__write_capture (capture, batch_header, sizeof (batch_header));
+  for (uint32_t i = 0; i < batch->scene_count; ++i)
+  {
+    moss__write_captured_sprites (capture, &batch->scenes[ i ]);
+  }
+  pthread_mutex_unlock (&capture->mutex);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static bool moss__lock_capture (Moss__Capture *const capture)
+{
+  if (!moss__is_capturing (capture)) { return false; }
+
+  // The capture may have ended since the unlocked check
+  pthread_mutex_lock (&capture->mutex);
+  if (capture->file == NULL)
+  {
+    pthread_mutex_unlock (&capture->mutex);
+    return false;
+  }
+
+  return true;
+}
+
+inline static void moss__close_capture_file (Moss__Capture *const capture)
+{
+  if (fclose (capture->file) != 0 || capture->is_failed)
+  {
+    moss__error ("Capture file is incomplete, writing it failed.\n");
+  }
+
+  __atomic_store_n (&capture->file, NULL, __ATOMIC_RELAXED);
+}
+
+inline static void moss__begin_capture_record (
+  Moss__Capture *const  capture,
+  const Moss__CaptureOp op,
+  const uint32_t        size
+)
+{
+  const Moss__CaptureRecordHeader record_header = {
+    .op   = (uint32_t)op,
+    .size = size,
+  };
+
+  moss__write_capture (capture, &record_header, sizeof (record_header));
+}
+
+inline static void moss__write_capture (
+  Moss__Capture *const capture,
+  const void *const    data,
+  const uint64_t       size
+)
+{
+  if (size == 0 || capture->is_failed) { return; }
+
+  if (fwrite (data, 1, (size_t)size, capture->file) != size)
+  {
+    capture->is_failed = true;
+  }
+}
+
+inline static uint64_t
+moss__get_captured_sprites_size (const MossSpriteBatch *const batch)
+{
+  const void *arrays[ MOSS__CAPTURE_SPRITE_ARRAY_COUNT ];
+  moss__get_sprite_arrays (batch, arrays);
+
+  // Every array element takes 4 bytes
+  uint64_t size = sizeof (Moss__CaptureSpriteBatchHeader);
+  for (uint32_t i = 0; i < MOSS__CAPTURE_SPRITE_ARRAY_COUNT; ++i)
+  {
+    if (arrays[ i ] != NULL) { size += (uint64_t)batch->count * 4; }
+  }
+
+  return size;
+}
+
+inline static void moss__write_captured_sprites (
+  Moss__Capture *const         capture,
+  const MossSpriteBatch *const batch
+)
+{
+  const void *arrays[ MOSS__CAPTURE_SPRITE_ARRAY_COUNT ];
+  moss__get_sprite_arrays (batch, arrays);
+
+  Moss__CaptureSpriteBatchHeader batch_header = {
+    .count = batch->count,
+    .mask  = 0,
+  };
+
+  for (uint32_t i = 0; i < MOSS__CAPTURE_SPRITE_ARRAY_COUNT; ++i)
+  {
+    if (arrays[ i ] != NULL) { batch_header.mask |= 1U << i; }
+  }
+
+  moss__write_capture (capture, &batch_header, sizeof (batch_header));
+
+  for (uint32_t i = 0; i < MOSS__CAPTURE_SPRITE_ARRAY_COUNT; ++i)
+  {
+    if (arrays[ i ] != NULL)
+    {
+      moss__write_capture (capture, arrays[ i ], (uint64_t)batch->count * 4);
+    }
+  }
+}
+
+inline static void moss__get_sprite_arrays (
+  const MossSpriteBatch *const batch,
+  const void **const           out_arrays
+)
+{
+  out_arrays[ 0 ] = batch->x;
+  out_arrays[ 1 ] = batch->y;
+  out_arrays[ 2 ] = batch->rotation;
+  out_arrays[ 3 ] = batch->scale_x;
+  out_arrays[ 4 ] = batch->scale_y;
+  out_arrays[ 5 ] = batch->texture_index;
+  out_arrays[ 6 ] = batch->color;
+  out_arrays[ 7 ] = batch->depth;
+  out_arrays[ 8 ] = batch->animation_clip;
+
+  // Start times are ignored without clips, so they aren't captured either
+  out_arrays[ 9 ] = batch->animation_clip != NULL ? batch->animation_start_time : NULL;
+}
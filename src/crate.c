@@ -27,9 +27,36 @@
 #include "moss/result.h"
 
 #include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
 #include "src/internal/log.h"
 #include "src/internal/memory_utils.h"
 #include "src/internal/vk_buffer_utils.h"
+#include "src/internal/vram_tracker.h"
+
+/*
+  @brief Returns what crate memory is spent on, judging by its usage.
+  @param info Crate creation info.
+  @return Returns VRAM category of the crate.
+*/
+inline static MossVramCategory
+moss__get_crate_vram_category (const Moss__CrateCreateInfo *const info)
+{
+  const VkBufferUsageFlags geometry_usage =
+    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+  const VkBufferUsageFlags transfer_usage =
+    VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+  if (info->usage & geometry_usage) { return MOSS_VRAM_CATEGORY_GEOMETRY; }
+
+  // Host visible crates only copied from or to are upload and readback buffers
+  if ((info->memory_properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+      (info->usage & ~transfer_usage) == 0)
+  {
+    return MOSS_VRAM_CATEGORY_STAGING;
+  }
+
+  return MOSS_VRAM_CATEGORY_BUFFERS;
+}
 
 MossResult
 moss__create_crate (const Moss__CrateCreateInfo *const info, Moss__Crate *const out_crate)
@@ -91,11 +118,36 @@ moss__create_crate (const Moss__CrateCreateInfo *const info, Moss__Crate *const
       moss__error ("Failed to allocate buffer memory: %d.", result);
       return MOSS_RESULT_ERROR;
     }
+
+    moss__track_vram_allocation (
+      info->physical_device,
+      out_crate->memory,
+      moss__get_crate_vram_category (info),
+      suitable_memory_type_index,
+      info->size,
+      memory_requirements.size
+    );
   }
 
   // After all bind memory to the buffer
   vkBindBufferMemory (info->device, out_crate->buffer, out_crate->memory, 0);
 
+  if (info->debug_name != NULL)
+  {
+    moss__set_debug_name (
+      info->device,
+      VK_OBJECT_TYPE_BUFFER,
+      out_crate->buffer,
+      info->debug_name
+    );
+    moss__set_debug_name (
+      info->device,
+      VK_OBJECT_TYPE_DEVICE_MEMORY,
+      out_crate->memory,
+      info->debug_name
+    );
+  }
+
   // Save device handles for later cleanup
   out_crate->original_device          = info->device;
   out_crate->original_physical_device = info->physical_device;
@@ -133,6 +185,7 @@ MossResult moss__fill_crate (const Moss__FillCrateInfo *const info)
       .shared_queue_family_index_count = dst_crate->shared_queue_family_index_count,
       .shared_queue_family_indices     = dst_crate->shared_queue_family_indices,
       .device                          = dst_crate->original_device,
+      .debug_name                      = "staging crate",
       .physical_device                 = dst_crate->original_physical_device,
     };
     moss__create_crate (&create_info, &staging_crate);
@@ -175,12 +228,78 @@ MossResult moss__fill_crate (const Moss__FillCrateInfo *const info)
   return MOSS_RESULT_SUCCESS;
 }
 
+MossResult moss__record_crate_update (const Moss__UpdateCrateInfo *const info)
+{
+  const Moss__Crate *const dst_crate = info->destination_crate;
+
+  if (info->size == 0 || info->size > MOSS__MAX_CRATE_UPDATE_SIZE ||
+      info->size % 4 != 0 || info->offset % 4 != 0 ||
+      info->offset + info->size > dst_crate->size)
+  {
+    moss__error (
+      "Invalid inline crate update of %llu bytes at offset %llu.\n",
+      (unsigned long long)info->size,
+      (unsigned long long)info->offset
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Reads recorded earlier must be done before the crate is overwritten
+  vkCmdPipelineBarrier (
+    info->command_buffer,
+    info->stage_mask,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0,
+    0,
+    NULL,
+    0,
+    NULL,
+    0,
+    NULL
+  );
+
+  vkCmdUpdateBuffer (
+    info->command_buffer,
+    dst_crate->buffer,
+    info->offset,
+    info->size,
+    info->source_memory
+  );
+
+  const VkBufferMemoryBarrier barrier = {
+    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+    .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+    .dstAccessMask       = info->access_mask,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .buffer              = dst_crate->buffer,
+    .offset              = info->offset,
+    .size                = info->size,
+  };
+
+  vkCmdPipelineBarrier (
+    info->command_buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    info->stage_mask,
+    0,
+    0,
+    NULL,
+    1,
+    &barrier,
+    0,
+    NULL
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
 void moss__destroy_crate (Moss__Crate *crate)
 {
   if (crate == NULL) { return; }
 
   if (crate->memory != VK_NULL_HANDLE)
   {
+    moss__untrack_vram_allocation (crate->memory);
     vkFreeMemory (crate->original_device, crate->memory, NULL);
     crate->memory = VK_NULL_HANDLE;
   }
@@ -0,0 +1,103 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/debug_utils.c
+  @brief Vulkan object names and command buffer labels implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "src/internal/debug_utils.h"
+
+#ifndef NDEBUG
+
+/* Loaded debug utils functions, NULL while unavailable. */
+static PFN_vkSetDebugUtilsObjectNameEXT g_set_object_name = NULL;
+static PFN_vkCmdBeginDebugUtilsLabelEXT g_begin_label     = NULL;
+static PFN_vkCmdEndDebugUtilsLabelEXT   g_end_label       = NULL;
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__load_debug_utils (const VkInstance instance)
+{
+  g_set_object_name = (PFN_vkSetDebugUtilsObjectNameEXT)vkGetInstanceProcAddr (
+    instance,
+    "vkSetDebugUtilsObjectNameEXT"
+  );
+  g_begin_label = (PFN_vkCmdBeginDebugUtilsLabelEXT)vkGetInstanceProcAddr (
+    instance,
+    "vkCmdBeginDebugUtilsLabelEXT"
+  );
+  g_end_label = (PFN_vkCmdEndDebugUtilsLabelEXT)vkGetInstanceProcAddr (
+    instance,
+    "vkCmdEndDebugUtilsLabelEXT"
+  );
+
+  // Labels must come in pairs, so either both label functions are used or none
+  if (g_begin_label == NULL || g_end_label == NULL)
+  {
+    g_begin_label = NULL;
+    g_end_label   = NULL;
+  }
+}
+
+void moss__set_vk_object_name (
+  const VkDevice     device,
+  const VkObjectType type,
+  const uint64_t     handle,
+  const char *const  name
+)
+{
+  if (g_set_object_name == NULL || handle == 0) { return; }
+
+  const VkDebugUtilsObjectNameInfoEXT name_info = {
+    .sType        = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+    .objectType   = type,
+    .objectHandle = handle,
+    .pObjectName  = name,
+  };
+
+  g_set_object_name (device, &name_info);
+}
+
+void moss__begin_debug_label (
+  const VkCommandBuffer command_buffer,
+  const char *const     name
+)
+{
+  if (g_begin_label == NULL) { return; }
+
+  const VkDebugUtilsLabelEXT label = {
+    .sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
+    .pLabelName = name,
+  };
+
+  g_begin_label (command_buffer, &label);
+}
+
+void moss__end_debug_label (const VkCommandBuffer command_buffer)
+{
+  if (g_end_label == NULL) { return; }
+
+  g_end_label (command_buffer);
+}
+
+#endif
@@ -0,0 +1,479 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/descriptor_cache.c
+  @brief Per-frame descriptor set cache implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/log.h"
+
+/* Descriptors of each supported type a frame's pool holds. */
+#define MOSS__DESCRIPTOR_POOL_TYPE_SIZE \
+  (uint32_t)(MOSS__DESCRIPTOR_CACHE_SIZE * MOSS__MAX_DESCRIPTOR_BINDING_COUNT / 2)
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Hashes set layout and binding contents.
+  @param layout Descriptor set layout.
+  @param bindings Binding contents.
+  @param binding_count Number of bindings.
+  @return 64-bit FNV-1a hash.
+*/
+inline static uint64_t moss__hash_descriptor_bindings (
+  VkDescriptorSetLayout          layout,
+  const Moss__DescriptorBinding *bindings,
+  uint32_t                       binding_count
+);
+
+/*
+  @brief Checks whether cached set was written with the given contents.
+  @param set Cached set.
+  @param hash Hash of the contents.
+  @param layout Descriptor set layout.
+  @param bindings Binding contents.
+  @param binding_count Number of bindings.
+  @return Returns true if the set can be bound as is, false otherwise.
+*/
+inline static bool moss__cached_descriptor_set_matches (
+  const Moss__CachedDescriptorSet *set,
+  uint64_t                         hash,
+  VkDescriptorSetLayout            layout,
+  const Moss__DescriptorBinding   *bindings,
+  uint32_t                         binding_count
+);
+
+/*
+  @brief Fills descriptor writes of the bindings.
+  @param set Set to write to, VK_NULL_HANDLE for push descriptors.
+  @param bindings Binding contents.
+  @param binding_count Number of bindings.
+  @param buffer_infos Output buffer infos, one per binding.
+  @param image_infos Output image infos, one per binding.
+  @param out_writes Output writes, one per binding.
+*/
+inline static void moss__fill_descriptor_writes (
+  VkDescriptorSet                set,
+  const Moss__DescriptorBinding *bindings,
+  uint32_t                       binding_count,
+  VkDescriptorBufferInfo        *buffer_infos,
+  VkDescriptorImageInfo         *image_infos,
+  VkWriteDescriptorSet          *out_writes
+);
+
+/*
+  @brief Checks whether descriptor type is described by a buffer.
+  @param type Descriptor type.
+  @return Returns true for uniform and storage buffers, false otherwise.
+*/
+inline static bool moss__is_buffer_descriptor_type (VkDescriptorType type);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_descriptor_cache (
+  const Moss__DescriptorCacheCreateInfo *const info,
+  Moss__DescriptorCache *const                 out_cache
+)
+{
+  *out_cache        = (Moss__DescriptorCache) {0};
+  out_cache->device = info->device;
+
+  if (info->is_push_descriptor_enabled)
+  {
+    out_cache->push_descriptor_set = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr (
+      info->device,
+      "vkCmdPushDescriptorSetKHR"
+    );
+  }
+
+  out_cache->is_push_descriptor_supported = out_cache->push_descriptor_set != NULL;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_descriptor_cache (Moss__DescriptorCache *const cache)
+{
+  *cache = (Moss__DescriptorCache) {0};
+}
+
+MossResult moss__create_descriptor_cache_frame (
+  const Moss__DescriptorCache *const cache,
+  Moss__DescriptorCacheFrame *const  out_frame
+)
+{
+  *out_frame = (Moss__DescriptorCacheFrame) {0};
+
+  // Pushed descriptors live in the command buffer
+  if (cache->is_push_descriptor_supported) { return MOSS_RESULT_SUCCESS; }
+
+  const VkDescriptorPoolSize pool_sizes[] = {
+    {
+     .type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+     .descriptorCount = MOSS__DESCRIPTOR_POOL_TYPE_SIZE,
+     },
+    {
+     .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = MOSS__DESCRIPTOR_POOL_TYPE_SIZE,
+     },
+    {
+     .type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+     .descriptorCount = MOSS__DESCRIPTOR_POOL_TYPE_SIZE,
+     },
+  };
+
+  // Sets are never freed one by one, the whole pool is reset instead
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = MOSS__DESCRIPTOR_CACHE_SIZE,
+    .poolSizeCount = sizeof (pool_sizes) / sizeof (pool_sizes[ 0 ]),
+    .pPoolSizes    = pool_sizes,
+  };
+
+  const VkResult result = vkCreateDescriptorPool (
+    cache->device,
+    &pool_info,
+    NULL,
+    &out_frame->descriptor_pool
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create frame descriptor pool. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_descriptor_cache_frame (
+  const Moss__DescriptorCache *const cache,
+  Moss__DescriptorCacheFrame *const  frame
+)
+{
+  if (frame->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (cache->device, frame->descriptor_pool, NULL);
+  }
+
+  frame->descriptor_pool = VK_NULL_HANDLE;
+  frame->set_count       = 0;
+}
+
+void moss__begin_descriptor_cache_frame (
+  const Moss__DescriptorCache *const cache,
+  Moss__DescriptorCacheFrame *const  frame
+)
+{
+  if (frame->descriptor_pool == VK_NULL_HANDLE) { return; }
+
+  // Keep hot sets around, start over only once the cache fills up
+  if (frame->set_count <= MOSS__DESCRIPTOR_CACHE_SIZE / 2) { return; }
+
+  vkResetDescriptorPool (cache->device, frame->descriptor_pool, 0);
+  frame->set_count = 0;
+}
+
+MossResult moss__create_cached_descriptor_set_layout (
+  const Moss__DescriptorCache *const        cache,
+  const VkDescriptorSetLayoutBinding *const bindings,
+  const uint32_t                            binding_count,
+  VkDescriptorSetLayout *const              out_layout
+)
+{
+  if (binding_count > MOSS__MAX_DESCRIPTOR_BINDING_COUNT)
+  {
+    moss__error (
+      "Cached set layouts can't have more than %u bindings.\n",
+      MOSS__MAX_DESCRIPTOR_BINDING_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetLayoutCreateInfo layout_info = {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .flags = cache->is_push_descriptor_supported
+             ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR
+             : 0,
+    .bindingCount = binding_count,
+    .pBindings    = bindings,
+  };
+
+  const VkResult result =
+    vkCreateDescriptorSetLayout (cache->device, &layout_info, NULL, out_layout);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create descriptor set layout. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+MossResult moss__bind_descriptors (
+  const Moss__DescriptorCache *const   cache,
+  Moss__DescriptorCacheFrame *const    frame,
+  const VkCommandBuffer                command_buffer,
+  const VkPipelineBindPoint            bind_point,
+  const VkPipelineLayout               pipeline_layout,
+  const uint32_t                       set_index,
+  const VkDescriptorSetLayout          set_layout,
+  const Moss__DescriptorBinding *const bindings,
+  const uint32_t                       binding_count
+)
+{
+  if (binding_count > MOSS__MAX_DESCRIPTOR_BINDING_COUNT)
+  {
+    moss__error (
+      "Can't bind more than %u descriptors at once.\n",
+      MOSS__MAX_DESCRIPTOR_BINDING_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkDescriptorBufferInfo buffer_infos[ MOSS__MAX_DESCRIPTOR_BINDING_COUNT ];
+  VkDescriptorImageInfo  image_infos[ MOSS__MAX_DESCRIPTOR_BINDING_COUNT ];
+  VkWriteDescriptorSet   writes[ MOSS__MAX_DESCRIPTOR_BINDING_COUNT ];
+
+  if (cache->is_push_descriptor_supported)
+  {
+    moss__fill_descriptor_writes (
+      VK_NULL_HANDLE,
+      bindings,
+      binding_count,
+      buffer_infos,
+      image_infos,
+      writes
+    );
+
+    cache->push_descriptor_set (
+      command_buffer,
+      bind_point,
+      pipeline_layout,
+      set_index,
+      binding_count,
+      writes
+    );
+
+    return MOSS_RESULT_SUCCESS;
+  }
+
+  const uint64_t hash =
+    moss__hash_descriptor_bindings (set_layout, bindings, binding_count);
+
+  VkDescriptorSet set = VK_NULL_HANDLE;
+  for (uint32_t i = 0; i < frame->set_count; ++i)
+  {
+    if (moss__cached_descriptor_set_matches (
+          &frame->sets[ i ],
+          hash,
+          set_layout,
+          bindings,
+          binding_count
+        ))
+    {
+      set = frame->sets[ i ].set;
+      break;
+    }
+  }
+
+  if (set == VK_NULL_HANDLE)
+  {
+    if (frame->set_count == MOSS__DESCRIPTOR_CACHE_SIZE)
+    {
+      moss__error (
+        "Frame can't bind more than %u distinct descriptor sets.\n",
+        MOSS__DESCRIPTOR_CACHE_SIZE
+      );
+      return MOSS_RESULT_ERROR;
+    }
+
+    const VkDescriptorSetAllocateInfo set_info = {
+      .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+      .descriptorPool     = frame->descriptor_pool,
+      .descriptorSetCount = 1,
+      .pSetLayouts        = &set_layout,
+    };
+
+    const VkResult result = vkAllocateDescriptorSets (cache->device, &set_info, &set);
+    if (result != VK_SUCCESS)
+    {
+      moss__error ("Failed to allocate cached descriptor set. Error code: %d.\n", result);
+      return MOSS_RESULT_ERROR;
+    }
+
+    moss__fill_descriptor_writes (
+      set,
+      bindings,
+      binding_count,
+      buffer_infos,
+      image_infos,
+      writes
+    );
+    vkUpdateDescriptorSets (cache->device, binding_count, writes, 0, NULL);
+
+    Moss__CachedDescriptorSet *const cached = &frame->sets[ frame->set_count++ ];
+    cached->hash                            = hash;
+    cached->layout                          = set_layout;
+    cached->binding_count                   = binding_count;
+    cached->set                             = set;
+    for (uint32_t i = 0; i < binding_count; ++i)
+    {
+      cached->bindings[ i ] = bindings[ i ];
+    }
+  }
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    bind_point,
+    pipeline_layout,
+    set_index,
+    1,
+    &set,
+    0,
+    NULL
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static uint64_t moss__hash_descriptor_bindings (
+  const VkDescriptorSetLayout          layout,
+  const Moss__DescriptorBinding *const bindings,
+  const uint32_t                       binding_count
+)
+{
+  // Fields are hashed one by one so struct padding never leaks into the hash
+  uint64_t hash = 14695981039346656037ULL;
+
+  hash = (hash ^ (uint64_t)(uintptr_t)layout) * 1099511628211ULL;
+
+  for (uint32_t i = 0; i < binding_count; ++i)
+  {
+    const Moss__DescriptorBinding *const binding = &bindings[ i ];
+
+    const uint64_t fields[] = {
+      binding->binding,
+      (uint64_t)binding->type,
+      (uint64_t)(uintptr_t)binding->buffer,
+      binding->offset,
+      binding->range,
+      (uint64_t)(uintptr_t)binding->sampler,
+      (uint64_t)(uintptr_t)binding->image_view,
+      (uint64_t)binding->image_layout,
+    };
+
+    for (uint32_t j = 0; j < sizeof (fields) / sizeof (fields[ 0 ]); ++j)
+    {
+      hash = (hash ^ fields[ j ]) * 1099511628211ULL;
+    }
+  }
+
+  return hash;
+}
+
+inline static bool moss__cached_descriptor_set_matches (
+  const Moss__CachedDescriptorSet *const set,
+  const uint64_t                         hash,
+  const VkDescriptorSetLayout            layout,
+  const Moss__DescriptorBinding *const   bindings,
+  const uint32_t                         binding_count
+)
+{
+  if (set->hash != hash || set->layout != layout ||
+      set->binding_count != binding_count)
+  {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < binding_count; ++i)
+  {
+    const Moss__DescriptorBinding *const a = &set->bindings[ i ];
+    const Moss__DescriptorBinding *const b = &bindings[ i ];
+
+    if (a->binding != b->binding || a->type != b->type || a->buffer != b->buffer ||
+        a->offset != b->offset || a->range != b->range || a->sampler != b->sampler ||
+        a->image_view != b->image_view || a->image_layout != b->image_layout)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline static void moss__fill_descriptor_writes (
+  const VkDescriptorSet                set,
+  const Moss__DescriptorBinding *const bindings,
+  const uint32_t                       binding_count,
+  VkDescriptorBufferInfo *const        buffer_infos,
+  VkDescriptorImageInfo *const         image_infos,
+  VkWriteDescriptorSet *const          out_writes
+)
+{
+  for (uint32_t i = 0; i < binding_count; ++i)
+  {
+    const Moss__DescriptorBinding *const binding   = &bindings[ i ];
+    const bool                           is_buffer = moss__is_buffer_descriptor_type (
+      binding->type
+    );
+
+    buffer_infos[ i ] = (VkDescriptorBufferInfo) {
+      .buffer = binding->buffer,
+      .offset = binding->offset,
+      .range  = binding->range,
+    };
+
+    image_infos[ i ] = (VkDescriptorImageInfo) {
+      .sampler     = binding->sampler,
+      .imageView   = binding->image_view,
+      .imageLayout = binding->image_layout,
+    };
+
+    out_writes[ i ] = (VkWriteDescriptorSet) {
+      .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+      .dstSet          = set,
+      .dstBinding      = binding->binding,
+      .descriptorCount = 1,
+      .descriptorType  = binding->type,
+      .pBufferInfo     = is_buffer ? &buffer_infos[ i ] : NULL,
+      .pImageInfo      = is_buffer ? NULL : &image_infos[ i ],
+    };
+  }
+}
+
+inline static bool moss__is_buffer_descriptor_type (const VkDescriptorType type)
+{
+  return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+         type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+         type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+         type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+}
@@ -0,0 +1,225 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/draw_queue.c
+  @brief Multi-producer draw command queue implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "moss/draw_command.h"
+#include "moss/result.h"
+
+#include "src/internal/draw_queue.h"
+#include "src/internal/log.h"
+#include "src/internal/radix_sort_utils.h"
+#include "src/internal/sprite_kernels.h"
+
+/*=============================================================================
+    THREAD STATE
+  =============================================================================*/
+
+/* Chunk the calling thread pushes commands to. */
+static __thread Moss__DrawChunk *g_thread_chunk = NULL;
+
+/* Queue the cached chunk belongs to. */
+static __thread const Moss__DrawQueue *g_thread_chunk_queue = NULL;
+
+/* Frame generation the cached chunk was claimed in. */
+static __thread uint64_t g_thread_chunk_generation = 0;
+
+/*=============================================================================
+    SHARED STATE
+  =============================================================================*/
+
+/* Last generation handed out to any queue. Atomic. */
+static uint64_t g_draw_queue_generation = 0;
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__init_draw_queue (Moss__DrawQueue *const out_queue)
+{
+  const size_t capacity    = MOSS__DRAW_QUEUE_CAPACITY;
+  const size_t chunk_count = MOSS__DRAW_QUEUE_CHUNK_COUNT;
+
+  out_queue->chunks              = calloc (chunk_count, sizeof (Moss__DrawChunk));
+  out_queue->claimed_chunk_count = 0;
+  out_queue->command_count       = 0;
+  out_queue->generation =
+    __atomic_add_fetch (&g_draw_queue_generation, 1, __ATOMIC_RELAXED);
+  out_queue->keys                = malloc (capacity * sizeof (uint64_t));
+  out_queue->values              = malloc (capacity * sizeof (uint32_t));
+  out_queue->scratch_keys        = malloc (capacity * sizeof (uint64_t));
+  out_queue->scratch_values      = malloc (capacity * sizeof (uint32_t));
+  out_queue->x                   = malloc (capacity * sizeof (float));
+  out_queue->y                   = malloc (capacity * sizeof (float));
+  out_queue->rotation            = malloc (capacity * sizeof (float));
+  out_queue->scale_x             = malloc (capacity * sizeof (float));
+  out_queue->scale_y             = malloc (capacity * sizeof (float));
+  out_queue->texture_index       = malloc (capacity * sizeof (uint32_t));
+  out_queue->color               = malloc (capacity * sizeof (uint32_t));
+
+  if (out_queue->chunks == NULL || out_queue->keys == NULL || out_queue->values == NULL ||
+      out_queue->scratch_keys == NULL || out_queue->scratch_values == NULL ||
+      out_queue->x == NULL || out_queue->y == NULL || out_queue->rotation == NULL ||
+      out_queue->scale_x == NULL || out_queue->scale_y == NULL ||
+      out_queue->texture_index == NULL || out_queue->color == NULL)
+  {
+    moss__error ("Failed to allocate memory for draw queue.\n");
+    moss__deinit_draw_queue (out_queue);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__deinit_draw_queue (Moss__DrawQueue *const queue)
+{
+  free (queue->chunks);
+  free (queue->keys);
+  free (queue->values);
+  free (queue->scratch_keys);
+  free (queue->scratch_values);
+  free (queue->x);
+  free (queue->y);
+  free (queue->rotation);
+  free (queue->scale_x);
+  free (queue->scale_y);
+  free (queue->texture_index);
+  free (queue->color);
+
+  *queue = (Moss__DrawQueue) {0};
+}
+
+MossResult moss__push_draw_command (
+  Moss__DrawQueue *const       queue,
+  const MossDrawCommand *const command
+)
+{
+  if (__atomic_fetch_add (&queue->command_count, 1, __ATOMIC_RELAXED) >=
+      MOSS__DRAW_QUEUE_CAPACITY)
+  {
+    moss__error ("Draw queue is full, command is dropped.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const uint64_t   generation = __atomic_load_n (&queue->generation, __ATOMIC_ACQUIRE);
+  Moss__DrawChunk *chunk      = g_thread_chunk;
+
+  if (chunk == NULL || g_thread_chunk_queue != queue ||
+      g_thread_chunk_generation != generation ||
+      chunk->count == MOSS__DRAW_CHUNK_CAPACITY)
+  {
+    const uint32_t chunk_index =
+      __atomic_fetch_add (&queue->claimed_chunk_count, 1, __ATOMIC_RELAXED);
+    if (chunk_index >= MOSS__DRAW_QUEUE_CHUNK_COUNT)
+    {
+      moss__error ("Draw chunk pool is exhausted, command is dropped.\n");
+      g_thread_chunk = NULL;
+      return MOSS_RESULT_ERROR;
+    }
+
+    chunk        = &queue->chunks[ chunk_index ];
+    chunk->count = 0;
+
+    g_thread_chunk            = chunk;
+    g_thread_chunk_queue      = queue;
+    g_thread_chunk_generation = generation;
+  }
+
+  chunk->commands[ chunk->count ] = *command;
+  ++chunk->count;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__merge_draw_queue (
+  Moss__DrawQueue *const queue,
+  Moss__SpriteSoA *const out_sprites
+)
+{
+  uint32_t chunk_count = __atomic_load_n (&queue->claimed_chunk_count, __ATOMIC_ACQUIRE);
+  if (chunk_count > MOSS__DRAW_QUEUE_CHUNK_COUNT)
+  {
+    chunk_count = MOSS__DRAW_QUEUE_CHUNK_COUNT;
+  }
+
+  // Gather keys of all claimed chunks
+  uint32_t count = 0;
+  for (uint32_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+  {
+    const Moss__DrawChunk *const chunk = &queue->chunks[ chunk_index ];
+
+    for (uint32_t i = 0; i < chunk->count; ++i)
+    {
+      queue->keys[ count ]   = chunk->commands[ i ].sort_key;
+      queue->values[ count ] = chunk_index * MOSS__DRAW_CHUNK_CAPACITY + i;
+      ++count;
+    }
+  }
+
+  moss__radix_sort_u64 (
+    queue->keys,
+    queue->values,
+    queue->scratch_keys,
+    queue->scratch_values,
+    count
+  );
+
+  // Scatter sorted commands into sprite arrays
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const uint32_t               value = queue->values[ i ];
+    const MossDrawCommand *const command =
+      &queue->chunks[ value / MOSS__DRAW_CHUNK_CAPACITY ]
+         .commands[ value % MOSS__DRAW_CHUNK_CAPACITY ];
+
+    queue->x[ i ]             = command->x;
+    queue->y[ i ]             = command->y;
+    queue->rotation[ i ]      = command->rotation;
+    queue->scale_x[ i ]       = command->scale_x;
+    queue->scale_y[ i ]       = command->scale_y;
+    queue->texture_index[ i ] = command->texture_index;
+    queue->color[ i ]         = command->color;
+  }
+
+  *out_sprites = (Moss__SpriteSoA) {
+    .x             = queue->x,
+    .y             = queue->y,
+    .rotation      = queue->rotation,
+    .scale_x       = queue->scale_x,
+    .scale_y       = queue->scale_y,
+    .uv_left       = NULL,
+    .uv_top        = NULL,
+    .uv_right      = NULL,
+    .uv_bottom     = NULL,
+    .color         = queue->color,
+    .texture_index = queue->texture_index,
+    .count         = count,
+  };
+
+  // Start a new frame, producers will claim fresh chunks on their next push
+  __atomic_store_n (&queue->claimed_chunk_count, 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&queue->command_count, 0, __ATOMIC_RELAXED);
+  __atomic_store_n (
+    &queue->generation,
+    __atomic_add_fetch (&g_draw_queue_generation, 1, __ATOMIC_RELAXED),
+    __ATOMIC_RELEASE
+  );
+}
@@ -30,23 +30,54 @@
 #include <stuffy/vulkan.h>
 #include <stuffy/window.h>
 
+#include "moss/animation.h"
 #include "moss/app_info.h"
+#include "moss/draw_command.h"
 #include "moss/engine.h"
+#include "moss/job.h"
+#include "moss/light.h"
+#include "moss/occluder.h"
+#include "moss/picking.h"
 #include "moss/result.h"
+#include "moss/skeleton.h"
+#include "moss/sprite.h"
 #include "moss/vertex.h"
 #include "moss/window_config.h"
 
 #include "src/internal/app_info.h"
+#include "src/internal/async_io.h"
+#include "src/internal/capture.h"
 #include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/draw_queue.h"
+#include "src/internal/engine.h"
+#include "src/internal/gpu_sort.h"
+#include "src/internal/gpu_timer.h"
+#include "src/internal/job_system.h"
+#include "src/internal/layer_cache.h"
+#include "src/internal/light_culling.h"
 #include "src/internal/log.h"
+#include "src/internal/offscreen_batch.h"
+#include "src/internal/pick_readback.h"
+#include "src/internal/resolution_controller_utils.h"
+#include "src/internal/scene_target.h"
 #include "src/internal/shaders.h"
+#include "src/internal/shadow_map.h"
+#include "src/internal/skinning.h"
+#include "src/internal/sprite_animation.h"
+#include "src/internal/sprite_kernels.h"
 #include "src/internal/vertex.h"
+#include "src/internal/video_texture.h"
+#include "src/internal/virtual_texture.h"
 #include "src/internal/vk_command_pool_utils.h"
 #include "src/internal/vk_instance_utils.h"
 #include "src/internal/vk_physical_device_utils.h"
 #include "src/internal/vk_shader_utils.h"
 #include "src/internal/vk_swapchain_utils.h"
 #include "src/internal/vk_validation_layers_utils.h"
+#include "src/internal/vram_tracker.h"
+#include "src/internal/wake_signal.h"
 #include "vulkan/vulkan_core.h"
 
 /*=============================================================================
@@ -55,10 +86,10 @@
 
 /* Vertex array just for implementing vertex buffers. */
 static const MossVertex g_verticies[ 4 ] = {
-  { { -0.5F, -0.5F }, { 1.0F, 0.0F, 0.0F } },
-  {  { 0.5F, -0.5F }, { 0.0F, 1.0F, 0.0F } },
-  {   { 0.5F, 0.5F }, { 0.0F, 0.0F, 1.0F } },
-  {  { -0.5F, 0.5F }, { 1.0F, 1.0F, 1.0F } }
+  { { -0.5F, -0.5F }, { 1.0F, 0.0F, 0.0F }, { 0.0F, 0.0F }, 0 },
+  {  { 0.5F, -0.5F }, { 0.0F, 1.0F, 0.0F }, { 1.0F, 0.0F }, 0 },
+  {   { 0.5F, 0.5F }, { 0.0F, 0.0F, 1.0F }, { 1.0F, 1.0F }, 0 },
+  {  { -0.5F, 0.5F }, { 1.0F, 1.0F, 1.0F }, { 0.0F, 1.0F }, 0 }
 };
 
 /* Index array just for implementing index buffers. */
@@ -73,6 +104,10 @@ static const uint16_t g_indices[ 6 ] = { 0, 1, 2, 2, 3, 0 };
 /* Max image count in swapchain. */
 #define MAX_SWAPCHAIN_IMAGE_COUNT (uint32_t)(4)
 
+/* Seconds between event checks of an idle run loop by default. Idle input waits
+   up to this long, which is still short enough to feel immediate. */
+#define DEFAULT_IDLE_EVENT_INTERVAL (float)(0.1F)
+
 /*
   @brief Engine state.
 */
@@ -101,6 +136,14 @@ typedef struct
   VkQueue present_queue;
   /* Transfer queue. */
   VkQueue transfer_queue;
+  /* Compute queue, the graphics queue if there is no async compute family. */
+  VkQueue compute_queue;
+  /* Whether VK_KHR_push_descriptor is enabled on the logical device. */
+  bool is_push_descriptor_supported;
+  /* Whether fragment shader stores are enabled on the logical device. */
+  bool is_fragment_store_supported;
+  /* Whether sampler Ycbcr conversion is enabled on the logical device. */
+  bool is_ycbcr_conversion_supported;
 
   /* === Buffer sharing mode and queue family indices === */
   /* Buffer sharing mode for buffers shared between graphics and transfer queues. */
@@ -109,6 +152,12 @@ typedef struct
   uint32_t shared_queue_family_index_count;
   /* Queue family indices that share buffers. */
   uint32_t shared_queue_family_indices[ 2 ];
+  /* Sharing mode for buffers shared between compute and graphics queues. */
+  VkSharingMode compute_sharing_mode;
+  /* Number of queue family indices that share compute buffers. */
+  uint32_t compute_shared_queue_family_index_count;
+  /* Queue family indices that share compute buffers. */
+  uint32_t compute_shared_queue_family_indices[ 2 ];
 
   /* === Swap chain === */
   /* Swap chain. */
@@ -142,6 +191,122 @@ typedef struct
   /* Index crate. */
   Moss__Crate index_crate;
 
+  /* === Sprite batching === */
+  /* Host visible sprite vertex crates, one per frame in flight. */
+  Moss__Crate sprite_vertex_crates[ MAX_FRAMES_IN_FLIGHT ];
+  /* Persistently mapped memory of the sprite vertex crates. */
+  MossVertex *sprite_vertices[ MAX_FRAMES_IN_FLIGHT ];
+  /* Quad index crate shared by all sprites. */
+  Moss__Crate sprite_index_crate;
+  /* Number of sprites submitted for the current frame. */
+  uint32_t sprite_count;
+  /* Sprite depth sorting pipelines. */
+  Moss__GpuSort sprite_sort;
+  /* Sprite depth sorting resources, one per frame in flight. */
+  Moss__GpuSortFrame sprite_sort_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Whether sprites of the current frame must be sorted by depth. */
+  bool is_sprite_sort_requested;
+  /* Draw commands submitted from any thread. */
+  Moss__DrawQueue draw_queue;
+
+  /* === Sprite animation === */
+  /* Uploaded animation clips. */
+  Moss__SpriteAnimation sprite_animation;
+  /* Per-sprite animation state, one per frame in flight. */
+  Moss__SpriteAnimationFrame sprite_animation_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Whether sprites of the current frame carry animation state. */
+  bool is_sprite_animation_requested;
+  /* Current animation time in seconds. */
+  float animation_time;
+
+  /* === Descriptors === */
+  /* Push descriptor entry point or cached set fallback. */
+  Moss__DescriptorCache descriptor_cache;
+  /* Descriptor pools and cached sets, one per frame in flight. */
+  Moss__DescriptorCacheFrame descriptor_cache_frames[ MAX_FRAMES_IN_FLIGHT ];
+
+  /* === Skinned meshes === */
+  /* Skinning pipeline and uploaded meshes. */
+  Moss__Skinning skinning;
+  /* Bone matrices and draws, one per frame in flight. */
+  Moss__SkinningFrame skinning_frames[ MAX_FRAMES_IN_FLIGHT ];
+
+  /* === Lighting === */
+  /* Tile light culling pipeline. */
+  Moss__LightCulling light_culling;
+  /* Light culling resources, one per frame in flight. */
+  Moss__LightCullingFrame light_culling_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Number of lights submitted for the current frame. */
+  uint32_t light_count;
+  /* Ambient light color. */
+  float ambient_light[ 4 ];
+  /* Shadow map pipeline. */
+  Moss__ShadowMaps shadow_maps;
+  /* Shadow map resources, one per frame in flight. */
+  Moss__ShadowMapFrame shadow_map_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Number of occluders submitted for the current frame. */
+  uint32_t occluder_count;
+
+  /* === Dynamic resolution === */
+  /* Offscreen target sprites are rendered to before the upscale. */
+  Moss__SceneTarget scene_target;
+  /* GPU frame timer. */
+  Moss__GpuTimer gpu_timer;
+  /* Render scale controller. */
+  Moss__ResolutionController resolution_controller;
+
+  /* === Picking === */
+  /* Whether the scene pass writes pick IDs. */
+  bool is_picking_enabled;
+  /* Pick ID readback. */
+  Moss__PickReadback pick_readback;
+  /* Whether a pick is requested for the next frame. */
+  bool is_pick_requested;
+  /* Swap chain pixel coordinates of the requested pick. */
+  float pick_position[ 2 ];
+  /* Whether a resolved pick hasn't been polled yet. */
+  bool is_pick_result_ready;
+  /* Latest resolved pick. */
+  MossPickResult pick_result;
+
+  /* === Virtual texture === */
+  /* Virtual texture pipeline, page atlas and the open image. */
+  Moss__VirtualTexture virtual_texture;
+  /* Virtual texture feedback and uploads, one per frame in flight. */
+  Moss__VirtualTextureFrame virtual_texture_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Whether the virtual texture is drawn during the current frame. */
+  bool is_virtual_texture_view_requested;
+  /* Placement of the virtual texture for the current frame. */
+  MossVirtualTextureView virtual_texture_view;
+
+  /* === Layers === */
+  /* Cached sprite layers composited beneath the frame's sprites. */
+  Moss__LayerCache layer_cache;
+
+  /* === Video === */
+  /* Video image, Ycbcr conversion and pipeline of the open video. */
+  Moss__VideoTexture video_texture;
+  /* Video frame staging crates, one per frame in flight. */
+  Moss__VideoTextureFrame video_texture_frames[ MAX_FRAMES_IN_FLIGHT ];
+  /* Whether the video is drawn during the current frame. */
+  bool is_video_view_requested;
+  /* Placement of the video for the current frame. */
+  MossVideoView video_view;
+
+  /* === Offscreen batch === */
+  /* Offscreen target independent scenes are rendered to. */
+  Moss__OffscreenBatch offscreen_batch;
+
+  /* === Run loop === */
+  /* Signal that wakes an idle @ref moss_engine_run loop to draw a frame. */
+  Moss__WakeSignal wake_signal;
+
+  /* === Capture === */
+  /* Capture of public API calls, see @ref moss_engine_begin_capture. */
+  Moss__Capture capture;
+  /* Header capture files start with, filled at initialization. */
+  Moss__CaptureHeader capture_header;
+
   /* === Command buffers === */
   /* General command pool. */
   VkCommandPool general_command_pool;
@@ -149,6 +314,10 @@ typedef struct
   VkCommandBuffer general_command_buffers[ MAX_FRAMES_IN_FLIGHT ];
   /* Transfer command pool. */
   VkCommandPool transfer_command_pool;
+  /* Compute command pool. */
+  VkCommandPool compute_command_pool;
+  /* Compute command buffers. */
+  VkCommandBuffer compute_command_buffers[ MAX_FRAMES_IN_FLIGHT ];
 
   /* === Synchronization objects === */
   /* Image available semaphores. */
@@ -157,6 +326,12 @@ typedef struct
   VkSemaphore render_finished_semaphores[ MAX_FRAMES_IN_FLIGHT ];
   /* In-flight fences. */
   VkFence in_flight_fences[ MAX_FRAMES_IN_FLIGHT ];
+  /* Compute finished semaphores, waited on by the frame's graphics submission. */
+  VkSemaphore compute_finished_semaphores[ MAX_FRAMES_IN_FLIGHT ];
+
+  /* === Asset streaming === */
+  /* Asynchronous file reader. */
+  Moss__AsyncIo async_io;
 
   /* === Frame state === */
   /* Current frame index. */
@@ -180,17 +355,26 @@ static Moss__Engine g_engine = {
   .graphics_queue                             = VK_NULL_HANDLE,
   .present_queue                              = VK_NULL_HANDLE,
   .transfer_queue = VK_NULL_HANDLE,
+  .compute_queue  = VK_NULL_HANDLE,
+  .is_push_descriptor_supported = false,
+  .is_fragment_store_supported  = false,
+  .is_ycbcr_conversion_supported = false,
   .queue_family_indices = {
     .graphics_family       = 0,
     .present_family        = 0,
     .transfer_family       = 0,
+    .compute_family        = 0,
     .graphics_family_found = false,
     .present_family_found  = false,
     .transfer_family_found = false,
+    .compute_family_found  = false,
   },
   .buffer_sharing_mode            = VK_SHARING_MODE_EXCLUSIVE,
   .shared_queue_family_index_count = 0,
   .shared_queue_family_indices     = {0, 0},
+  .compute_sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+  .compute_shared_queue_family_index_count = 0,
+  .compute_shared_queue_family_indices     = {0, 0},
 
   /* Swap chain. */
   .swapchain                   = VK_NULL_HANDLE,
@@ -211,14 +395,91 @@ static Moss__Engine g_engine = {
   .vertex_crate = {0},
   .index_crate = {0},
 
+  /* Sprite batching. */
+  .sprite_vertex_crates     = { {0}, {0} },
+  .sprite_vertices          = { NULL, NULL },
+  .sprite_index_crate       = {0},
+  .sprite_count             = 0,
+  .sprite_sort              = {0},
+  .sprite_sort_frames       = { {0}, {0} },
+  .is_sprite_sort_requested = false,
+  .draw_queue               = {0},
+
+  /* Sprite animation. */
+  .sprite_animation              = {0},
+  .sprite_animation_frames       = { {0}, {0} },
+  .is_sprite_animation_requested = false,
+  .animation_time                = 0.0F,
+
+  /* Descriptors. */
+  .descriptor_cache        = {0},
+  .descriptor_cache_frames = { {0}, {0} },
+
+  /* Skinned meshes. */
+  .skinning        = {0},
+  .skinning_frames = { {0}, {0} },
+
+  /* Lighting. */
+  .light_culling        = {0},
+  .light_culling_frames = { {0}, {0} },
+  .light_count          = 0,
+  .ambient_light        = { 1.0F, 1.0F, 1.0F, 1.0F },
+  .shadow_maps          = {0},
+  .shadow_map_frames    = { {0}, {0} },
+  .occluder_count       = 0,
+
+  /* Dynamic resolution. */
+  .scene_target          = {0},
+  .gpu_timer             = {0},
+  .resolution_controller = { .render_scale = 1.0F, .target_frame_time = 1.0F / 60.0F },
+
+  /* Picking. */
+  .is_picking_enabled   = false,
+  .pick_readback        = {0},
+  .is_pick_requested    = false,
+  .pick_position        = { 0.0F, 0.0F },
+  .is_pick_result_ready = false,
+  .pick_result          = {0},
+
+  /* Virtual texture. */
+  .virtual_texture                   = {0},
+  .virtual_texture_frames            = { {0}, {0} },
+  .is_virtual_texture_view_requested = false,
+  .virtual_texture_view              = {0},
+
+  /* Layers. */
+  .layer_cache = {0},
+
+  /* Video. */
+  .video_texture           = {0},
+  .video_texture_frames    = { {0}, {0} },
+  .is_video_view_requested = false,
+  .video_view              = {0},
+
+  /* Offscreen batch. */
+  .offscreen_batch = {0},
+
+  /* Run loop. */
+  .wake_signal = {0},
+
+  /* Capture. */
+  .capture        = {0},
+  .capture_header = {0},
+
   /* Command buffers. */
   .general_command_pool    = VK_NULL_HANDLE,
   .general_command_buffers = { VK_NULL_HANDLE, VK_NULL_HANDLE },
+  .compute_command_pool    = VK_NULL_HANDLE,
+  .compute_command_buffers = { VK_NULL_HANDLE, VK_NULL_HANDLE },
 
   /* Synchronization objects. */
   .image_available_semaphores = { VK_NULL_HANDLE, VK_NULL_HANDLE },
   .render_finished_semaphores = { VK_NULL_HANDLE, VK_NULL_HANDLE },
   .in_flight_fences           = { VK_NULL_HANDLE, VK_NULL_HANDLE },
+  .compute_finished_semaphores = { VK_NULL_HANDLE, VK_NULL_HANDLE },
+
+  /* Asset streaming. */
+  .async_io = {0},
 
   /* Frame state. */
   .current_frame = 0,
@@ -355,12 +616,229 @@ inline static MossResult moss__create_index_crate (void);
 */
 inline static MossResult moss__fill_index_crate (void);
 
+/*
+  @brief Creates and maps per-frame sprite vertex crates.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_sprite_vertex_crates (void);
+
+/*
+  @brief Creates sprite index crate and fills it with quad indices.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_sprite_index_crate (void);
+
+/*
+  @brief Destroys sprite vertex and index crates.
+*/
+inline static void moss__cleanup_sprite_crates (void);
+
+/*
+  @brief Creates sprite depth sorting pipelines and per-frame resources.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_sprite_sort (void);
+
+/*
+  @brief Destroys sprite depth sorting pipelines and per-frame resources.
+*/
+inline static void moss__cleanup_sprite_sort (void);
+
+/*
+  @brief Creates animation clip crates and per-frame sprite animation state.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_sprite_animation (void);
+
+/*
+  @brief Destroys animation clip crates and per-frame sprite animation state.
+*/
+inline static void moss__cleanup_engine_sprite_animation (void);
+
+/*
+  @brief Creates descriptor cache and per-frame descriptor pools.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_descriptor_cache (void);
+
+/*
+  @brief Destroys descriptor cache and per-frame descriptor pools.
+*/
+inline static void moss__cleanup_engine_descriptor_cache (void);
+
+/*
+  @brief Creates skinning pipeline and per-frame bone crates.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_skinning (void);
+
+/*
+  @brief Destroys skinning pipeline, per-frame bone crates and uploaded meshes.
+*/
+inline static void moss__cleanup_engine_skinning (void);
+
+/*
+  @brief Expands sprites into the current frame's vertex crate.
+  @param sprites Sprites to draw.
+  @param depth Sprite depths. May be NULL.
+  @param animation_clip Sprite animation clip IDs. May be NULL.
+  @param animation_start_time Times sprite animation clips started at.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame
+          can't fit the sprites.
+*/
+inline static MossResult moss__write_frame_sprites (
+  const Moss__SpriteSoA *sprites,
+  const float           *depth,
+  const uint32_t        *animation_clip,
+  const float           *animation_start_time
+);
+
+/*
+  @brief Sorts draw commands submitted during the frame and writes them as sprites.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__flush_draw_queue (void);
+
+/*
+  @brief Checks if picks, tile streaming or asset reads still need frames to finish.
+  @return Returns true if the engine has outstanding work, false otherwise.
+*/
+inline static bool moss__has_pending_engine_work (void);
+
+/*
+  @brief Creates light culling and shadow map pipelines and per-frame resources.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_lighting (void);
+
+/*
+  @brief Recreates light tiles for the current swap chain extent.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__resize_lighting (void);
+
+/*
+  @brief Destroys light culling and shadow map pipelines and per-frame resources.
+*/
+inline static void moss__cleanup_lighting (void);
+
+/*
+  @brief Creates offscreen scene target and GPU frame timer.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_dynamic_resolution (void);
+
+/*
+  @brief Destroys offscreen scene target and GPU frame timer.
+*/
+inline static void moss__cleanup_dynamic_resolution (void);
+
+/*
+  @brief Creates pick ID readback if picking is enabled.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_picking (void);
+
+/*
+  @brief Destroys pick ID readback and drops pending picks.
+*/
+inline static void moss__cleanup_picking (void);
+
+/*
+  @brief Records copy of the requested pick ID, if any.
+  @details Must be recorded after the scene pass has ended.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Size of the sub-rectangle the scene was rendered to.
+*/
+inline static void
+moss__record_pick_request (VkCommandBuffer command_buffer, VkExtent2D render_extent);
+
+/*
+  @brief Creates virtual texture pipeline, page atlas and per-frame feedback crates.
+  @details Creates nothing if fragment shader stores aren't supported.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_virtual_texture (void);
+
+/*
+  @brief Closes open virtual texture and destroys its pipeline and per-frame state.
+*/
+inline static void moss__cleanup_engine_virtual_texture (void);
+
+/*
+  @brief Creates cached sprite layers and their composite pipeline.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_layer_cache (void);
+
+/*
+  @brief Redraws layers whose cached renders are out of date.
+  @details Must be recorded outside of any render pass, before the scene pass.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Size of the scene sub-rectangle.
+  @param scene_sets Light, shadow map and sprite animation sets of the frame.
+  @param scene_set_count Number of scene sets.
+  @param shading_constants Light shading push constants of the frame.
+*/
+inline static void moss__record_layer_passes (
+  VkCommandBuffer                        command_buffer,
+  VkExtent2D                             render_extent,
+  const VkDescriptorSet                 *scene_sets,
+  uint32_t                               scene_set_count,
+  const Moss__LightShadingPushConstants *shading_constants
+);
+
+/*
+  @brief Creates video texture without an open video.
+*/
+inline static void moss__create_engine_video_texture (void);
+
+/*
+  @brief Closes open video and destroys per-frame staging crates.
+*/
+inline static void moss__cleanup_engine_video_texture (void);
+
+/*
+  @brief Creates offscreen batch render pass.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_engine_offscreen_batch (void);
+
+/*
+  @brief Records all scenes of an offscreen batch and their readback.
+  @details Vertices of the scenes must already be written, one scene after another.
+  @param command_buffer Command buffer to record to.
+  @param batch Offscreen batch.
+*/
+inline static void moss__record_offscreen_batch (
+  VkCommandBuffer           command_buffer,
+  const MossOffscreenBatch *batch
+);
+
+/*
+  @brief Returns size of the scene sub-rectangle rendered at the current scale.
+  @return Render extent, never larger than the swap chain extent.
+*/
+inline static VkExtent2D moss__get_render_extent (void);
+
 /*
   @brief Creates command buffers.
   @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
 */
 inline static MossResult moss__create_general_command_buffers (void);
 
+/*
+  @brief Creates compute command buffers.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_compute_command_buffers (void);
+
+/*
+  @brief Initializes asynchronous file reader used for asset streaming.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__init_engine_async_io (void);
+
 /*
   @brief Creates image available semaphores.
   @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
@@ -373,6 +851,12 @@ inline static MossResult moss__create_image_available_semaphores (void);
 */
 inline static MossResult moss__create_render_finished_semaphores (void);
 
+/*
+  @brief Creates compute finished semaphores.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_compute_finished_semaphores (void);
+
 /*
   @brief Creates in-flight fences.
   @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
@@ -407,6 +891,11 @@ inline static void moss__cleanup_image_available_semaphores (void);
 */
 inline static void moss__cleanup_render_finished_semaphores (void);
 
+/*
+  @brief Cleans up compute finished semaphores.
+*/
+inline static void moss__cleanup_compute_finished_semaphores (void);
+
 /*
   @brief Cleans up in-flight fences.
 */
@@ -425,6 +914,28 @@ inline static void moss__cleanup_synchronization_objects (void);
 inline static void
 moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_index);
 
+/*
+  @brief Drops sprites, lights, occluders and views submitted for the current frame.
+  @details Called on every exit of @ref moss_engine_draw_frame once the draw queue
+           is flushed, so a failed frame doesn't leak its submissions into the next.
+*/
+inline static void moss__reset_frame_submissions (void);
+
+/*
+  @brief Checks whether the current frame has compute work.
+  @return Returns true if sprites must be sorted or lights must be culled.
+*/
+inline static bool moss__has_compute_work (void);
+
+/*
+  @brief Records compute work of the current frame.
+  @details Sprite sorting, light culling and shadow maps only read data uploaded
+           by the host, so they run on the compute queue and overlap with
+           graphics work of the previous frame.
+  @param command_buffer Command buffer to record.
+*/
+inline static void moss__record_compute_command_buffer (VkCommandBuffer command_buffer);
+
 /*
   @brief Cleans up swapchain framebuffers.
 */
@@ -469,7 +980,27 @@ inline static MossResult moss__recreate_swapchain (uint32_t width, uint32_t heig
 */
 MossResult moss_engine_init (const MossEngineConfig *const config)
 {
-  if (moss__init_stuffy_app ( ) != MOSS_RESULT_SUCCESS) { return MOSS_RESULT_ERROR; }
+  g_engine.is_picking_enabled = config->enable_picking;
+
+  g_engine.capture_header = (Moss__CaptureHeader) {
+    .window_width   = config->window_config->width,
+    .window_height  = config->window_config->height,
+    .enable_picking = config->enable_picking,
+  };
+
+  if (moss__init_job_system (config->job_system_config) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__init_stuffy_app ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__deinit_job_system ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__init_wake_signal (&g_engine.wake_signal);
+  moss__init_capture (&g_engine.capture);
 
   if (moss__open_window (config->window_config) != MOSS_RESULT_SUCCESS)
   {
@@ -529,6 +1060,13 @@ MossResult moss_engine_init (const MossEngineConfig *const config)
     &g_engine.transfer_queue
   );
 
+  vkGetDeviceQueue (
+    g_engine.device,
+    g_engine.queue_family_indices.compute_family,
+    0,
+    &g_engine.compute_queue
+  );
+
   moss__init_buffer_sharing_mode ( );
 
   const StuffyExtent2D framebuffer_size =
@@ -552,6 +1090,62 @@ MossResult moss_engine_init (const MossEngineConfig *const config)
     return MOSS_RESULT_ERROR;
   }
 
+  if (moss__create_dynamic_resolution ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_picking ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_lighting ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_engine_sprite_animation ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_engine_descriptor_cache ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_engine_skinning ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_engine_virtual_texture ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_engine_layer_cache ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__create_engine_video_texture ( );
+
+  if (moss__create_engine_offscreen_batch ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
   if (moss__create_graphics_pipeline ( ) != MOSS_RESULT_SUCCESS)
   {
     moss_engine_deinit ( );
@@ -586,6 +1180,17 @@ MossResult moss_engine_init (const MossEngineConfig *const config)
     return MOSS_RESULT_ERROR;
   }
 
+  // Create compute command pool
+  if (moss__create_command_pool (
+        g_engine.device,
+        g_engine.queue_family_indices.compute_family,
+        &g_engine.compute_command_pool
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
   if (moss__create_vertex_crate ( ) != MOSS_RESULT_SUCCESS)
   {
     moss_engine_deinit ( );
@@ -610,18 +1215,54 @@ MossResult moss_engine_init (const MossEngineConfig *const config)
     return MOSS_RESULT_ERROR;
   }
 
+  if (moss__create_sprite_vertex_crates ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_sprite_index_crate ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_sprite_sort ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__init_draw_queue (&g_engine.draw_queue) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
   if (moss__create_general_command_buffers ( ) != MOSS_RESULT_SUCCESS)
   {
     moss_engine_deinit ( );
     return MOSS_RESULT_ERROR;
   }
 
+  if (moss__create_compute_command_buffers ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
   if (moss__create_synchronization_objects ( ) != MOSS_RESULT_SUCCESS)
   {
     moss_engine_deinit ( );
     return MOSS_RESULT_ERROR;
   }
 
+  if (moss__init_engine_async_io ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss_engine_deinit ( );
+    return MOSS_RESULT_ERROR;
+  }
+
   g_engine.current_frame = 0;
 
   return MOSS_RESULT_SUCCESS;
@@ -633,6 +1274,12 @@ MossResult moss_engine_init (const MossEngineConfig *const config)
 */
 void moss_engine_deinit (void)
 {
+  // Calls made from now on are not captured anymore
+  moss__deinit_capture (&g_engine.capture);
+
+  // Reads may still target staging memory, finish them before anything is freed
+  moss__deinit_async_io (&g_engine.async_io);
+
   if (g_engine.device != VK_NULL_HANDLE) { vkDeviceWaitIdle (g_engine.device); }
 
   moss__cleanup_swapchain ( );
@@ -640,6 +1287,12 @@ void moss_engine_deinit (void)
 
   if (g_engine.device != VK_NULL_HANDLE)
   {
+    if (g_engine.compute_command_pool != VK_NULL_HANDLE)
+    {
+      vkDestroyCommandPool (g_engine.device, g_engine.compute_command_pool, NULL);
+      g_engine.compute_command_pool = VK_NULL_HANDLE;
+    }
+
     if (g_engine.transfer_command_pool != VK_NULL_HANDLE)
     {
       vkDestroyCommandPool (g_engine.device, g_engine.transfer_command_pool, NULL);
@@ -652,6 +1305,20 @@ void moss_engine_deinit (void)
       g_engine.general_command_pool = VK_NULL_HANDLE;
     }
 
+    moss__destroy_offscreen_batch (&g_engine.offscreen_batch);
+    moss__cleanup_engine_video_texture ( );
+    moss__destroy_layer_cache (&g_engine.layer_cache);
+    moss__cleanup_engine_virtual_texture ( );
+    moss__cleanup_engine_skinning ( );
+    moss__cleanup_engine_descriptor_cache ( );
+    moss__cleanup_engine_sprite_animation ( );
+    moss__cleanup_lighting ( );
+    moss__cleanup_picking ( );
+    moss__cleanup_dynamic_resolution ( );
+    moss__cleanup_sprite_sort ( );
+    moss__cleanup_sprite_crates ( );
+    moss__deinit_draw_queue (&g_engine.draw_queue);
+
     moss__destroy_crate (&g_engine.index_crate);
 
     moss__destroy_crate (&g_engine.vertex_crate);
@@ -680,12 +1347,15 @@ void moss_engine_deinit (void)
     g_engine.graphics_queue                             = VK_NULL_HANDLE;
     g_engine.transfer_queue                             = VK_NULL_HANDLE;
     g_engine.present_queue                              = VK_NULL_HANDLE;
+    g_engine.compute_queue                              = VK_NULL_HANDLE;
     g_engine.queue_family_indices.graphics_family       = 0;
     g_engine.queue_family_indices.present_family        = 0;
     g_engine.queue_family_indices.transfer_family       = 0;
+    g_engine.queue_family_indices.compute_family        = 0;
     g_engine.queue_family_indices.graphics_family_found = false;
     g_engine.queue_family_indices.present_family_found  = false;
     g_engine.queue_family_indices.transfer_family_found = false;
+    g_engine.queue_family_indices.compute_family_found  = false;
   }
 
   if (g_engine.surface != VK_NULL_HANDLE)
@@ -706,8 +1376,12 @@ void moss_engine_deinit (void)
     g_engine.window = NULL;
   }
 
+  moss__deinit_wake_signal (&g_engine.wake_signal);
+
   moss__deinit_stuffy_app ( );
 
+  moss__deinit_job_system ( );
+
   g_engine.current_frame = 0;
 }
 
@@ -723,21 +1397,125 @@ bool moss_engine_should_close (void)
 }
 
 /*
-  @brief Draws a frame.
-  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+  @brief Runs main loop until the window closes.
+  @param config Main loop configuration.
+  @return Returns MOSS_RESULT_SUCCESS once the window closes, MOSS_RESULT_ERROR if
+          a frame fails to draw.
 */
-MossResult moss_engine_draw_frame (void)
+MossResult moss_engine_run (const MossRunConfig *const config)
 {
-  const VkFence     in_flight_fence = g_engine.in_flight_fences[ g_engine.current_frame ];
-  const VkSemaphore image_available_semaphore =
-    g_engine.image_available_semaphores[ g_engine.current_frame ];
-  const VkSemaphore render_finished_semaphore =
-    g_engine.render_finished_semaphores[ g_engine.current_frame ];
-  const VkCommandBuffer command_buffer =
-    g_engine.general_command_buffers[ g_engine.current_frame ];
+  const float idle_event_interval = config->idle_event_interval > 0.0F
+                                    ? config->idle_event_interval
+                                    : DEFAULT_IDLE_EVENT_INTERVAL;
+
+  double last_frame_time    = 0.0;
+  double next_frame_time    = 0.0;
+  bool   is_first_frame     = true;
+  bool   is_waiting_forever = false;
+  bool   is_frame_due       = true;
+
+  while (!moss_engine_should_close ( ))
+  {
+    if (config->event_callback != NULL) { config->event_callback (config->user_data); }
+
+    const double now = moss__get_monotonic_time ( );
+
+    if (!is_frame_due && !g_engine.framebuffer_resize_requsted &&
+        !moss__has_pending_engine_work ( ) &&
+        (is_waiting_forever || now < next_frame_time))
+    {
+      // Events are checked between sleeps, windows give no blocking wait
+      float wait_seconds = idle_event_interval;
+      if (!is_waiting_forever && next_frame_time - now < wait_seconds)
+      {
+        wait_seconds = (float)(next_frame_time - now);
+      }
+
+      is_frame_due = moss__wait_wake_signal (&g_engine.wake_signal, wait_seconds);
+      continue;
+    }
+
+    const float delta_seconds = is_first_frame ? 0.0F : (float)(now - last_frame_time);
+    last_frame_time = now;
+    is_first_frame  = false;
+    is_frame_due    = false;
+
+    const float next_frame_delay =
+      config->frame_callback (config->user_data, delta_seconds);
+
+    if (moss_engine_draw_frame ( ) != MOSS_RESULT_SUCCESS) { return MOSS_RESULT_ERROR; }
+
+    is_waiting_forever = next_frame_delay < 0.0F;
+    next_frame_time    = now + (double)next_frame_delay;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+/*
+  @brief Requests a frame from an idle main loop.
+*/
+void moss_engine_invalidate (void) { moss__raise_wake_signal (&g_engine.wake_signal); }
+
+/*
+  @brief Draws a frame.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_draw_frame (void)
+{
+  // Calls made before the frame are replayed before it, the last frame ends capture
+  moss__capture_frame (&g_engine.capture);
+
+  const VkFence     in_flight_fence = g_engine.in_flight_fences[ g_engine.current_frame ];
+  const VkSemaphore image_available_semaphore =
+    g_engine.image_available_semaphores[ g_engine.current_frame ];
+  const VkSemaphore render_finished_semaphore =
+    g_engine.render_finished_semaphores[ g_engine.current_frame ];
+  const VkCommandBuffer command_buffer =
+    g_engine.general_command_buffers[ g_engine.current_frame ];
+  const VkCommandBuffer compute_command_buffer =
+    g_engine.compute_command_buffers[ g_engine.current_frame ];
+  const VkSemaphore compute_finished_semaphore =
+    g_engine.compute_finished_semaphores[ g_engine.current_frame ];
 
   vkWaitForFences (g_engine.device, 1, &in_flight_fence, VK_TRUE, UINT64_MAX);
-  vkResetFences (g_engine.device, 1, &in_flight_fence);
+
+  // Sets cached by the frame that used these resources aren't in use anymore
+  moss__begin_descriptor_cache_frame (
+    &g_engine.descriptor_cache,
+    &g_engine.descriptor_cache_frames[ g_engine.current_frame ]
+  );
+
+  // Timestamps of the frame that used these resources are ready once its fence is
+  float gpu_frame_time;
+  if (moss__read_gpu_timer (&g_engine.gpu_timer, g_engine.current_frame, &gpu_frame_time))
+  {
+    moss__update_resolution_controller (&g_engine.resolution_controller, gpu_frame_time);
+  }
+
+  // Pick copied out by that frame is in host memory by now as well
+  MossPickResult pick_result;
+  if (moss__read_pick (&g_engine.pick_readback, g_engine.current_frame, &pick_result))
+  {
+    g_engine.pick_result          = pick_result;
+    g_engine.is_pick_result_ready = true;
+  }
+
+  // So is the tile feedback it wrote, missing tiles start streaming right away
+  moss__begin_virtual_texture_frame (
+    &g_engine.virtual_texture,
+    &g_engine.virtual_texture_frames[ g_engine.current_frame ],
+    &g_engine.async_io
+  );
+
+  // Report finished asset reads, so their uploads can be recorded this frame
+  moss__poll_async_io (&g_engine.async_io);
+
+  if (moss__flush_draw_queue ( ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__reset_frame_submissions ( );
+    return MOSS_RESULT_ERROR;
+  }
 
   uint32_t current_image_index;
   VkResult result = vkAcquireNextImageKHR (
@@ -752,6 +1530,7 @@ MossResult moss_engine_draw_frame (void)
   if (result == VK_ERROR_OUT_OF_DATE_KHR)
   {
     // Swap chain is out of date, need to recreate before we can acquire image
+    moss__reset_frame_submissions ( );
     const StuffyExtent2D framebuffer_size =
       stuffy_window_get_framebuffer_size (g_engine.window);
     return moss__recreate_swapchain (framebuffer_size.width, framebuffer_size.height);
@@ -759,40 +1538,102 @@ MossResult moss_engine_draw_frame (void)
 
   if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
   {
+    moss__reset_frame_submissions ( );
     moss__error ("Failed to acquire swap chain image.\n");
     return MOSS_RESULT_ERROR;
   }
 
+  // Compute work goes first, so it overlaps with the previous frame still rendering
+  const bool is_compute_submitted = moss__has_compute_work ( );
+  if (is_compute_submitted)
+  {
+    vkResetCommandBuffer (compute_command_buffer, 0);
+    moss__record_compute_command_buffer (compute_command_buffer);
+
+    const VkSubmitInfo compute_submit_info = {
+      .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      .commandBufferCount   = 1,
+      .pCommandBuffers      = &compute_command_buffer,
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores    = &compute_finished_semaphore,
+    };
+
+    if (vkQueueSubmit (g_engine.compute_queue, 1, &compute_submit_info, VK_NULL_HANDLE) !=
+        VK_SUCCESS)
+    {
+      // Unsignal the acquired image's semaphore, nothing else is going to wait on it
+      const VkPipelineStageFlags recovery_wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+      const VkSubmitInfo         recovery_submit_info = {
+        .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores    = &image_available_semaphore,
+        .pWaitDstStageMask  = &recovery_wait_stage,
+      };
+      vkQueueSubmit (g_engine.graphics_queue, 1, &recovery_submit_info, VK_NULL_HANDLE);
+
+      moss__reset_frame_submissions ( );
+      moss__error ("Failed to submit compute command buffer.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
   vkResetCommandBuffer (command_buffer, 0);
   moss__record_command_buffer (command_buffer, current_image_index);
 
-  const VkSemaphore wait_semaphores[] = { image_available_semaphore };
-  const size_t      wait_semaphore_count =
-    sizeof (wait_semaphores) / sizeof (wait_semaphores[ 0 ]);
+  const VkSemaphore wait_semaphores[] = {
+    image_available_semaphore,
+    compute_finished_semaphore,
+  };
+  const VkPipelineStageFlags wait_stages[] = {
+    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+  };
+  // Compute finished semaphore is only waited on when it's going to be signaled
+  const size_t wait_semaphore_count = is_compute_submitted ? 2 : 1;
 
   const VkSemaphore signal_semaphores[] = { render_finished_semaphore };
   const size_t      signal_semaphore_count =
     sizeof (signal_semaphores) / sizeof (signal_semaphores[ 0 ]);
 
   const VkSubmitInfo submit_info = {
-    .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-    .waitSemaphoreCount = wait_semaphore_count,
-    .pWaitSemaphores    = wait_semaphores,
-    .pWaitDstStageMask =
-      (const VkPipelineStageFlags[]) { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT },
+    .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+    .waitSemaphoreCount   = wait_semaphore_count,
+    .pWaitSemaphores      = wait_semaphores,
+    .pWaitDstStageMask    = wait_stages,
     .commandBufferCount   = 1,
     .pCommandBuffers      = &command_buffer,
     .signalSemaphoreCount = signal_semaphore_count,
     .pSignalSemaphores    = signal_semaphores,
   };
 
+  // Reset only right before the submit that signals it, so an early return
+  // doesn't leave the fence unsignaled forever
+  vkResetFences (g_engine.device, 1, &in_flight_fence);
+
   if (vkQueueSubmit (g_engine.graphics_queue, 1, &submit_info, in_flight_fence) !=
       VK_SUCCESS)
   {
+    // Without command buffers the submit only unsignals semaphores the draw would
+    // have waited on and signals the fence, so the frame slot can be used again
+    const VkPipelineStageFlags recovery_wait_stages[] = {
+      VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+      VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+    };
+    const VkSubmitInfo recovery_submit_info = {
+      .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      .waitSemaphoreCount = wait_semaphore_count,
+      .pWaitSemaphores    = wait_semaphores,
+      .pWaitDstStageMask  = recovery_wait_stages,
+    };
+    vkQueueSubmit (g_engine.graphics_queue, 1, &recovery_submit_info, in_flight_fence);
+
+    moss__reset_frame_submissions ( );
     moss__error ("Failed to submit draw command buffer.\n");
     return MOSS_RESULT_ERROR;
   }
 
+  moss__reset_frame_submissions ( );
+
   const VkPresentInfoKHR present_info = {
     .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
     .waitSemaphoreCount = signal_semaphore_count,
@@ -829,357 +1670,2107 @@ MossResult moss_engine_draw_frame (void)
   return MOSS_RESULT_SUCCESS;
 }
 
-/*=============================================================================
-    INTERNAL CALLBACK FUNCTIONS IMPLENTATION
-  =============================================================================*/
-
-static void
-moss__window_resize_callback (StuffyWindow *const window, StuffyWindowRect rect)
+/*
+  @brief Submits sprites to draw during the next frame.
+  @param batch Sprites to draw.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_submit_sprites (const MossSpriteBatch *const batch)
 {
-  (void)(window);
-  (void)(rect);
+  moss__capture_sprites (&g_engine.capture, MOSS__CAPTURE_OP_SUBMIT_SPRITES, 0, batch);
+
+  const Moss__SpriteSoA sprites = {
+    .x             = batch->x,
+    .y             = batch->y,
+    .rotation      = batch->rotation,
+    .scale_x       = batch->scale_x,
+    .scale_y       = batch->scale_y,
+    .uv_left       = NULL,
+    .uv_top        = NULL,
+    .uv_right      = NULL,
+    .uv_bottom     = NULL,
+    .color         = batch->color,
+    .texture_index = batch->texture_index,
+    .count         = batch->count,
+  };
 
-  g_engine.framebuffer_resize_requsted = true;
+  return moss__write_frame_sprites (
+    &sprites,
+    batch->depth,
+    batch->animation_clip,
+    batch->animation_start_time
+  );
 }
 
-/*=============================================================================
-    INTERNAL FUNCTIONS IMPLEMENTATION
-  =============================================================================*/
+/*
+  @brief Submits a sprite draw command from any thread.
+  @param command Draw command.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_submit_draw (const MossDrawCommand *const command)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SUBMIT_DRAW,
+    command,
+    sizeof (*command)
+  );
 
-inline static MossResult moss__create_api_instance (const MossAppInfo *const app_info)
+  return moss__push_draw_command (&g_engine.draw_queue, command);
+}
+
+/*
+  @brief Submits lights to use during the next frame.
+  @param lights Lights.
+  @param count Number of lights.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_submit_lights (const MossLight *const lights, const uint32_t count)
 {
-  // Set up validation layers
-#ifdef NDEBUG
-  const bool enable_validation_layers = false;
-#else
-  const bool enable_validation_layers = true;
-#endif
+  moss__capture_array_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SUBMIT_LIGHTS,
+    lights,
+    count,
+    sizeof (*lights)
+  );
 
-  uint32_t           validation_layer_count = 0;
-  const char *const *validation_layer_names = NULL;
+  if (count == 0) { return MOSS_RESULT_SUCCESS; }
 
-  if (enable_validation_layers)
+  if (count > MOSS_MAX_LIGHT_COUNT - g_engine.light_count)
   {
-    if (moss__check_vk_validation_layer_support ( ))
-    {
-      const Moss__VkValidationLayers validation_layers =
-        moss__get_vk_validation_layers ( );
-      validation_layer_count = validation_layers.count;
-      validation_layer_names = validation_layers.names;
-    }
-    else {
-      moss__warning (
-        "Validation layers are enabled but not supported. Disabling validation layers."
-      );
-    }
+    moss__error (
+      "%u lights don't fit into the frame, %u lights are already submitted.\n",
+      count,
+      g_engine.light_count
+    );
+    return MOSS_RESULT_ERROR;
   }
 
-  // Set up other required info
-  const VkApplicationInfo          vk_app_info = moss__create_vk_app_info (app_info);
-  const Moss__VkInstanceExtensions extensions =
-    moss__get_required_vk_instance_extensions ( );
-
-  // Make instance create info
-  const VkInstanceCreateInfo instance_create_info = {
-    .sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
-    .pApplicationInfo        = &vk_app_info,
-    .ppEnabledExtensionNames = extensions.names,
-    .enabledExtensionCount   = extensions.count,
-    .enabledLayerCount       = validation_layer_count,
-    .ppEnabledLayerNames     = validation_layer_names,
-    .flags                   = moss__get_required_vk_instance_flags ( ),
-  };
+  // The GPU may still read this frame's light crate from its previous submission
+  if (g_engine.light_count == 0)
+  {
+    vkWaitForFences (
+      g_engine.device,
+      1,
+      &g_engine.in_flight_fences[ g_engine.current_frame ],
+      VK_TRUE,
+      UINT64_MAX
+    );
+  }
 
-  const VkResult result =
-    vkCreateInstance (&instance_create_info, NULL, &g_engine.api_instance);
-  if (result != VK_SUCCESS)
+  Moss__GpuLight *const frame_lights =
+    g_engine.light_culling_frames[ g_engine.current_frame ].lights + g_engine.light_count;
+  for (uint32_t i = 0; i < count; ++i)
   {
-    moss__error ("Failed to create Vulkan instance. Error code: %d.\n", result);
-    return MOSS_RESULT_ERROR;
+    moss__pack_gpu_light (&lights[ i ], &frame_lights[ i ]);
   }
 
+  g_engine.light_count += count;
+
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__init_stuffy_app (void)
+/*
+  @brief Submits light occluders to use during the next frame.
+  @param occluders Occluders.
+  @param count Number of occluders.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult
+moss_engine_submit_occluders (const MossOccluder *const occluders, const uint32_t count)
 {
-  if (stuffy_app_init ( ) != 0)
+  moss__capture_array_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SUBMIT_OCCLUDERS,
+    occluders,
+    count,
+    sizeof (*occluders)
+  );
+
+  if (count == 0) { return MOSS_RESULT_SUCCESS; }
+
+  if (count > MOSS_MAX_OCCLUDER_COUNT - g_engine.occluder_count)
   {
-    moss__error ("Failed to initialize stuffy app.\n");
+    moss__error (
+      "%u occluders don't fit into the frame, %u occluders are already submitted.\n",
+      count,
+      g_engine.occluder_count
+    );
     return MOSS_RESULT_ERROR;
   }
+
+  // The GPU may still read this frame's occluder crate from its previous submission
+  if (g_engine.occluder_count == 0)
+  {
+    vkWaitForFences (
+      g_engine.device,
+      1,
+      &g_engine.in_flight_fences[ g_engine.current_frame ],
+      VK_TRUE,
+      UINT64_MAX
+    );
+  }
+
+  Moss__GpuOccluder *const frame_occluders =
+    g_engine.shadow_map_frames[ g_engine.current_frame ].occluders +
+    g_engine.occluder_count;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    frame_occluders[ i ] = (Moss__GpuOccluder) {
+      .start = { occluders[ i ].start_x, occluders[ i ].start_y },
+      .end   = { occluders[ i ].end_x, occluders[ i ].end_y },
+    };
+  }
+
+  g_engine.occluder_count += count;
+
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static void moss__deinit_stuffy_app (void) { stuffy_app_deinit ( ); }
+/*
+  @brief Sets ambient light color.
+  @param color RGBA8 color, red in the least significant byte.
+*/
+void moss_engine_set_ambient_light (const uint32_t color)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SET_AMBIENT_LIGHT,
+    &color,
+    sizeof (color)
+  );
 
-inline static StuffyWindowConfig
-moss__create_stuffy_window_config (const MossWindowConfig *const window_config)
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    g_engine.ambient_light[ i ] = (float)((color >> (i * 8)) & 0xFF) / 255.0F;
+  }
+}
+
+/*
+  @brief Sets GPU frame time dynamic resolution aims for.
+  @param seconds Target GPU frame time. 0 disables dynamic resolution.
+*/
+void moss_engine_set_target_frame_time (const float seconds)
 {
-  const StuffyWindowRect window_rect = {
-    .x      = 128,
-    .y      = 128,
-    .width  = window_config->width,
-    .height = window_config->height,
-  };
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SET_TARGET_FRAME_TIME,
+    &seconds,
+    sizeof (seconds)
+  );
 
-  const StuffyWindowConfig result_config = {
-    .rect       = window_rect,
-    .title      = window_config->title,
-    .style_mask = STUFFY_WINDOW_STYLE_TITLED_BIT | STUFFY_WINDOW_STYLE_CLOSABLE_BIT |
-                  STUFFY_WINDOW_STYLE_RESIZABLE_BIT | STUFFY_WINDOW_STYLE_ICONIFIABLE_BIT,
-  };
+  g_engine.resolution_controller.target_frame_time = seconds;
 
-  return result_config;
+  if (seconds <= 0.0F) { g_engine.resolution_controller.render_scale = 1.0F; }
 }
 
-inline static MossResult moss__open_window (const MossWindowConfig *window_config)
+/*
+  @brief Returns current render scale.
+  @return Share of the window resolution sprites are rendered at, per axis.
+*/
+float moss_engine_get_render_scale (void)
 {
-  const StuffyWindowConfig stuffy_window_config =
-    moss__create_stuffy_window_config (window_config);
+  return g_engine.resolution_controller.render_scale;
+}
 
-  g_engine.window = stuffy_window_open (&stuffy_window_config);
-  if (g_engine.window == NULL)
+/*
+  @brief Replaces animation clips sprites can play.
+  @param clips Clips to upload, clip IDs are their indices.
+  @param count Number of clips.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_upload_animation_clips (
+  const MossAnimationClip *const clips,
+  const uint32_t                 count
+)
+{
+  moss__capture_animation_clips (&g_engine.capture, clips, count);
+
+  return moss__upload_animation_clips (
+    &g_engine.sprite_animation,
+    clips,
+    count,
+    g_engine.transfer_queue,
+    g_engine.transfer_command_pool
+  );
+}
+
+/*
+  @brief Sets animation time sprite animation clips are evaluated at.
+  @param seconds Animation time.
+*/
+void moss_engine_set_animation_time (const float seconds)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SET_ANIMATION_TIME,
+    &seconds,
+    sizeof (seconds)
+  );
+
+  g_engine.animation_time = seconds;
+}
+
+/*
+  @brief Uploads skinned mesh.
+  @param info Mesh creation information.
+  @param out_mesh Output mesh ID.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_create_skinned_mesh (
+  const MossSkinnedMeshCreateInfo *const info,
+  uint32_t *const                        out_mesh
+)
+{
+  moss__capture_skinned_mesh (&g_engine.capture, info);
+
+  return moss__create_skinned_mesh (
+    &g_engine.skinning,
+    info,
+    g_engine.transfer_queue,
+    g_engine.transfer_command_pool,
+    out_mesh
+  );
+}
+
+/*
+  @brief Submits skinned mesh to draw during the next frame.
+  @param mesh Mesh ID.
+  @param pose Local bone transforms.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult
+moss_engine_submit_skinned_mesh (const uint32_t mesh, const MossBone *const pose)
+{
+  Moss__SkinningFrame *const frame = &g_engine.skinning_frames[ g_engine.current_frame ];
+
+  // The GPU may still read this frame's bone crate from its previous submission
+  if (frame->draw_count == 0)
+  {
+    vkWaitForFences (
+      g_engine.device,
+      1,
+      &g_engine.in_flight_fences[ g_engine.current_frame ],
+      VK_TRUE,
+      UINT64_MAX
+    );
+  }
+
+  if (moss__push_skinned_mesh_draw (&g_engine.skinning, frame, mesh, pose) !=
+      MOSS_RESULT_SUCCESS)
   {
-    moss__error ("Failed to create window.\n");
     return MOSS_RESULT_ERROR;
   }
 
-  stuffy_window_set_resize_callback (g_engine.window, moss__window_resize_callback);
+  // Pose length is only known once the mesh is validated
+  moss__capture_skinned_mesh_pose (
+    &g_engine.capture,
+    mesh,
+    pose,
+    g_engine.skinning.meshes[ mesh ].bone_count
+  );
 
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__create_surface (void)
+/*
+  @brief Requests pick of the object drawn at a pixel during the next frame.
+  @param x X coordinate in swap chain pixels, from the left edge.
+  @param y Y coordinate in swap chain pixels, from the top edge.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if picking
+          isn't enabled.
+*/
+MossResult moss_engine_request_pick (const float x, const float y)
 {
-  const StuffyVkSurfaceCreateInfo create_info = {
-    .window    = g_engine.window,
-    .instance  = g_engine.api_instance,
-    .allocator = NULL,
-  };
+  const float position[ 2 ] = { x, y };
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_REQUEST_PICK,
+    position,
+    sizeof (position)
+  );
 
-  const VkResult result = stuffy_vk_create_surface (&create_info, &g_engine.surface);
-  if (result != VK_SUCCESS)
+  if (!g_engine.is_picking_enabled)
   {
-    moss__error ("Failed to create window surface. Error code: %d.\n", result);
+    moss__error ("Picking isn't enabled in the engine config.\n");
     return MOSS_RESULT_ERROR;
   }
 
+  g_engine.is_pick_requested  = true;
+  g_engine.pick_position[ 0 ] = x;
+  g_engine.pick_position[ 1 ] = y;
+
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__create_logical_device (void)
+/*
+  @brief Returns latest resolved pick.
+  @param out_result Output pick result.
+  @return Returns true if a pick resolved since the last call, false otherwise.
+*/
+bool moss_engine_poll_pick (MossPickResult *const out_result)
 {
-  const Moss__VkPhysicalDeviceExtensions extensions =
-    moss__get_required_vk_device_extensions ( );
+  if (!g_engine.is_pick_result_ready) { return false; }
 
-  uint32_t                queue_create_info_count = 0;
-  VkDeviceQueueCreateInfo queue_create_infos[ 3 ];
-  const float             queue_priority = 1.0F;
+  *out_result                   = g_engine.pick_result;
+  g_engine.is_pick_result_ready = false;
 
-  // Add graphics queue create info
+  return true;
+}
+
+/*
+  @brief Opens tiled image file as the virtual texture.
+  @param path Path to the file.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_open_virtual_texture (const char *const path)
+{
+  moss__capture_virtual_texture_path (&g_engine.capture, path);
+
+  // Frames in flight may still sample the page table of the previous image
+  vkDeviceWaitIdle (g_engine.device);
+
+  return moss__open_virtual_texture (
+    &g_engine.virtual_texture,
+    path,
+    &g_engine.async_io,
+    g_engine.transfer_queue,
+    g_engine.transfer_command_pool
+  );
+}
+
+/*
+  @brief Closes open virtual texture.
+*/
+void moss_engine_close_virtual_texture (void)
+{
+  moss__capture_call (&g_engine.capture, MOSS__CAPTURE_OP_CLOSE_VIRTUAL_TEXTURE, NULL, 0);
+
+  vkDeviceWaitIdle (g_engine.device);
+
+  moss__close_virtual_texture (&g_engine.virtual_texture, &g_engine.async_io);
+  g_engine.is_virtual_texture_view_requested = false;
+}
+
+/*
+  @brief Submits virtual texture placement for the current frame.
+  @param view Placement of the virtual texture.
+*/
+void moss_engine_submit_virtual_texture (const MossVirtualTextureView *const view)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SUBMIT_VIRTUAL_TEXTURE,
+    view,
+    sizeof (*view)
+  );
+
+  g_engine.virtual_texture_view              = *view;
+  g_engine.is_virtual_texture_view_requested = true;
+}
+
+/*
+  @brief Replaces sprites of a cached layer.
+  @param layer Layer index.
+  @param batch Sprites of the layer.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult
+moss_engine_set_layer_sprites (const uint32_t layer, const MossSpriteBatch *const batch)
+{
+  moss__capture_sprites (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SET_LAYER_SPRITES,
+    layer,
+    batch
+  );
+
+  if (batch->count > MOSS_MAX_SPRITE_COUNT)
   {
-    const VkDeviceQueueCreateInfo create_info = {
-      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-      .queueFamilyIndex = g_engine.queue_family_indices.graphics_family,
-      .queueCount       = 1,
-      .pQueuePriorities = &queue_priority,
-    };
-    queue_create_infos[ queue_create_info_count++ ] = create_info;
+    moss__error (
+      "Layer batch of %u sprites exceeds %u sprites.\n",
+      batch->count,
+      MOSS_MAX_SPRITE_COUNT
+    );
+    return MOSS_RESULT_ERROR;
   }
 
-  // Add present queue create info
-  if (g_engine.queue_family_indices.graphics_family !=
-      g_engine.queue_family_indices.present_family)
+  // Frames in flight may still redraw the layer from its vertex crate
+  vkWaitForFences (
+    g_engine.device,
+    MAX_FRAMES_IN_FLIGHT,
+    g_engine.in_flight_fences,
+    VK_TRUE,
+    UINT64_MAX
+  );
+
+  const Moss__SpriteSoA sprites = {
+    .x             = batch->x,
+    .y             = batch->y,
+    .rotation      = batch->rotation,
+    .scale_x       = batch->scale_x,
+    .scale_y       = batch->scale_y,
+    .uv_left       = NULL,
+    .uv_top        = NULL,
+    .uv_right      = NULL,
+    .uv_bottom     = NULL,
+    .color         = batch->color,
+    .texture_index = batch->texture_index,
+    .count         = batch->count,
+  };
+
+  return moss__write_layer_sprites (&g_engine.layer_cache, layer, &sprites);
+}
+
+/*
+  @brief Redraws a cached layer during the next frame.
+  @param layer Layer index.
+*/
+void moss_engine_invalidate_layer (const uint32_t layer)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_INVALIDATE_LAYER,
+    &layer,
+    sizeof (layer)
+  );
+
+  if (layer >= MOSS_MAX_LAYER_COUNT) { return; }
+
+  g_engine.layer_cache.layers[ layer ].is_dirty = true;
+}
+
+/*
+  @brief Opens video frames are uploaded to.
+  @param info Video information.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_open_video (const MossVideoCreateInfo *const info)
+{
+  const uint32_t fields[ 5 ] = {
+    (uint32_t)info->format,
+    (uint32_t)info->color_space,
+    (uint32_t)info->is_full_range,
+    info->width,
+    info->height,
+  };
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_OPEN_VIDEO,
+    fields,
+    sizeof (fields)
+  );
+
+  // Frames in flight may still sample the previous video image
+  vkDeviceWaitIdle (g_engine.device);
+
+  // Staged frames were packed for the previous video
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
   {
-    const VkDeviceQueueCreateInfo create_info = {
-      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-      .queueFamilyIndex = g_engine.queue_family_indices.present_family,
-      .queueCount       = 1,
-      .pQueuePriorities = &queue_priority,
+    g_engine.video_texture_frames[ i ].is_upload_pending = false;
+  }
+
+  return moss__open_video_texture (&g_engine.video_texture, info);
+}
+
+/*
+  @brief Closes open video.
+*/
+void moss_engine_close_video (void)
+{
+  moss__capture_call (&g_engine.capture, MOSS__CAPTURE_OP_CLOSE_VIDEO, NULL, 0);
+
+  vkDeviceWaitIdle (g_engine.device);
+
+  moss__close_video_texture (&g_engine.video_texture);
+  g_engine.is_video_view_requested = false;
+}
+
+/*
+  @brief Uploads decoded video frame during the next frame.
+  @param frame Decoded video frame.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_upload_video_frame (const MossVideoFrame *const frame)
+{
+  // The frame's staging crate may still be copied from by its previous submission
+  vkWaitForFences (
+    g_engine.device,
+    1,
+    &g_engine.in_flight_fences[ g_engine.current_frame ],
+    VK_TRUE,
+    UINT64_MAX
+  );
+
+  Moss__VideoTextureFrame *const texture_frame =
+    &g_engine.video_texture_frames[ g_engine.current_frame ];
+
+  if (moss__write_video_frame (&g_engine.video_texture, texture_frame, frame) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Frames may come from a file descriptor, so the packed staging copy is captured
+  moss__capture_video_frame (
+    &g_engine.capture,
+    texture_frame->staging,
+    g_engine.video_texture.frame_size
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+/*
+  @brief Submits video placement for the current frame.
+  @param view Placement of the video.
+*/
+void moss_engine_submit_video (const MossVideoView *const view)
+{
+  moss__capture_call (
+    &g_engine.capture,
+    MOSS__CAPTURE_OP_SUBMIT_VIDEO,
+    view,
+    sizeof (*view)
+  );
+
+  g_engine.video_view              = *view;
+  g_engine.is_video_view_requested = true;
+}
+
+/*
+  @brief Renders independent scenes offscreen and reads them back.
+  @param batch Scenes to render.
+  @param out_pixels Output RGBA8 pixels of all scenes.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_render_offscreen_batch (
+  const MossOffscreenBatch *const batch,
+  void *const                     out_pixels
+)
+{
+  moss__capture_offscreen_batch (&g_engine.capture, batch);
+
+  if (batch->width == 0 || batch->height == 0 ||
+      batch->width > MOSS_OFFSCREEN_TARGET_SIZE ||
+      batch->height > MOSS_OFFSCREEN_TARGET_SIZE)
+  {
+    moss__error (
+      "Offscreen scenes must be 1 to %u pixels wide and high.\n",
+      MOSS_OFFSCREEN_TARGET_SIZE
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (batch->scene_count == 0) { return MOSS_RESULT_SUCCESS; }
+
+  uint64_t sprite_count = 0;
+  for (uint32_t i = 0; i < batch->scene_count; ++i)
+  {
+    if (batch->scenes[ i ].count > MOSS_MAX_SPRITE_COUNT)
+    {
+      moss__error (
+        "Offscreen scene of %u sprites exceeds %u sprites.\n",
+        batch->scenes[ i ].count,
+        MOSS_MAX_SPRITE_COUNT
+      );
+      return MOSS_RESULT_ERROR;
+    }
+
+    sprite_count += batch->scenes[ i ].count;
+  }
+
+  if (sprite_count > UINT32_MAX / MOSS__SPRITE_VERTEX_COUNT)
+  {
+    moss__error ("Offscreen batch has too many sprites.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDeviceSize pixel_size =
+    (VkDeviceSize)batch->scene_count * batch->width * batch->height * 4;
+
+  if (moss__reserve_offscreen_batch (
+        &g_engine.offscreen_batch,
+        (uint32_t)sprite_count,
+        pixel_size
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  uint32_t first_sprite = 0;
+  for (uint32_t i = 0; i < batch->scene_count; ++i)
+  {
+    const MossSpriteBatch *const scene = &batch->scenes[ i ];
+    if (scene->count == 0) { continue; }
+
+    const Moss__SpriteSoA sprites = {
+      .x             = scene->x,
+      .y             = scene->y,
+      .rotation      = scene->rotation,
+      .scale_x       = scene->scale_x,
+      .scale_y       = scene->scale_y,
+      .uv_left       = NULL,
+      .uv_top        = NULL,
+      .uv_right      = NULL,
+      .uv_bottom     = NULL,
+      .color         = scene->color,
+      .texture_index = scene->texture_index,
+      .count         = scene->count,
     };
-    queue_create_infos[ queue_create_info_count++ ] = create_info;
+
+    moss__generate_sprite_vertices_parallel (
+      &sprites,
+      g_engine.offscreen_batch.vertices + first_sprite * MOSS__SPRITE_VERTEX_COUNT
+    );
+
+    first_sprite += scene->count;
+  }
+
+  const VkCommandBufferAllocateInfo alloc_info = {
+    .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .commandPool        = g_engine.general_command_pool,
+    .commandBufferCount = 1,
+  };
+
+  VkCommandBuffer command_buffer;
+  if (vkAllocateCommandBuffers (g_engine.device, &alloc_info, &command_buffer) !=
+      VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate offscreen command buffer.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkCommandBufferBeginInfo begin_info = {
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+  };
+
+  vkBeginCommandBuffer (command_buffer, &begin_info);
+  moss__begin_debug_label (command_buffer, "Offscreen batch");
+  moss__record_offscreen_batch (command_buffer, batch);
+  moss__end_debug_label (command_buffer);
+  vkEndCommandBuffer (command_buffer);
+
+  const VkSubmitInfo submit_info = {
+    .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+    .commandBufferCount = 1,
+    .pCommandBuffers    = &command_buffer,
+  };
+
+  // The whole batch is a single submission, waited on once
+  VkResult result =
+    vkQueueSubmit (g_engine.graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
+  if (result == VK_SUCCESS) { result = vkQueueWaitIdle (g_engine.graphics_queue); }
+
+  vkFreeCommandBuffers (
+    g_engine.device,
+    g_engine.general_command_pool,
+    1,
+    &command_buffer
+  );
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to render offscreen batch. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__read_offscreen_pixels (&g_engine.offscreen_batch, pixel_size, out_pixels);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+/*
+  @brief Starts capturing public API calls into a file.
+  @param path Path to the capture file.
+  @param frame_count Number of frames to capture.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+MossResult moss_engine_begin_capture (const char *const path, const uint32_t frame_count)
+{
+  return moss__begin_capture (
+    &g_engine.capture,
+    path,
+    g_engine.capture_header,
+    frame_count
+  );
+}
+
+/*
+  @brief Stops capturing public API calls.
+*/
+void moss_engine_end_capture (void) { moss__end_capture (&g_engine.capture); }
+
+/*
+  @brief Reports device memory taken by the engine.
+  @param out_report Output report.
+*/
+void moss_engine_get_vram_report (MossVramReport *const out_report)
+{
+  moss__get_vram_report (g_engine.physical_device, out_report);
+}
+
+void moss__wait_engine_idle (void) { vkDeviceWaitIdle (g_engine.device); }
+
+/*=============================================================================
+    INTERNAL CALLBACK FUNCTIONS IMPLENTATION
+  =============================================================================*/
+
+static void
+moss__window_resize_callback (StuffyWindow *const window, StuffyWindowRect rect)
+{
+  (void)(window);
+  (void)(rect);
+
+  g_engine.framebuffer_resize_requsted = true;
+}
+
+/*=============================================================================
+    INTERNAL FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+inline static MossResult moss__create_api_instance (const MossAppInfo *const app_info)
+{
+  // Set up validation layers
+#ifdef NDEBUG
+  const bool enable_validation_layers = false;
+  const bool enable_debug_utils       = false;
+#else
+  const bool enable_validation_layers = true;
+  const bool enable_debug_utils       = true;
+#endif
+
+  uint32_t           validation_layer_count = 0;
+  const char *const *validation_layer_names = NULL;
+
+  if (enable_validation_layers)
+  {
+    if (moss__check_vk_validation_layer_support ( ))
+    {
+      const Moss__VkValidationLayers validation_layers =
+        moss__get_vk_validation_layers ( );
+      validation_layer_count = validation_layers.count;
+      validation_layer_names = validation_layers.names;
+    }
+    else {
+      moss__warning (
+        "Validation layers are enabled but not supported. Disabling validation layers."
+      );
+    }
+  }
+
+  // Set up other required info
+  const VkApplicationInfo          vk_app_info = moss__create_vk_app_info (app_info);
+  const Moss__VkInstanceExtensions extensions =
+    moss__get_required_vk_instance_extensions ( );
+
+  // Debug utils are only present when a debugger or profiler provides them
+  const char *extension_names[ extensions.count + 1 ];
+  memcpy (
+    extension_names,
+    extensions.names,
+    extensions.count * sizeof (*extension_names)
+  );
+
+  uint32_t extension_count = (uint32_t)extensions.count;
+  if (enable_debug_utils && moss__check_vk_debug_utils_support ( ))
+  {
+    extension_names[ extension_count++ ] = VK_EXT_DEBUG_UTILS_EXTENSION_NAME;
+  }
+
+  // Make instance create info
+  const VkInstanceCreateInfo instance_create_info = {
+    .sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+    .pApplicationInfo        = &vk_app_info,
+    .ppEnabledExtensionNames = extension_names,
+    .enabledExtensionCount   = extension_count,
+    .enabledLayerCount       = validation_layer_count,
+    .ppEnabledLayerNames     = validation_layer_names,
+    .flags                   = moss__get_required_vk_instance_flags ( ),
+  };
+
+  const VkResult result =
+    vkCreateInstance (&instance_create_info, NULL, &g_engine.api_instance);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create Vulkan instance. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (extension_count > extensions.count)
+  {
+    moss__load_debug_utils (g_engine.api_instance);
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__init_stuffy_app (void)
+{
+  if (stuffy_app_init ( ) != 0)
+  {
+    moss__error ("Failed to initialize stuffy app.\n");
+    return MOSS_RESULT_ERROR;
+  }
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__deinit_stuffy_app (void) { stuffy_app_deinit ( ); }
+
+inline static StuffyWindowConfig
+moss__create_stuffy_window_config (const MossWindowConfig *const window_config)
+{
+  const StuffyWindowRect window_rect = {
+    .x      = 128,
+    .y      = 128,
+    .width  = window_config->width,
+    .height = window_config->height,
+  };
+
+  const StuffyWindowConfig result_config = {
+    .rect       = window_rect,
+    .title      = window_config->title,
+    .style_mask = STUFFY_WINDOW_STYLE_TITLED_BIT | STUFFY_WINDOW_STYLE_CLOSABLE_BIT |
+                  STUFFY_WINDOW_STYLE_RESIZABLE_BIT | STUFFY_WINDOW_STYLE_ICONIFIABLE_BIT,
+  };
+
+  return result_config;
+}
+
+inline static MossResult moss__open_window (const MossWindowConfig *window_config)
+{
+  const StuffyWindowConfig stuffy_window_config =
+    moss__create_stuffy_window_config (window_config);
+
+  g_engine.window = stuffy_window_open (&stuffy_window_config);
+  if (g_engine.window == NULL)
+  {
+    moss__error ("Failed to create window.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  stuffy_window_set_resize_callback (g_engine.window, moss__window_resize_callback);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_surface (void)
+{
+  const StuffyVkSurfaceCreateInfo create_info = {
+    .window    = g_engine.window,
+    .instance  = g_engine.api_instance,
+    .allocator = NULL,
+  };
+
+  const VkResult result = stuffy_vk_create_surface (&create_info, &g_engine.surface);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create window surface. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_logical_device (void)
+{
+  const Moss__VkPhysicalDeviceExtensions required_extensions =
+    moss__get_required_vk_device_extensions ( );
+
+  // Push descriptors are optional, descriptor cache falls back to cached sets
+  const char *extension_names[ required_extensions.count + 1 ];
+  uint32_t    extension_count = 0;
+
+  for (uint32_t i = 0; i < required_extensions.count; ++i)
+  {
+    extension_names[ extension_count++ ] = required_extensions.names[ i ];
+  }
+
+  g_engine.is_push_descriptor_supported = moss__check_optional_device_extension_support (
+    g_engine.physical_device,
+    VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME
+  );
+  if (g_engine.is_push_descriptor_supported)
+  {
+    extension_names[ extension_count++ ] = VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME;
+  }
+
+  uint32_t                queue_create_info_count = 0;
+  VkDeviceQueueCreateInfo queue_create_infos[ 4 ];
+  const float             queue_priority = 1.0F;
+
+  // Add graphics queue create info
+  {
+    const VkDeviceQueueCreateInfo create_info = {
+      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+      .queueFamilyIndex = g_engine.queue_family_indices.graphics_family,
+      .queueCount       = 1,
+      .pQueuePriorities = &queue_priority,
+    };
+    queue_create_infos[ queue_create_info_count++ ] = create_info;
+  }
+
+  // Add present queue create info
+  if (g_engine.queue_family_indices.graphics_family !=
+      g_engine.queue_family_indices.present_family)
+  {
+    const VkDeviceQueueCreateInfo create_info = {
+      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+      .queueFamilyIndex = g_engine.queue_family_indices.present_family,
+      .queueCount       = 1,
+      .pQueuePriorities = &queue_priority,
+    };
+    queue_create_infos[ queue_create_info_count++ ] = create_info;
+  }
+
+  // Add transfer queue create info
+  if (g_engine.queue_family_indices.graphics_family !=
+      g_engine.queue_family_indices.transfer_family)
+  {
+    const VkDeviceQueueCreateInfo create_info = {
+      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+      .queueFamilyIndex = g_engine.queue_family_indices.transfer_family,
+      .queueCount       = 1,
+      .pQueuePriorities = &queue_priority,
+    };
+    queue_create_infos[ queue_create_info_count++ ] = create_info;
+  }
+
+  // Add compute queue create info, unless its family already got a queue
+  bool is_compute_family_unique = true;
+  for (uint32_t i = 0; i < queue_create_info_count; ++i)
+  {
+    if (queue_create_infos[ i ].queueFamilyIndex ==
+        g_engine.queue_family_indices.compute_family)
+    {
+      is_compute_family_unique = false;
+    }
+  }
+
+  if (is_compute_family_unique)
+  {
+    const VkDeviceQueueCreateInfo create_info = {
+      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+      .queueFamilyIndex = g_engine.queue_family_indices.compute_family,
+      .queueCount       = 1,
+      .pQueuePriorities = &queue_priority,
+    };
+    queue_create_infos[ queue_create_info_count++ ] = create_info;
+  }
+
+  VkPhysicalDeviceFeatures supported_features;
+  vkGetPhysicalDeviceFeatures (g_engine.physical_device, &supported_features);
+
+  // Fragment stores are optional, virtual textures need them for tile feedback
+  g_engine.is_fragment_store_supported =
+    supported_features.fragmentStoresAndAtomics == VK_TRUE;
+
+  VkPhysicalDeviceFeatures device_features = { 0 };
+  device_features.fragmentStoresAndAtomics = supported_features.fragmentStoresAndAtomics;
+
+  // Ycbcr conversion is core since Vulkan 1.1 but still optional, videos need it
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties (g_engine.physical_device, &properties);
+
+  VkPhysicalDeviceSamplerYcbcrConversionFeatures ycbcr_features = {
+    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SAMPLER_YCBCR_CONVERSION_FEATURES,
+  };
+
+  if (properties.apiVersion >= VK_API_VERSION_1_1)
+  {
+    VkPhysicalDeviceFeatures2 features = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+      .pNext = &ycbcr_features,
+    };
+    vkGetPhysicalDeviceFeatures2 (g_engine.physical_device, &features);
+  }
+
+  g_engine.is_ycbcr_conversion_supported =
+    ycbcr_features.samplerYcbcrConversion == VK_TRUE;
+
+  const VkDeviceCreateInfo create_info = {
+    .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+    .pNext                   = g_engine.is_ycbcr_conversion_supported
+                               ? &ycbcr_features
+                               : NULL,
+    .queueCreateInfoCount    = queue_create_info_count,
+    .pQueueCreateInfos       = queue_create_infos,
+    .enabledExtensionCount   = extension_count,
+    .ppEnabledExtensionNames = extension_names,
+    .pEnabledFeatures        = &device_features,
+  };
+
+  const VkResult result =
+    vkCreateDevice (g_engine.physical_device, &create_info, NULL, &g_engine.device);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create logical device. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__init_buffer_sharing_mode (void)
+{
+  if (g_engine.queue_family_indices.graphics_family ==
+      g_engine.queue_family_indices.transfer_family)
+  {
+    g_engine.buffer_sharing_mode             = VK_SHARING_MODE_EXCLUSIVE;
+    g_engine.shared_queue_family_index_count = 0;
+  }
+  else {
+    g_engine.buffer_sharing_mode = VK_SHARING_MODE_CONCURRENT;
+    g_engine.shared_queue_family_indices[ 0 ] =
+      g_engine.queue_family_indices.graphics_family;
+    g_engine.shared_queue_family_indices[ 1 ] =
+      g_engine.queue_family_indices.transfer_family;
+    g_engine.shared_queue_family_index_count = 2;
+  }
+
+  if (g_engine.queue_family_indices.graphics_family ==
+      g_engine.queue_family_indices.compute_family)
+  {
+    g_engine.compute_sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE;
+    g_engine.compute_shared_queue_family_index_count = 0;
+  }
+  else {
+    g_engine.compute_sharing_mode = VK_SHARING_MODE_CONCURRENT;
+    g_engine.compute_shared_queue_family_indices[ 0 ] =
+      g_engine.queue_family_indices.graphics_family;
+    g_engine.compute_shared_queue_family_indices[ 1 ] =
+      g_engine.queue_family_indices.compute_family;
+    g_engine.compute_shared_queue_family_index_count = 2;
+  }
+}
+
+inline static MossResult
+moss__create_swapchain (const uint32_t width, const uint32_t height)
+{
+  const Moss__SwapChainSupportDetails swapchain_support =
+    moss__query_swapchain_support (g_engine.physical_device, g_engine.surface);
+
+  const VkSurfaceFormatKHR surface_format = moss__choose_swap_surface_format (
+    swapchain_support.formats,
+    swapchain_support.format_count
+  );
+  const VkPresentModeKHR present_mode = moss__choose_swap_present_mode (
+    swapchain_support.present_modes,
+    swapchain_support.present_mode_count
+  );
+  const VkExtent2D extent =
+    moss__choose_swap_extent (&swapchain_support.capabilities, width, height);
+
+  VkSwapchainCreateInfoKHR create_info = {
+    .sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+    .surface          = g_engine.surface,
+    .minImageCount    = swapchain_support.capabilities.minImageCount,
+    .imageFormat      = surface_format.format,
+    .imageColorSpace  = surface_format.colorSpace,
+    .imageExtent      = extent,
+    .imageArrayLayers = 1,
+    .imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+    .preTransform     = swapchain_support.capabilities.currentTransform,
+    .compositeAlpha   = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+    .presentMode      = present_mode,
+    .clipped          = VK_TRUE,
+    .oldSwapchain     = VK_NULL_HANDLE,
+  };
+
+  uint32_t queue_family_indices[] = {
+    g_engine.queue_family_indices.graphics_family,
+    g_engine.queue_family_indices.present_family,
+  };
+
+  if (g_engine.queue_family_indices.graphics_family !=
+      g_engine.queue_family_indices.present_family)
+  {
+    create_info.imageSharingMode      = VK_SHARING_MODE_CONCURRENT;
+    create_info.queueFamilyIndexCount = 2;
+    create_info.pQueueFamilyIndices   = queue_family_indices;
+  }
+  else {
+    create_info.imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE;
+    create_info.queueFamilyIndexCount = 0;
+    create_info.pQueueFamilyIndices   = NULL;
+  }
+
+  const VkResult result =
+    vkCreateSwapchainKHR (g_engine.device, &create_info, NULL, &g_engine.swapchain);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create swap chain. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  vkGetSwapchainImagesKHR (
+    g_engine.device,
+    g_engine.swapchain,
+    &g_engine.swapchain_image_count,
+    NULL
+  );
+
+  if (g_engine.swapchain_image_count > MAX_SWAPCHAIN_IMAGE_COUNT)
+  {
+    moss__error (
+      "Real swapchain image count is bigger than expected. (%d > %d)",
+      g_engine.swapchain_image_count,
+      MAX_SWAPCHAIN_IMAGE_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  vkGetSwapchainImagesKHR (
+    g_engine.device,
+    g_engine.swapchain,
+    &g_engine.swapchain_image_count,
+    g_engine.swapchain_images
+  );
+
+  g_engine.swapchain_image_format = surface_format.format;
+  g_engine.swapchain_extent       = extent;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_image_views (void)
+{
+  for (uint32_t i = 0; i < g_engine.swapchain_image_count; ++i)
+  {
+    const VkImageViewCreateInfo create_info = {
+      .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+      .image    = g_engine.swapchain_images[ i ],
+      .viewType = VK_IMAGE_VIEW_TYPE_2D,
+      .format   = g_engine.swapchain_image_format,
+      .components =
+        {
+                     .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                     .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                     .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                     .a = VK_COMPONENT_SWIZZLE_IDENTITY,
+                     },
+      .subresourceRange = {
+                     .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                     .baseMipLevel   = 0,
+                     .levelCount     = 1,
+                     .baseArrayLayer = 0,
+                     .layerCount     = 1,
+                     },
+    };
+
+    if (vkCreateImageView (
+          g_engine.device,
+          &create_info,
+          NULL,
+          &g_engine.swapchain_image_views[ i ]
+        ) != VK_SUCCESS)
+    {
+      moss__error ("Failed to create image view %u.\n", i);
+      for (uint32_t j = 0; j < i; ++j)
+      {
+        vkDestroyImageView (g_engine.device, g_engine.swapchain_image_views[ j ], NULL);
+      }
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_render_pass (void)
+{
+  const VkAttachmentDescription color_attachment = {
+    .format         = g_engine.swapchain_image_format,
+    .samples        = VK_SAMPLE_COUNT_1_BIT,
+    .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+    .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+    .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+    .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+    .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+    .finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+  };
+
+  const VkAttachmentReference color_attachment_ref = {
+    .attachment = 0,
+    .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+  };
+
+  const VkSubpassDescription subpass = {
+    .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    .colorAttachmentCount = 1,
+    .pColorAttachments    = &color_attachment_ref,
+  };
+
+  const VkSubpassDependency dependency = {
+    .srcSubpass    = VK_SUBPASS_EXTERNAL,
+    .dstSubpass    = 0,
+    .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    .srcAccessMask = 0,
+    .dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+  };
+
+  const VkRenderPassCreateInfo render_pass_info = {
+    .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+    .attachmentCount = 1,
+    .pAttachments    = &color_attachment,
+    .subpassCount    = 1,
+    .pSubpasses      = &subpass,
+    .dependencyCount = 1,
+    .pDependencies   = &dependency,
+  };
+
+  const VkResult result =
+    vkCreateRenderPass (g_engine.device, &render_pass_info, NULL, &g_engine.render_pass);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create render pass. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    g_engine.device,
+    VK_OBJECT_TYPE_RENDER_PASS,
+    g_engine.render_pass,
+    "present render pass"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static VkPipelineVertexInputStateCreateInfo
+moss__create_vk_pipeline_vertex_input_state_info (void)
+{
+  const Moss__VkVertexInputBindingDescriptionPack binding_descriptions_pack =
+    moss__get_vk_vertex_input_binding_description ( );
+
+  const Moss__VkVertexInputAttributeDescriptionPack attribute_descriptions_pack =
+    moss__get_vk_vertex_input_attribute_description ( );
+
+  const VkPipelineVertexInputStateCreateInfo info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+    .vertexBindingDescriptionCount   = binding_descriptions_pack.count,
+    .pVertexBindingDescriptions      = binding_descriptions_pack.descriptions,
+    .vertexAttributeDescriptionCount = attribute_descriptions_pack.count,
+    .pVertexAttributeDescriptions    = attribute_descriptions_pack.descriptions,
+  };
+
+  return info;
+}
+
+inline static MossResult moss__create_graphics_pipeline (void)
+{
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        g_engine.device,
+        MOSS__VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_shader_module_from_file (
+        g_engine.device,
+        MOSS__FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo vert_shader_stage_info = {
+    .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+    .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+    .module = vert_shader_module,
+    .pName  = "main",
+  };
+
+  const VkPipelineShaderStageCreateInfo frag_shader_stage_info = {
+    .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+    .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+    .module = frag_shader_module,
+    .pName  = "main",
+  };
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = { vert_shader_stage_info,
+                                                            frag_shader_stage_info };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info =
+    moss__create_vk_pipeline_vertex_input_state_info ( );
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_BACK_BIT,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  // Second attachment receives pick IDs when picking is enabled
+  const VkPipelineColorBlendAttachmentState color_blend_attachments[ 2 ] = {
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                       VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+     .blendEnable = VK_FALSE,
+     },
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT,
+     .blendEnable    = VK_FALSE,
+     },
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = g_engine.scene_target.color_attachment_count,
+    .pAttachments    = color_blend_attachments,
+  };
+
+  const VkPushConstantRange push_constant_ranges[] = {
+    {
+     .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .offset     = 0,
+     .size       = sizeof (Moss__LightShadingPushConstants),
+     },
+    {
+     .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+     .offset     = sizeof (Moss__LightShadingPushConstants),
+     .size       = sizeof (Moss__SpriteAnimationPushConstants),
+     },
+  };
+
+  const VkDescriptorSetLayout set_layouts[] = {
+    g_engine.light_culling.descriptor_set_layout,
+    g_engine.shadow_maps.descriptor_set_layout,
+    g_engine.sprite_animation.descriptor_set_layout,
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = sizeof (set_layouts) / sizeof (set_layouts[ 0 ]),
+    .pSetLayouts            = set_layouts,
+    .pushConstantRangeCount =
+      sizeof (push_constant_ranges) / sizeof (push_constant_ranges[ 0 ]),
+    .pPushConstantRanges = push_constant_ranges,
+  };
+
+  if (vkCreatePipelineLayout (
+        g_engine.device,
+        &pipeline_layout_info,
+        NULL,
+        &g_engine.pipeline_layout
+      ) != VK_SUCCESS)
+  {
+    moss__error ("Failed to create pipeline layout.\n");
+    vkDestroyShaderModule (g_engine.device, frag_shader_module, NULL);
+    vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
+    return VK_ERROR_INITIALIZATION_FAILED;
+  }
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = g_engine.pipeline_layout,
+    .renderPass          = g_engine.scene_target.render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  const VkResult result = vkCreateGraphicsPipelines (
+    g_engine.device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &g_engine.graphics_pipeline
+  );
+
+  vkDestroyShaderModule (g_engine.device, frag_shader_module, NULL);
+  vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create graphics pipeline. Error code: %d.\n", result);
+    vkDestroyPipelineLayout (g_engine.device, g_engine.pipeline_layout, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    g_engine.device,
+    VK_OBJECT_TYPE_PIPELINE,
+    g_engine.graphics_pipeline,
+    "sprite pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_framebuffers (void)
+{
+  for (uint32_t i = 0; i < g_engine.swapchain_image_count; ++i)
+  {
+    const VkImageView attachments[] = { g_engine.swapchain_image_views[ i ] };
+
+    const VkFramebufferCreateInfo framebuffer_info = {
+      .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+      .renderPass      = g_engine.render_pass,
+      .attachmentCount = 1,
+      .pAttachments    = attachments,
+      .width           = g_engine.swapchain_extent.width,
+      .height          = g_engine.swapchain_extent.height,
+      .layers          = 1,
+    };
+
+    if (vkCreateFramebuffer (
+          g_engine.device,
+          &framebuffer_info,
+          NULL,
+          &g_engine.swapchain_framebuffers[ i ]
+        ) != VK_SUCCESS)
+    {
+      moss__error ("Failed to create framebuffer %u.\n", i);
+      for (uint32_t j = 0; j < i; ++j)
+      {
+        vkDestroyFramebuffer (
+          g_engine.device,
+          g_engine.swapchain_framebuffers[ j ],
+          NULL
+        );
+      }
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_vertex_crate (void)
+{
+  const Moss__CrateCreateInfo create_info = {
+    .size  = sizeof (g_verticies),
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
+    .device                          = g_engine.device,
+    .physical_device                 = g_engine.physical_device,
+    .debug_name                      = "quad vertex crate",
+  };
+
+  const MossResult result = moss__create_crate (&create_info, &g_engine.vertex_crate);
+  if (result != MOSS_RESULT_SUCCESS) { moss__error ("Failed to create vertex crate.\n"); }
+
+  return result;
+}
+
+inline static MossResult moss__fill_vertex_crate (void)
+{
+  const Moss__FillCrateInfo fill_info = {
+    .destination_crate = &g_engine.vertex_crate,
+    .source_memory     = (void *)g_verticies,
+    .size              = sizeof (g_verticies),
+    .transfer_queue    = g_engine.transfer_queue,
+    .command_pool      = g_engine.transfer_command_pool,
+  };
+
+  return moss__fill_crate (&fill_info);
+}
+
+inline static MossResult moss__create_index_crate (void)
+{
+  const Moss__CrateCreateInfo create_info = {
+    .size  = sizeof (g_verticies),
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
+    .device                          = g_engine.device,
+    .physical_device                 = g_engine.physical_device,
+    .debug_name                      = "quad index crate",
+  };
+
+  const MossResult result = moss__create_crate (&create_info, &g_engine.index_crate);
+  if (result != MOSS_RESULT_SUCCESS) { moss__error ("Failed to create vertex crate.\n"); }
+
+  return result;
+}
+
+inline static MossResult moss__fill_index_crate (void)
+{
+  const Moss__FillCrateInfo fill_info = {
+    .destination_crate = &g_engine.index_crate,
+    .source_memory     = (void *)g_indices,
+    .size              = sizeof (g_indices),
+    .transfer_queue    = g_engine.transfer_queue,
+    .command_pool      = g_engine.transfer_command_pool,
+  };
+
+  return moss__fill_crate (&fill_info);
+}
+
+inline static MossResult moss__create_sprite_vertex_crates (void)
+{
+  const Moss__CrateCreateInfo create_info = {
+    .size = (VkDeviceSize)MOSS_MAX_SPRITE_COUNT * MOSS__SPRITE_VERTEX_COUNT *
+            sizeof (MossVertex),
+    .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+    .memory_properties =
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = g_engine.device,
+    .physical_device                 = g_engine.physical_device,
+    .debug_name                      = "sprite vertex crate",
+  };
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    Moss__Crate *const crate = &g_engine.sprite_vertex_crates[ i ];
+
+    if (moss__create_crate (&create_info, crate) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create sprite vertex crate.\n");
+      return MOSS_RESULT_ERROR;
+    }
+
+    void          *mapped_memory;
+    const VkResult result =
+      vkMapMemory (g_engine.device, crate->memory, 0, crate->size, 0, &mapped_memory);
+    if (result != VK_SUCCESS)
+    {
+      moss__error ("Failed to map sprite vertex crate. Error code: %d.\n", result);
+      return MOSS_RESULT_ERROR;
+    }
+
+    g_engine.sprite_vertices[ i ] = mapped_memory;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_sprite_index_crate (void)
+{
+  const uint32_t index_count = MOSS_MAX_SPRITE_COUNT * MOSS__SPRITE_INDEX_COUNT;
+
+  const Moss__CrateCreateInfo create_info = {
+    .size  = (VkDeviceSize)index_count * sizeof (uint32_t),
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
+    .device                          = g_engine.device,
+    .physical_device                 = g_engine.physical_device,
+    .debug_name                      = "sprite index crate",
+  };
+
+  if (moss__create_crate (&create_info, &g_engine.sprite_index_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create sprite index crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  uint32_t *const indices = malloc (create_info.size);
+  if (indices == NULL)
+  {
+    moss__error ("Failed to allocate memory for sprite indices.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  static const uint32_t quad_indices[ MOSS__SPRITE_INDEX_COUNT ] = { 0, 1, 2, 2, 3, 0 };
+  for (uint32_t i = 0; i < index_count; ++i)
+  {
+    const uint32_t sprite = i / MOSS__SPRITE_INDEX_COUNT;
+    const uint32_t corner = quad_indices[ i % MOSS__SPRITE_INDEX_COUNT ];
+    indices[ i ]          = sprite * MOSS__SPRITE_VERTEX_COUNT + corner;
+  }
+
+  const Moss__FillCrateInfo fill_info = {
+    .destination_crate = &g_engine.sprite_index_crate,
+    .source_memory     = indices,
+    .size              = create_info.size,
+    .transfer_queue    = g_engine.transfer_queue,
+    .command_pool      = g_engine.transfer_command_pool,
+  };
+
+  const MossResult result = moss__fill_crate (&fill_info);
+  free (indices);
+
+  return result;
+}
+
+inline static void moss__cleanup_sprite_crates (void)
+{
+  // Freeing crate memory unmaps it as well
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_crate (&g_engine.sprite_vertex_crates[ i ]);
+    g_engine.sprite_vertices[ i ] = NULL;
+  }
+
+  moss__destroy_crate (&g_engine.sprite_index_crate);
+
+  g_engine.sprite_count = 0;
+}
+
+inline static MossResult moss__create_sprite_sort (void)
+{
+  const Moss__GpuSortCreateInfo create_info = {
+    .physical_device                 = g_engine.physical_device,
+    .device                          = g_engine.device,
+    .max_count                       = MOSS_MAX_SPRITE_COUNT,
+    .sharing_mode                    = g_engine.compute_sharing_mode,
+    .shared_queue_family_index_count = g_engine.compute_shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.compute_shared_queue_family_indices,
+  };
+
+  if (moss__create_gpu_sort (&create_info, &g_engine.sprite_sort) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create sprite sort.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_gpu_sort_frame (
+          &g_engine.sprite_sort,
+          &create_info,
+          &g_engine.sprite_sort_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create sprite sort frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_sprite_sort (void)
+{
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_gpu_sort_frame (
+      &g_engine.sprite_sort,
+      &g_engine.sprite_sort_frames[ i ]
+    );
+  }
+
+  moss__destroy_gpu_sort (&g_engine.sprite_sort);
+
+  g_engine.is_sprite_sort_requested = false;
+}
+
+inline static MossResult moss__create_engine_sprite_animation (void)
+{
+  const Moss__SpriteAnimationCreateInfo create_info = {
+    .physical_device                 = g_engine.physical_device,
+    .device                          = g_engine.device,
+    .sharing_mode                    = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
+  };
+
+  if (moss__create_sprite_animation (&create_info, &g_engine.sprite_animation) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create sprite animation.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_sprite_animation_frame (
+          &g_engine.sprite_animation,
+          &create_info,
+          &g_engine.sprite_animation_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create sprite animation frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_engine_sprite_animation (void)
+{
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_sprite_animation_frame (
+      &g_engine.sprite_animation,
+      &g_engine.sprite_animation_frames[ i ]
+    );
+  }
+
+  moss__destroy_sprite_animation (&g_engine.sprite_animation);
+
+  g_engine.is_sprite_animation_requested = false;
+}
+
+inline static MossResult moss__create_engine_descriptor_cache (void)
+{
+  const Moss__DescriptorCacheCreateInfo create_info = {
+    .device                     = g_engine.device,
+    .is_push_descriptor_enabled = g_engine.is_push_descriptor_supported,
+  };
+
+  if (moss__create_descriptor_cache (&create_info, &g_engine.descriptor_cache) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create descriptor cache.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_descriptor_cache_frame (
+          &g_engine.descriptor_cache,
+          &g_engine.descriptor_cache_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create descriptor cache frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_engine_descriptor_cache (void)
+{
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_descriptor_cache_frame (
+      &g_engine.descriptor_cache,
+      &g_engine.descriptor_cache_frames[ i ]
+    );
+  }
+
+  moss__destroy_descriptor_cache (&g_engine.descriptor_cache);
+}
+
+inline static MossResult moss__create_engine_skinning (void)
+{
+  const Moss__SkinningCreateInfo create_info = {
+    .physical_device                  = g_engine.physical_device,
+    .device                           = g_engine.device,
+    .descriptor_cache                 = &g_engine.descriptor_cache,
+    .render_pass                      = g_engine.scene_target.render_pass,
+    .color_attachment_count           = g_engine.scene_target.color_attachment_count,
+    .light_descriptor_set_layout      = g_engine.light_culling.descriptor_set_layout,
+    .shadow_map_descriptor_set_layout = g_engine.shadow_maps.descriptor_set_layout,
+    .sharing_mode                     = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count  = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices      = g_engine.shared_queue_family_indices,
+  };
+
+  if (moss__create_skinning (&create_info, &g_engine.skinning) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create skinning.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_skinning_frame (
+          &g_engine.skinning,
+          &g_engine.skinning_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create skinning frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_engine_skinning (void)
+{
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_skinning_frame (&g_engine.skinning, &g_engine.skinning_frames[ i ]);
+  }
+
+  moss__destroy_skinning (&g_engine.skinning);
+}
+
+inline static MossResult moss__write_frame_sprites (
+  const Moss__SpriteSoA *const sprites,
+  const float *const           depth,
+  const uint32_t *const        animation_clip,
+  const float *const           animation_start_time
+)
+{
+  if (sprites->count == 0) { return MOSS_RESULT_SUCCESS; }
+
+  if (sprites->count > MOSS_MAX_SPRITE_COUNT - g_engine.sprite_count)
+  {
+    moss__error (
+      "Sprite batch of %u sprites doesn't fit into the frame, %u sprites are already "
+      "submitted.\n",
+      sprites->count,
+      g_engine.sprite_count
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  // The GPU may still read this frame's vertex crate from its previous submission
+  if (g_engine.sprite_count == 0)
+  {
+    vkWaitForFences (
+      g_engine.device,
+      1,
+      &g_engine.in_flight_fences[ g_engine.current_frame ],
+      VK_TRUE,
+      UINT64_MAX
+    );
+  }
+
+  MossVertex *const frame_vertices = g_engine.sprite_vertices[ g_engine.current_frame ];
+  moss__generate_sprite_vertices_parallel (
+    sprites,
+    frame_vertices + (size_t)g_engine.sprite_count * MOSS__SPRITE_VERTEX_COUNT
+  );
+
+  uint32_t *const frame_keys = g_engine.sprite_sort_frames[ g_engine.current_frame ].keys;
+
+  const uint32_t zero_depth_key = moss__make_back_to_front_sort_key (0.0F);
+
+  // Sprites submitted before the first depth batch are drawn at depth 0
+  if (depth != NULL && !g_engine.is_sprite_sort_requested)
+  {
+    for (uint32_t i = 0; i < g_engine.sprite_count; ++i)
+    {
+      frame_keys[ i ] = zero_depth_key;
+    }
+
+    g_engine.is_sprite_sort_requested = true;
+  }
+
+  if (g_engine.is_sprite_sort_requested)
+  {
+    for (uint32_t i = 0; i < sprites->count; ++i)
+    {
+      frame_keys[ g_engine.sprite_count + i ] =
+        depth != NULL ? moss__make_back_to_front_sort_key (depth[ i ]) : zero_depth_key;
+    }
+  }
+
+  Moss__GpuSpriteAnimation *const frame_animations =
+    g_engine.sprite_animation_frames[ g_engine.current_frame ].sprites;
+
+  // Sprites submitted before the first animated batch stay static
+  if (animation_clip != NULL && !g_engine.is_sprite_animation_requested)
+  {
+    for (uint32_t i = 0; i < g_engine.sprite_count; ++i)
+    {
+      frame_animations[ i ] = (Moss__GpuSpriteAnimation) {
+        .clip       = MOSS_ANIMATION_CLIP_NONE,
+        .start_time = 0.0F,
+      };
+    }
+
+    g_engine.is_sprite_animation_requested = true;
   }
 
-  // Add transfer queue create info
-  if (g_engine.queue_family_indices.graphics_family !=
-      g_engine.queue_family_indices.transfer_family)
+  if (g_engine.is_sprite_animation_requested)
   {
-    const VkDeviceQueueCreateInfo create_info = {
-      .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-      .queueFamilyIndex = g_engine.queue_family_indices.transfer_family,
-      .queueCount       = 1,
-      .pQueuePriorities = &queue_priority,
-    };
-    queue_create_infos[ queue_create_info_count++ ] = create_info;
-  }
+    const uint32_t clip_count = g_engine.sprite_animation.clip_count;
 
-  VkPhysicalDeviceFeatures device_features = { 0 };
+    for (uint32_t i = 0; i < sprites->count; ++i)
+    {
+      Moss__GpuSpriteAnimation *const animation =
+        &frame_animations[ g_engine.sprite_count + i ];
 
-  const VkDeviceCreateInfo create_info = {
-    .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-    .queueCreateInfoCount    = queue_create_info_count,
-    .pQueueCreateInfos       = queue_create_infos,
-    .enabledExtensionCount   = extensions.count,
-    .ppEnabledExtensionNames = extensions.names,
-    .pEnabledFeatures        = &device_features,
-  };
+      // Unknown clips would index past the uploaded clips, so they are drawn static
+      const bool is_animated = animation_clip != NULL && animation_clip[ i ] < clip_count;
 
-  const VkResult result =
-    vkCreateDevice (g_engine.physical_device, &create_info, NULL, &g_engine.device);
-  if (result != VK_SUCCESS)
-  {
-    moss__error ("Failed to create logical device. Error code: %d.\n", result);
-    return MOSS_RESULT_ERROR;
+      animation->clip = is_animated ? animation_clip[ i ] : MOSS_ANIMATION_CLIP_NONE;
+      animation->start_time = is_animated && animation_start_time != NULL
+                              ? animation_start_time[ i ]
+                              : 0.0F;
+    }
   }
 
+  g_engine.sprite_count += sprites->count;
+
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static void moss__init_buffer_sharing_mode (void)
+inline static bool moss__has_pending_engine_work (void)
 {
-  if (g_engine.queue_family_indices.graphics_family ==
-      g_engine.queue_family_indices.transfer_family)
+  if (g_engine.is_pick_requested) { return true; }
+
+  // Pick results and read completions are only collected when a frame begins
+  for (uint32_t i = 0; i < g_engine.pick_readback.frame_count; ++i)
   {
-    g_engine.buffer_sharing_mode             = VK_SHARING_MODE_EXCLUSIVE;
-    g_engine.shared_queue_family_index_count = 0;
-  }
-  else {
-    g_engine.buffer_sharing_mode = VK_SHARING_MODE_CONCURRENT;
-    g_engine.shared_queue_family_indices[ 0 ] =
-      g_engine.queue_family_indices.graphics_family;
-    g_engine.shared_queue_family_indices[ 1 ] =
-      g_engine.queue_family_indices.transfer_family;
-    g_engine.shared_queue_family_index_count = 2;
+    if (g_engine.pick_readback.is_frame_pending[ i ]) { return true; }
   }
+
+  if (g_engine.async_io.in_flight_count != 0) { return true; }
+
+  return moss__is_virtual_texture_streaming (&g_engine.virtual_texture);
 }
 
-inline static MossResult
-moss__create_swapchain (const uint32_t width, const uint32_t height)
+inline static MossResult moss__flush_draw_queue (void)
 {
-  const Moss__SwapChainSupportDetails swapchain_support =
-    moss__query_swapchain_support (g_engine.physical_device, g_engine.surface);
+  Moss__SpriteSoA sprites;
+  moss__merge_draw_queue (&g_engine.draw_queue, &sprites);
 
-  const VkSurfaceFormatKHR surface_format = moss__choose_swap_surface_format (
-    swapchain_support.formats,
-    swapchain_support.format_count
-  );
-  const VkPresentModeKHR present_mode = moss__choose_swap_present_mode (
-    swapchain_support.present_modes,
-    swapchain_support.present_mode_count
-  );
-  const VkExtent2D extent =
-    moss__choose_swap_extent (&swapchain_support.capabilities, width, height);
+  // Directly submitted sprites take room as well, keep the commands that still fit
+  const uint32_t free_sprite_count = MOSS_MAX_SPRITE_COUNT - g_engine.sprite_count;
+  if (sprites.count > free_sprite_count)
+  {
+    moss__error (
+      "Frame is full, %u queued draw commands are dropped.\n",
+      sprites.count - free_sprite_count
+    );
+    sprites.count = free_sprite_count;
+  }
 
-  VkSwapchainCreateInfoKHR create_info = {
-    .sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
-    .surface          = g_engine.surface,
-    .minImageCount    = swapchain_support.capabilities.minImageCount,
-    .imageFormat      = surface_format.format,
-    .imageColorSpace  = surface_format.colorSpace,
-    .imageExtent      = extent,
-    .imageArrayLayers = 1,
-    .imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-    .preTransform     = swapchain_support.capabilities.currentTransform,
-    .compositeAlpha   = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
-    .presentMode      = present_mode,
-    .clipped          = VK_TRUE,
-    .oldSwapchain     = VK_NULL_HANDLE,
-  };
+  return moss__write_frame_sprites (&sprites, NULL, NULL, NULL);
+}
 
-  uint32_t queue_family_indices[] = {
-    g_engine.queue_family_indices.graphics_family,
-    g_engine.queue_family_indices.present_family,
+inline static MossResult moss__create_lighting (void)
+{
+  const Moss__LightCullingCreateInfo create_info = {
+    .physical_device                 = g_engine.physical_device,
+    .device                          = g_engine.device,
+    .extent                          = g_engine.swapchain_extent,
+    .sharing_mode                    = g_engine.compute_sharing_mode,
+    .shared_queue_family_index_count = g_engine.compute_shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.compute_shared_queue_family_indices,
   };
 
-  if (g_engine.queue_family_indices.graphics_family !=
-      g_engine.queue_family_indices.present_family)
+  if (moss__create_light_culling (&create_info, &g_engine.light_culling) !=
+      MOSS_RESULT_SUCCESS)
   {
-    create_info.imageSharingMode      = VK_SHARING_MODE_CONCURRENT;
-    create_info.queueFamilyIndexCount = 2;
-    create_info.pQueueFamilyIndices   = queue_family_indices;
-  }
-  else {
-    create_info.imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE;
-    create_info.queueFamilyIndexCount = 0;
-    create_info.pQueueFamilyIndices   = NULL;
+    moss__error ("Failed to create light culling.\n");
+    return MOSS_RESULT_ERROR;
   }
 
-  const VkResult result =
-    vkCreateSwapchainKHR (g_engine.device, &create_info, NULL, &g_engine.swapchain);
-  if (result != VK_SUCCESS)
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
   {
-    moss__error ("Failed to create swap chain. Error code: %d.\n", result);
-    return MOSS_RESULT_ERROR;
+    if (moss__create_light_culling_frame (
+          &g_engine.light_culling,
+          &create_info,
+          &g_engine.light_culling_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create light culling frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
   }
 
-  vkGetSwapchainImagesKHR (
-    g_engine.device,
-    g_engine.swapchain,
-    &g_engine.swapchain_image_count,
-    NULL
-  );
+  const Moss__ShadowMapCreateInfo shadow_map_info = {
+    .physical_device                 = g_engine.physical_device,
+    .device                          = g_engine.device,
+    .light_descriptor_set_layout     = g_engine.light_culling.descriptor_set_layout,
+    .sharing_mode                    = g_engine.compute_sharing_mode,
+    .shared_queue_family_index_count = g_engine.compute_shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.compute_shared_queue_family_indices,
+  };
 
-  if (g_engine.swapchain_image_count > MAX_SWAPCHAIN_IMAGE_COUNT)
+  if (moss__create_shadow_maps (&shadow_map_info, &g_engine.shadow_maps) !=
+      MOSS_RESULT_SUCCESS)
   {
-    moss__error (
-      "Real swapchain image count is bigger than expected. (%d > %d)",
-      g_engine.swapchain_image_count,
-      MAX_SWAPCHAIN_IMAGE_COUNT
-    );
+    moss__error ("Failed to create shadow maps.\n");
     return MOSS_RESULT_ERROR;
   }
 
-  vkGetSwapchainImagesKHR (
-    g_engine.device,
-    g_engine.swapchain,
-    &g_engine.swapchain_image_count,
-    g_engine.swapchain_images
-  );
-
-  g_engine.swapchain_image_format = surface_format.format;
-  g_engine.swapchain_extent       = extent;
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_shadow_map_frame (
+          &g_engine.shadow_maps,
+          &shadow_map_info,
+          &g_engine.shadow_map_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create shadow map frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
 
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__create_image_views (void)
+inline static MossResult moss__resize_lighting (void)
 {
-  for (uint32_t i = 0; i < g_engine.swapchain_image_count; ++i)
-  {
-    const VkImageViewCreateInfo create_info = {
-      .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-      .image    = g_engine.swapchain_images[ i ],
-      .viewType = VK_IMAGE_VIEW_TYPE_2D,
-      .format   = g_engine.swapchain_image_format,
-      .components =
-        {
-                     .r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                     .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                     .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                     .a = VK_COMPONENT_SWIZZLE_IDENTITY,
-                     },
-      .subresourceRange = {
-                     .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-                     .baseMipLevel   = 0,
-                     .levelCount     = 1,
-                     .baseArrayLayer = 0,
-                     .layerCount     = 1,
-                     },
-    };
+  const Moss__LightCullingCreateInfo create_info = {
+    .physical_device                 = g_engine.physical_device,
+    .device                          = g_engine.device,
+    .extent                          = g_engine.swapchain_extent,
+    .sharing_mode                    = g_engine.compute_sharing_mode,
+    .shared_queue_family_index_count = g_engine.compute_shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.compute_shared_queue_family_indices,
+  };
 
-    if (vkCreateImageView (
-          g_engine.device,
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__resize_light_culling_frame (
+          &g_engine.light_culling,
           &create_info,
-          NULL,
-          &g_engine.swapchain_image_views[ i ]
-        ) != VK_SUCCESS)
+          &g_engine.light_culling_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
     {
-      moss__error ("Failed to create image view %u.\n", i);
-      for (uint32_t j = 0; j < i; ++j)
-      {
-        vkDestroyImageView (g_engine.device, g_engine.swapchain_image_views[ j ], NULL);
-      }
+      moss__error ("Failed to resize light tiles.\n");
       return MOSS_RESULT_ERROR;
     }
   }
@@ -1187,341 +3778,517 @@ inline static MossResult moss__create_image_views (void)
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__create_render_pass (void)
+inline static void moss__cleanup_lighting (void)
 {
-  const VkAttachmentDescription color_attachment = {
-    .format         = g_engine.swapchain_image_format,
-    .samples        = VK_SAMPLE_COUNT_1_BIT,
-    .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
-    .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
-    .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-    .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-    .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
-    .finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_shadow_map_frame (
+      &g_engine.shadow_maps,
+      &g_engine.shadow_map_frames[ i ]
+    );
+    moss__destroy_light_culling_frame (
+      &g_engine.light_culling,
+      &g_engine.light_culling_frames[ i ]
+    );
+  }
+
+  moss__destroy_shadow_maps (&g_engine.shadow_maps);
+  moss__destroy_light_culling (&g_engine.light_culling);
+
+  g_engine.light_count    = 0;
+  g_engine.occluder_count = 0;
+}
+
+inline static MossResult moss__create_dynamic_resolution (void)
+{
+  const Moss__SceneTargetCreateInfo target_info = {
+    .physical_device     = g_engine.physical_device,
+    .device              = g_engine.device,
+    .format              = g_engine.swapchain_image_format,
+    .extent              = g_engine.swapchain_extent,
+    .present_render_pass = g_engine.render_pass,
+    .is_picking_enabled  = g_engine.is_picking_enabled,
   };
 
-  const VkAttachmentReference color_attachment_ref = {
-    .attachment = 0,
-    .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+  if (moss__create_scene_target (&target_info, &g_engine.scene_target) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create scene target.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__GpuTimerCreateInfo timer_info = {
+    .physical_device    = g_engine.physical_device,
+    .device             = g_engine.device,
+    .queue_family_index = g_engine.queue_family_indices.graphics_family,
+    .frame_count        = MAX_FRAMES_IN_FLIGHT,
   };
 
-  const VkSubpassDescription subpass = {
-    .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
-    .colorAttachmentCount = 1,
-    .pColorAttachments    = &color_attachment_ref,
+  if (moss__create_gpu_timer (&timer_info, &g_engine.gpu_timer) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create GPU frame timer.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_dynamic_resolution (void)
+{
+  moss__destroy_gpu_timer (&g_engine.gpu_timer);
+  moss__destroy_scene_target (&g_engine.scene_target);
+}
+
+inline static MossResult moss__create_picking (void)
+{
+  if (!g_engine.is_picking_enabled) { return MOSS_RESULT_SUCCESS; }
+
+  const Moss__PickReadbackCreateInfo readback_info = {
+    .physical_device = g_engine.physical_device,
+    .device          = g_engine.device,
+    .frame_count     = MAX_FRAMES_IN_FLIGHT,
   };
 
-  const VkSubpassDependency dependency = {
-    .srcSubpass    = VK_SUBPASS_EXTERNAL,
-    .dstSubpass    = 0,
-    .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-    .srcAccessMask = 0,
-    .dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-    .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+  if (moss__create_pick_readback (&readback_info, &g_engine.pick_readback) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create pick readback.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__cleanup_picking (void)
+{
+  moss__destroy_pick_readback (&g_engine.pick_readback);
+
+  g_engine.is_pick_requested    = false;
+  g_engine.is_pick_result_ready = false;
+}
+
+inline static void moss__record_pick_request (
+  const VkCommandBuffer command_buffer,
+  const VkExtent2D      render_extent
+)
+{
+  if (!g_engine.is_pick_requested) { return; }
+
+  g_engine.is_pick_requested = false;
+
+  // The scene only covers the top left sub-rectangle at the current render scale
+  const float scale = g_engine.resolution_controller.render_scale;
+  float       x     = g_engine.pick_position[ 0 ] * scale;
+  float       y     = g_engine.pick_position[ 1 ] * scale;
+
+  if (x < 0.0F) { x = 0.0F; }
+  if (y < 0.0F) { y = 0.0F; }
+  if (x > (float)(render_extent.width - 1)) { x = (float)(render_extent.width - 1); }
+  if (y > (float)(render_extent.height - 1)) { y = (float)(render_extent.height - 1); }
+
+  const Moss__RecordPickInfo pick_info = {
+    .command_buffer = command_buffer,
+    .frame          = g_engine.current_frame,
+    .id_image       = g_engine.scene_target.id_image,
+    .texel          = { (int32_t)x, (int32_t)y },
+    .x              = g_engine.pick_position[ 0 ],
+    .y              = g_engine.pick_position[ 1 ],
   };
 
-  const VkRenderPassCreateInfo render_pass_info = {
-    .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-    .attachmentCount = 1,
-    .pAttachments    = &color_attachment,
-    .subpassCount    = 1,
-    .pSubpasses      = &subpass,
-    .dependencyCount = 1,
-    .pDependencies   = &dependency,
+  moss__record_pick (&g_engine.pick_readback, &pick_info);
+}
+
+inline static MossResult moss__create_engine_virtual_texture (void)
+{
+  const Moss__VirtualTextureCreateInfo create_info = {
+    .physical_device           = g_engine.physical_device,
+    .device                    = g_engine.device,
+    .is_fragment_store_enabled = g_engine.is_fragment_store_supported,
+    .descriptor_cache          = &g_engine.descriptor_cache,
+    .render_pass               = g_engine.scene_target.render_pass,
+    .color_attachment_count    = g_engine.scene_target.color_attachment_count,
+    .sharing_mode              = g_engine.buffer_sharing_mode,
+    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
+    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
   };
 
-  const VkResult result =
-    vkCreateRenderPass (g_engine.device, &render_pass_info, NULL, &g_engine.render_pass);
-  if (result != VK_SUCCESS)
+  if (moss__create_virtual_texture (&create_info, &g_engine.virtual_texture) !=
+      MOSS_RESULT_SUCCESS)
   {
-    moss__error ("Failed to create render pass. Error code: %d.\n", result);
+    moss__error ("Failed to create virtual texture.\n");
     return MOSS_RESULT_ERROR;
   }
 
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    if (moss__create_virtual_texture_frame (
+          &g_engine.virtual_texture,
+          &g_engine.virtual_texture_frames[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create virtual texture frame resources.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static VkPipelineVertexInputStateCreateInfo
-moss__create_vk_pipeline_vertex_input_state_info (void)
+inline static void moss__cleanup_engine_virtual_texture (void)
 {
-  const Moss__VkVertexInputBindingDescriptionPack binding_descriptions_pack =
-    moss__get_vk_vertex_input_binding_description ( );
+  moss__close_virtual_texture (&g_engine.virtual_texture, &g_engine.async_io);
 
-  const Moss__VkVertexInputAttributeDescriptionPack attribute_descriptions_pack =
-    moss__get_vk_vertex_input_attribute_description ( );
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__destroy_virtual_texture_frame (
+      &g_engine.virtual_texture,
+      &g_engine.virtual_texture_frames[ i ]
+    );
+  }
 
-  const VkPipelineVertexInputStateCreateInfo info = {
-    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-    .vertexBindingDescriptionCount   = binding_descriptions_pack.count,
-    .pVertexBindingDescriptions      = binding_descriptions_pack.descriptions,
-    .vertexAttributeDescriptionCount = attribute_descriptions_pack.count,
-    .pVertexAttributeDescriptions    = attribute_descriptions_pack.descriptions,
-  };
+  moss__destroy_virtual_texture (&g_engine.virtual_texture);
 
-  return info;
+  g_engine.is_virtual_texture_view_requested = false;
 }
 
-inline static MossResult moss__create_graphics_pipeline (void)
+inline static MossResult moss__create_engine_layer_cache (void)
 {
-  VkShaderModule vert_shader_module;
-  VkShaderModule frag_shader_module;
+  const Moss__LayerCacheCreateInfo create_info = {
+    .physical_device        = g_engine.physical_device,
+    .device                 = g_engine.device,
+    .format                 = g_engine.swapchain_image_format,
+    .extent                 = g_engine.swapchain_extent,
+    .descriptor_cache       = &g_engine.descriptor_cache,
+    .scene_render_pass      = g_engine.scene_target.render_pass,
+    .color_attachment_count = g_engine.scene_target.color_attachment_count,
+  };
 
-  if (moss__create_shader_module_from_file (
-        g_engine.device,
-        MOSS__VERT_SHADER_PATH,
-        &vert_shader_module
-      ) != VK_SUCCESS)
+  if (moss__create_layer_cache (&create_info, &g_engine.layer_cache) !=
+      MOSS_RESULT_SUCCESS)
   {
+    moss__error ("Failed to create layer cache.\n");
     return MOSS_RESULT_ERROR;
   }
 
-  if (moss__create_shader_module_from_file (
-        g_engine.device,
-        MOSS__FRAG_SHADER_PATH,
-        &frag_shader_module
-      ) != VK_SUCCESS)
-  {
-    vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
-    return MOSS_RESULT_ERROR;
-  }
+  return MOSS_RESULT_SUCCESS;
+}
 
-  const VkPipelineShaderStageCreateInfo vert_shader_stage_info = {
-    .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-    .stage  = VK_SHADER_STAGE_VERTEX_BIT,
-    .module = vert_shader_module,
-    .pName  = "main",
+inline static void moss__record_layer_passes (
+  const VkCommandBuffer                        command_buffer,
+  const VkExtent2D                             render_extent,
+  const VkDescriptorSet *const                 scene_sets,
+  const uint32_t                               scene_set_count,
+  const Moss__LightShadingPushConstants *const shading_constants
+)
+{
+  // Layers are static, so per-sprite animation state is ignored and lighting is
+  // baked until the layer is redrawn
+  const Moss__SpriteAnimationPushConstants animation_constants = {
+    .time        = g_engine.animation_time,
+    .is_animated = 0,
+    .is_pickable = 0,
   };
 
-  const VkPipelineShaderStageCreateInfo frag_shader_stage_info = {
-    .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-    .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
-    .module = frag_shader_module,
-    .pName  = "main",
+  const VkViewport viewport = {
+    .x        = 0.0F,
+    .y        = 0.0F,
+    .width    = (float)render_extent.width,
+    .height   = (float)render_extent.height,
+    .minDepth = 0.0F,
+    .maxDepth = 1.0F,
   };
 
-  const VkPipelineShaderStageCreateInfo shader_stages[] = { vert_shader_stage_info,
-                                                            frag_shader_stage_info };
+  const VkRect2D scissor = {
+    .offset = { 0, 0 },
+    .extent = render_extent,
+  };
 
-  const VkPipelineVertexInputStateCreateInfo vertex_input_info =
-    moss__create_vk_pipeline_vertex_input_state_info ( );
+  const VkDeviceSize vertex_buffer_offset = 0;
 
-  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
-    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
-    .primitiveRestartEnable = VK_FALSE,
-  };
+  for (uint32_t i = 0; i < MOSS_MAX_LAYER_COUNT; ++i)
+  {
+    if (!moss__begin_layer_pass (&g_engine.layer_cache, i, command_buffer, render_extent))
+    {
+      continue;
+    }
 
-  const VkPipelineViewportStateCreateInfo viewport_state = {
-    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-    .viewportCount = 1,
-    .pViewports    = NULL,  // Dynamic viewport
-    .scissorCount  = 1,
-    .pScissors     = NULL,  // Dynamic scissor
-  };
+    const Moss__Layer *const layer = &g_engine.layer_cache.layers[ i ];
 
-  const VkPipelineRasterizationStateCreateInfo rasterizer = {
-    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-    .depthClampEnable        = VK_FALSE,
-    .rasterizerDiscardEnable = VK_FALSE,
-    .polygonMode             = VK_POLYGON_MODE_FILL,
-    .lineWidth               = 1.0F,
-    .cullMode                = VK_CULL_MODE_BACK_BIT,
-    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
-    .depthBiasEnable         = VK_FALSE,
-  };
+    vkCmdBindPipeline (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_GRAPHICS,
+      g_engine.graphics_pipeline
+    );
 
-  const VkPipelineMultisampleStateCreateInfo multisampling = {
-    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-    .sampleShadingEnable  = VK_FALSE,
-    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-  };
+    vkCmdBindDescriptorSets (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_GRAPHICS,
+      g_engine.pipeline_layout,
+      0,
+      scene_set_count,
+      scene_sets,
+      0,
+      NULL
+    );
 
-  const VkPipelineColorBlendAttachmentState color_blend_attachment = {
-    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-                      VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
-    .blendEnable = VK_FALSE,
-  };
+    vkCmdPushConstants (
+      command_buffer,
+      g_engine.pipeline_layout,
+      VK_SHADER_STAGE_FRAGMENT_BIT,
+      0,
+      sizeof (*shading_constants),
+      shading_constants
+    );
 
-  const VkPipelineColorBlendStateCreateInfo color_blending = {
-    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-    .logicOpEnable   = VK_FALSE,
-    .attachmentCount = 1,
-    .pAttachments    = &color_blend_attachment,
-  };
+    vkCmdPushConstants (
+      command_buffer,
+      g_engine.pipeline_layout,
+      VK_SHADER_STAGE_VERTEX_BIT,
+      sizeof (Moss__LightShadingPushConstants),
+      sizeof (animation_constants),
+      &animation_constants
+    );
 
-  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
-    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-    .setLayoutCount         = 0,
-    .pSetLayouts            = NULL,
-    .pushConstantRangeCount = 0,
-    .pPushConstantRanges    = NULL,
-  };
+    vkCmdSetViewport (command_buffer, 0, 1, &viewport);
+    vkCmdSetScissor (command_buffer, 0, 1, &scissor);
 
-  if (vkCreatePipelineLayout (
-        g_engine.device,
-        &pipeline_layout_info,
-        NULL,
-        &g_engine.pipeline_layout
-      ) != VK_SUCCESS)
-  {
-    moss__error ("Failed to create pipeline layout.\n");
-    vkDestroyShaderModule (g_engine.device, frag_shader_module, NULL);
-    vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
-    return VK_ERROR_INITIALIZATION_FAILED;
-  }
+    vkCmdBindVertexBuffers (
+      command_buffer,
+      0,
+      1,
+      &layer->vertex_crate.buffer,
+      &vertex_buffer_offset
+    );
 
-  const VkDynamicState dynamic_states[] = {
-    VK_DYNAMIC_STATE_VIEWPORT,
-    VK_DYNAMIC_STATE_SCISSOR,
-  };
+    vkCmdBindIndexBuffer (
+      command_buffer,
+      g_engine.sprite_index_crate.buffer,
+      0,
+      VK_INDEX_TYPE_UINT32
+    );
 
-  const VkPipelineDynamicStateCreateInfo dynamic_state = {
-    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
-    .pDynamicStates    = dynamic_states,
-  };
+    vkCmdDrawIndexed (
+      command_buffer,
+      layer->sprite_count * MOSS__SPRITE_INDEX_COUNT,
+      1,
+      0,
+      0,
+      0
+    );
 
-  const VkGraphicsPipelineCreateInfo pipeline_info = {
-    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-    .stageCount          = 2,
-    .pStages             = shader_stages,
-    .pVertexInputState   = &vertex_input_info,
-    .pInputAssemblyState = &input_assembly,
-    .pViewportState      = &viewport_state,
-    .pRasterizationState = &rasterizer,
-    .pMultisampleState   = &multisampling,
-    .pColorBlendState    = &color_blending,
-    .pDynamicState       = &dynamic_state,
-    .layout              = g_engine.pipeline_layout,
-    .renderPass          = g_engine.render_pass,
-    .subpass             = 0,
-    .basePipelineHandle  = VK_NULL_HANDLE,
-    .basePipelineIndex   = -1,
+    moss__end_layer_pass (&g_engine.layer_cache, i, command_buffer, render_extent);
+  }
+}
+
+inline static void moss__create_engine_video_texture (void)
+{
+  const Moss__VideoTextureCreateInfo create_info = {
+    .physical_device             = g_engine.physical_device,
+    .device                      = g_engine.device,
+    .is_ycbcr_conversion_enabled = g_engine.is_ycbcr_conversion_supported,
+    .descriptor_cache            = &g_engine.descriptor_cache,
+    .render_pass                 = g_engine.scene_target.render_pass,
+    .color_attachment_count      = g_engine.scene_target.color_attachment_count,
   };
 
-  const VkResult result = vkCreateGraphicsPipelines (
-    g_engine.device,
-    VK_NULL_HANDLE,
-    1,
-    &pipeline_info,
-    NULL,
-    &g_engine.graphics_pipeline
-  );
+  moss__create_video_texture (&create_info, &g_engine.video_texture);
+}
 
-  vkDestroyShaderModule (g_engine.device, frag_shader_module, NULL);
-  vkDestroyShaderModule (g_engine.device, vert_shader_module, NULL);
+inline static void moss__cleanup_engine_video_texture (void)
+{
+  moss__close_video_texture (&g_engine.video_texture);
 
-  if (result != VK_SUCCESS)
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
   {
-    moss__error ("Failed to create graphics pipeline. Error code: %d.\n", result);
-    vkDestroyPipelineLayout (g_engine.device, g_engine.pipeline_layout, NULL);
-    return MOSS_RESULT_ERROR;
+    moss__destroy_video_texture_frame (&g_engine.video_texture_frames[ i ]);
   }
 
-  return MOSS_RESULT_SUCCESS;
+  g_engine.is_video_view_requested = false;
 }
 
-inline static MossResult moss__create_framebuffers (void)
+inline static MossResult moss__create_engine_offscreen_batch (void)
 {
-  for (uint32_t i = 0; i < g_engine.swapchain_image_count; ++i)
-  {
-    const VkImageView attachments[] = { g_engine.swapchain_image_views[ i ] };
-
-    const VkFramebufferCreateInfo framebuffer_info = {
-      .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-      .renderPass      = g_engine.render_pass,
-      .attachmentCount = 1,
-      .pAttachments    = attachments,
-      .width           = g_engine.swapchain_extent.width,
-      .height          = g_engine.swapchain_extent.height,
-      .layers          = 1,
-    };
+  const Moss__OffscreenBatchCreateInfo create_info = {
+    .physical_device        = g_engine.physical_device,
+    .device                 = g_engine.device,
+    .format                 = g_engine.swapchain_image_format,
+    .color_attachment_count = g_engine.scene_target.color_attachment_count,
+  };
 
-    if (vkCreateFramebuffer (
-          g_engine.device,
-          &framebuffer_info,
-          NULL,
-          &g_engine.swapchain_framebuffers[ i ]
-        ) != VK_SUCCESS)
-    {
-      moss__error ("Failed to create framebuffer %u.\n", i);
-      for (uint32_t j = 0; j < i; ++j)
-      {
-        vkDestroyFramebuffer (
-          g_engine.device,
-          g_engine.swapchain_framebuffers[ j ],
-          NULL
-        );
-      }
-      return MOSS_RESULT_ERROR;
-    }
+  if (moss__create_offscreen_batch (&create_info, &g_engine.offscreen_batch) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen batch.\n");
+    return MOSS_RESULT_ERROR;
   }
 
   return MOSS_RESULT_SUCCESS;
 }
 
-inline static MossResult moss__create_vertex_crate (void)
+inline static void moss__record_offscreen_batch (
+  const VkCommandBuffer           command_buffer,
+  const MossOffscreenBatch *const batch
+)
 {
-  const Moss__CrateCreateInfo create_info = {
-    .size  = sizeof (g_verticies),
-    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-    .sharing_mode                    = g_engine.buffer_sharing_mode,
-    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
-    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
-    .device                          = g_engine.device,
-    .physical_device                 = g_engine.physical_device,
+  const Moss__OffscreenGrid grid = moss__get_offscreen_grid (batch->width, batch->height);
+
+  const Moss__LightCullingFrame *const light_frame =
+    &g_engine.light_culling_frames[ g_engine.current_frame ];
+
+  // Sets are only bound to satisfy the layout, unlit static scenes read none of them
+  const VkDescriptorSet scene_sets[] = {
+    light_frame->descriptor_set,
+    g_engine.shadow_map_frames[ g_engine.current_frame ].descriptor_set,
+    g_engine.sprite_animation_frames[ g_engine.current_frame ].descriptor_set,
+  };
+
+  const Moss__LightShadingPushConstants shading_constants = {
+    .ambient        = { 1.0F, 1.0F, 1.0F, 1.0F },
+    .tile_count_x   = light_frame->tile_count_x,
+    .light_count    = 0,
+    .occluder_count = 0,
+    .render_scale   = 1.0F,
   };
 
-  const MossResult result = moss__create_crate (&create_info, &g_engine.vertex_crate);
-  if (result != MOSS_RESULT_SUCCESS) { moss__error ("Failed to create vertex crate.\n"); }
+  const Moss__SpriteAnimationPushConstants animation_constants = {
+    .time        = 0.0F,
+    .is_animated = 0,
+    .is_pickable = 0,
+  };
+
+  const VkDeviceSize vertex_buffer_offset = 0;
+
+  // Bound state carries over between passes of the command buffer
+  vkCmdBindPipeline (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    g_engine.graphics_pipeline
+  );
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    g_engine.pipeline_layout,
+    0,
+    sizeof (scene_sets) / sizeof (scene_sets[ 0 ]),
+    scene_sets,
+    0,
+    NULL
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    g_engine.pipeline_layout,
+    VK_SHADER_STAGE_FRAGMENT_BIT,
+    0,
+    sizeof (shading_constants),
+    &shading_constants
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    g_engine.pipeline_layout,
+    VK_SHADER_STAGE_VERTEX_BIT,
+    sizeof (Moss__LightShadingPushConstants),
+    sizeof (animation_constants),
+    &animation_constants
+  );
+
+  vkCmdBindVertexBuffers (
+    command_buffer,
+    0,
+    1,
+    &g_engine.offscreen_batch.vertex_crate.buffer,
+    &vertex_buffer_offset
+  );
+
+  vkCmdBindIndexBuffer (
+    command_buffer,
+    g_engine.sprite_index_crate.buffer,
+    0,
+    VK_INDEX_TYPE_UINT32
+  );
+
+  uint32_t first_sprite = 0;
 
-  return result;
-}
+  for (uint32_t first_scene = 0; first_scene < batch->scene_count;
+       first_scene += grid.scenes_per_pass)
+  {
+    uint32_t scene_count = batch->scene_count - first_scene;
+    if (scene_count > grid.scenes_per_pass) { scene_count = grid.scenes_per_pass; }
 
-inline static MossResult moss__fill_vertex_crate (void)
-{
-  const Moss__FillCrateInfo fill_info = {
-    .destination_crate = &g_engine.vertex_crate,
-    .source_memory     = (void *)g_verticies,
-    .size              = sizeof (g_verticies),
-    .transfer_queue    = g_engine.transfer_queue,
-    .command_pool      = g_engine.transfer_command_pool,
-  };
+    const uint32_t column_count =
+      scene_count < grid.column_count ? scene_count : grid.column_count;
+    const uint32_t row_count = (scene_count + grid.column_count - 1) / grid.column_count;
 
-  return moss__fill_crate (&fill_info);
-}
+    const VkExtent2D render_extent = {
+      .width  = column_count * batch->width,
+      .height = row_count * batch->height,
+    };
 
-inline static MossResult moss__create_index_crate (void)
-{
-  const Moss__CrateCreateInfo create_info = {
-    .size  = sizeof (g_verticies),
-    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-    .sharing_mode                    = g_engine.buffer_sharing_mode,
-    .shared_queue_family_index_count = g_engine.shared_queue_family_index_count,
-    .shared_queue_family_indices     = g_engine.shared_queue_family_indices,
-    .device                          = g_engine.device,
-    .physical_device                 = g_engine.physical_device,
-  };
+    moss__begin_offscreen_pass (&g_engine.offscreen_batch, command_buffer, render_extent);
 
-  const MossResult result = moss__create_crate (&create_info, &g_engine.index_crate);
-  if (result != MOSS_RESULT_SUCCESS) { moss__error ("Failed to create vertex crate.\n"); }
+    // A scene only costs a viewport change and a draw
+    for (uint32_t i = 0; i < scene_count; ++i)
+    {
+      const uint32_t sprite_count = batch->scenes[ first_scene + i ].count;
+      if (sprite_count == 0) { continue; }
+
+      const VkViewport viewport = {
+        .x        = (float)((i % grid.column_count) * batch->width),
+        .y        = (float)((i / grid.column_count) * batch->height),
+        .width    = (float)batch->width,
+        .height   = (float)batch->height,
+        .minDepth = 0.0F,
+        .maxDepth = 1.0F,
+      };
+
+      const VkRect2D scissor = {
+        .offset = { (int32_t)viewport.x, (int32_t)viewport.y },
+        .extent = { batch->width, batch->height },
+      };
+
+      vkCmdSetViewport (command_buffer, 0, 1, &viewport);
+      vkCmdSetScissor (command_buffer, 0, 1, &scissor);
+
+      vkCmdDrawIndexed (
+        command_buffer,
+        sprite_count * MOSS__SPRITE_INDEX_COUNT,
+        1,
+        0,
+        (int32_t)(first_sprite * MOSS__SPRITE_VERTEX_COUNT),
+        0
+      );
 
-  return result;
+      first_sprite += sprite_count;
+    }
+
+    vkCmdEndRenderPass (command_buffer);
+
+    moss__record_offscreen_readback (
+      &g_engine.offscreen_batch,
+      command_buffer,
+      &grid,
+      batch,
+      first_scene,
+      scene_count
+    );
+  }
 }
 
-inline static MossResult moss__fill_index_crate (void)
+inline static VkExtent2D moss__get_render_extent (void)
 {
-  const Moss__FillCrateInfo fill_info = {
-    .destination_crate = &g_engine.index_crate,
-    .source_memory     = (void *)g_indices,
-    .size              = sizeof (g_indices),
-    .transfer_queue    = g_engine.transfer_queue,
-    .command_pool      = g_engine.transfer_command_pool,
+  const float scale = g_engine.resolution_controller.render_scale;
+
+  VkExtent2D extent = {
+    .width  = (uint32_t)((float)g_engine.swapchain_extent.width * scale),
+    .height = (uint32_t)((float)g_engine.swapchain_extent.height * scale),
   };
 
-  return moss__fill_crate (&fill_info);
+  if (extent.width == 0) { extent.width = 1; }
+  if (extent.height == 0) { extent.height = 1; }
+
+  return extent;
 }
 
 inline static MossResult moss__create_general_command_buffers (void)
@@ -1544,9 +4311,70 @@ inline static MossResult moss__create_general_command_buffers (void)
     return MOSS_RESULT_ERROR;
   }
 
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__set_debug_name (
+      g_engine.device,
+      VK_OBJECT_TYPE_COMMAND_BUFFER,
+      g_engine.general_command_buffers[ i ],
+      "frame command buffer"
+    );
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_compute_command_buffers (void)
+{
+  const VkCommandBufferAllocateInfo alloc_info = {
+    .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    .commandPool        = g_engine.compute_command_pool,
+    .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .commandBufferCount = MAX_FRAMES_IN_FLIGHT,
+  };
+
+  const VkResult result = vkAllocateCommandBuffers (
+    g_engine.device,
+    &alloc_info,
+    g_engine.compute_command_buffers
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to allocate compute command buffers. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    moss__set_debug_name (
+      g_engine.device,
+      VK_OBJECT_TYPE_COMMAND_BUFFER,
+      g_engine.compute_command_buffers[ i ],
+      "frame compute command buffer"
+    );
+  }
+
   return MOSS_RESULT_SUCCESS;
 }
 
+inline static MossResult moss__init_engine_async_io (void)
+{
+  const Moss__AsyncIoCreateInfo create_info = {
+    .allow_io_uring = true,
+  };
+
+  const MossResult result = moss__init_async_io (&create_info, &g_engine.async_io);
+  if (result != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to initialize asynchronous file reader.\n");
+  }
+
+  return result;
+}
+
 inline static void
 moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_index)
 {
@@ -1560,22 +4388,134 @@ moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_inde
     return;
   }
 
-  const VkRenderPassBeginInfo render_pass_info = {
+  moss__record_gpu_timer_begin (
+    &g_engine.gpu_timer,
+    command_buffer,
+    g_engine.current_frame
+  );
+
+  const VkExtent2D render_extent = moss__get_render_extent ( );
+
+  moss__begin_debug_label (command_buffer, "Uploads");
+
+  moss__record_animation_clip_update (&g_engine.sprite_animation, command_buffer);
+
+  Moss__VirtualTextureFrame *const virtual_texture_frame =
+    &g_engine.virtual_texture_frames[ g_engine.current_frame ];
+  moss__record_virtual_texture_uploads (
+    &g_engine.virtual_texture,
+    virtual_texture_frame,
+    command_buffer
+  );
+
+  moss__record_video_upload (
+    &g_engine.video_texture,
+    &g_engine.video_texture_frames[ g_engine.current_frame ],
+    command_buffer
+  );
+
+  moss__end_debug_label (command_buffer);
+
+  const Moss__GpuSortFrame *const sort_frame =
+    &g_engine.sprite_sort_frames[ g_engine.current_frame ];
+  const Moss__LightCullingFrame *const light_frame =
+    &g_engine.light_culling_frames[ g_engine.current_frame ];
+  const Moss__ShadowMapFrame *const shadow_map_frame =
+    &g_engine.shadow_map_frames[ g_engine.current_frame ];
+
+  const VkDescriptorSet scene_sets[] = {
+    light_frame->descriptor_set,
+    shadow_map_frame->descriptor_set,
+    g_engine.sprite_animation_frames[ g_engine.current_frame ].descriptor_set,
+  };
+
+  Moss__LightShadingPushConstants shading_constants = {
+    .tile_count_x   = light_frame->tile_count_x,
+    .light_count    = g_engine.light_count,
+    .occluder_count = g_engine.occluder_count,
+    .render_scale   = g_engine.resolution_controller.render_scale,
+  };
+  memcpy (
+    shading_constants.ambient,
+    g_engine.ambient_light,
+    sizeof (shading_constants.ambient)
+  );
+
+  moss__begin_debug_label (command_buffer, "Layers");
+  moss__record_layer_passes (
+    command_buffer,
+    render_extent,
+    scene_sets,
+    sizeof (scene_sets) / sizeof (scene_sets[ 0 ]),
+    &shading_constants
+  );
+  moss__end_debug_label (command_buffer);
+
+  // Scene is drawn into the top left sub-rectangle of the offscreen target, pick
+  // IDs are cleared to 0 so empty pixels pick nothing
+  const VkRenderPassBeginInfo scene_pass_info = {
     .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-    .renderPass  = g_engine.render_pass,
-    .framebuffer = g_engine.swapchain_framebuffers[ image_index ],
+    .renderPass  = g_engine.scene_target.render_pass,
+    .framebuffer = g_engine.scene_target.framebuffer,
     .renderArea =
       {
                    .offset = {0, 0},
-                   .extent = g_engine.swapchain_extent,
+                   .extent = render_extent,
                    },
-    .clearValueCount = 1,
+    .clearValueCount = g_engine.scene_target.color_attachment_count,
     .pClearValues    = (const VkClearValue[]) {
                    {.color = {{0.0F, 0.0F, 0.0F, 1.0F}}},
+                   {.color = {.uint32 = {0, 0, 0, 0}}},
                    },
   };
 
-  vkCmdBeginRenderPass (command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+  moss__begin_debug_label (command_buffer, "Scene");
+  vkCmdBeginRenderPass (command_buffer, &scene_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+
+  // Virtual texture goes first, so everything else is drawn over it
+  const Moss__RecordVirtualTextureInfo virtual_texture_info = {
+    .command_buffer         = command_buffer,
+    .render_extent          = render_extent,
+    .view                   = g_engine.is_virtual_texture_view_requested
+                              ? &g_engine.virtual_texture_view
+                              : NULL,
+    .descriptor_cache       = &g_engine.descriptor_cache,
+    .descriptor_cache_frame = &g_engine.descriptor_cache_frames[ g_engine.current_frame ],
+  };
+  moss__begin_debug_label (command_buffer, "Virtual texture");
+  moss__record_virtual_texture (
+    &g_engine.virtual_texture,
+    virtual_texture_frame,
+    &virtual_texture_info
+  );
+  moss__end_debug_label (command_buffer);
+
+  // Video goes over the virtual texture
+  const Moss__RecordVideoInfo video_info = {
+    .command_buffer         = command_buffer,
+    .render_extent          = render_extent,
+    .view                   = g_engine.is_video_view_requested
+                              ? &g_engine.video_view
+                              : NULL,
+    .descriptor_cache       = &g_engine.descriptor_cache,
+    .descriptor_cache_frame = &g_engine.descriptor_cache_frames[ g_engine.current_frame ],
+  };
+  moss__begin_debug_label (command_buffer, "Video");
+  moss__record_video (&g_engine.video_texture, &video_info);
+  moss__end_debug_label (command_buffer);
+
+  // Cached layers go over them, beneath the frame's sprites
+  const Moss__RecordLayerCompositeInfo layer_composite_info = {
+    .command_buffer         = command_buffer,
+    .render_extent          = render_extent,
+    .descriptor_cache       = &g_engine.descriptor_cache,
+    .descriptor_cache_frame = &g_engine.descriptor_cache_frames[ g_engine.current_frame ],
+  };
+  moss__begin_debug_label (command_buffer, "Layer composite");
+  moss__record_layer_composite (&g_engine.layer_cache, &layer_composite_info);
+  moss__end_debug_label (command_buffer);
+
+  moss__begin_debug_label (command_buffer, "Sprites");
 
   vkCmdBindPipeline (
     command_buffer,
@@ -1583,18 +4523,54 @@ moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_inde
     g_engine.graphics_pipeline
   );
 
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    g_engine.pipeline_layout,
+    0,
+    sizeof (scene_sets) / sizeof (scene_sets[ 0 ]),
+    scene_sets,
+    0,
+    NULL
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    g_engine.pipeline_layout,
+    VK_SHADER_STAGE_FRAGMENT_BIT,
+    0,
+    sizeof (shading_constants),
+    &shading_constants
+  );
+
+  // The static quad has no per-sprite animation state and isn't a sprite to pick
+  Moss__SpriteAnimationPushConstants animation_constants = {
+    .time        = g_engine.animation_time,
+    .is_animated = 0,
+    .is_pickable = 0,
+  };
+
+  vkCmdPushConstants (
+    command_buffer,
+    g_engine.pipeline_layout,
+    VK_SHADER_STAGE_VERTEX_BIT,
+    sizeof (Moss__LightShadingPushConstants),
+    sizeof (animation_constants),
+    &animation_constants
+  );
+
   const VkViewport viewport = {
     .x        = 0.0F,
     .y        = 0.0F,
-    .width    = (float)g_engine.swapchain_extent.width,
-    .height   = (float)g_engine.swapchain_extent.height,
+    .width    = (float)render_extent.width,
+    .height   = (float)render_extent.height,
     .minDepth = 0.0F,
     .maxDepth = 1.0F,
   };
 
   const VkRect2D scissor = {
     .offset = { 0, 0 },
-    .extent = g_engine.swapchain_extent,
+    .extent = render_extent,
   };
 
   const VkBuffer     vertex_buffers[]        = { g_engine.vertex_crate.buffer };
@@ -1621,7 +4597,104 @@ moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_inde
     0
   );
 
+  if (g_engine.sprite_count > 0)
+  {
+    const VkBuffer sprite_vertex_buffers[] = {
+      g_engine.sprite_vertex_crates[ g_engine.current_frame ].buffer,
+    };
+
+    vkCmdBindVertexBuffers (
+      command_buffer,
+      0,
+      1,
+      sprite_vertex_buffers,
+      vertex_buffer_offsets
+    );
+
+    const VkBuffer sprite_index_buffer = g_engine.is_sprite_sort_requested
+                                         ? sort_frame->sorted_index_crate.buffer
+                                         : g_engine.sprite_index_crate.buffer;
+
+    vkCmdBindIndexBuffer (command_buffer, sprite_index_buffer, 0, VK_INDEX_TYPE_UINT32);
+
+    animation_constants.is_animated = g_engine.is_sprite_animation_requested ? 1 : 0;
+    animation_constants.is_pickable = 1;
+
+    vkCmdPushConstants (
+      command_buffer,
+      g_engine.pipeline_layout,
+      VK_SHADER_STAGE_VERTEX_BIT,
+      sizeof (Moss__LightShadingPushConstants),
+      sizeof (animation_constants),
+      &animation_constants
+    );
+
+    vkCmdDrawIndexed (
+      command_buffer,
+      g_engine.sprite_count * MOSS__SPRITE_INDEX_COUNT,
+      1,
+      0,
+      0,
+      0
+    );
+  }
+
+  moss__end_debug_label (command_buffer);
+
+  moss__begin_debug_label (command_buffer, "Skinned meshes");
+  moss__record_skinned_meshes (
+    &g_engine.skinning,
+    &g_engine.skinning_frames[ g_engine.current_frame ],
+    &g_engine.descriptor_cache,
+    &g_engine.descriptor_cache_frames[ g_engine.current_frame ],
+    command_buffer,
+    light_frame->descriptor_set,
+    shadow_map_frame->descriptor_set,
+    &shading_constants
+  );
+  moss__end_debug_label (command_buffer);
+
+  vkCmdEndRenderPass (command_buffer);
+  moss__end_debug_label (command_buffer);
+
+  moss__record_pick_request (command_buffer, render_extent);
+  moss__record_virtual_texture_feedback_barrier (virtual_texture_frame, command_buffer);
+
+  const VkRenderPassBeginInfo present_pass_info = {
+    .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+    .renderPass  = g_engine.render_pass,
+    .framebuffer = g_engine.swapchain_framebuffers[ image_index ],
+    .renderArea =
+      {
+                   .offset = {0, 0},
+                   .extent = g_engine.swapchain_extent,
+                   },
+    .clearValueCount = 1,
+    .pClearValues    = (const VkClearValue[]) {
+                   {.color = {{0.0F, 0.0F, 0.0F, 1.0F}}},
+                   },
+  };
+
+  moss__begin_debug_label (command_buffer, "Upscale");
+  vkCmdBeginRenderPass (command_buffer, &present_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+
+  // Sharpen harder the more detail the lower resolution loses
+  const float sharpness = (1.0F - g_engine.resolution_controller.render_scale) * 0.5F;
+  moss__record_scene_upscale (
+    &g_engine.scene_target,
+    command_buffer,
+    render_extent,
+    sharpness
+  );
+
   vkCmdEndRenderPass (command_buffer);
+  moss__end_debug_label (command_buffer);
+
+  moss__record_gpu_timer_end (
+    &g_engine.gpu_timer,
+    command_buffer,
+    g_engine.current_frame
+  );
 
   if (vkEndCommandBuffer (command_buffer) != VK_SUCCESS)
   {
@@ -1629,6 +4702,87 @@ moss__record_command_buffer (VkCommandBuffer command_buffer, uint32_t image_inde
   }
 }
 
+inline static void moss__reset_frame_submissions (void)
+{
+  g_engine.sprite_count                  = 0;
+  g_engine.is_sprite_sort_requested      = false;
+  g_engine.is_sprite_animation_requested = false;
+  g_engine.light_count                   = 0;
+  g_engine.occluder_count                = 0;
+
+  g_engine.is_virtual_texture_view_requested = false;
+  g_engine.is_video_view_requested           = false;
+
+  g_engine.skinning_frames[ g_engine.current_frame ].draw_count = 0;
+  g_engine.skinning_frames[ g_engine.current_frame ].bone_count = 0;
+}
+
+inline static bool moss__has_compute_work (void)
+{
+  return g_engine.is_sprite_sort_requested || g_engine.light_count > 0;
+}
+
+inline static void moss__record_compute_command_buffer (VkCommandBuffer command_buffer)
+{
+  const VkCommandBufferBeginInfo begin_info = {
+    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+  };
+
+  if (vkBeginCommandBuffer (command_buffer, &begin_info) != VK_SUCCESS)
+  {
+    moss__error ("Failed to begin recording compute command buffer.\n");
+    return;
+  }
+
+  // Passes don't read each other's results, so no barriers are needed between them
+  if (g_engine.is_sprite_sort_requested)
+  {
+    moss__begin_debug_label (command_buffer, "Sprite sort");
+    moss__record_gpu_sort (
+      &g_engine.sprite_sort,
+      &g_engine.sprite_sort_frames[ g_engine.current_frame ],
+      command_buffer,
+      g_engine.sprite_count
+    );
+    moss__end_debug_label (command_buffer);
+  }
+
+  const Moss__LightCullingFrame *const light_frame =
+    &g_engine.light_culling_frames[ g_engine.current_frame ];
+
+  if (g_engine.light_count > 0)
+  {
+    moss__begin_debug_label (command_buffer, "Light culling");
+    moss__record_light_culling (
+      &g_engine.light_culling,
+      light_frame,
+      command_buffer,
+      g_engine.light_count
+    );
+    moss__end_debug_label (command_buffer);
+  }
+
+  if (g_engine.light_count > 0 && g_engine.occluder_count > 0)
+  {
+    moss__begin_debug_label (command_buffer, "Shadow maps");
+    moss__record_shadow_maps (
+      &g_engine.shadow_maps,
+      &g_engine.shadow_map_frames[ g_engine.current_frame ],
+      light_frame->descriptor_set,
+      command_buffer,
+      g_engine.light_count,
+      g_engine.occluder_count
+    );
+    moss__end_debug_label (command_buffer);
+  }
+
+  if (vkEndCommandBuffer (command_buffer) != VK_SUCCESS)
+  {
+    moss__error ("Failed to record compute command buffer.\n");
+  }
+}
+
 inline static void moss__cleanup_swapchain_framebuffers (void)
 {
   for (uint32_t i = 0; i < g_engine.swapchain_image_count; ++i)
@@ -1696,6 +4850,17 @@ inline static MossResult moss__recreate_swapchain (uint32_t width, uint32_t heig
   }
   if (moss__create_image_views ( ) != MOSS_RESULT_SUCCESS) { return MOSS_RESULT_ERROR; }
   if (moss__create_framebuffers ( ) != MOSS_RESULT_SUCCESS) { return MOSS_RESULT_ERROR; }
+  if (moss__resize_scene_target (&g_engine.scene_target, g_engine.swapchain_extent) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+  if (moss__resize_lighting ( ) != MOSS_RESULT_SUCCESS) { return MOSS_RESULT_ERROR; }
+  if (moss__resize_layer_cache (&g_engine.layer_cache, g_engine.swapchain_extent) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
 
   return MOSS_RESULT_SUCCESS;
 }
@@ -1758,6 +4923,35 @@ inline static MossResult moss__create_render_finished_semaphores (void)
   return MOSS_RESULT_SUCCESS;
 }
 
+/*
+  @brief Creates compute finished semaphores.
+  @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
+*/
+inline static MossResult moss__create_compute_finished_semaphores (void)
+{
+  if (g_engine.device == VK_NULL_HANDLE) { return MOSS_RESULT_ERROR; }
+
+  const VkSemaphoreCreateInfo semaphore_info = {
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+  };
+
+  for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+  {
+    const VkResult result = vkCreateSemaphore (
+      g_engine.device,
+      &semaphore_info,
+      NULL,
+      &g_engine.compute_finished_semaphores[ i ]
+    );
+    if (result == VK_SUCCESS) { continue; }
+
+    moss__error ("Failed to create compute finished semaphore for frame %u.\n", i);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
 /*
   @brief Creates in-flight fences.
   @return Returns MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR otherwise.
@@ -1800,6 +4994,11 @@ inline static MossResult moss__create_synchronization_objects (void)
     return MOSS_RESULT_ERROR;
   }
 
+  if (moss__create_compute_finished_semaphores ( ) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
   if (moss__create_in_flight_fences ( ) != MOSS_RESULT_SUCCESS)
   {
     return MOSS_RESULT_ERROR;
@@ -1854,6 +5053,14 @@ inline static void moss__cleanup_render_finished_semaphores (void)
   moss__cleanup_semaphores (g_engine.render_finished_semaphores);
 }
 
+/*
+  @brief Cleans up compute finished semaphores.
+*/
+inline static void moss__cleanup_compute_finished_semaphores (void)
+{
+  moss__cleanup_semaphores (g_engine.compute_finished_semaphores);
+}
+
 /*
   @brief Cleans up in-flight fences.
 */
@@ -1868,6 +5075,7 @@ inline static void moss__cleanup_in_flight_fences (void)
 inline static void moss__cleanup_synchronization_objects (void)
 {
   moss__cleanup_in_flight_fences ( );
+  moss__cleanup_compute_finished_semaphores ( );
   moss__cleanup_render_finished_semaphores ( );
   moss__cleanup_image_available_semaphores ( );
 }
@@ -0,0 +1,601 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/gpu_sort.c
+  @brief GPU radix sort of sprites implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/gpu_sort.h"
+#include "src/internal/log.h"
+#include "src/internal/shaders.h"
+#include "src/internal/vk_shader_utils.h"
+
+/* Number of storage buffer bindings used by sort shaders. */
+#define MOSS__GPU_SORT_BINDING_COUNT (uint32_t)(6)
+
+/*
+  @brief Push constants of sort shaders.
+*/
+typedef struct
+{
+  uint32_t count;       /* Number of keys. */
+  uint32_t shift;       /* Shift of the pass digit. */
+  uint32_t block_count; /* Number of sort blocks. */
+  uint32_t pass_index;  /* Pass index. */
+} Moss__GpuSortPushConstants;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates compute pipeline out of a SPIR-V file.
+  @param sort Sort with pipeline layout created.
+  @param shader_path Path to the compute shader SPIR-V file.
+  @param out_pipeline Output pipeline.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_gpu_sort_pipeline (
+  const Moss__GpuSort *sort,
+  const char          *shader_path,
+  VkPipeline          *out_pipeline
+);
+
+/*
+  @brief Creates device local storage crate.
+  @param info Sort creation information.
+  @param size Crate size.
+  @param usage Extra usage flags.
+  @param memory_properties Memory properties.
+  @param out_crate Output crate.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_gpu_sort_crate (
+  const Moss__GpuSortCreateInfo *info,
+  VkDeviceSize                   size,
+  VkBufferUsageFlags             usage,
+  VkMemoryPropertyFlags          memory_properties,
+  Moss__Crate                   *out_crate
+);
+
+/*
+  @brief Records a barrier that makes compute writes visible to later commands.
+  @param command_buffer Command buffer to record to.
+  @param destination_stage Stage that consumes the writes.
+  @param destination_access Access that consumes the writes.
+*/
+inline static void moss__record_gpu_sort_barrier (
+  VkCommandBuffer      command_buffer,
+  VkPipelineStageFlags destination_stage,
+  VkAccessFlags        destination_access
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_gpu_sort (
+  const Moss__GpuSortCreateInfo *const info,
+  Moss__GpuSort *const                 out_sort
+)
+{
+  *out_sort        = (Moss__GpuSort) {0};
+  out_sort->device = info->device;
+
+  VkDescriptorSetLayoutBinding bindings[ MOSS__GPU_SORT_BINDING_COUNT ];
+  for (uint32_t i = 0; i < MOSS__GPU_SORT_BINDING_COUNT; ++i)
+  {
+    bindings[ i ] = (VkDescriptorSetLayoutBinding) {
+      .binding         = i,
+      .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1,
+      .stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT,
+    };
+  }
+
+  const VkDescriptorSetLayoutCreateInfo set_layout_info = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .bindingCount = MOSS__GPU_SORT_BINDING_COUNT,
+    .pBindings    = bindings,
+  };
+
+  VkResult result = vkCreateDescriptorSetLayout (
+    info->device,
+    &set_layout_info,
+    NULL,
+    &out_sort->descriptor_set_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create sort descriptor set layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_gpu_sort (out_sort);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__GpuSortPushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &out_sort->descriptor_set_layout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  result = vkCreatePipelineLayout (
+    info->device,
+    &pipeline_layout_info,
+    NULL,
+    &out_sort->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create sort pipeline layout. Error code: %d.\n", result);
+    moss__destroy_gpu_sort (out_sort);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_gpu_sort_pipeline (
+        out_sort,
+        MOSS__RADIX_SORT_HISTOGRAM_SHADER_PATH,
+        &out_sort->histogram_pipeline
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_pipeline (
+        out_sort,
+        MOSS__RADIX_SORT_SCAN_SHADER_PATH,
+        &out_sort->scan_pipeline
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_pipeline (
+        out_sort,
+        MOSS__RADIX_SORT_SCATTER_SHADER_PATH,
+        &out_sort->scatter_pipeline
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_pipeline (
+        out_sort,
+        MOSS__RADIX_SORT_INDICES_SHADER_PATH,
+        &out_sort->indices_pipeline
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_gpu_sort (out_sort);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_gpu_sort (Moss__GpuSort *const sort)
+{
+  if (sort->device == VK_NULL_HANDLE) { return; }
+
+  const VkPipeline pipelines[] = {
+    sort->histogram_pipeline,
+    sort->scan_pipeline,
+    sort->scatter_pipeline,
+    sort->indices_pipeline,
+  };
+
+  for (uint32_t i = 0; i < sizeof (pipelines) / sizeof (pipelines[ 0 ]); ++i)
+  {
+    if (pipelines[ i ] != VK_NULL_HANDLE)
+    {
+      vkDestroyPipeline (sort->device, pipelines[ i ], NULL);
+    }
+  }
+
+  if (sort->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (sort->device, sort->pipeline_layout, NULL);
+  }
+
+  if (sort->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (sort->device, sort->descriptor_set_layout, NULL);
+  }
+
+  *sort = (Moss__GpuSort) {0};
+}
+
+MossResult moss__create_gpu_sort_frame (
+  const Moss__GpuSort *const           sort,
+  const Moss__GpuSortCreateInfo *const info,
+  Moss__GpuSortFrame *const            out_frame
+)
+{
+  *out_frame           = (Moss__GpuSortFrame) {0};
+  out_frame->max_count = info->max_count;
+
+  const VkDeviceSize key_size   = (VkDeviceSize)info->max_count * sizeof (uint32_t);
+  const uint32_t     max_blocks = (info->max_count + MOSS__GPU_SORT_BLOCK_SIZE - 1) /
+                              MOSS__GPU_SORT_BLOCK_SIZE;
+  const VkDeviceSize histogram_size =
+    (VkDeviceSize)max_blocks * MOSS__GPU_SORT_BUCKET_COUNT * sizeof (uint32_t);
+  const VkDeviceSize index_size = key_size * 6;
+
+  const VkMemoryPropertyFlags host_memory =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  const VkMemoryPropertyFlags device_memory = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+  if (moss__create_gpu_sort_crate (
+        info, key_size, 0, host_memory, &out_frame->key_crates[ 0 ]
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_crate (
+        info, key_size, 0, device_memory, &out_frame->key_crates[ 1 ]
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_crate (
+        info, key_size, 0, device_memory, &out_frame->value_crates[ 0 ]
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_crate (
+        info, key_size, 0, device_memory, &out_frame->value_crates[ 1 ]
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_crate (
+        info, histogram_size, 0, device_memory, &out_frame->histogram_crate
+      ) != MOSS_RESULT_SUCCESS ||
+      moss__create_gpu_sort_crate (
+        info,
+        index_size,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        device_memory,
+        &out_frame->sorted_index_crate
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_gpu_sort_frame (sort, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  void    *mapped_memory;
+  VkResult result = vkMapMemory (
+    info->device,
+    out_frame->key_crates[ 0 ].memory,
+    0,
+    out_frame->key_crates[ 0 ].size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map sort key crate. Error code: %d.\n", result);
+    moss__destroy_gpu_sort_frame (sort, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->keys = mapped_memory;
+
+  const VkDescriptorPoolSize pool_size = {
+    .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .descriptorCount = MOSS__GPU_SORT_BINDING_COUNT * 2,
+  };
+
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = 2,
+    .poolSizeCount = 1,
+    .pPoolSizes    = &pool_size,
+  };
+
+  result =
+    vkCreateDescriptorPool (info->device, &pool_info, NULL, &out_frame->descriptor_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create sort descriptor pool. Error code: %d.\n", result);
+    moss__destroy_gpu_sort_frame (sort, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetLayout set_layouts[ 2 ] = {
+    sort->descriptor_set_layout,
+    sort->descriptor_set_layout,
+  };
+
+  const VkDescriptorSetAllocateInfo set_info = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .descriptorPool     = out_frame->descriptor_pool,
+    .descriptorSetCount = 2,
+    .pSetLayouts        = set_layouts,
+  };
+
+  result = vkAllocateDescriptorSets (info->device, &set_info, out_frame->descriptor_sets);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate sort descriptor sets. Error code: %d.\n", result);
+    moss__destroy_gpu_sort_frame (sort, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Set 0 reads the first crate pair and writes the second one, set 1 does the opposite
+  for (uint32_t set = 0; set < 2; ++set)
+  {
+    const Moss__Crate *const crates[ MOSS__GPU_SORT_BINDING_COUNT ] = {
+      &out_frame->key_crates[ set ],
+      &out_frame->value_crates[ set ],
+      &out_frame->key_crates[ 1 - set ],
+      &out_frame->value_crates[ 1 - set ],
+      &out_frame->histogram_crate,
+      &out_frame->sorted_index_crate,
+    };
+
+    VkDescriptorBufferInfo buffer_infos[ MOSS__GPU_SORT_BINDING_COUNT ];
+    VkWriteDescriptorSet   writes[ MOSS__GPU_SORT_BINDING_COUNT ];
+    for (uint32_t binding = 0; binding < MOSS__GPU_SORT_BINDING_COUNT; ++binding)
+    {
+      buffer_infos[ binding ] = (VkDescriptorBufferInfo) {
+        .buffer = crates[ binding ]->buffer,
+        .offset = 0,
+        .range  = VK_WHOLE_SIZE,
+      };
+
+      writes[ binding ] = (VkWriteDescriptorSet) {
+        .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet          = out_frame->descriptor_sets[ set ],
+        .dstBinding      = binding,
+        .descriptorCount = 1,
+        .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo     = &buffer_infos[ binding ],
+      };
+    }
+
+    vkUpdateDescriptorSets (info->device, MOSS__GPU_SORT_BINDING_COUNT, writes, 0, NULL);
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_gpu_sort_frame (
+  const Moss__GpuSort *const sort,
+  Moss__GpuSortFrame *const  frame
+)
+{
+  if (frame->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (sort->device, frame->descriptor_pool, NULL);
+  }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->key_crates[ 0 ]);
+  moss__destroy_crate (&frame->key_crates[ 1 ]);
+  moss__destroy_crate (&frame->value_crates[ 0 ]);
+  moss__destroy_crate (&frame->value_crates[ 1 ]);
+  moss__destroy_crate (&frame->histogram_crate);
+  moss__destroy_crate (&frame->sorted_index_crate);
+
+  *frame = (Moss__GpuSortFrame) {0};
+}
+
+void moss__record_gpu_sort (
+  const Moss__GpuSort *const      sort,
+  const Moss__GpuSortFrame *const frame,
+  const VkCommandBuffer           command_buffer,
+  const uint32_t                  count
+)
+{
+  // Host writes to keys are made visible by the queue submission itself
+  const uint32_t block_count =
+    (count + MOSS__GPU_SORT_BLOCK_SIZE - 1) / MOSS__GPU_SORT_BLOCK_SIZE;
+
+  for (uint32_t pass = 0; pass < MOSS__GPU_SORT_PASS_COUNT; ++pass)
+  {
+    const Moss__GpuSortPushConstants push_constants = {
+      .count       = count,
+      .shift       = pass * 8,
+      .block_count = block_count,
+      .pass_index  = pass,
+    };
+
+    vkCmdBindDescriptorSets (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      sort->pipeline_layout,
+      0,
+      1,
+      &frame->descriptor_sets[ pass % 2 ],
+      0,
+      NULL
+    );
+
+    vkCmdPushConstants (
+      command_buffer,
+      sort->pipeline_layout,
+      VK_SHADER_STAGE_COMPUTE_BIT,
+      0,
+      sizeof (push_constants),
+      &push_constants
+    );
+
+    vkCmdBindPipeline (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      sort->histogram_pipeline
+    );
+    vkCmdDispatch (command_buffer, block_count, 1, 1);
+    moss__record_gpu_sort_barrier (
+      command_buffer,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+
+    vkCmdBindPipeline (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      sort->scan_pipeline
+    );
+    vkCmdDispatch (command_buffer, 1, 1, 1);
+    moss__record_gpu_sort_barrier (
+      command_buffer,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+
+    vkCmdBindPipeline (
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      sort->scatter_pipeline
+    );
+    vkCmdDispatch (command_buffer, block_count, 1, 1);
+    moss__record_gpu_sort_barrier (
+      command_buffer,
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+  }
+
+  // After an even number of passes sorted values are back in the first crate pair
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    sort->pipeline_layout,
+    0,
+    1,
+    &frame->descriptor_sets[ 0 ],
+    0,
+    NULL
+  );
+
+  vkCmdBindPipeline (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    sort->indices_pipeline
+  );
+  vkCmdDispatch (
+    command_buffer,
+    (count + MOSS__GPU_SORT_WORKGROUP_SIZE - 1) / MOSS__GPU_SORT_WORKGROUP_SIZE,
+    1,
+    1
+  );
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_gpu_sort_pipeline (
+  const Moss__GpuSort *const sort,
+  const char *const          shader_path,
+  VkPipeline *const          out_pipeline
+)
+{
+  VkShaderModule shader_module;
+  if (moss__create_shader_module_from_file (sort->device, shader_path, &shader_module) !=
+      VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkComputePipelineCreateInfo pipeline_info = {
+    .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+    .stage =
+      {
+              .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+              .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
+              .module = shader_module,
+              .pName  = "main",
+              },
+    .layout = sort->pipeline_layout,
+  };
+
+  const VkResult result = vkCreateComputePipelines (
+    sort->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    out_pipeline
+  );
+
+  vkDestroyShaderModule (sort->device, shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create sort pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    sort->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    *out_pipeline,
+    "sprite sort pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_gpu_sort_crate (
+  const Moss__GpuSortCreateInfo *const info,
+  const VkDeviceSize                   size,
+  const VkBufferUsageFlags             usage,
+  const VkMemoryPropertyFlags          memory_properties,
+  Moss__Crate *const                   out_crate
+)
+{
+  const Moss__CrateCreateInfo create_info = {
+    .size                            = size,
+    .usage                           = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage,
+    .memory_properties               = memory_properties,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "sprite sort crate",
+  };
+
+  if (moss__create_crate (&create_info, out_crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create sort crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__record_gpu_sort_barrier (
+  const VkCommandBuffer      command_buffer,
+  const VkPipelineStageFlags destination_stage,
+  const VkAccessFlags        destination_access
+)
+{
+  const VkMemoryBarrier barrier = {
+    .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+    .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+    .dstAccessMask = destination_access,
+  };
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    destination_stage,
+    0,
+    1,
+    &barrier,
+    0,
+    NULL,
+    0,
+    NULL
+  );
+}
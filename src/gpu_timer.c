@@ -0,0 +1,193 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/gpu_timer.c
+  @brief GPU frame timer implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+#include "src/internal/gpu_timer.h"
+#include "src/internal/log.h"
+
+/* Number of timestamps written per frame. */
+#define MOSS__GPU_TIMER_QUERIES_PER_FRAME (uint32_t)(2)
+
+MossResult moss__create_gpu_timer (
+  const Moss__GpuTimerCreateInfo *const info,
+  Moss__GpuTimer *const                 out_timer
+)
+{
+  *out_timer = (Moss__GpuTimer) {0};
+
+  if (info->frame_count > MOSS__GPU_TIMER_MAX_FRAME_COUNT)
+  {
+    moss__error (
+      "GPU timer can't track more than %u frames.\n",
+      MOSS__GPU_TIMER_MAX_FRAME_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties (info->physical_device, &properties);
+
+  uint32_t queue_family_count = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties (
+    info->physical_device,
+    &queue_family_count,
+    NULL
+  );
+
+  VkQueueFamilyProperties *const queue_families =
+    malloc (sizeof (VkQueueFamilyProperties) * queue_family_count);
+  if (queue_families == NULL)
+  {
+    moss__error ("Failed to allocate memory for queue family properties.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  vkGetPhysicalDeviceQueueFamilyProperties (
+    info->physical_device,
+    &queue_family_count,
+    queue_families
+  );
+
+  const uint32_t valid_bits =
+    queue_families[ info->queue_family_index ].timestampValidBits;
+  free (queue_families);
+
+  out_timer->device      = info->device;
+  out_timer->frame_count = info->frame_count;
+
+  // Timestamps are optional, frame time simply stays unknown without them
+  if (valid_bits == 0 || properties.limits.timestampPeriod == 0.0F)
+  {
+    return MOSS_RESULT_SUCCESS;
+  }
+
+  out_timer->tick_period     = properties.limits.timestampPeriod;
+  out_timer->valid_bits_mask = valid_bits >= 64 ? UINT64_MAX : (1ULL << valid_bits) - 1;
+
+  const VkQueryPoolCreateInfo pool_info = {
+    .sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+    .queryType  = VK_QUERY_TYPE_TIMESTAMP,
+    .queryCount = info->frame_count * MOSS__GPU_TIMER_QUERIES_PER_FRAME,
+  };
+
+  const VkResult result =
+    vkCreateQueryPool (info->device, &pool_info, NULL, &out_timer->query_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create timestamp query pool. Error code: %d.\n", result);
+    *out_timer = (Moss__GpuTimer) {0};
+    return MOSS_RESULT_ERROR;
+  }
+
+  out_timer->is_supported = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_gpu_timer (Moss__GpuTimer *const timer)
+{
+  if (timer->query_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyQueryPool (timer->device, timer->query_pool, NULL);
+  }
+
+  *timer = (Moss__GpuTimer) {0};
+}
+
+void moss__record_gpu_timer_begin (
+  Moss__GpuTimer *const timer,
+  const VkCommandBuffer command_buffer,
+  const uint32_t        frame
+)
+{
+  if (!timer->is_supported) { return; }
+
+  const uint32_t first_query = frame * MOSS__GPU_TIMER_QUERIES_PER_FRAME;
+
+  vkCmdResetQueryPool (
+    command_buffer,
+    timer->query_pool,
+    first_query,
+    MOSS__GPU_TIMER_QUERIES_PER_FRAME
+  );
+
+  vkCmdWriteTimestamp (
+    command_buffer,
+    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+    timer->query_pool,
+    first_query
+  );
+}
+
+void moss__record_gpu_timer_end (
+  Moss__GpuTimer *const timer,
+  const VkCommandBuffer command_buffer,
+  const uint32_t        frame
+)
+{
+  if (!timer->is_supported) { return; }
+
+  vkCmdWriteTimestamp (
+    command_buffer,
+    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+    timer->query_pool,
+    frame * MOSS__GPU_TIMER_QUERIES_PER_FRAME + 1
+  );
+
+  timer->is_frame_recorded[ frame ] = true;
+}
+
+bool moss__read_gpu_timer (
+  const Moss__GpuTimer *const timer,
+  const uint32_t              frame,
+  float *const                out_seconds
+)
+{
+  if (!timer->is_supported || !timer->is_frame_recorded[ frame ]) { return false; }
+
+  uint64_t timestamps[ MOSS__GPU_TIMER_QUERIES_PER_FRAME ];
+
+  // Fence of the frame is signaled, so results are there and no wait is needed
+  const VkResult result = vkGetQueryPoolResults (
+    timer->device,
+    timer->query_pool,
+    frame * MOSS__GPU_TIMER_QUERIES_PER_FRAME,
+    MOSS__GPU_TIMER_QUERIES_PER_FRAME,
+    sizeof (timestamps),
+    timestamps,
+    sizeof (uint64_t),
+    VK_QUERY_RESULT_64_BIT
+  );
+  if (result != VK_SUCCESS) { return false; }
+
+  const uint64_t ticks =
+    ((timestamps[ 1 ] - timestamps[ 0 ]) & timer->valid_bits_mask);
+
+  *out_seconds = (float)ticks * timer->tick_period * 1e-9F;
+
+  return true;
+}
@@ -45,7 +45,7 @@ inline static VkApplicationInfo moss__create_vk_app_info (const MossAppInfo *app
     .applicationVersion = app_version,
     .pEngineName        = engine_name,
     .engineVersion      = engine_version,
-    .apiVersion         = VK_API_VERSION_1_0,
+    .apiVersion         = VK_API_VERSION_1_1,
   };
 
   return application_info;
@@ -0,0 +1,227 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/async_io.h
+  @brief Asynchronous file read functions.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Reads file ranges straight into caller provided memory (usually mapped
+           staging crate memory) without blocking the calling thread. On Linux the
+           reads are performed with io_uring, everywhere else (or when io_uring is
+           unavailable at runtime) blocking reads are executed on a dedicated I/O
+           thread, so they never occupy the engine thread or job workers.
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "moss/result.h"
+
+/* Max number of read requests that can be in flight at the same time. */
+#define MOSS__ASYNC_IO_MAX_REQUESTS (uint32_t)(256)
+
+/*
+  @brief Callback that is invoked once a read request is completed.
+  @param user_data User data passed with the read request.
+  @param result MOSS_RESULT_SUCCESS if the whole range was read, MOSS_RESULT_ERROR
+                otherwise.
+  @param bytes_read Number of bytes that were written to the destination memory.
+*/
+typedef void (*Moss__AsyncReadCallback) (
+  void      *user_data,
+  MossResult result,
+  size_t     bytes_read
+);
+
+/*
+  @brief Backend that is used to perform reads.
+*/
+typedef enum
+{
+  MOSS__ASYNC_IO_BACKEND_THREAD,   /* Blocking reads on a dedicated I/O thread. */
+  MOSS__ASYNC_IO_BACKEND_IO_URING, /* Linux io_uring submission/completion rings. */
+} Moss__AsyncIoBackend;
+
+/*
+  @brief Required information for asynchronous read operation.
+*/
+typedef struct
+{
+  /* File descriptor to read from. Must stay open until the callback is invoked. */
+  int file_descriptor;
+
+  /* Offset in the file to start reading from. */
+  uint64_t offset;
+
+  /* Number of bytes to read. Zero-size reads complete successfully. */
+  size_t size;
+
+  /* Memory to write data to. Must stay valid until the callback is invoked. */
+  void *destination;
+
+  /* Callback to invoke on completion. May be NULL. */
+  Moss__AsyncReadCallback callback;
+
+  /* User data to pass to the callback. */
+  void *user_data;
+} Moss__AsyncReadInfo;
+
+/*
+  @brief Async I/O creation information.
+*/
+typedef struct
+{
+  /* Whether io_uring backend may be used when it's available. */
+  bool allow_io_uring;
+} Moss__AsyncIoCreateInfo;
+
+typedef struct Moss__AsyncIo Moss__AsyncIo;
+
+/*
+  @brief Read request slot.
+  @details Slots are preallocated, so submitting a read never allocates memory.
+*/
+typedef struct
+{
+  /* Read request info. */
+  Moss__AsyncReadInfo info;
+
+  /* Number of bytes read so far. */
+  size_t bytes_read;
+
+  /* Request result. */
+  MossResult result;
+
+  /* Index of the next slot in the free list. */
+  uint32_t next_free;
+} Moss__AsyncReadRequest;
+
+/*
+  @brief Memory mapped io_uring rings.
+  @note Only used on Linux.
+*/
+typedef struct
+{
+  int ring_fd; /* io_uring file descriptor. */
+
+  void  *sq_ring;      /* Mapped submission queue ring. */
+  size_t sq_ring_size; /* Size of the mapped submission queue ring. */
+  void  *cq_ring;      /* Mapped completion queue ring. */
+  size_t cq_ring_size; /* Size of the mapped completion queue ring. */
+
+  struct io_uring_sqe *sqes;      /* Mapped submission queue entries. */
+  size_t               sqes_size; /* Size of the mapped submission queue entries. */
+
+  uint32_t *sq_head;  /* Submission queue head. */
+  uint32_t *sq_tail;  /* Submission queue tail. */
+  uint32_t *sq_mask;  /* Submission queue index mask. */
+  uint32_t *sq_array; /* Submission queue index array. */
+  uint32_t  sq_entries; /* Number of submission queue entries. */
+
+  uint32_t            *cq_head; /* Completion queue head. */
+  uint32_t            *cq_tail; /* Completion queue tail. */
+  uint32_t            *cq_mask; /* Completion queue index mask. */
+  struct io_uring_cqe *cqes;    /* Completion queue entries. */
+} Moss__IoUring;
+
+/*
+  @brief Asynchronous file reader.
+*/
+struct Moss__AsyncIo
+{
+  /* Whether reader was successfully initialized. */
+  bool is_running;
+
+  /* Backend in use. */
+  Moss__AsyncIoBackend backend;
+
+  /* Request slots. */
+  Moss__AsyncReadRequest requests[ MOSS__ASYNC_IO_MAX_REQUESTS ];
+
+  /* Head of the free slot list. */
+  uint32_t free_head;
+
+  /* Number of requests that were submitted but not reported as completed yet. */
+  uint32_t in_flight_count;
+
+  /* io_uring rings. Valid only with MOSS__ASYNC_IO_BACKEND_IO_URING backend. */
+  Moss__IoUring ring;
+
+  /* === Thread backend === */
+  /* I/O thread performing blocking reads. */
+  pthread_t thread;
+  /* Whether the I/O thread should exit. Guarded by the mutex. */
+  bool is_thread_stopping;
+  /* Mutex protecting the pending and completed queues. */
+  pthread_mutex_t mutex;
+  /* Condition signaled when a read completes. */
+  pthread_cond_t condition;
+  /* Condition signaled when a read is queued or the I/O thread is stopped. */
+  pthread_cond_t pending_condition;
+  /* Ring of slot indices waiting to be read. */
+  uint32_t pending_queue[ MOSS__ASYNC_IO_MAX_REQUESTS ];
+  /* Pending queue head and tail counters. */
+  uint32_t pending_head, pending_tail;
+  /* Ring of slot indices that were read but not reported yet. */
+  uint32_t completed_queue[ MOSS__ASYNC_IO_MAX_REQUESTS ];
+  /* Completed queue head and tail counters. */
+  uint32_t completed_head, completed_tail;
+};
+
+/*
+  @brief Initializes asynchronous file reader.
+  @details Tries io_uring first (if allowed and supported), falls back to the
+           thread backend otherwise.
+  @param info Required info for reader creation.
+  @param out_async_io Reader to initialize.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult
+moss__init_async_io (const Moss__AsyncIoCreateInfo *info, Moss__AsyncIo *out_async_io);
+
+/*
+  @brief Submits asynchronous read request.
+  @details Doesn't block on disk. Completion is reported by @ref moss__poll_async_io.
+  @param async_io Reader to submit request to.
+  @param info Read request info.
+  @return MOSS_RESULT_SUCCESS if request was queued, otherwise MOSS_RESULT_ERROR.
+  @warning Not thread safe. Must be called from the thread that polls the reader.
+*/
+MossResult
+moss__submit_async_read (Moss__AsyncIo *async_io, const Moss__AsyncReadInfo *info);
+
+/*
+  @brief Reports completed read requests.
+  @details Invokes callbacks of all completed requests on the calling thread.
+  @param async_io Reader to poll.
+  @return Number of reported requests.
+*/
+uint32_t moss__poll_async_io (Moss__AsyncIo *async_io);
+
+/*
+  @brief Blocks until all submitted requests are completed and reported.
+  @param async_io Reader to wait on.
+*/
+void moss__wait_async_io_idle (Moss__AsyncIo *async_io);
+
+/*
+  @brief Deinitializes asynchronous file reader.
+  @details Waits for in-flight requests and unmaps rings.
+  @param async_io Reader to deinitialize.
+*/
+void moss__deinit_async_io (Moss__AsyncIo *async_io);
@@ -0,0 +1,310 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/capture.h
+  @brief API call capture.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details A capture file starts with @ref Moss__CaptureHeader followed by one
+           record per public API call that changes engine state, in the order
+           calls were made. A record is a @ref Moss__CaptureRecordHeader followed
+           by its payload. Payloads hold call arguments in native byte order:
+           scalars and plain structs as they are, arrays as their elements right
+           after the count. Sizes of payloads are multiples of 4, so arrays can
+           be read in place.
+
+           Sprite batches are stored as @ref Moss__CaptureSpriteBatchHeader
+           followed by every array present in its mask, in mask bit order.
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "moss/animation.h"
+#include "moss/draw_command.h"
+#include "moss/light.h"
+#include "moss/occluder.h"
+#include "moss/offscreen.h"
+#include "moss/result.h"
+#include "moss/skeleton.h"
+#include "moss/sprite.h"
+#include "moss/video.h"
+#include "moss/virtual_texture.h"
+
+/*
+  @brief Captured calls.
+*/
+typedef enum
+{
+  MOSS__CAPTURE_OP_DRAW_FRAME = 1,        /* moss_engine_draw_frame. */
+  MOSS__CAPTURE_OP_SUBMIT_SPRITES,        /* Sprite batch. */
+  MOSS__CAPTURE_OP_SUBMIT_DRAW,           /* MossDrawCommand. */
+  MOSS__CAPTURE_OP_SUBMIT_LIGHTS,         /* Count, MossLight array. */
+  MOSS__CAPTURE_OP_SUBMIT_OCCLUDERS,      /* Count, MossOccluder array. */
+  MOSS__CAPTURE_OP_SET_AMBIENT_LIGHT,     /* RGBA8 color. */
+  MOSS__CAPTURE_OP_SET_TARGET_FRAME_TIME, /* Seconds. */
+  MOSS__CAPTURE_OP_UPLOAD_ANIMATION_CLIPS, /* Count, then per clip loop mode,
+                                              frame count and frames. */
+  MOSS__CAPTURE_OP_SET_ANIMATION_TIME,    /* Seconds. */
+  MOSS__CAPTURE_OP_CREATE_SKINNED_MESH,   /* Vertex, index and bone counts, then
+                                             vertices, indices and bind pose. */
+  MOSS__CAPTURE_OP_SUBMIT_SKINNED_MESH,   /* Mesh ID, bone count, pose. */
+  MOSS__CAPTURE_OP_REQUEST_PICK,          /* X and Y coordinates. */
+  MOSS__CAPTURE_OP_OPEN_VIRTUAL_TEXTURE,  /* Path length, zero padded path. */
+  MOSS__CAPTURE_OP_CLOSE_VIRTUAL_TEXTURE, /* Nothing. */
+  MOSS__CAPTURE_OP_SUBMIT_VIRTUAL_TEXTURE, /* MossVirtualTextureView. */
+  MOSS__CAPTURE_OP_SET_LAYER_SPRITES,     /* Layer index, sprite batch. */
+  MOSS__CAPTURE_OP_INVALIDATE_LAYER,      /* Layer index. */
+  MOSS__CAPTURE_OP_OPEN_VIDEO,            /* MossVideoCreateInfo fields. */
+  MOSS__CAPTURE_OP_CLOSE_VIDEO,           /* Nothing. */
+  MOSS__CAPTURE_OP_UPLOAD_VIDEO_FRAME,    /* Tightly packed planes back to back,
+                                             zero padded. */
+  MOSS__CAPTURE_OP_SUBMIT_VIDEO,          /* MossVideoView. */
+  MOSS__CAPTURE_OP_RENDER_OFFSCREEN_BATCH, /* Scene count, width, height, then
+                                              a sprite batch per scene. */
+} Moss__CaptureOp;
+
+/*
+  @brief Capture file header.
+*/
+typedef struct
+{
+  uint64_t magic;          /* @ref MOSS_CAPTURE_MAGIC. */
+  uint32_t version;        /* @ref MOSS_CAPTURE_VERSION. */
+  uint32_t window_width;   /* Window width the engine was initialized with. */
+  uint32_t window_height;  /* Window height the engine was initialized with. */
+  uint32_t enable_picking; /* Whether picking was enabled. */
+} Moss__CaptureHeader;
+
+/*
+  @brief Header of a captured call.
+*/
+typedef struct
+{
+  uint32_t op;   /* @ref Moss__CaptureOp. */
+  uint32_t size; /* Number of payload bytes that follow. */
+} Moss__CaptureRecordHeader;
+
+/*
+  @brief Bits of arrays present in a captured sprite batch.
+*/
+typedef enum
+{
+  MOSS__CAPTURE_SPRITE_X                    = 1 << 0,
+  MOSS__CAPTURE_SPRITE_Y                    = 1 << 1,
+  MOSS__CAPTURE_SPRITE_ROTATION             = 1 << 2,
+  MOSS__CAPTURE_SPRITE_SCALE_X              = 1 << 3,
+  MOSS__CAPTURE_SPRITE_SCALE_Y              = 1 << 4,
+  MOSS__CAPTURE_SPRITE_TEXTURE_INDEX        = 1 << 5,
+  MOSS__CAPTURE_SPRITE_COLOR                = 1 << 6,
+  MOSS__CAPTURE_SPRITE_DEPTH                = 1 << 7,
+  MOSS__CAPTURE_SPRITE_ANIMATION_CLIP       = 1 << 8,
+  MOSS__CAPTURE_SPRITE_ANIMATION_START_TIME = 1 << 9,
+} Moss__CaptureSpriteArray;
+
+/* Number of arrays of a sprite batch. */
+#define MOSS__CAPTURE_SPRITE_ARRAY_COUNT (uint32_t)(10)
+
+/*
+  @brief Header of a captured sprite batch.
+*/
+typedef struct
+{
+  uint32_t count; /* Number of sprites. */
+  uint32_t mask;  /* @ref Moss__CaptureSpriteArray bits of present arrays. */
+} Moss__CaptureSpriteBatchHeader;
+
+/*
+  @brief Capture state.
+*/
+typedef struct
+{
+  /* File calls are written to, NULL while not capturing. Written with the mutex
+     locked, atomic. */
+  FILE *file;
+
+  /* Serializes records of calls made from different threads with opening and
+     closing the file. Lives from engine init to deinit. */
+  pthread_mutex_t mutex;
+
+  /* Whether the mutex is initialized. */
+  bool is_initialized;
+
+  /* Number of frames left to capture. */
+  uint32_t remaining_frame_count;
+
+  /* Whether a write failed, the capture is then closed at the next frame. */
+  bool is_failed;
+} Moss__Capture;
+
+/*
+  @brief Returns whether calls are being captured.
+  @details Lock free hint for skipping work, writers check again under the mutex.
+  @param capture Capture state.
+  @return Returns true while capturing, false otherwise.
+*/
+inline static bool moss__is_capturing (const Moss__Capture *const capture)
+{
+  return __atomic_load_n (&capture->file, __ATOMIC_ACQUIRE) != NULL;
+}
+
+/*
+  @brief Initializes capture state, not capturing.
+  @param out_capture Capture state to initialize.
+*/
+void moss__init_capture (Moss__Capture *out_capture);
+
+/*
+  @brief Ends the capture if there is one and deinitializes capture state.
+  @details No other thread may capture calls anymore.
+  @param capture Capture state. Safe to call if it isn't initialized.
+*/
+void moss__deinit_capture (Moss__Capture *capture);
+
+/*
+  @brief Starts capturing calls into a file.
+  @param capture Capture state, not capturing.
+  @param path Path to the capture file, replaced if it exists.
+  @param header Header to write, magic and version are filled in.
+  @param frame_count Number of frames to capture.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__begin_capture (
+  Moss__Capture       *capture,
+  const char          *path,
+  Moss__CaptureHeader  header,
+  uint32_t             frame_count
+);
+
+/*
+  @brief Stops capturing and closes the file.
+  @param capture Capture state. Safe to call while not capturing.
+*/
+void moss__end_capture (Moss__Capture *capture);
+
+/*
+  @brief Captures a drawn frame, ending the capture after the last one.
+  @param capture Capture state.
+*/
+void moss__capture_frame (Moss__Capture *capture);
+
+/*
+  @brief Captures a call with a plain payload.
+  @param capture Capture state.
+  @param op Captured call.
+  @param payload Call arguments, NULL if there are none.
+  @param size Payload size, a multiple of 4.
+*/
+void moss__capture_call (
+  Moss__Capture  *capture,
+  Moss__CaptureOp op,
+  const void     *payload,
+  uint32_t        size
+);
+
+/*
+  @brief Captures a call with a counted array.
+  @param capture Capture state.
+  @param op Captured call.
+  @param elements Array elements.
+  @param count Number of elements.
+  @param element_size Element size, a multiple of 4.
+*/
+void moss__capture_array_call (
+  Moss__Capture  *capture,
+  Moss__CaptureOp op,
+  const void     *elements,
+  uint32_t        count,
+  uint32_t        element_size
+);
+
+/*
+  @brief Captures a sprite batch submission or layer update.
+  @param capture Capture state.
+  @param op @ref MOSS__CAPTURE_OP_SUBMIT_SPRITES or
+            @ref MOSS__CAPTURE_OP_SET_LAYER_SPRITES.
+  @param layer Layer index, ignored for sprite submissions.
+  @param batch Sprite batch.
+*/
+void moss__capture_sprites (
+  Moss__Capture         *capture,
+  Moss__CaptureOp        op,
+  uint32_t               layer,
+  const MossSpriteBatch *batch
+);
+
+/*
+  @brief Captures animation clip upload.
+  @param capture Capture state.
+  @param clips Clips.
+  @param count Number of clips.
+*/
+void moss__capture_animation_clips (
+  Moss__Capture           *capture,
+  const MossAnimationClip *clips,
+  uint32_t                 count
+);
+
+/*
+  @brief Captures skinned mesh creation.
+  @param capture Capture state.
+  @param info Mesh creation information.
+*/
+void moss__capture_skinned_mesh (
+  Moss__Capture                   *capture,
+  const MossSkinnedMeshCreateInfo *info
+);
+
+/*
+  @brief Captures skinned mesh submission.
+  @param capture Capture state.
+  @param mesh Mesh ID.
+  @param pose Pose bones.
+  @param bone_count Number of bones.
+*/
+void moss__capture_skinned_mesh_pose (
+  Moss__Capture  *capture,
+  uint32_t        mesh,
+  const MossBone *pose,
+  uint32_t        bone_count
+);
+
+/*
+  @brief Captures virtual texture opening.
+  @param capture Capture state.
+  @param path Path to the file.
+*/
+void moss__capture_virtual_texture_path (Moss__Capture *capture, const char *path);
+
+/*
+  @brief Captures video frame upload.
+  @param capture Capture state.
+  @param frame Frame with tightly packed planes stored back to back.
+  @param size Frame size in bytes.
+*/
+void moss__capture_video_frame (Moss__Capture *capture, const void *frame, uint64_t size);
+
+/*
+  @brief Captures offscreen batch rendering.
+  @param capture Capture state.
+  @param batch Offscreen batch.
+*/
+void moss__capture_offscreen_batch (
+  Moss__Capture            *capture,
+  const MossOffscreenBatch *batch
+);
@@ -27,6 +27,9 @@
 #include "moss/result.h"
 #include "vulkan/vulkan_core.h"
 
+/* Max number of bytes a single inline crate update may carry. */
+#define MOSS__MAX_CRATE_UPDATE_SIZE (VkDeviceSize)(65536)
+
 /*
   @brief Crate - a self-contained GPU buffer abstraction.
   @details A crate is a wrapper structure that encapsulates a Vulkan buffer along with
@@ -38,6 +41,7 @@
   - Create: Use @ref moss__create_crate to allocate and bind buffer memory
   - Use: Access the buffer via the @c buffer field for Vulkan operations
   - Fill: Use @ref moss__fill_crate to upload data to the buffer
+  - Update: Use @ref moss__record_crate_update to patch small ranges in a frame
   - Destroy: Use @ref moss__free_crate to release all resources
 
   @par Example:
@@ -159,6 +163,9 @@ typedef struct
 
   /* Required memory properties for the buffer's backing memory. */
   VkMemoryPropertyFlags memory_properties;
+
+  /* Name debuggers and profilers show for the buffer and its memory. May be NULL. */
+  const char *debug_name;
 } Moss__CrateCreateInfo;
 
 /*
@@ -182,6 +189,34 @@ typedef struct
   VkCommandPool command_pool;
 } Moss__FillCrateInfo;
 
+/*
+  @brief Required information for inline crate update recording.
+*/
+typedef struct
+{
+  /* Destination crate, must be created with VK_BUFFER_USAGE_TRANSFER_DST_BIT. */
+  const Moss__Crate *destination_crate;
+
+  /* Byte offset to write at, must be a multiple of 4. */
+  VkDeviceSize offset;
+
+  /* Source memory to read data from, copied into the command buffer. */
+  const void *source_memory;
+
+  /* Number of bytes to write, a multiple of 4 not larger than
+     @ref MOSS__MAX_CRATE_UPDATE_SIZE. */
+  VkDeviceSize size;
+
+  /* Command buffer to record to, outside of any render pass. */
+  VkCommandBuffer command_buffer;
+
+  /* Stages that read the crate before and after the update. */
+  VkPipelineStageFlags stage_mask;
+
+  /* Accesses that read the crate after the update. */
+  VkAccessFlags access_mask;
+} Moss__UpdateCrateInfo;
+
 /*
   @brief Creates moss crate.
   @param info Required info for crate creation.
@@ -199,6 +234,17 @@ MossResult moss__create_crate (const Moss__CrateCreateInfo *info, Moss__Crate *o
 */
 MossResult moss__fill_crate (const Moss__FillCrateInfo *info);
 
+/*
+  @brief Records inline crate update.
+  @details Embeds the data straight into the command buffer with vkCmdUpdateBuffer,
+           so small updates need neither a staging crate nor a separate submission.
+           Earlier reads of the crate on the same queue finish before the write,
+           and the write is made visible to @c stage_mask reads that follow.
+  @param info Required information for crate update.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__record_crate_update (const Moss__UpdateCrateInfo *info);
+
 /*
   @brief Free moss crate.
   @details Destroys the buffer and frees its memory. After calling this function,
@@ -0,0 +1,109 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/debug_utils.h
+  @brief Vulkan object names and command buffer labels for debuggers and profilers.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Names and labels are emitted through VK_EXT_debug_utils when the
+           Vulkan loader provides it, e.g. under RenderDoc or a GPU profiler.
+           Release builds compile every call out.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vulkan/vulkan.h>
+
+/*
+  @brief Checks if VK_EXT_debug_utils instance extension is available.
+  @return Returns true if the extension can be enabled, false otherwise.
+*/
+inline static bool moss__check_vk_debug_utils_support (void)
+{
+  uint32_t extension_count = 0;
+  vkEnumerateInstanceExtensionProperties (NULL, &extension_count, NULL);
+
+  if (extension_count == 0) { return false; }
+
+  VkExtensionProperties extensions[ extension_count ];
+  vkEnumerateInstanceExtensionProperties (NULL, &extension_count, extensions);
+
+  for (uint32_t i = 0; i < extension_count; ++i)
+  {
+    if (strcmp (extensions[ i ].extensionName, VK_EXT_DEBUG_UTILS_EXTENSION_NAME) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#ifdef NDEBUG
+#  define moss__load_debug_utils(instance)
+#  define moss__set_debug_name(device, type, handle, name)
+#  define moss__begin_debug_label(command_buffer, name)
+#  define moss__end_debug_label(command_buffer)
+#else
+/*
+  @brief Loads debug utils functions of an instance.
+  @details Names and labels are ignored until functions are loaded, or when the
+           instance was created without VK_EXT_debug_utils.
+  @param instance Vulkan instance.
+*/
+void moss__load_debug_utils (VkInstance instance);
+
+/*
+  @brief Names a Vulkan object.
+  @param device Logical device the object belongs to.
+  @param type Object type.
+  @param handle Object handle.
+  @param name Name shown by debuggers and profilers.
+*/
+#  define moss__set_debug_name(device, type, handle, name)                              \
+    moss__set_vk_object_name (device, type, (uint64_t)(handle), name)
+
+/*
+  @brief Opens a labeled scope of commands.
+  @details Every scope must be closed with @ref moss__end_debug_label in the same
+           command buffer.
+  @param command_buffer Command buffer in recording state.
+  @param name Scope name.
+*/
+void moss__begin_debug_label (VkCommandBuffer command_buffer, const char *name);
+
+/*
+  @brief Closes the innermost labeled scope of commands.
+  @param command_buffer Command buffer in recording state.
+*/
+void moss__end_debug_label (VkCommandBuffer command_buffer);
+
+/*
+  @brief Names a Vulkan object, use @ref moss__set_debug_name instead.
+  @param device Logical device the object belongs to.
+  @param type Object type.
+  @param handle Object handle.
+  @param name Name shown by debuggers and profilers.
+*/
+void moss__set_vk_object_name (
+  VkDevice     device,
+  VkObjectType type,
+  uint64_t     handle,
+  const char  *name
+);
+#endif
@@ -0,0 +1,201 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/descriptor_cache.h
+  @brief Per-frame descriptor set cache with push descriptor fast path.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Draws describe their resources as a list of bindings instead of owning
+           descriptor sets. With VK_KHR_push_descriptor the bindings are pushed
+           straight into the command buffer. Otherwise every frame in flight owns
+           a descriptor pool and a cache of sets keyed by layout and binding
+           contents, so binding the same resources again allocates and writes
+           nothing. The pool is reset wholesale once the frame's fence signals and
+           the cache grows past half of its capacity.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+/* Number of descriptor sets a frame can cache. */
+#define MOSS__DESCRIPTOR_CACHE_SIZE (uint32_t)(256)
+
+/* Max number of bindings of a single cached set. */
+#define MOSS__MAX_DESCRIPTOR_BINDING_COUNT (uint32_t)(8)
+
+/*
+  @brief Contents of a single buffer or image binding.
+*/
+typedef struct
+{
+  uint32_t         binding;      /* Binding index. */
+  VkDescriptorType type;         /* Descriptor type. */
+  VkBuffer         buffer;       /* Buffer of buffer descriptors. */
+  VkDeviceSize     offset;       /* Buffer offset. */
+  VkDeviceSize     range;        /* Buffer range. */
+  VkSampler        sampler;      /* Sampler of sampler descriptors. */
+  VkImageView      image_view;   /* Image view of image descriptors. */
+  VkImageLayout    image_layout; /* Image layout of image descriptors. */
+} Moss__DescriptorBinding;
+
+/*
+  @brief Cached descriptor set.
+*/
+typedef struct
+{
+  uint64_t                hash;          /* Hash of the layout and bindings. */
+  VkDescriptorSetLayout   layout;        /* Layout the set was allocated with. */
+  uint32_t                binding_count; /* Number of bindings. */
+  Moss__DescriptorBinding bindings[ MOSS__MAX_DESCRIPTOR_BINDING_COUNT ]; /* Contents. */
+  VkDescriptorSet         set;           /* Cached set. */
+} Moss__CachedDescriptorSet;
+
+/*
+  @brief Descriptor handling shared by all frames.
+*/
+typedef struct
+{
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Whether bindings are pushed instead of cached. */
+  bool is_push_descriptor_supported;
+
+  /* vkCmdPushDescriptorSetKHR entry point. */
+  PFN_vkCmdPushDescriptorSetKHR push_descriptor_set;
+} Moss__DescriptorCache;
+
+/*
+  @brief Descriptor pool and set cache of a single frame in flight.
+*/
+typedef struct
+{
+  /* Pool cached sets are allocated from, NULL when descriptors are pushed. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Cached sets. */
+  Moss__CachedDescriptorSet sets[ MOSS__DESCRIPTOR_CACHE_SIZE ];
+
+  /* Number of cached sets. */
+  uint32_t set_count;
+} Moss__DescriptorCacheFrame;
+
+/*
+  @brief Descriptor cache creation information.
+*/
+typedef struct
+{
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Whether VK_KHR_push_descriptor is enabled on the device. */
+  bool is_push_descriptor_enabled;
+} Moss__DescriptorCacheCreateInfo;
+
+/*
+  @brief Creates descriptor cache.
+  @param info Creation information.
+  @param out_cache Output descriptor cache.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_descriptor_cache (
+  const Moss__DescriptorCacheCreateInfo *info,
+  Moss__DescriptorCache                 *out_cache
+);
+
+/*
+  @brief Destroys descriptor cache.
+  @param cache Descriptor cache. Safe to call on a zeroed struct.
+*/
+void moss__destroy_descriptor_cache (Moss__DescriptorCache *cache);
+
+/*
+  @brief Creates descriptor cache resources of a frame.
+  @param cache Descriptor cache.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_descriptor_cache_frame (
+  const Moss__DescriptorCache *cache,
+  Moss__DescriptorCacheFrame  *out_frame
+);
+
+/*
+  @brief Destroys descriptor cache resources of a frame.
+  @param cache Descriptor cache.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_descriptor_cache_frame (
+  const Moss__DescriptorCache *cache,
+  Moss__DescriptorCacheFrame  *frame
+);
+
+/*
+  @brief Prepares frame's cache for recording.
+  @details Must be called once the frame's fence has signaled, before anything is
+           bound. Resets the frame's pool if the cache is more than half full.
+  @param cache Descriptor cache.
+  @param frame Frame resources.
+*/
+void moss__begin_descriptor_cache_frame (
+  const Moss__DescriptorCache *cache,
+  Moss__DescriptorCacheFrame  *frame
+);
+
+/*
+  @brief Creates descriptor set layout usable with @ref moss__bind_descriptors.
+  @param cache Descriptor cache.
+  @param bindings Layout bindings.
+  @param binding_count Number of bindings, at most
+                       @ref MOSS__MAX_DESCRIPTOR_BINDING_COUNT.
+  @param out_layout Output descriptor set layout.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_cached_descriptor_set_layout (
+  const Moss__DescriptorCache        *cache,
+  const VkDescriptorSetLayoutBinding *bindings,
+  uint32_t                            binding_count,
+  VkDescriptorSetLayout              *out_layout
+);
+
+/*
+  @brief Binds resources to a set of the pipeline layout.
+  @param cache Descriptor cache.
+  @param frame Frame resources.
+  @param command_buffer Command buffer to record to.
+  @param bind_point Pipeline bind point.
+  @param pipeline_layout Pipeline layout.
+  @param set_index Index of the set in the pipeline layout.
+  @param set_layout Layout created with @ref moss__create_cached_descriptor_set_layout.
+  @param bindings Binding contents.
+  @param binding_count Number of bindings.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__bind_descriptors (
+  const Moss__DescriptorCache   *cache,
+  Moss__DescriptorCacheFrame    *frame,
+  VkCommandBuffer                command_buffer,
+  VkPipelineBindPoint            bind_point,
+  VkPipelineLayout               pipeline_layout,
+  uint32_t                       set_index,
+  VkDescriptorSetLayout          set_layout,
+  const Moss__DescriptorBinding *bindings,
+  uint32_t                       binding_count
+);
@@ -0,0 +1,133 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/draw_queue.h
+  @brief Multi-producer draw command queue.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Every producer thread fills its own chunk of commands, so pushing a command
+           is a plain store. A thread only touches shared state when its chunk is full
+           or belongs to a previous frame: it then claims a new chunk from the pool
+           with a single atomic increment. At frame end the engine thread gathers all
+           claimed chunks and sorts commands by key.
+
+           Pushes for a frame must happen before the merge, e.g. producer jobs are
+           waited for before the frame is drawn.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "moss/draw_command.h"
+#include "moss/result.h"
+#include "moss/sprite.h"
+
+#include "src/internal/sprite_kernels.h"
+
+/* Number of commands in a single chunk. */
+#define MOSS__DRAW_CHUNK_CAPACITY (uint32_t)(256)
+
+/* Max number of commands that can be pushed during a frame, as many as a frame
+   can draw. */
+#define MOSS__DRAW_QUEUE_CAPACITY MOSS_MAX_SPRITE_COUNT
+
+/* Number of chunks available during a frame. Twice as many as the capacity needs,
+   since every producer thread leaves its last chunk partially filled. */
+#define MOSS__DRAW_QUEUE_CHUNK_COUNT \
+  (MOSS__DRAW_QUEUE_CAPACITY / MOSS__DRAW_CHUNK_CAPACITY * 2)
+
+/*
+  @brief Chunk of draw commands owned by a single producer thread.
+*/
+typedef struct
+{
+  /* Number of pushed commands. Written by the owner thread only. */
+  uint32_t count;
+
+  /* Commands. */
+  MossDrawCommand commands[ MOSS__DRAW_CHUNK_CAPACITY ];
+} Moss__DrawChunk;
+
+/*
+  @brief Draw command queue.
+*/
+typedef struct
+{
+  /* Chunk pool. */
+  Moss__DrawChunk *chunks;
+
+  /* Number of chunks claimed during the current frame. Atomic. */
+  uint32_t claimed_chunk_count;
+
+  /* Number of commands admitted during the current frame. Atomic. */
+  uint32_t command_count;
+
+  /* Frame generation, producers drop cached chunks of other generations. Unique
+     across all queues and inits, so a queue re-created at the same address never
+     accepts chunks cached for its predecessor. Atomic. */
+  uint64_t generation;
+
+  /* Sort keys of the merged commands. */
+  uint64_t *keys;
+
+  /* Indices of the merged commands. */
+  uint32_t *values;
+
+  /* Radix sort scratch keys. */
+  uint64_t *scratch_keys;
+
+  /* Radix sort scratch values. */
+  uint32_t *scratch_values;
+
+  /* Sorted sprite arrays. */
+  float    *x;
+  float    *y;
+  float    *rotation;
+  float    *scale_x;
+  float    *scale_y;
+  uint32_t *texture_index;
+  uint32_t *color;
+} Moss__DrawQueue;
+
+/*
+  @brief Initializes draw queue.
+  @param out_queue Queue to initialize.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__init_draw_queue (Moss__DrawQueue *out_queue);
+
+/*
+  @brief Frees draw queue memory.
+  @param queue Queue to deinitialize. Safe to call on a zeroed queue.
+*/
+void moss__deinit_draw_queue (Moss__DrawQueue *queue);
+
+/*
+  @brief Pushes a command to the queue.
+  @details Can be called from any thread.
+  @param queue Queue to push command to.
+  @param command Command to push.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the frame already
+          holds @ref MOSS__DRAW_QUEUE_CAPACITY commands or chunk pool is exhausted.
+*/
+MossResult
+moss__push_draw_command (Moss__DrawQueue *queue, const MossDrawCommand *command);
+
+/*
+  @brief Sorts commands pushed during the frame and starts a new frame.
+  @param queue Queue to merge.
+  @param out_sprites Output sorted sprites. Arrays stay valid until the next merge.
+*/
+void moss__merge_draw_queue (Moss__DrawQueue *queue, Moss__SpriteSoA *out_sprites);
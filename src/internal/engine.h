@@ -0,0 +1,27 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/engine.h
+  @brief Engine functions shared with other internal modules.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+/*
+  @brief Waits until the GPU finishes all submitted work.
+  @details The engine must be initialized.
+*/
+void moss__wait_engine_idle (void);
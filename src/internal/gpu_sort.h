@@ -0,0 +1,199 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/gpu_sort.h
+  @brief GPU radix sort of sprites.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Sorts 32 bit sprite keys with compute shaders and writes quad indices of
+           sprites in sorted order, so the draw consumes the result without a CPU
+           round trip. Each of the four 8 bit passes runs three dispatches:
+           per-block digit histograms, a single workgroup exclusive scan and a
+           stable scatter. Keys and values ping-pong between two crate pairs and
+           end up in the first pair after an even number of passes.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+
+/* Number of keys processed by a single sort workgroup. */
+#define MOSS__GPU_SORT_BLOCK_SIZE (uint32_t)(1024)
+
+/* Number of invocations in a sort workgroup. */
+#define MOSS__GPU_SORT_WORKGROUP_SIZE (uint32_t)(256)
+
+/* Number of digit buckets of a sort pass. */
+#define MOSS__GPU_SORT_BUCKET_COUNT (uint32_t)(256)
+
+/* Number of sort passes over 32 bit keys. */
+#define MOSS__GPU_SORT_PASS_COUNT (uint32_t)(4)
+
+/*
+  @brief GPU sort pipelines shared by all frames.
+*/
+typedef struct
+{
+  /* Device the pipelines were created on. */
+  VkDevice device;
+
+  /* Storage buffer bindings of all sort shaders. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Pipeline layout with sort push constants. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Digit histogram pipeline. */
+  VkPipeline histogram_pipeline;
+
+  /* Histogram scan pipeline. */
+  VkPipeline scan_pipeline;
+
+  /* Scatter pipeline. */
+  VkPipeline scatter_pipeline;
+
+  /* Sorted quad index generation pipeline. */
+  VkPipeline indices_pipeline;
+} Moss__GpuSort;
+
+/*
+  @brief GPU sort resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Max number of keys the frame can sort. */
+  uint32_t max_count;
+
+  /* Key crates. The first one is host visible and receives keys to sort. */
+  Moss__Crate key_crates[ 2 ];
+
+  /* Value crates. */
+  Moss__Crate value_crates[ 2 ];
+
+  /* Block histograms crate. */
+  Moss__Crate histogram_crate;
+
+  /* Quad indices of sorted sprites. */
+  Moss__Crate sorted_index_crate;
+
+  /* Persistently mapped memory of the first key crate. */
+  uint32_t *keys;
+
+  /* Descriptor pool of the frame's sets. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Descriptor sets for passes reading the first and the second crate pair. */
+  VkDescriptorSet descriptor_sets[ 2 ];
+} Moss__GpuSortFrame;
+
+/*
+  @brief GPU sort creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Max number of keys sorted per frame. */
+  uint32_t max_count;
+
+  /* Sharing mode of crates read by both compute and graphics queues. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__GpuSortCreateInfo;
+
+/*
+  @brief Converts sprite depth into a key that sorts sprites back to front.
+  @details Float bits are flipped into an unsigned order and inverted, so larger
+           depths come first.
+  @param depth Sprite depth.
+  @return Sort key.
+*/
+inline static uint32_t moss__make_back_to_front_sort_key (const float depth)
+{
+  union
+  {
+    float    value;
+    uint32_t bits;
+  } converter = { .value = depth };
+
+  const uint32_t mask = (converter.bits & 0x80000000U) ? 0xFFFFFFFFU : 0x80000000U;
+  return ~(converter.bits ^ mask);
+}
+
+/*
+  @brief Creates sort pipelines.
+  @param info Creation information.
+  @param out_sort Output sort pipelines.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult
+moss__create_gpu_sort (const Moss__GpuSortCreateInfo *info, Moss__GpuSort *out_sort);
+
+/*
+  @brief Destroys sort pipelines.
+  @param sort Sort pipelines. Safe to call on a zeroed struct.
+*/
+void moss__destroy_gpu_sort (Moss__GpuSort *sort);
+
+/*
+  @brief Creates sort resources of a frame.
+  @param sort Sort pipelines.
+  @param info Creation information.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_gpu_sort_frame (
+  const Moss__GpuSort           *sort,
+  const Moss__GpuSortCreateInfo *info,
+  Moss__GpuSortFrame            *out_frame
+);
+
+/*
+  @brief Destroys sort resources of a frame.
+  @param sort Sort pipelines.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_gpu_sort_frame (const Moss__GpuSort *sort, Moss__GpuSortFrame *frame);
+
+/*
+  @brief Records sorting of the frame's keys.
+  @details Must be recorded outside of a render pass. Index reads of the sorted
+           indices must wait for the sort, the sort doesn't record a barrier to
+           graphics stages, so it can be submitted to a compute-only queue.
+  @param sort Sort pipelines.
+  @param frame Frame resources with keys written to @c keys.
+  @param command_buffer Command buffer to record to.
+  @param count Number of keys to sort.
+*/
+void moss__record_gpu_sort (
+  const Moss__GpuSort      *sort,
+  const Moss__GpuSortFrame *frame,
+  VkCommandBuffer           command_buffer,
+  uint32_t                  count
+);
@@ -0,0 +1,133 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/gpu_timer.h
+  @brief GPU frame timer.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Writes a timestamp at the start and at the end of every frame's command
+           buffer. Results of a frame are read once its fence is signaled, so
+           reading never stalls.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+/* Max number of frames the timer can track. */
+#define MOSS__GPU_TIMER_MAX_FRAME_COUNT (uint32_t)(4)
+
+/*
+  @brief GPU frame timer.
+*/
+typedef struct
+{
+  /* Device the query pool was created on. */
+  VkDevice device;
+
+  /* Timestamp query pool, two queries per frame. */
+  VkQueryPool query_pool;
+
+  /* Number of tracked frames. */
+  uint32_t frame_count;
+
+  /* Nanoseconds per timestamp tick. */
+  float tick_period;
+
+  /* Mask of valid timestamp bits. */
+  uint64_t valid_bits_mask;
+
+  /* Whether the queue supports timestamps. Timer records nothing otherwise. */
+  bool is_supported;
+
+  /* Whether timestamps of the frame were recorded. */
+  bool is_frame_recorded[ MOSS__GPU_TIMER_MAX_FRAME_COUNT ];
+} Moss__GpuTimer;
+
+/*
+  @brief GPU timer creation information.
+*/
+typedef struct
+{
+  /* Physical device to query timestamp support on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create query pool on. */
+  VkDevice device;
+
+  /* Family of the queue command buffers are submitted to. */
+  uint32_t queue_family_index;
+
+  /* Number of frames to track. */
+  uint32_t frame_count;
+} Moss__GpuTimerCreateInfo;
+
+/*
+  @brief Creates GPU timer.
+  @details Succeeds without a query pool if the queue doesn't support timestamps.
+  @param info Creation information.
+  @param out_timer Output timer.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult
+moss__create_gpu_timer (const Moss__GpuTimerCreateInfo *info, Moss__GpuTimer *out_timer);
+
+/*
+  @brief Destroys GPU timer.
+  @param timer Timer. Safe to call on a zeroed struct.
+*/
+void moss__destroy_gpu_timer (Moss__GpuTimer *timer);
+
+/*
+  @brief Records frame start timestamp.
+  @details Must be recorded first in the command buffer, outside of a render pass.
+  @param timer Timer.
+  @param command_buffer Command buffer to record to.
+  @param frame Frame index.
+*/
+void moss__record_gpu_timer_begin (
+  Moss__GpuTimer *timer,
+  VkCommandBuffer command_buffer,
+  uint32_t        frame
+);
+
+/*
+  @brief Records frame end timestamp.
+  @param timer Timer.
+  @param command_buffer Command buffer to record to.
+  @param frame Frame index.
+*/
+void moss__record_gpu_timer_end (
+  Moss__GpuTimer *timer,
+  VkCommandBuffer command_buffer,
+  uint32_t        frame
+);
+
+/*
+  @brief Reads GPU time of a finished frame.
+  @param timer Timer.
+  @param frame Frame index. The frame's fence must be signaled.
+  @param out_seconds Output frame time in seconds.
+  @return true if the frame time is available, false otherwise.
+*/
+bool moss__read_gpu_timer (
+  const Moss__GpuTimer *timer,
+  uint32_t              frame,
+  float                *out_seconds
+);
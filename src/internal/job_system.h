@@ -0,0 +1,114 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/job_system.h
+  @brief Work-stealing job system internals.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "moss/job.h"
+#include "moss/result.h"
+
+/* Max number of threads executing jobs, including the engine thread. */
+#define MOSS__JOB_MAX_THREADS (uint32_t)(64)
+
+/* Capacity of every per-thread job deque. Must be a power of two. */
+#define MOSS__JOB_DEQUE_CAPACITY (uint32_t)(4096)
+
+/* Max number of jobs that can depend on a single job. */
+#define MOSS__JOB_MAX_CONTINUATIONS (uint32_t)(8)
+
+/*
+  @brief Job.
+*/
+struct MossJob
+{
+  /* Function to execute. */
+  MossJobFunction function;
+
+  /* User data to pass to the function. */
+  void *user_data;
+
+  /* Parent job, or NULL. */
+  MossJob *parent;
+
+  /* Number of unfinished parts: the job itself and its children. Atomic. */
+  uint32_t unfinished_count;
+
+  /* Number of reasons the job can't be queued yet: not submitted and unfinished
+     dependencies. Atomic. */
+  uint32_t blocker_count;
+
+  /* Number of jobs waiting for this one. */
+  uint32_t continuation_count;
+
+  /* Jobs waiting for this one. */
+  MossJob *continuations[ MOSS__JOB_MAX_CONTINUATIONS ];
+
+  /* Range function for parallel for jobs. */
+  MossJobRangeFunction range_function;
+
+  /* First index of the parallel for range. */
+  uint32_t range_begin;
+
+  /* Index past the last index of the parallel for range. */
+  uint32_t range_end;
+
+  /* Whether the slot holds a job that hasn't finished yet. Set by the creating
+     thread, cleared once the job and all of its children finish. Atomic. */
+  bool is_in_use;
+};
+
+/*
+  @brief Chase-Lev work-stealing deque.
+  @details The owner thread pushes and pops at the bottom, other threads steal
+           from the top.
+*/
+typedef struct
+{
+  /* Index of the oldest job. Atomic. */
+  int64_t top;
+
+  /* Index past the newest job. Atomic. */
+  int64_t bottom;
+
+  /* Job ring. */
+  MossJob *jobs[ MOSS__JOB_DEQUE_CAPACITY ];
+} Moss__JobDeque;
+
+/*
+  @brief Initializes job system and starts worker threads.
+  @details Calling thread becomes the thread with index zero.
+  @param config Job system configuration. May be NULL to use defaults.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__init_job_system (const MossJobSystemConfig *config);
+
+/*
+  @brief Stops worker threads.
+  @details Jobs that are still queued are executed before workers exit.
+*/
+void moss__deinit_job_system (void);
+
+/*
+  @brief Executes one queued job on the calling thread, if there is any.
+  @return True if a job was executed, false otherwise.
+*/
+bool moss__run_pending_job (void);
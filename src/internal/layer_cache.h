@@ -0,0 +1,255 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/layer_cache.h
+  @brief Cached sprite layers.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Every layer keeps its sprites in its own vertex crate and its last
+           render in its own image. A layer is only redrawn when its sprites
+           change, when it's invalidated or when the render extent changes. Every
+           frame cached images are composited into the scene beneath the sprites
+           of the frame, so static content costs a single fullscreen pass per
+           layer no matter how many sprites it holds.
+
+           Layers are drawn with the scene's sprite pipeline, so their render pass
+           mirrors the scene pass. With picking enabled it gets a scratch pick ID
+           attachment that is never stored, layer sprites aren't pickable.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/layer.h"
+#include "moss/result.h"
+#include "moss/vertex.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/sprite_kernels.h"
+
+/*
+  @brief Cached layer.
+*/
+typedef struct
+{
+  /* Vertices of the layer's sprites, host visible. */
+  Moss__Crate vertex_crate;
+
+  /* Mapped vertex crate. */
+  MossVertex *vertices;
+
+  /* Number of sprites the vertex crate fits. */
+  uint32_t sprite_capacity;
+
+  /* Number of sprites in the layer, empty layers aren't composited. */
+  uint32_t sprite_count;
+
+  /* Cached render of the layer. */
+  VkImage image;
+
+  /* Memory bound to the cached render. */
+  VkDeviceMemory memory;
+
+  /* View of the cached render. */
+  VkImageView image_view;
+
+  /* Framebuffer of the layer render pass. */
+  VkFramebuffer framebuffer;
+
+  /* Whether the cached render is out of date. */
+  bool is_dirty;
+
+  /* Render extent the cached render was drawn at. */
+  VkExtent2D rendered_extent;
+} Moss__Layer;
+
+/*
+  @brief Cached layers and their composite pipeline.
+*/
+typedef struct
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Color format of the scene. */
+  VkFormat format;
+
+  /* Full size of the scene. */
+  VkExtent2D extent;
+
+  /* Number of color attachments of the scene pass, 2 with picking enabled. */
+  uint32_t color_attachment_count;
+
+  /* Render pass layers are drawn with, compatible with the scene pass. */
+  VkRenderPass render_pass;
+
+  /* Scratch pick ID image shared by all layers, NULL with picking disabled. */
+  VkImage id_image;
+
+  /* Memory bound to the scratch pick ID image. */
+  VkDeviceMemory id_memory;
+
+  /* View of the scratch pick ID image. */
+  VkImageView id_image_view;
+
+  /* Sampler cached renders are read with. */
+  VkSampler sampler;
+
+  /* Layout of the composite input set. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Composite pipeline layout. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Composite pipeline. */
+  VkPipeline pipeline;
+
+  /* Layers, composited in index order. */
+  Moss__Layer layers[ MOSS_MAX_LAYER_COUNT ];
+} Moss__LayerCache;
+
+/*
+  @brief Layer cache creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Color format of the scene. */
+  VkFormat format;
+
+  /* Full size of the scene. */
+  VkExtent2D extent;
+
+  /* Descriptor cache the composite set layout is created with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Scene render pass layers are composited in. */
+  VkRenderPass scene_render_pass;
+
+  /* Number of color attachments of the scene pass. */
+  uint32_t color_attachment_count;
+} Moss__LayerCacheCreateInfo;
+
+/*
+  @brief Layer composite recording information.
+*/
+typedef struct
+{
+  /* Command buffer to record to, inside of the scene render pass. */
+  VkCommandBuffer command_buffer;
+
+  /* Size of the sub-rectangle the scene is rendered to. */
+  VkExtent2D render_extent;
+
+  /* Descriptor cache composite inputs are bound with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Descriptor cache resources of the current frame. */
+  Moss__DescriptorCacheFrame *descriptor_cache_frame;
+} Moss__RecordLayerCompositeInfo;
+
+/*
+  @brief Creates layer render pass and composite pipeline.
+  @param info Creation information.
+  @param out_cache Output layer cache.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_layer_cache (
+  const Moss__LayerCacheCreateInfo *info,
+  Moss__LayerCache                 *out_cache
+);
+
+/*
+  @brief Destroys layer cache and all layers.
+  @param cache Layer cache. Safe to call on a zeroed struct.
+*/
+void moss__destroy_layer_cache (Moss__LayerCache *cache);
+
+/*
+  @brief Recreates cached renders for a new scene extent.
+  @details The device must be idle. All layers are redrawn during the next frame.
+  @param cache Layer cache.
+  @param extent New full size of the scene.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__resize_layer_cache (Moss__LayerCache *cache, VkExtent2D extent);
+
+/*
+  @brief Replaces sprites of a layer and marks it dirty.
+  @details The GPU must not be using the layer's vertex crate.
+  @param cache Layer cache.
+  @param layer Layer index.
+  @param sprites Sprites of the layer, none to empty it.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__write_layer_sprites (
+  Moss__LayerCache      *cache,
+  uint32_t               layer,
+  const Moss__SpriteSoA *sprites
+);
+
+/*
+  @brief Begins layer render pass if the layer's cached render is out of date.
+  @details Sprites are drawn by the caller with the scene's sprite pipeline, then
+           the pass is ended with @ref moss__end_layer_pass. Clears to transparent.
+  @param cache Layer cache.
+  @param layer Layer index.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Size of the sub-rectangle the scene is rendered to.
+  @return Returns true if the pass has begun, false if the layer is up to date.
+*/
+bool moss__begin_layer_pass (
+  Moss__LayerCache *cache,
+  uint32_t          layer,
+  VkCommandBuffer   command_buffer,
+  VkExtent2D        render_extent
+);
+
+/*
+  @brief Ends layer render pass and marks the layer up to date.
+  @param cache Layer cache.
+  @param layer Layer index.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Size of the sub-rectangle the layer was rendered to.
+*/
+void moss__end_layer_pass (
+  Moss__LayerCache *cache,
+  uint32_t          layer,
+  VkCommandBuffer   command_buffer,
+  VkExtent2D        render_extent
+);
+
+/*
+  @brief Records composite of all non-empty layers.
+  @details Sets its own viewport and scissor. Pick IDs are left untouched.
+  @param cache Layer cache.
+  @param info Recording information.
+*/
+void moss__record_layer_composite (
+  const Moss__LayerCache               *cache,
+  const Moss__RecordLayerCompositeInfo *info
+);
@@ -0,0 +1,226 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/light_culling.h
+  @brief Tile-based 2D light culling.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details A compute pass splits the framebuffer into square tiles and lists lights
+           whose radius touches each tile. The sprite fragment shader then only
+           evaluates lights of its own tile, so shading cost follows the local
+           light density instead of the total number of lights.
+
+           Both passes share one descriptor set: binding 0 holds lights, binding 1
+           holds per-tile light lists of @ref MOSS__LIGHT_TILE_STRIDE uints, the
+           first of which is the list length.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/light.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+
+/* Tile side in pixels. */
+#define MOSS__LIGHT_TILE_SIZE (uint32_t)(16)
+
+/* Max number of lights affecting a single tile, extra lights are dropped. */
+#define MOSS__MAX_LIGHTS_PER_TILE (uint32_t)(127)
+
+/* Number of uints describing a single tile. */
+#define MOSS__LIGHT_TILE_STRIDE (MOSS__MAX_LIGHTS_PER_TILE + 1)
+
+/* Number of invocations in a culling workgroup. */
+#define MOSS__LIGHT_CULLING_WORKGROUP_SIZE (uint32_t)(64)
+
+/*
+  @brief Light layout shared with shaders, std430 compatible.
+*/
+typedef struct
+{
+  float position[ 2 ];  /* Light center. */
+  float radius;         /* Light radius. */
+  float intensity;      /* Intensity multiplier. */
+  float color[ 4 ];     /* Normalized RGBA color. */
+  float direction[ 2 ]; /* Normalized spot direction. */
+  float cos_cone;       /* Cosine of the spot half angle, -1 for point lights. */
+  float height;         /* Height above the sprite plane, 0 skips normal shading. */
+} Moss__GpuLight;
+
+/*
+  @brief Push constants of the sprite fragment shader.
+*/
+typedef struct
+{
+  float    ambient[ 4 ];   /* Ambient light color. */
+  uint32_t tile_count_x;   /* Number of tile columns. */
+  uint32_t light_count;    /* Number of lights, 0 skips tile lookups. */
+  uint32_t occluder_count; /* Number of occluders, 0 skips shadow lookups. */
+  float    render_scale;   /* Share of the tile grid extent being rendered. */
+} Moss__LightShadingPushConstants;
+
+/*
+  @brief Light culling pipeline shared by all frames.
+*/
+typedef struct
+{
+  /* Device the pipeline was created on. */
+  VkDevice device;
+
+  /* Light and tile bindings used by culling and sprite shaders. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Pipeline layout with culling push constants. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Culling pipeline. */
+  VkPipeline pipeline;
+} Moss__LightCulling;
+
+/*
+  @brief Light culling resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible light crate. */
+  Moss__Crate light_crate;
+
+  /* Persistently mapped memory of the light crate. */
+  Moss__GpuLight *lights;
+
+  /* Per-tile light lists. */
+  Moss__Crate tile_crate;
+
+  /* Framebuffer extent the tiles cover. */
+  VkExtent2D extent;
+
+  /* Number of tile columns. */
+  uint32_t tile_count_x;
+
+  /* Number of tile rows. */
+  uint32_t tile_count_y;
+
+  /* Descriptor pool of the frame's set. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Descriptor set with the frame's light and tile crates. */
+  VkDescriptorSet descriptor_set;
+} Moss__LightCullingFrame;
+
+/*
+  @brief Light culling creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Framebuffer extent to split into tiles. */
+  VkExtent2D extent;
+
+  /* Sharing mode of crates read by both compute and graphics queues. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__LightCullingCreateInfo;
+
+/*
+  @brief Converts a public light into its shader layout.
+  @param light Light to convert.
+  @param out_light Output shader light.
+*/
+void moss__pack_gpu_light (const MossLight *light, Moss__GpuLight *out_light);
+
+/*
+  @brief Creates light culling pipeline.
+  @param info Creation information.
+  @param out_culling Output culling pipeline.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_light_culling (
+  const Moss__LightCullingCreateInfo *info,
+  Moss__LightCulling                 *out_culling
+);
+
+/*
+  @brief Destroys light culling pipeline.
+  @param culling Culling pipeline. Safe to call on a zeroed struct.
+*/
+void moss__destroy_light_culling (Moss__LightCulling *culling);
+
+/*
+  @brief Creates light culling resources of a frame.
+  @param culling Culling pipeline.
+  @param info Creation information.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_light_culling_frame (
+  const Moss__LightCulling           *culling,
+  const Moss__LightCullingCreateInfo *info,
+  Moss__LightCullingFrame            *out_frame
+);
+
+/*
+  @brief Recreates tile lists of a frame for a new framebuffer extent.
+  @details The frame must not be in use by the device.
+  @param culling Culling pipeline.
+  @param info Creation information with the new extent.
+  @param frame Frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__resize_light_culling_frame (
+  const Moss__LightCulling           *culling,
+  const Moss__LightCullingCreateInfo *info,
+  Moss__LightCullingFrame            *frame
+);
+
+/*
+  @brief Destroys light culling resources of a frame.
+  @param culling Culling pipeline.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_light_culling_frame (
+  const Moss__LightCulling *culling,
+  Moss__LightCullingFrame  *frame
+);
+
+/*
+  @brief Records binning of the frame's lights into tiles.
+  @details Must be recorded outside of a render pass. Fragment shader reads of the
+           tile lists must wait for the culling, no barrier to graphics stages
+           is recorded, so it can be submitted to a compute-only queue.
+  @param culling Culling pipeline.
+  @param frame Frame resources with lights written to @c lights.
+  @param command_buffer Command buffer to record to.
+  @param light_count Number of lights to bin.
+*/
+void moss__record_light_culling (
+  const Moss__LightCulling      *culling,
+  const Moss__LightCullingFrame *frame,
+  VkCommandBuffer                command_buffer,
+  uint32_t                       light_count
+);
@@ -0,0 +1,215 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/offscreen_batch.h
+  @brief Offscreen target independent scenes are rendered to in one submission.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Scenes are laid out on a grid over a single offscreen image. All scenes
+           that fit the image are drawn in one render pass, changing only the
+           viewport between scenes, and copied out with a single copy that packs
+           them tightly into a host visible readback crate. Batches larger than
+           the image reuse it pass after pass within the same command buffer.
+
+           Scenes are drawn with the scene's sprite pipeline, so the render pass
+           mirrors the scene pass, with a scratch pick ID attachment when picking
+           is enabled.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/offscreen.h"
+#include "moss/result.h"
+#include "moss/vertex.h"
+
+#include "src/internal/crate.h"
+
+/*
+  @brief Offscreen batch target.
+*/
+typedef struct
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Color format of the scene. */
+  VkFormat format;
+
+  /* Number of color attachments of the scene pass, 2 with picking enabled. */
+  uint32_t color_attachment_count;
+
+  /* Render pass scenes are drawn with, compatible with the scene pass. */
+  VkRenderPass render_pass;
+
+  /* Offscreen image scenes are packed into, created on first use. */
+  VkImage image;
+
+  /* Memory bound to the offscreen image. */
+  VkDeviceMemory memory;
+
+  /* View of the offscreen image. */
+  VkImageView image_view;
+
+  /* Scratch pick ID image, NULL with picking disabled. */
+  VkImage id_image;
+
+  /* Memory bound to the scratch pick ID image. */
+  VkDeviceMemory id_memory;
+
+  /* View of the scratch pick ID image. */
+  VkImageView id_image_view;
+
+  /* Framebuffer of the offscreen pass. */
+  VkFramebuffer framebuffer;
+
+  /* Vertices of all scenes, host visible. */
+  Moss__Crate vertex_crate;
+
+  /* Mapped vertex crate. */
+  MossVertex *vertices;
+
+  /* Number of sprites the vertex crate fits. */
+  uint32_t sprite_capacity;
+
+  /* Pixels of all scenes, host visible. */
+  Moss__Crate readback_crate;
+
+  /* Mapped readback crate. */
+  const uint8_t *pixels;
+
+  /* Number of bytes the readback crate fits. */
+  VkDeviceSize pixel_capacity;
+} Moss__OffscreenBatch;
+
+/*
+  @brief Offscreen batch creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Color format of the scene. */
+  VkFormat format;
+
+  /* Number of color attachments of the scene pass. */
+  uint32_t color_attachment_count;
+} Moss__OffscreenBatchCreateInfo;
+
+/*
+  @brief Grid scenes are laid out on.
+*/
+typedef struct
+{
+  /* Number of scenes per row of the offscreen image. */
+  uint32_t column_count;
+
+  /* Number of scenes a single pass fits. */
+  uint32_t scenes_per_pass;
+} Moss__OffscreenGrid;
+
+/*
+  @brief Creates offscreen render pass.
+  @details Images and crates are created on first use.
+  @param info Creation information.
+  @param out_batch Output offscreen batch.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_offscreen_batch (
+  const Moss__OffscreenBatchCreateInfo *info,
+  Moss__OffscreenBatch                 *out_batch
+);
+
+/*
+  @brief Destroys offscreen batch.
+  @param batch Offscreen batch. Safe to call on a zeroed struct.
+*/
+void moss__destroy_offscreen_batch (Moss__OffscreenBatch *batch);
+
+/*
+  @brief Returns grid scenes of the given size are laid out on.
+  @param width Scene width, at most @ref MOSS_OFFSCREEN_TARGET_SIZE.
+  @param height Scene height, at most @ref MOSS_OFFSCREEN_TARGET_SIZE.
+  @return Scene grid.
+*/
+Moss__OffscreenGrid moss__get_offscreen_grid (uint32_t width, uint32_t height);
+
+/*
+  @brief Creates offscreen image and grows crates to fit a batch.
+  @details The GPU must not be using the batch.
+  @param batch Offscreen batch.
+  @param sprite_count Number of sprites of all scenes.
+  @param pixel_size Number of bytes of all scenes.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__reserve_offscreen_batch (
+  Moss__OffscreenBatch *batch,
+  uint32_t              sprite_count,
+  VkDeviceSize          pixel_size
+);
+
+/*
+  @brief Begins offscreen pass.
+  @details Clears the offscreen image to transparent black. Copies of earlier
+           passes finish before the pass writes.
+  @param batch Offscreen batch.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Part of the offscreen image scenes of the pass cover.
+*/
+void moss__begin_offscreen_pass (
+  const Moss__OffscreenBatch *batch,
+  VkCommandBuffer             command_buffer,
+  VkExtent2D                  render_extent
+);
+
+/*
+  @brief Records copy of the scenes of an ended pass into the readback crate.
+  @param batch Offscreen batch.
+  @param command_buffer Command buffer to record to.
+  @param grid Scene grid.
+  @param batch_info Batch the scenes belong to.
+  @param first_scene Index of the first scene of the pass.
+  @param scene_count Number of scenes of the pass.
+*/
+void moss__record_offscreen_readback (
+  const Moss__OffscreenBatch *batch,
+  VkCommandBuffer             command_buffer,
+  const Moss__OffscreenGrid  *grid,
+  const MossOffscreenBatch   *batch_info,
+  uint32_t                    first_scene,
+  uint32_t                    scene_count
+);
+
+/*
+  @brief Copies read back scenes into RGBA8 pixels.
+  @details The GPU must have finished the batch.
+  @param batch Offscreen batch.
+  @param pixel_size Number of bytes of all scenes.
+  @param out_pixels Output pixels.
+*/
+void moss__read_offscreen_pixels (
+  const Moss__OffscreenBatch *batch,
+  VkDeviceSize                pixel_size,
+  uint8_t                    *out_pixels
+);
@@ -0,0 +1,140 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/pick_readback.h
+  @brief Asynchronous readback of pick IDs.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Copies the pick ID under the cursor into a host visible crate right
+           after the scene pass. The ID is decoded once the frame's fence is
+           signaled, so picking never stalls and costs a single texel copy no
+           matter how many objects are drawn.
+
+           ID 0 means nothing was drawn. Sprites write their index in the frame
+           plus one, skinned meshes additionally set @ref MOSS__PICK_SKINNED_MESH_BIT.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/picking.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+
+/* Max number of frames the readback can track. */
+#define MOSS__PICK_READBACK_MAX_FRAME_COUNT (uint32_t)(4)
+
+/* Pick ID bit set by skinned meshes. */
+#define MOSS__PICK_SKINNED_MESH_BIT (uint32_t)(0x80000000)
+
+/*
+  @brief Pick ID readback.
+*/
+typedef struct
+{
+  /* Host visible crate with one pick ID per frame. */
+  Moss__Crate crate;
+
+  /* Persistently mapped memory of the crate. */
+  uint32_t *ids;
+
+  /* Number of tracked frames. */
+  uint32_t frame_count;
+
+  /* Whether a pick copy of the frame was recorded. */
+  bool is_frame_pending[ MOSS__PICK_READBACK_MAX_FRAME_COUNT ];
+
+  /* Coordinates the pick of the frame was requested at. */
+  float positions[ MOSS__PICK_READBACK_MAX_FRAME_COUNT ][ 2 ];
+} Moss__PickReadback;
+
+/*
+  @brief Pick ID readback creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create the crate on. */
+  VkDevice device;
+
+  /* Number of frames to track. */
+  uint32_t frame_count;
+} Moss__PickReadbackCreateInfo;
+
+/*
+  @brief Pick copy recording information.
+*/
+typedef struct
+{
+  /* Command buffer to record to, outside of a render pass. */
+  VkCommandBuffer command_buffer;
+
+  /* Frame index. */
+  uint32_t frame;
+
+  /* Pick ID image in the transfer source layout. */
+  VkImage id_image;
+
+  /* Texel of the ID image to copy. */
+  VkOffset2D texel;
+
+  /* Coordinates the pick was requested at, reported back with the result. */
+  float x;
+  float y;
+} Moss__RecordPickInfo;
+
+/*
+  @brief Creates pick ID readback.
+  @param info Creation information.
+  @param out_readback Output readback.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_pick_readback (
+  const Moss__PickReadbackCreateInfo *info,
+  Moss__PickReadback                 *out_readback
+);
+
+/*
+  @brief Destroys pick ID readback.
+  @param readback Readback. Safe to call on a zeroed struct.
+*/
+void moss__destroy_pick_readback (Moss__PickReadback *readback);
+
+/*
+  @brief Records copy of a pick ID into the frame's readback slot.
+  @details Must be recorded after the scene pass has ended.
+  @param readback Readback.
+  @param info Recording information.
+*/
+void moss__record_pick (Moss__PickReadback *readback, const Moss__RecordPickInfo *info);
+
+/*
+  @brief Reads pick of a finished frame.
+  @param readback Readback.
+  @param frame Frame index. The frame's fence must be signaled.
+  @param out_result Output pick result.
+  @return true if the frame had a pick recorded, false otherwise.
+*/
+bool moss__read_pick (
+  Moss__PickReadback *readback,
+  uint32_t            frame,
+  MossPickResult     *out_result
+);
@@ -0,0 +1,119 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/radix_sort_utils.h
+  @brief Radix sort utility functions.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/* Number of bits sorted by a single radix sort pass. */
+#define MOSS__RADIX_SORT_DIGIT_BITS (uint32_t)(8)
+
+/* Number of buckets of a single radix sort pass. */
+#define MOSS__RADIX_SORT_BUCKET_COUNT (uint32_t)(1 << MOSS__RADIX_SORT_DIGIT_BITS)
+
+/* Number of passes required to sort 64 bit keys. */
+#define MOSS__RADIX_SORT_PASS_COUNT (uint32_t)(64 / MOSS__RADIX_SORT_DIGIT_BITS)
+
+/*
+  @brief Sorts key/value pairs by key in ascending order.
+  @details Stable least significant digit radix sort. All digit histograms are built
+           in a single pass over the keys, and passes where every key has the same
+           digit are skipped, so narrow keys cost only as many passes as they have
+           distinct bytes.
+  @param keys Keys to sort. Sorted keys are written back here.
+  @param values Values to sort along with keys. Sorted values are written back here.
+  @param scratch_keys Scratch memory for @p count keys.
+  @param scratch_values Scratch memory for @p count values.
+  @param count Number of key/value pairs.
+*/
+inline static void moss__radix_sort_u64 (
+  uint64_t *const keys,
+  uint32_t *const values,
+  uint64_t *const scratch_keys,
+  uint32_t *const scratch_values,
+  const uint32_t  count
+)
+{
+  if (count < 2) { return; }
+
+  uint32_t histograms[ MOSS__RADIX_SORT_PASS_COUNT ][ MOSS__RADIX_SORT_BUCKET_COUNT ];
+  memset (histograms, 0, sizeof (histograms));
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    for (uint32_t pass = 0; pass < MOSS__RADIX_SORT_PASS_COUNT; ++pass)
+    {
+      const uint32_t shift = pass * MOSS__RADIX_SORT_DIGIT_BITS;
+      const uint32_t digit =
+        (uint32_t)(keys[ i ] >> shift) & (MOSS__RADIX_SORT_BUCKET_COUNT - 1);
+      ++histograms[ pass ][ digit ];
+    }
+  }
+
+  uint64_t *source_keys        = keys;
+  uint32_t *source_values      = values;
+  uint64_t *destination_keys   = scratch_keys;
+  uint32_t *destination_values = scratch_values;
+
+  for (uint32_t pass = 0; pass < MOSS__RADIX_SORT_PASS_COUNT; ++pass)
+  {
+    uint32_t *const histogram = histograms[ pass ];
+    const uint32_t  shift     = pass * MOSS__RADIX_SORT_DIGIT_BITS;
+
+    // Every key has the same digit, pass wouldn't change the order
+    const uint32_t any_digit =
+      (uint32_t)(source_keys[ 0 ] >> shift) & (MOSS__RADIX_SORT_BUCKET_COUNT - 1);
+    if (histogram[ any_digit ] == count) { continue; }
+
+    // Turn counts into bucket offsets
+    uint32_t offset = 0;
+    for (uint32_t bucket = 0; bucket < MOSS__RADIX_SORT_BUCKET_COUNT; ++bucket)
+    {
+      const uint32_t bucket_size = histogram[ bucket ];
+      histogram[ bucket ]        = offset;
+      offset += bucket_size;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const uint64_t key = source_keys[ i ];
+      const uint32_t digit =
+        (uint32_t)(key >> shift) & (MOSS__RADIX_SORT_BUCKET_COUNT - 1);
+      const uint32_t destination = histogram[ digit ]++;
+
+      destination_keys[ destination ]   = key;
+      destination_values[ destination ] = source_values[ i ];
+    }
+
+    uint64_t *const swap_keys   = source_keys;
+    uint32_t *const swap_values = source_values;
+    source_keys                 = destination_keys;
+    source_values               = destination_values;
+    destination_keys            = swap_keys;
+    destination_values          = swap_values;
+  }
+
+  if (source_keys != keys)
+  {
+    memcpy (keys, source_keys, sizeof (uint64_t) * count);
+    memcpy (values, source_values, sizeof (uint32_t) * count);
+  }
+}
@@ -0,0 +1,70 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/resolution_controller_utils.h
+  @brief Dynamic resolution controller utility functions.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <math.h>
+
+/* Lowest render scale the controller may choose. */
+#define MOSS__MIN_RENDER_SCALE (float)(0.5F)
+
+/* Share of the scale error corrected every frame. */
+#define MOSS__RENDER_SCALE_SMOOTHING (float)(0.1F)
+
+/* Relative frame time error the controller ignores, prevents scale jitter. */
+#define MOSS__FRAME_TIME_TOLERANCE (float)(0.05F)
+
+/*
+  @brief Render scale controller state.
+*/
+typedef struct
+{
+  float render_scale;      /* Share of the swap chain extent rendered per axis. */
+  float target_frame_time; /* GPU frame time to hold, in seconds. */
+} Moss__ResolutionController;
+
+/*
+  @brief Adjusts render scale towards the target frame time.
+  @details GPU cost of sprites follows the number of shaded pixels, which follows
+           the square of the render scale. The scale that would hit the target is
+           approached gradually, so a single slow frame doesn't cause a visible jump.
+  @param controller Controller to update.
+  @param gpu_frame_time Measured GPU time of a frame, in seconds.
+*/
+inline static void moss__update_resolution_controller (
+  Moss__ResolutionController *const controller,
+  const float                       gpu_frame_time
+)
+{
+  if (gpu_frame_time <= 0.0F || controller->target_frame_time <= 0.0F) { return; }
+
+  const float error = gpu_frame_time / controller->target_frame_time - 1.0F;
+  if (fabsf (error) < MOSS__FRAME_TIME_TOLERANCE) { return; }
+
+  const float desired_scale =
+    controller->render_scale * sqrtf (controller->target_frame_time / gpu_frame_time);
+
+  float scale = controller->render_scale +
+                (desired_scale - controller->render_scale) * MOSS__RENDER_SCALE_SMOOTHING;
+  if (scale < MOSS__MIN_RENDER_SCALE) { scale = MOSS__MIN_RENDER_SCALE; }
+  if (scale > 1.0F) { scale = 1.0F; }
+
+  controller->render_scale = scale;
+}
@@ -0,0 +1,174 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/scene_target.h
+  @brief Offscreen scene render target with sharpening upscale.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Sprites are drawn into an offscreen image the size of the swap chain, but
+           only into its top left sub-rectangle picked by the render scale. The
+           upscale pass stretches that sub-rectangle over the swap chain image and
+           sharpens it to recover edges lost by the lower resolution.
+
+           Keeping the image at full size means changing the render scale never
+           reallocates anything, only the render area and the viewport change.
+
+           With picking enabled the scene pass has a second R32_UINT attachment the
+           fragment shader writes pick IDs to. It is left in the transfer source
+           layout, so pixels under the cursor can be copied out after the pass.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+/* Format of the pick ID attachment. */
+#define MOSS__PICK_ID_FORMAT VK_FORMAT_R32_UINT
+
+/*
+  @brief Offscreen scene target and upscale pipeline.
+*/
+typedef struct
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Render pass that draws the scene into the target image. */
+  VkRenderPass render_pass;
+
+  /* Format of the target image. */
+  VkFormat format;
+
+  /* Full size of the target image. */
+  VkExtent2D extent;
+
+  /* Target image. */
+  VkImage image;
+
+  /* Memory bound to the target image. */
+  VkDeviceMemory memory;
+
+  /* View of the target image. */
+  VkImageView image_view;
+
+  /* Whether the scene pass writes pick IDs. */
+  bool is_picking_enabled;
+
+  /* Number of color attachments of the scene pass, 2 with picking enabled. */
+  uint32_t color_attachment_count;
+
+  /* Pick ID image, NULL with picking disabled. */
+  VkImage id_image;
+
+  /* Memory bound to the pick ID image. */
+  VkDeviceMemory id_memory;
+
+  /* View of the pick ID image. */
+  VkImageView id_image_view;
+
+  /* Framebuffer of the scene render pass. */
+  VkFramebuffer framebuffer;
+
+  /* Bilinear sampler the upscale pass reads the image with. */
+  VkSampler sampler;
+
+  /* Layout of the upscale input set. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Pool of the upscale input set. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Upscale input set with the target image. */
+  VkDescriptorSet descriptor_set;
+
+  /* Upscale pipeline layout. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Upscale pipeline. */
+  VkPipeline pipeline;
+} Moss__SceneTarget;
+
+/*
+  @brief Scene target creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Color format of the scene, usually the swap chain format. */
+  VkFormat format;
+
+  /* Full size of the scene, usually the swap chain extent. */
+  VkExtent2D extent;
+
+  /* Render pass the upscale pass is recorded in. */
+  VkRenderPass present_render_pass;
+
+  /* Whether to add the pick ID attachment. */
+  bool is_picking_enabled;
+} Moss__SceneTargetCreateInfo;
+
+/*
+  @brief Creates scene target.
+  @param info Creation information.
+  @param out_target Output scene target.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_scene_target (
+  const Moss__SceneTargetCreateInfo *info,
+  Moss__SceneTarget                 *out_target
+);
+
+/*
+  @brief Destroys scene target.
+  @param target Scene target. Safe to call on a zeroed struct.
+*/
+void moss__destroy_scene_target (Moss__SceneTarget *target);
+
+/*
+  @brief Recreates target image for a new extent.
+  @details The device must be idle.
+  @param target Scene target.
+  @param extent New full size of the scene.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__resize_scene_target (Moss__SceneTarget *target, VkExtent2D extent);
+
+/*
+  @brief Records upscale of the rendered sub-rectangle.
+  @details Must be recorded inside of the present render pass, after the scene
+           render pass has ended. Sets its own viewport and scissor.
+  @param target Scene target.
+  @param command_buffer Command buffer to record to.
+  @param render_extent Size of the sub-rectangle the scene was rendered to.
+  @param sharpness Sharpening strength, 0 disables sharpening.
+*/
+void moss__record_scene_upscale (
+  const Moss__SceneTarget *target,
+  VkCommandBuffer          command_buffer,
+  VkExtent2D               render_extent,
+  float                    sharpness
+);
@@ -35,3 +35,102 @@
            Shader source: example/shaders/shader.frag
 */
 #define MOSS__FRAG_SHADER_PATH "shaders/shader.frag.spv"
+
+/*
+  @brief Path to radix sort histogram compute shader SPIR-V file.
+  @details Counts key digits of every sort block.
+           Shader source: example/shaders/radix_sort_histogram.comp
+*/
+#define MOSS__RADIX_SORT_HISTOGRAM_SHADER_PATH "shaders/radix_sort_histogram.comp.spv"
+
+/*
+  @brief Path to radix sort scan compute shader SPIR-V file.
+  @details Turns block histograms into scatter offsets.
+           Shader source: example/shaders/radix_sort_scan.comp
+*/
+#define MOSS__RADIX_SORT_SCAN_SHADER_PATH "shaders/radix_sort_scan.comp.spv"
+
+/*
+  @brief Path to radix sort scatter compute shader SPIR-V file.
+  @details Stably moves keys and values to their sorted positions.
+           Shader source: example/shaders/radix_sort_scatter.comp
+*/
+#define MOSS__RADIX_SORT_SCATTER_SHADER_PATH "shaders/radix_sort_scatter.comp.spv"
+
+/*
+  @brief Path to sorted quad indices compute shader SPIR-V file.
+  @details Writes quad indices of sprites in sorted order.
+           Shader source: example/shaders/radix_sort_indices.comp
+*/
+#define MOSS__RADIX_SORT_INDICES_SHADER_PATH "shaders/radix_sort_indices.comp.spv"
+
+/*
+  @brief Path to light culling compute shader SPIR-V file.
+  @details Bins lights into screen tiles for the sprite fragment shader.
+           Shader source: example/shaders/light_culling.comp
+*/
+#define MOSS__LIGHT_CULLING_SHADER_PATH "shaders/light_culling.comp.spv"
+
+/*
+  @brief Path to shadow map compute shader SPIR-V file.
+  @details Builds 1D polar shadow maps of lights from occluder segments.
+           Shader source: example/shaders/shadow_map.comp
+*/
+#define MOSS__SHADOW_MAP_SHADER_PATH "shaders/shadow_map.comp.spv"
+
+/*
+  @brief Path to upscale vertex shader SPIR-V file.
+  @details Emits a fullscreen triangle for the upscale pass.
+           Shader source: example/shaders/upscale.vert
+*/
+#define MOSS__UPSCALE_VERT_SHADER_PATH "shaders/upscale.vert.spv"
+
+/*
+  @brief Path to upscale fragment shader SPIR-V file.
+  @details Stretches the scene sub-rectangle over the screen and sharpens it.
+           Shader source: example/shaders/upscale.frag
+*/
+#define MOSS__UPSCALE_FRAG_SHADER_PATH "shaders/upscale.frag.spv"
+
+/*
+  @brief Path to skinning vertex shader SPIR-V file.
+  @details Blends bone matrices of skinned mesh vertices by their weights.
+           Shader source: example/shaders/skinning.vert
+*/
+#define MOSS__SKINNING_VERT_SHADER_PATH "shaders/skinning.vert.spv"
+
+/*
+  @brief Path to virtual texture vertex shader SPIR-V file.
+  @details Places the virtual texture quad on the screen.
+           Shader source: example/shaders/virtual_texture.vert
+*/
+#define MOSS__VIRTUAL_TEXTURE_VERT_SHADER_PATH "shaders/virtual_texture.vert.spv"
+
+/*
+  @brief Path to virtual texture fragment shader SPIR-V file.
+  @details Samples resident tiles through the page table and writes tile feedback.
+           Shader source: example/shaders/virtual_texture.frag
+*/
+#define MOSS__VIRTUAL_TEXTURE_FRAG_SHADER_PATH "shaders/virtual_texture.frag.spv"
+
+/*
+  @brief Path to layer composite fragment shader SPIR-V file.
+  @details Copies a cached layer render over the scene, drawn with the upscale
+           vertex shader.
+           Shader source: example/shaders/layer_composite.frag
+*/
+#define MOSS__LAYER_COMPOSITE_FRAG_SHADER_PATH "shaders/layer_composite.frag.spv"
+
+/*
+  @brief Path to video vertex shader SPIR-V file.
+  @details Places the video quad on the screen.
+           Shader source: example/shaders/video.vert
+*/
+#define MOSS__VIDEO_VERT_SHADER_PATH "shaders/video.vert.spv"
+
+/*
+  @brief Path to video fragment shader SPIR-V file.
+  @details Samples the video through its Ycbcr conversion sampler.
+           Shader source: example/shaders/video.frag
+*/
+#define MOSS__VIDEO_FRAG_SHADER_PATH "shaders/video.frag.spv"
@@ -0,0 +1,174 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/shadow_map.h
+  @brief 1D polar shadow maps of 2D lights.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details A compute pass casts @ref MOSS__SHADOW_MAP_RESOLUTION rays around every
+           light and stores the distance to the nearest occluder along each of them.
+           The sprite fragment shader compares its own distance to the light with
+           the stored one, so occluders cost the CPU nothing but an upload.
+
+           The pass reads lights through the light culling set bound as set 0 and
+           uses its own set 1: binding 0 holds occluders, binding 1 holds shadow
+           maps of all lights, one row of distances per light.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/occluder.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+
+/* Number of angular bins of a light's shadow map. */
+#define MOSS__SHADOW_MAP_RESOLUTION (uint32_t)(256)
+
+/*
+  @brief Occluder layout shared with shaders, std430 compatible.
+*/
+typedef struct
+{
+  float start[ 2 ]; /* Segment start. */
+  float end[ 2 ];   /* Segment end. */
+} Moss__GpuOccluder;
+
+/*
+  @brief Shadow map pipeline shared by all frames.
+*/
+typedef struct
+{
+  /* Device the pipeline was created on. */
+  VkDevice device;
+
+  /* Occluder and shadow map bindings used by shadow and sprite shaders. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Pipeline layout with light and shadow sets. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Shadow map pipeline. */
+  VkPipeline pipeline;
+} Moss__ShadowMaps;
+
+/*
+  @brief Shadow map resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible occluder crate. */
+  Moss__Crate occluder_crate;
+
+  /* Persistently mapped memory of the occluder crate. */
+  Moss__GpuOccluder *occluders;
+
+  /* Shadow maps of all lights. */
+  Moss__Crate shadow_map_crate;
+
+  /* Descriptor pool of the frame's set. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Descriptor set with the frame's occluder and shadow map crates. */
+  VkDescriptorSet descriptor_set;
+} Moss__ShadowMapFrame;
+
+/*
+  @brief Shadow map creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Layout of the set lights are read from. */
+  VkDescriptorSetLayout light_descriptor_set_layout;
+
+  /* Sharing mode of crates read by both compute and graphics queues. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__ShadowMapCreateInfo;
+
+/*
+  @brief Creates shadow map pipeline.
+  @param info Creation information.
+  @param out_maps Output shadow map pipeline.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_shadow_maps (
+  const Moss__ShadowMapCreateInfo *info,
+  Moss__ShadowMaps                *out_maps
+);
+
+/*
+  @brief Destroys shadow map pipeline.
+  @param maps Shadow map pipeline. Safe to call on a zeroed struct.
+*/
+void moss__destroy_shadow_maps (Moss__ShadowMaps *maps);
+
+/*
+  @brief Creates shadow map resources of a frame.
+  @param maps Shadow map pipeline.
+  @param info Creation information.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_shadow_map_frame (
+  const Moss__ShadowMaps          *maps,
+  const Moss__ShadowMapCreateInfo *info,
+  Moss__ShadowMapFrame            *out_frame
+);
+
+/*
+  @brief Destroys shadow map resources of a frame.
+  @param maps Shadow map pipeline.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_shadow_map_frame (
+  const Moss__ShadowMaps *maps,
+  Moss__ShadowMapFrame   *frame
+);
+
+/*
+  @brief Records shadow map rendering of the frame's lights.
+  @details Must be recorded outside of a render pass. Fragment shader reads of the
+           shadow maps must wait for the pass, no barrier to graphics stages is
+           recorded, so it can be submitted to a compute-only queue.
+  @param maps Shadow map pipeline.
+  @param frame Frame resources with occluders written to @c occluders.
+  @param light_descriptor_set Set with the frame's lights.
+  @param command_buffer Command buffer to record to.
+  @param light_count Number of lights.
+  @param occluder_count Number of occluders.
+*/
+void moss__record_shadow_maps (
+  const Moss__ShadowMaps     *maps,
+  const Moss__ShadowMapFrame *frame,
+  VkDescriptorSet             light_descriptor_set,
+  VkCommandBuffer             command_buffer,
+  uint32_t                    light_count,
+  uint32_t                    occluder_count
+);
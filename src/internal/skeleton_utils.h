@@ -0,0 +1,135 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/skeleton_utils.h
+  @brief Bone hierarchy evaluation utility functions.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "moss/skeleton.h"
+
+/*
+  @brief 2D affine bone transform.
+  @details Transforms a point as x' = a * x + c * y + tx, y' = b * x + d * y + ty.
+*/
+typedef struct
+{
+  float a;  /* X axis X component. */
+  float b;  /* X axis Y component. */
+  float c;  /* Y axis X component. */
+  float d;  /* Y axis Y component. */
+  float tx; /* X translation. */
+  float ty; /* Y translation. */
+} Moss__BoneMatrix;
+
+/*
+  @brief Makes bone matrix from a local bone transform.
+  @param bone Bone transform.
+  @return Bone matrix that scales, rotates and then translates.
+*/
+inline static Moss__BoneMatrix moss__make_bone_matrix (const MossBone *const bone)
+{
+  const float cosine = cosf (bone->rotation);
+  const float sine   = sinf (bone->rotation);
+
+  return (Moss__BoneMatrix) {
+    .a  = cosine * bone->scale_x,
+    .b  = sine * bone->scale_x,
+    .c  = -sine * bone->scale_y,
+    .d  = cosine * bone->scale_y,
+    .tx = bone->x,
+    .ty = bone->y,
+  };
+}
+
+/*
+  @brief Multiplies bone matrices.
+  @param parent Matrix applied second.
+  @param child Matrix applied first.
+  @return Matrix equivalent to applying child and then parent.
+*/
+inline static Moss__BoneMatrix moss__multiply_bone_matrices (
+  const Moss__BoneMatrix *const parent,
+  const Moss__BoneMatrix *const child
+)
+{
+  return (Moss__BoneMatrix) {
+    .a  = parent->a * child->a + parent->c * child->b,
+    .b  = parent->b * child->a + parent->d * child->b,
+    .c  = parent->a * child->c + parent->c * child->d,
+    .d  = parent->b * child->c + parent->d * child->d,
+    .tx = parent->a * child->tx + parent->c * child->ty + parent->tx,
+    .ty = parent->b * child->tx + parent->d * child->ty + parent->ty,
+  };
+}
+
+/*
+  @brief Inverts bone matrix.
+  @param matrix Matrix to invert.
+  @param out_inverse Output inverse matrix.
+  @return Returns false if the matrix is degenerate, true otherwise.
+*/
+inline static bool moss__invert_bone_matrix (
+  const Moss__BoneMatrix *const matrix,
+  Moss__BoneMatrix *const       out_inverse
+)
+{
+  const float determinant = matrix->a * matrix->d - matrix->b * matrix->c;
+  if (determinant == 0.0F) { return false; }
+
+  const float inverse_determinant = 1.0F / determinant;
+
+  out_inverse->a  = matrix->d * inverse_determinant;
+  out_inverse->b  = -matrix->b * inverse_determinant;
+  out_inverse->c  = -matrix->c * inverse_determinant;
+  out_inverse->d  = matrix->a * inverse_determinant;
+  out_inverse->tx = -(out_inverse->a * matrix->tx + out_inverse->c * matrix->ty);
+  out_inverse->ty = -(out_inverse->b * matrix->tx + out_inverse->d * matrix->ty);
+
+  return true;
+}
+
+/*
+  @brief Evaluates world matrices of a bone hierarchy.
+  @details Parents always precede their children, so a single forward pass
+           resolves the whole hierarchy.
+  @param bones Local bone transforms.
+  @param parents Parent indices, @ref MOSS_BONE_PARENT_NONE for root bones.
+  @param count Number of bones.
+  @param out_world Output world matrices, @p count elements.
+*/
+inline static void moss__evaluate_skeleton (
+  const MossBone *const   bones,
+  const uint32_t *const   parents,
+  const uint32_t          count,
+  Moss__BoneMatrix *const out_world
+)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const Moss__BoneMatrix local = moss__make_bone_matrix (&bones[ i ]);
+
+    out_world[ i ] =
+      parents[ i ] == MOSS_BONE_PARENT_NONE
+        ? local
+        : moss__multiply_bone_matrices (&out_world[ parents[ i ] ], &local);
+  }
+}
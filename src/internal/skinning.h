@@ -0,0 +1,270 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/skinning.h
+  @brief GPU skinned skeletal meshes.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Meshes are uploaded once with their bind pose. Every frame only bone
+           matrices of submitted meshes are written into a single per-frame bone
+           crate, the skinning vertex shader blends them with vertex weights.
+
+           The skinning pipeline shares sets 0 and 1 and the fragment shader with
+           the sprite pipeline, so skinned meshes are lit the same way. Set 2
+           binding 0 holds bone matrices of the frame in flight, it is bound
+           through the descriptor cache.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/skeleton.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/light_culling.h"
+#include "src/internal/skeleton_utils.h"
+
+/*
+  @brief Bone matrix layout shared with shaders, std430 compatible.
+  @details Rows of the 2x3 affine skinning matrix, last components are unused.
+*/
+typedef struct
+{
+  float rows[ 2 ][ 4 ]; /* (a, c, tx, 0) and (b, d, ty, 0). */
+} Moss__GpuBoneMatrix;
+
+/*
+  @brief Push constants of the skinning vertex shader.
+  @details Placed right after @ref Moss__LightShadingPushConstants.
+*/
+typedef struct
+{
+  uint32_t first_bone; /* Index of the mesh's first bone in the frame's bone crate. */
+  uint32_t draw_index; /* Index of the draw in the frame, written as its pick ID. */
+} Moss__SkinningPushConstants;
+
+/*
+  @brief Uploaded skinned mesh.
+*/
+typedef struct
+{
+  Moss__Crate       vertex_crate; /* Device local vertex crate. */
+  Moss__Crate       index_crate;  /* Device local index crate. */
+  uint32_t          index_count;  /* Number of indices. */
+  uint32_t          bone_count;   /* Number of bones. */
+  uint32_t         *parents;      /* Parent indices of bones. */
+  Moss__BoneMatrix *inverse_bind; /* Inverse bind pose world matrices. */
+} Moss__SkinnedMesh;
+
+/*
+  @brief Skinned mesh draw submitted for a frame.
+*/
+typedef struct
+{
+  uint32_t mesh;       /* Mesh ID. */
+  uint32_t first_bone; /* Index of the draw's first bone in the frame's bone crate. */
+} Moss__SkinnedMeshDraw;
+
+/*
+  @brief Skinning pipeline and uploaded meshes.
+*/
+typedef struct
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Sharing mode of crates filled by the transfer queue. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  uint32_t shared_queue_family_indices[ 2 ];
+
+  /* Bone matrix binding used by the skinning vertex shader. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Skinning pipeline layout. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Skinning pipeline. */
+  VkPipeline pipeline;
+
+  /* Uploaded meshes, mesh IDs are their indices. */
+  Moss__SkinnedMesh meshes[ MOSS_MAX_SKINNED_MESH_COUNT ];
+
+  /* Number of uploaded meshes. */
+  uint32_t mesh_count;
+} Moss__Skinning;
+
+/*
+  @brief Skinning resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible bone matrix crate. */
+  Moss__Crate bone_crate;
+
+  /* Persistently mapped memory of the bone crate. */
+  Moss__GpuBoneMatrix *bones;
+
+  /* Draws submitted for the frame. */
+  Moss__SkinnedMeshDraw draws[ MOSS_MAX_SKINNED_MESH_DRAW_COUNT ];
+
+  /* Number of submitted draws. */
+  uint32_t draw_count;
+
+  /* Number of bones written to the bone crate. */
+  uint32_t bone_count;
+} Moss__SkinningFrame;
+
+/*
+  @brief Skinning creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Descriptor cache the bone set layout is created with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Render pass skinned meshes are drawn in. */
+  VkRenderPass render_pass;
+
+  /* Number of color attachments of the render pass. */
+  uint32_t color_attachment_count;
+
+  /* Light culling set layout, set 0 of the pipeline. */
+  VkDescriptorSetLayout light_descriptor_set_layout;
+
+  /* Shadow map set layout, set 1 of the pipeline. */
+  VkDescriptorSetLayout shadow_map_descriptor_set_layout;
+
+  /* Sharing mode of crates filled by the transfer queue. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__SkinningCreateInfo;
+
+/*
+  @brief Creates skinning pipeline.
+  @param info Creation information.
+  @param out_skinning Output skinning.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_skinning (
+  const Moss__SkinningCreateInfo *info,
+  Moss__Skinning                 *out_skinning
+);
+
+/*
+  @brief Destroys skinning pipeline and all uploaded meshes.
+  @param skinning Skinning. Safe to call on a zeroed struct.
+*/
+void moss__destroy_skinning (Moss__Skinning *skinning);
+
+/*
+  @brief Creates skinning resources of a frame.
+  @param skinning Skinning.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_skinning_frame (
+  const Moss__Skinning *skinning,
+  Moss__SkinningFrame  *out_frame
+);
+
+/*
+  @brief Destroys skinning resources of a frame.
+  @param skinning Skinning.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_skinning_frame (
+  const Moss__Skinning *skinning,
+  Moss__SkinningFrame  *frame
+);
+
+/*
+  @brief Uploads skinned mesh.
+  @param skinning Skinning.
+  @param info Mesh creation information.
+  @param transfer_queue Queue to upload the mesh on.
+  @param command_pool Command pool of the transfer queue family.
+  @param out_mesh Output mesh ID.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_skinned_mesh (
+  Moss__Skinning                  *skinning,
+  const MossSkinnedMeshCreateInfo *info,
+  VkQueue                          transfer_queue,
+  VkCommandPool                    command_pool,
+  uint32_t                        *out_mesh
+);
+
+/*
+  @brief Evaluates mesh pose and adds the mesh to the frame's draws.
+  @details The device must not be reading the frame's bone crate.
+  @param skinning Skinning.
+  @param frame Frame resources.
+  @param mesh_id Mesh ID.
+  @param pose Local bone transforms, parents are taken from the bind pose.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__push_skinned_mesh_draw (
+  const Moss__Skinning *skinning,
+  Moss__SkinningFrame  *frame,
+  uint32_t              mesh_id,
+  const MossBone       *pose
+);
+
+/*
+  @brief Records draws submitted for the frame.
+  @details Must be recorded inside of the scene render pass, after the viewport and
+           scissor are set. Rebinds the pipeline and all sets.
+  @param skinning Skinning.
+  @param frame Frame resources.
+  @param descriptor_cache Descriptor cache.
+  @param descriptor_cache_frame Descriptor cache resources of the frame.
+  @param command_buffer Command buffer to record to.
+  @param light_descriptor_set Light culling set of the frame.
+  @param shadow_map_descriptor_set Shadow map set of the frame.
+  @param shading_constants Light shading push constants of the frame.
+*/
+void moss__record_skinned_meshes (
+  const Moss__Skinning                  *skinning,
+  const Moss__SkinningFrame             *frame,
+  const Moss__DescriptorCache           *descriptor_cache,
+  Moss__DescriptorCacheFrame            *descriptor_cache_frame,
+  VkCommandBuffer                        command_buffer,
+  VkDescriptorSet                        light_descriptor_set,
+  VkDescriptorSet                        shadow_map_descriptor_set,
+  const Moss__LightShadingPushConstants *shading_constants
+);
@@ -0,0 +1,221 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/sprite_animation.h
+  @brief GPU evaluated sprite sheet animation.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Clips are uploaded once into device local crates. Every sprite only
+           carries a clip ID and a start time, the sprite vertex shader picks the
+           current frame from the time push constant and replaces the texture
+           coordinates of the sprite's corner with the frame rectangle.
+
+           The vertex shader reads set 2: binding 0 holds clips, binding 1 holds
+           frames of all clips, binding 2 holds per-sprite animation state of the
+           frame in flight, indexed by the sprite's vertex index divided by 4.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/animation.h"
+#include "moss/result.h"
+#include "moss/sprite.h"
+
+#include "src/internal/crate.h"
+
+/*
+  @brief Clip layout shared with shaders, std430 compatible.
+*/
+typedef struct
+{
+  uint32_t first_frame; /* Index of the clip's first frame. */
+  uint32_t frame_count; /* Number of frames. */
+  uint32_t loop_mode;   /* @ref MossAnimationLoopMode value. */
+  float    duration;    /* Sum of frame durations. */
+} Moss__GpuAnimationClip;
+
+/*
+  @brief Frame layout shared with shaders, std430 compatible.
+*/
+typedef struct
+{
+  float uv[ 4 ];      /* Left, top, right and bottom texture coordinates. */
+  float end_time;     /* Time since the clip start the frame ends at. */
+  float padding[ 3 ]; /* Pads the struct to its std430 alignment. */
+} Moss__GpuAnimationFrame;
+
+/*
+  @brief Per-sprite animation state shared with shaders, std430 compatible.
+*/
+typedef struct
+{
+  uint32_t clip;       /* Clip ID, @ref MOSS_ANIMATION_CLIP_NONE if not animated. */
+  float    start_time; /* Animation time the clip started playing at. */
+} Moss__GpuSpriteAnimation;
+
+/*
+  @brief Push constants of the sprite vertex shader.
+  @details Placed right after @ref Moss__LightShadingPushConstants.
+*/
+typedef struct
+{
+  float    time;        /* Current animation time in seconds. */
+  uint32_t is_animated; /* Whether the draw reads per-sprite animation state. */
+  uint32_t is_pickable; /* Whether the draw writes sprite pick IDs. */
+} Moss__SpriteAnimationPushConstants;
+
+/*
+  @brief Animation clips shared by all frames.
+*/
+typedef struct
+{
+  /* Device the objects were created on. */
+  VkDevice device;
+
+  /* Clip, frame and sprite state bindings used by the sprite vertex shader. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Device local clip crate. */
+  Moss__Crate clip_crate;
+
+  /* Device local frame crate. */
+  Moss__Crate frame_crate;
+
+  /* Number of uploaded clips. */
+  uint32_t clip_count;
+
+  /* Packed clips waiting to be recorded inline, NULL if there are none. */
+  Moss__GpuAnimationClip *pending_clips;
+
+  /* Packed frames waiting to be recorded inline. */
+  Moss__GpuAnimationFrame *pending_frames;
+
+  /* Number of pending frames. */
+  uint32_t pending_frame_count;
+} Moss__SpriteAnimation;
+
+/*
+  @brief Sprite animation resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible per-sprite animation state crate. */
+  Moss__Crate sprite_crate;
+
+  /* Persistently mapped memory of the sprite crate. */
+  Moss__GpuSpriteAnimation *sprites;
+
+  /* Descriptor pool of the frame's set. */
+  VkDescriptorPool descriptor_pool;
+
+  /* Descriptor set with clip, frame and the frame's sprite crates. */
+  VkDescriptorSet descriptor_set;
+} Moss__SpriteAnimationFrame;
+
+/*
+  @brief Sprite animation creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Sharing mode of crates filled by the transfer queue. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__SpriteAnimationCreateInfo;
+
+/*
+  @brief Creates sprite animation set layout and clip crates.
+  @param info Creation information.
+  @param out_animation Output sprite animation.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_sprite_animation (
+  const Moss__SpriteAnimationCreateInfo *info,
+  Moss__SpriteAnimation                 *out_animation
+);
+
+/*
+  @brief Destroys sprite animation.
+  @param animation Sprite animation. Safe to call on a zeroed struct.
+*/
+void moss__destroy_sprite_animation (Moss__SpriteAnimation *animation);
+
+/*
+  @brief Creates sprite animation resources of a frame.
+  @param animation Sprite animation.
+  @param info Creation information.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_sprite_animation_frame (
+  const Moss__SpriteAnimation           *animation,
+  const Moss__SpriteAnimationCreateInfo *info,
+  Moss__SpriteAnimationFrame            *out_frame
+);
+
+/*
+  @brief Destroys sprite animation resources of a frame.
+  @param animation Sprite animation.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_sprite_animation_frame (
+  const Moss__SpriteAnimation *animation,
+  Moss__SpriteAnimationFrame  *frame
+);
+
+/*
+  @brief Replaces all clips.
+  @details Clip sets that fit into inline crate updates are only packed and wait for
+           @ref moss__record_animation_clip_update. Larger sets wait for the device
+           to become idle and are uploaded through a staging crate right away.
+  @param animation Sprite animation.
+  @param clips Clips to upload, clip IDs are their indices.
+  @param count Number of clips.
+  @param transfer_queue Queue to upload clips on.
+  @param command_pool Command pool of the transfer queue family.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__upload_animation_clips (
+  Moss__SpriteAnimation   *animation,
+  const MossAnimationClip *clips,
+  uint32_t                 count,
+  VkQueue                  transfer_queue,
+  VkCommandPool            command_pool
+);
+
+/*
+  @brief Records pending inline clip update.
+  @details Must be recorded outside of any render pass, before sprites are drawn.
+           Does nothing if no clips are pending.
+  @param animation Sprite animation.
+  @param command_buffer Graphics command buffer to record to.
+*/
+void moss__record_animation_clip_update (
+  Moss__SpriteAnimation *animation,
+  VkCommandBuffer        command_buffer
+);
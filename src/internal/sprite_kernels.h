@@ -0,0 +1,154 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/sprite_kernels.h
+  @brief Sprite vertex generation kernels.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Kernels expand sprites stored as structure of arrays into four
+           @ref MossVertex corners each, writing them straight to the destination
+           (usually mapped vertex crate memory). Corners are emitted in the
+           top-left, top-right, bottom-right, bottom-left order, so every sprite is
+           drawn with indices { 0, 1, 2, 2, 3, 0 } offset by 4 * sprite index.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "moss/vertex.h"
+
+/* Number of vertices generated per sprite. */
+#define MOSS__SPRITE_VERTEX_COUNT (uint32_t)(4)
+
+/* Number of indices used to draw a sprite. */
+#define MOSS__SPRITE_INDEX_COUNT (uint32_t)(6)
+
+/*
+  @brief Sprites stored as structure of arrays.
+  @details Every non-NULL array must contain at least @c count elements.
+*/
+typedef struct
+{
+  const float *x;        /* Sprite center X coordinates. */
+  const float *y;        /* Sprite center Y coordinates. */
+  const float *rotation; /* Rotations in radians. NULL means no rotation. */
+  const float *scale_x;  /* Sprite widths. */
+  const float *scale_y;  /* Sprite heights. */
+
+  /* Texture rectangles. NULL means the whole texture ([0, 1] range). */
+  const float *uv_left;   /* Left texture coordinates. */
+  const float *uv_top;    /* Top texture coordinates. */
+  const float *uv_right;  /* Right texture coordinates. */
+  const float *uv_bottom; /* Bottom texture coordinates. */
+
+  /* Colors packed as RGBA8, red in the least significant byte. NULL means white. */
+  const uint32_t *color;
+
+  /* Texture indices. NULL means texture zero. */
+  const uint32_t *texture_index;
+
+  uint32_t count; /* Number of sprites. */
+} Moss__SpriteSoA;
+
+/*
+  @brief Sprite vertex generation kernel.
+  @param sprites Sprites to expand.
+  @param first Index of the first sprite to expand.
+  @param count Number of sprites to expand.
+  @param out_vertices Destination for count * 4 vertices.
+*/
+typedef void (*Moss__SpriteVertexKernel) (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+
+/*
+  @brief Scalar reference kernel.
+  @details Uses libm sin/cos, SIMD kernels are expected to match it within 1e-5.
+*/
+void moss__generate_sprite_vertices_scalar (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+
+#if defined(__x86_64__)
+/*
+  @brief SSE2 kernel. Processes 4 sprites per iteration.
+*/
+void moss__generate_sprite_vertices_sse2 (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+
+/*
+  @brief AVX2 kernel. Processes 8 sprites per iteration.
+  @warning Must only be called when the CPU supports AVX2.
+*/
+void moss__generate_sprite_vertices_avx2 (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+/*
+  @brief NEON kernel. Processes 4 sprites per iteration.
+*/
+void moss__generate_sprite_vertices_neon (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+#endif
+
+/*
+  @brief Returns the fastest kernel supported by the running CPU.
+  @return Kernel function.
+*/
+Moss__SpriteVertexKernel moss__select_sprite_vertex_kernel (void);
+
+/*
+  @brief Expands sprites with the fastest available kernel.
+  @param sprites Sprites to expand.
+  @param first Index of the first sprite to expand.
+  @param count Number of sprites to expand.
+  @param out_vertices Destination for count * 4 vertices.
+*/
+void moss__generate_sprite_vertices (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+
+/*
+  @brief Expands sprites splitting the work between job threads.
+  @details Small batches are expanded on the calling thread.
+  @param sprites Sprites to expand.
+  @param out_vertices Destination for sprites->count * 4 vertices.
+*/
+void moss__generate_sprite_vertices_parallel (
+  const Moss__SpriteSoA *sprites,
+  MossVertex            *out_vertices
+);
@@ -91,6 +91,18 @@ moss__get_vk_vertex_input_attribute_description (void)
      .location = 1,
      .format   = VK_FORMAT_R32G32B32_SFLOAT,
      .offset   = offsetof (MossVertex,    color),
+     },
+    {
+     .binding  = 0,
+     .location = 2,
+     .format   = VK_FORMAT_R32G32_SFLOAT,
+     .offset   = offsetof (MossVertex, texture_coordinates),
+     },
+    {
+     .binding  = 0,
+     .location = 3,
+     .format   = VK_FORMAT_R32_UINT,
+     .offset   = offsetof (MossVertex, texture_index),
      }
   };
 
@@ -0,0 +1,256 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/video_texture.h
+  @brief Multi-planar YUV video texture.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Decoded NV12 and I420 frames are written into a per-frame staging
+           crate as they are, copied into the planes of a multi-planar image and
+           sampled through a sampler Ycbcr conversion. Color conversion and
+           chroma upsampling happen in the sampler, so frames are never converted
+           to RGB on the CPU or in a separate pass.
+
+           Ycbcr conversion samplers must be immutable, so the set layout and
+           the pipeline are created per opened video.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/video.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/descriptor_cache.h"
+
+/*
+  @brief Push constants of the video shaders.
+*/
+typedef struct
+{
+  float rect[ 4 ]; /* Screen rectangle, x, y, width and height. */
+} Moss__VideoPushConstants;
+
+/*
+  @brief Video pipeline and the open video's image.
+*/
+typedef struct
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Whether sampler Ycbcr conversion is enabled on the device. */
+  bool is_supported;
+
+  /* Descriptor cache set layouts are created with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Scene render pass videos are drawn in. */
+  VkRenderPass render_pass;
+
+  /* Number of color attachments of the scene pass. */
+  uint32_t color_attachment_count;
+
+  /* Whether a video is open. */
+  bool is_open;
+
+  /* Multi-planar format of the open video. */
+  VkFormat format;
+
+  /* Number of planes of the open video. */
+  uint32_t plane_count;
+
+  /* Width of every plane in texels. */
+  uint32_t plane_widths[ MOSS_MAX_VIDEO_PLANE_COUNT ];
+
+  /* Height of every plane in texels. */
+  uint32_t plane_heights[ MOSS_MAX_VIDEO_PLANE_COUNT ];
+
+  /* Size of a texel of every plane in bytes. */
+  uint32_t plane_texel_sizes[ MOSS_MAX_VIDEO_PLANE_COUNT ];
+
+  /* Offsets of tightly packed planes in a staging crate. */
+  VkDeviceSize plane_offsets[ MOSS_MAX_VIDEO_PLANE_COUNT ];
+
+  /* Size of a tightly packed frame in bytes. */
+  VkDeviceSize frame_size;
+
+  /* Ycbcr to RGB conversion of the open video. */
+  VkSamplerYcbcrConversion conversion;
+
+  /* Immutable sampler with the conversion attached. */
+  VkSampler sampler;
+
+  /* Multi-planar video image. */
+  VkImage image;
+
+  /* Memory bound to the video image. */
+  VkDeviceMemory memory;
+
+  /* View of the video image with the conversion attached. */
+  VkImageView image_view;
+
+  /* Whether a frame has been copied to the image. */
+  bool is_image_initialized;
+
+  /* Layout of the video set, with the immutable sampler. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Video pipeline layout. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Video pipeline. */
+  VkPipeline pipeline;
+} Moss__VideoTexture;
+
+/*
+  @brief Video upload resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible staging crate frames are written to. */
+  Moss__Crate staging_crate;
+
+  /* Mapped staging crate. */
+  uint8_t *staging;
+
+  /* Whether the staging crate holds a frame not copied yet. */
+  bool is_upload_pending;
+} Moss__VideoTextureFrame;
+
+/*
+  @brief Video texture creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Whether sampler Ycbcr conversion is enabled on the device. */
+  bool is_ycbcr_conversion_enabled;
+
+  /* Descriptor cache set layouts are created with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Scene render pass videos are drawn in. */
+  VkRenderPass render_pass;
+
+  /* Number of color attachments of the scene pass. */
+  uint32_t color_attachment_count;
+} Moss__VideoTextureCreateInfo;
+
+/*
+  @brief Video draw recording information.
+*/
+typedef struct
+{
+  /* Command buffer to record to, inside of the scene render pass. */
+  VkCommandBuffer command_buffer;
+
+  /* Size of the sub-rectangle the scene is rendered to. */
+  VkExtent2D render_extent;
+
+  /* Placement of the video, NULL to skip the draw. */
+  const MossVideoView *view;
+
+  /* Descriptor cache the video is bound with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Descriptor cache resources of the current frame. */
+  Moss__DescriptorCacheFrame *descriptor_cache_frame;
+} Moss__RecordVideoInfo;
+
+/*
+  @brief Creates video texture without an open video.
+  @param info Creation information.
+  @param out_texture Output video texture.
+*/
+void moss__create_video_texture (
+  const Moss__VideoTextureCreateInfo *info,
+  Moss__VideoTexture                 *out_texture
+);
+
+/*
+  @brief Closes open video.
+  @details The device must be idle.
+  @param texture Video texture. Safe to call on a zeroed struct.
+*/
+void moss__close_video_texture (Moss__VideoTexture *texture);
+
+/*
+  @brief Opens video, creating its image, conversion and pipeline.
+  @details Closes the previously open video. The device must be idle.
+  @param texture Video texture.
+  @param info Video information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult
+moss__open_video_texture (Moss__VideoTexture *texture, const MossVideoCreateInfo *info);
+
+/*
+  @brief Destroys video upload resources of a frame.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_video_texture_frame (Moss__VideoTextureFrame *frame);
+
+/*
+  @brief Writes decoded video frame into the staging crate of a frame.
+  @details The GPU must not be using the frame's staging crate. The staging crate
+           is created on first use.
+  @param texture Video texture with an open video.
+  @param frame Frame resources.
+  @param video_frame Decoded video frame.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__write_video_frame (
+  const Moss__VideoTexture *texture,
+  Moss__VideoTextureFrame  *frame,
+  const MossVideoFrame     *video_frame
+);
+
+/*
+  @brief Records copy of the written frame into the video image.
+  @details Must be recorded outside of a render pass, before the draw.
+  @param texture Video texture.
+  @param frame Frame resources.
+  @param command_buffer Command buffer to record to.
+*/
+void moss__record_video_upload (
+  Moss__VideoTexture      *texture,
+  Moss__VideoTextureFrame *frame,
+  VkCommandBuffer          command_buffer
+);
+
+/*
+  @brief Records video draw.
+  @details Sets its own viewport and scissor. Draws nothing until a frame has
+           been uploaded.
+  @param texture Video texture.
+  @param info Recording information.
+*/
+void moss__record_video (
+  const Moss__VideoTexture    *texture,
+  const Moss__RecordVideoInfo *info
+);
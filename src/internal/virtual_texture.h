@@ -0,0 +1,416 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/virtual_texture.h
+  @brief Software virtual texturing of images that don't fit into VRAM.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Only tiles the screen actually shows live on the GPU, in a fixed size
+           physical page atlas. A page table crate maps every tile of every level
+           to its atlas page, 0 meaning the tile isn't resident. The fragment
+           shader falls back to the closest resident coarser level, so something
+           is always shown while finer tiles stream in.
+
+           Feedback is rendered at an eighth of the resolution per axis: every
+           frame one pixel of each 8x8 block, rotating through the block, writes
+           the tile it wants into a host visible feedback crate. Once the frame's
+           fence is signaled the requested tiles are read from the tiled file
+           with async I/O, then copied into least recently used atlas pages.
+
+           VRAM use doesn't depend on the image size apart from the page table,
+           which takes 4 bytes per tile.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/virtual_texture.h"
+
+#include "src/internal/async_io.h"
+#include "src/internal/crate.h"
+#include "src/internal/descriptor_cache.h"
+
+/* Number of atlas pages per atlas row and column. */
+#define MOSS__VIRTUAL_TEXTURE_ATLAS_PAGES_PER_ROW (uint32_t)(16)
+
+/* Number of physical pages of the atlas. */
+#define MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT \
+  (uint32_t)(MOSS__VIRTUAL_TEXTURE_ATLAS_PAGES_PER_ROW * \
+             MOSS__VIRTUAL_TEXTURE_ATLAS_PAGES_PER_ROW)
+
+/* Number of bytes of a single tile. */
+#define MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE \
+  (uint32_t)(MOSS_VIRTUAL_TEXTURE_PAGE_SIZE * MOSS_VIRTUAL_TEXTURE_PAGE_SIZE * 4)
+
+/* Number of tiles that can be read from the file at the same time. */
+#define MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT (uint32_t)(32)
+
+/* Max number of tiles copied into the atlas per frame. */
+#define MOSS__VIRTUAL_TEXTURE_MAX_UPLOAD_COUNT (uint32_t)(16)
+
+/* Screen pixels per feedback texel, per axis. */
+#define MOSS__VIRTUAL_TEXTURE_FEEDBACK_STRIDE (uint32_t)(8)
+
+/* Max feedback size per axis. */
+#define MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE (uint32_t)(512)
+
+/* Max number of tiles of the coarsest level, those stay resident all the time. */
+#define MOSS__VIRTUAL_TEXTURE_MAX_ROOT_TILE_COUNT (uint32_t)(16)
+
+/*
+  @brief Level layout shared with shaders, std430 compatible.
+  @details Stored at the start of the page table crate, one per possible level.
+*/
+typedef struct
+{
+  uint32_t tile_count_x; /* Number of tile columns. */
+  uint32_t tile_count_y; /* Number of tile rows. */
+  uint32_t first_tile;   /* Index of the level's first tile in the page table. */
+  uint32_t reserved;     /* Padding. */
+} Moss__VirtualTextureLevel;
+
+/*
+  @brief Push constants of the virtual texture shaders.
+*/
+typedef struct
+{
+  float    rect[ 4 ];       /* Screen rectangle, x, y, width and height. */
+  float    uv_rect[ 4 ];    /* Shown image region, left, top, right and bottom. */
+  uint32_t image_size[ 2 ]; /* Size of level 0 in texels. */
+  uint32_t level_count;     /* Number of levels. */
+  uint32_t feedback_width;  /* Feedback width, rows are this many entries long. */
+  uint32_t feedback_height; /* Feedback height. */
+  uint32_t feedback_phase;  /* Pixel of every 8x8 block that writes feedback. */
+  uint32_t reserved[ 2 ];   /* Padding. */
+} Moss__VirtualTexturePushConstants;
+
+/*
+  @brief State of a tile read slot.
+*/
+typedef enum
+{
+  MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE,      /* Slot is unused. */
+  MOSS__VIRTUAL_TEXTURE_LOAD_STATE_LOADING,   /* Tile is being read from the file. */
+  MOSS__VIRTUAL_TEXTURE_LOAD_STATE_LOADED,    /* Tile waits for an atlas page. */
+  MOSS__VIRTUAL_TEXTURE_LOAD_STATE_UPLOADING, /* Copy to the atlas is in flight. */
+} Moss__VirtualTextureLoadState;
+
+typedef struct Moss__VirtualTexture Moss__VirtualTexture;
+
+/*
+  @brief Tile read slot, owns a page sized region of the staging crate.
+*/
+typedef struct
+{
+  Moss__VirtualTexture         *owner; /* Virtual texture the slot belongs to. */
+  Moss__VirtualTextureLoadState state; /* Slot state. */
+  uint32_t                      tile;  /* Tile being loaded. */
+} Moss__VirtualTextureLoad;
+
+/*
+  @brief Virtual texture pipeline, page atlas and the open image.
+*/
+struct Moss__VirtualTexture
+{
+  /* Physical device memory is allocated on. */
+  VkPhysicalDevice physical_device;
+
+  /* Device objects were created on. */
+  VkDevice device;
+
+  /* Sharing mode of crates filled by the transfer queue. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  uint32_t shared_queue_family_indices[ 2 ];
+
+  /* Whether the device can write feedback from fragment shaders. */
+  bool is_supported;
+
+  /* Page table, atlas and feedback bindings. */
+  VkDescriptorSetLayout descriptor_set_layout;
+
+  /* Virtual texture pipeline layout. */
+  VkPipelineLayout pipeline_layout;
+
+  /* Virtual texture pipeline. */
+  VkPipeline pipeline;
+
+  /* Physical page atlas. */
+  VkImage atlas_image;
+
+  /* Memory bound to the atlas. */
+  VkDeviceMemory atlas_memory;
+
+  /* View of the atlas. */
+  VkImageView atlas_image_view;
+
+  /* Bilinear sampler the atlas is read with. */
+  VkSampler sampler;
+
+  /* Whether the atlas left the undefined layout. */
+  bool is_atlas_initialized;
+
+  /* Host visible staging crate with one page per read slot. */
+  Moss__Crate staging_crate;
+
+  /* Persistently mapped memory of the staging crate. */
+  uint8_t *staging;
+
+  /* Tile read slots. */
+  Moss__VirtualTextureLoad loads[ MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT ];
+
+  /* Tile each atlas page holds, UINT32_MAX for free pages. */
+  uint32_t atlas_tiles[ MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT ];
+
+  /* Frame each atlas page was last requested in, UINT32_MAX for pinned pages. */
+  uint32_t atlas_last_used[ MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT ];
+
+  /* Number of frames begun so far. */
+  uint32_t frame_number;
+
+  /* === Open image === */
+  /* Whether an image is open. */
+  bool is_open;
+  /* File descriptor of the open image. */
+  int file_descriptor;
+  /* Header of the open image. */
+  MossVirtualTextureFileHeader header;
+  /* Level layouts. */
+  Moss__VirtualTextureLevel levels[ MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT ];
+  /* Number of tiles of all levels. */
+  uint32_t tile_count;
+  /* Device local page table, level layouts followed by one entry per tile. */
+  Moss__Crate page_table_crate;
+  /* Host copy of the page table entries. */
+  uint32_t *page_table;
+  /* Atlas page of every tile plus one, 0 if not resident, UINT16_MAX if loading. */
+  uint16_t *tile_pages;
+  /* Frame every tile was last requested in. */
+  uint32_t *tile_request_frames;
+  /* Whether the last processed feedback asked for tiles that aren't resident. */
+  bool is_refining;
+};
+
+/*
+  @brief Virtual texture resources of a single frame in flight.
+*/
+typedef struct
+{
+  /* Host visible feedback crate. */
+  Moss__Crate feedback_crate;
+
+  /* Persistently mapped memory of the feedback crate. */
+  uint32_t *feedback;
+
+  /* Feedback width the frame was recorded with, 0 if nothing was recorded. */
+  uint32_t feedback_width;
+
+  /* Feedback height the frame was recorded with. */
+  uint32_t feedback_height;
+
+  /* Read slots whose copies were recorded in the frame. */
+  uint32_t uploaded_loads[ MOSS__VIRTUAL_TEXTURE_MAX_UPLOAD_COUNT ];
+
+  /* Number of recorded copies. */
+  uint32_t uploaded_load_count;
+} Moss__VirtualTextureFrame;
+
+/*
+  @brief Virtual texture creation information.
+*/
+typedef struct
+{
+  /* Physical device to allocate memory on. */
+  VkPhysicalDevice physical_device;
+
+  /* Logical device to create objects on. */
+  VkDevice device;
+
+  /* Whether fragmentStoresAndAtomics is enabled on the device. */
+  bool is_fragment_store_enabled;
+
+  /* Descriptor cache the set layout is created with. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Render pass the virtual texture is drawn in. */
+  VkRenderPass render_pass;
+
+  /* Number of color attachments of the render pass. */
+  uint32_t color_attachment_count;
+
+  /* Sharing mode of crates filled by the transfer queue. */
+  VkSharingMode sharing_mode;
+
+  /* Number of queue families sharing the crates. */
+  uint32_t shared_queue_family_index_count;
+
+  /* Queue families sharing the crates. */
+  const uint32_t *shared_queue_family_indices;
+} Moss__VirtualTextureCreateInfo;
+
+/*
+  @brief Virtual texture draw recording information.
+*/
+typedef struct
+{
+  /* Command buffer to record to, inside of the scene render pass. */
+  VkCommandBuffer command_buffer;
+
+  /* Size of the sub-rectangle the scene is rendered to. */
+  VkExtent2D render_extent;
+
+  /* Where to show the image. */
+  const MossVirtualTextureView *view;
+
+  /* Descriptor cache. */
+  const Moss__DescriptorCache *descriptor_cache;
+
+  /* Descriptor cache resources of the frame. */
+  Moss__DescriptorCacheFrame *descriptor_cache_frame;
+} Moss__RecordVirtualTextureInfo;
+
+/*
+  @brief Creates virtual texture pipeline, page atlas and staging crate.
+  @details Succeeds without creating anything if fragment stores aren't enabled.
+  @param info Creation information.
+  @param out_texture Output virtual texture.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_virtual_texture (
+  const Moss__VirtualTextureCreateInfo *info,
+  Moss__VirtualTexture                 *out_texture
+);
+
+/*
+  @brief Destroys virtual texture.
+  @details The open image must be closed first.
+  @param texture Virtual texture. Safe to call on a zeroed struct.
+*/
+void moss__destroy_virtual_texture (Moss__VirtualTexture *texture);
+
+/*
+  @brief Creates virtual texture resources of a frame.
+  @param texture Virtual texture.
+  @param out_frame Output frame resources.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__create_virtual_texture_frame (
+  const Moss__VirtualTexture *texture,
+  Moss__VirtualTextureFrame  *out_frame
+);
+
+/*
+  @brief Destroys virtual texture resources of a frame.
+  @param texture Virtual texture.
+  @param frame Frame resources. Safe to call on a zeroed struct.
+*/
+void moss__destroy_virtual_texture_frame (
+  const Moss__VirtualTexture *texture,
+  Moss__VirtualTextureFrame  *frame
+);
+
+/*
+  @brief Opens tiled image file and starts streaming its coarsest level.
+  @details Closes the previously open image. The device must be idle.
+  @param texture Virtual texture.
+  @param path Path to the file.
+  @param async_io Reader tiles are streamed with.
+  @param transfer_queue Queue to upload the empty page table on.
+  @param command_pool Command pool of the transfer queue family.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+MossResult moss__open_virtual_texture (
+  Moss__VirtualTexture *texture,
+  const char           *path,
+  Moss__AsyncIo        *async_io,
+  VkQueue               transfer_queue,
+  VkCommandPool         command_pool
+);
+
+/*
+  @brief Closes open image.
+  @details Waits for reads in flight. The device must be idle.
+  @param texture Virtual texture.
+  @param async_io Reader tiles are streamed with.
+*/
+void moss__close_virtual_texture (Moss__VirtualTexture *texture, Moss__AsyncIo *async_io);
+
+/*
+  @brief Processes feedback of a finished frame and requests missing tiles.
+  @details Must be called once the frame's fence has signaled.
+  @param texture Virtual texture.
+  @param frame Frame resources.
+  @param async_io Reader tiles are streamed with.
+*/
+void moss__begin_virtual_texture_frame (
+  Moss__VirtualTexture      *texture,
+  Moss__VirtualTextureFrame *frame,
+  Moss__AsyncIo             *async_io
+);
+
+/*
+  @brief Checks if tiles are still being streamed in.
+  @details True while reads or atlas copies are in flight, or while the last
+           processed feedback asked for tiles that aren't resident yet.
+  @param texture Virtual texture.
+  @return Returns true if more frames are needed to finish streaming.
+*/
+bool moss__is_virtual_texture_streaming (const Moss__VirtualTexture *texture);
+
+/*
+  @brief Records copies of loaded tiles into the atlas and page table updates.
+  @details Must be recorded outside of a render pass, before the draw.
+  @param texture Virtual texture.
+  @param frame Frame resources.
+  @param command_buffer Command buffer to record to.
+*/
+void moss__record_virtual_texture_uploads (
+  Moss__VirtualTexture      *texture,
+  Moss__VirtualTextureFrame *frame,
+  VkCommandBuffer            command_buffer
+);
+
+/*
+  @brief Records virtual texture draw and feedback writes.
+  @details Sets its own viewport and scissor. Draws nothing until the coarsest
+           level is resident.
+  @param texture Virtual texture.
+  @param frame Frame resources.
+  @param info Recording information.
+*/
+void moss__record_virtual_texture (
+  const Moss__VirtualTexture           *texture,
+  Moss__VirtualTextureFrame            *frame,
+  const Moss__RecordVirtualTextureInfo *info
+);
+
+/*
+  @brief Makes feedback written by the frame visible to the host.
+  @details Must be recorded after the scene render pass has ended.
+  @param frame Frame resources.
+  @param command_buffer Command buffer to record to.
+*/
+void moss__record_virtual_texture_feedback_barrier (
+  const Moss__VirtualTextureFrame *frame,
+  VkCommandBuffer                  command_buffer
+);
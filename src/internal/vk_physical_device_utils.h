@@ -41,9 +41,11 @@ typedef struct
   uint32_t graphics_family;       /* Graphics queue family index. */
   uint32_t present_family;        /* Present queue family index. */
   uint32_t transfer_family;       /* Transfer queue family index. */
+  uint32_t compute_family;        /* Compute queue family index. */
   bool     graphics_family_found; /* Whether graphics family index is valid. */
   bool     present_family_found;  /* Whether present family index is valid. */
   bool     transfer_family_found; /* Whether present family index is valid. */
+  bool     compute_family_found;  /* Whether compute family index is valid. */
 } Moss__QueueFamilyIndices;
 
 /*
@@ -89,6 +91,7 @@ moss__find_queue_families (const VkPhysicalDevice device, const VkSurfaceKHR sur
     .graphics_family_found = false,
     .present_family_found  = false,
     .transfer_family_found = false,
+    .compute_family_found  = false,
   };
 
   uint32_t queue_family_count = 0;
@@ -108,7 +111,17 @@ moss__find_queue_families (const VkPhysicalDevice device, const VkSurfaceKHR sur
       indices.transfer_family_found = true;
     }
 
-    if (queue_family_flags & VK_QUEUE_GRAPHICS_BIT)
+    // Compute family without graphics runs asynchronously to rendering
+    if ((queue_family_flags & VK_QUEUE_COMPUTE_BIT) &&
+        !(queue_family_flags & VK_QUEUE_GRAPHICS_BIT))
+    {
+      indices.compute_family       = i;
+      indices.compute_family_found = true;
+    }
+
+    // Graphics family can run compute dispatches if no dedicated family exists
+    if ((queue_family_flags & VK_QUEUE_GRAPHICS_BIT) &&
+        (queue_family_flags & VK_QUEUE_COMPUTE_BIT))
     {
       indices.graphics_family       = i;
       indices.graphics_family_found = true;
@@ -124,7 +137,7 @@ moss__find_queue_families (const VkPhysicalDevice device, const VkSurfaceKHR sur
     }
 
     if (indices.transfer_family_found && indices.graphics_family_found &&
-        indices.present_family_found)
+        indices.present_family_found && indices.compute_family_found)
     {
       break;
     }
@@ -137,6 +150,13 @@ moss__find_queue_families (const VkPhysicalDevice device, const VkSurfaceKHR sur
     indices.transfer_family_found = true;
   }
 
+  // If async compute queue family not found, compute work shares the graphics queue
+  if (!indices.compute_family_found)
+  {
+    indices.compute_family       = indices.graphics_family;
+    indices.compute_family_found = true;
+  }
+
   return indices;
 }
 
@@ -234,6 +254,39 @@ inline static bool moss__check_device_extension_support (const VkPhysicalDevice
   return true;
 }
 
+/*
+  @brief Checks if device supports an optional extension.
+  @param device Physical device to check.
+  @param extension_name Name of the extension.
+  @return True if the extension is supported, otherwise false.
+*/
+inline static bool moss__check_optional_device_extension_support (
+  const VkPhysicalDevice device,
+  const char *const      extension_name
+)
+{
+  uint32_t available_extension_count;
+  vkEnumerateDeviceExtensionProperties (device, NULL, &available_extension_count, NULL);
+
+  VkExtensionProperties available_extensions[ available_extension_count ];
+  vkEnumerateDeviceExtensionProperties (
+    device,
+    NULL,
+    &available_extension_count,
+    available_extensions
+  );
+
+  for (uint32_t i = 0; i < available_extension_count; ++i)
+  {
+    if (strcmp (extension_name, available_extensions[ i ].extensionName) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 
 /*
   @brief Checks if device supports required formats.
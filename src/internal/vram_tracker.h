@@ -0,0 +1,59 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/vram_tracker.h
+  @brief Tracking of device memory allocations.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "moss/vram.h"
+
+/*
+  @brief Starts tracking device memory block.
+  @details Called right after the block is allocated. Tracking is process wide
+           and thread safe, so crates created on any thread are counted.
+  @param physical_device Physical device the block is allocated on.
+  @param memory Device memory block.
+  @param category What the block is spent on.
+  @param memory_type_index Memory type the block is allocated from.
+  @param used_size Bytes the resource asked for.
+  @param reserved_size Size of the block in bytes.
+*/
+void moss__track_vram_allocation (
+  VkPhysicalDevice physical_device,
+  VkDeviceMemory   memory,
+  MossVramCategory category,
+  uint32_t         memory_type_index,
+  VkDeviceSize     used_size,
+  VkDeviceSize     reserved_size
+);
+
+/*
+  @brief Stops tracking device memory block.
+  @details Called right before the block is freed. Untracked blocks are ignored.
+  @param memory Device memory block.
+*/
+void moss__untrack_vram_allocation (VkDeviceMemory memory);
+
+/*
+  @brief Sums tracked device memory blocks by category and heap.
+  @param physical_device Physical device to describe heaps of.
+  @param out_report Output report.
+*/
+void moss__get_vram_report (VkPhysicalDevice physical_device, MossVramReport *out_report);
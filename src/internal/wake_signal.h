@@ -0,0 +1,75 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/internal/wake_signal.h
+  @brief Signal that wakes a sleeping main loop from any thread.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+
+/*
+  @brief Wake signal.
+  @details A raised signal stays raised until the next wait consumes it, so
+           raises aren't lost while the loop is busy drawing.
+*/
+typedef struct
+{
+  /* Mutex that guards the raised flag. */
+  pthread_mutex_t mutex;
+  /* Condition the sleeping thread waits on. */
+  pthread_cond_t condition;
+  /* Whether the signal was raised since the last wait. */
+  bool is_raised;
+  /* Whether mutex and condition are initialized. */
+  bool is_initialized;
+} Moss__WakeSignal;
+
+/*
+  @brief Initializes wake signal.
+  @param out_signal Output wake signal.
+*/
+void moss__init_wake_signal (Moss__WakeSignal *out_signal);
+
+/*
+  @brief Deinitializes wake signal.
+  @param signal Wake signal. Safe to call on a zeroed struct.
+*/
+void moss__deinit_wake_signal (Moss__WakeSignal *signal);
+
+/*
+  @brief Raises wake signal, waking the waiting thread.
+  @details Can be called from any thread.
+  @param signal Wake signal.
+*/
+void moss__raise_wake_signal (Moss__WakeSignal *signal);
+
+/*
+  @brief Sleeps until the signal is raised or the timeout passes.
+  @details Returns immediately if the signal was raised since the last wait.
+  @param signal Wake signal.
+  @param seconds Max time to sleep.
+  @return Returns true if the signal was raised, false on timeout.
+*/
+bool moss__wait_wake_signal (Moss__WakeSignal *signal, float seconds);
+
+/*
+  @brief Returns monotonic time.
+  @return Seconds since an arbitrary point.
+*/
+double moss__get_monotonic_time (void);
@@ -0,0 +1,706 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/job_system.c
+  @brief Work-stealing job system implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#ifdef __linux__
+#  define _GNU_SOURCE
+#endif
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#  include <mach/mach.h>
+#  include <mach/thread_policy.h>
+#endif
+
+#include "moss/job.h"
+#include "moss/result.h"
+
+#include "src/internal/job_system.h"
+#include "src/internal/log.h"
+
+/* Thread index of threads that don't belong to the job system. */
+#define MOSS__JOB_INVALID_THREAD_INDEX UINT32_MAX
+
+/* Number of parallel for batches per thread when batch size is picked automatically. */
+#define MOSS__JOB_BATCHES_PER_THREAD (uint32_t)(4)
+
+/*=============================================================================
+    JOB SYSTEM STATE
+  =============================================================================*/
+
+/*
+  @brief Per-thread job system state.
+*/
+typedef struct
+{
+  /* Queue of jobs created on this thread. */
+  Moss__JobDeque deque;
+
+  /* Pool of jobs allocated by this thread. */
+  MossJob jobs[ MOSS_JOB_POOL_SIZE ];
+
+  /* Index of the pool slot to look at first on the next allocation. */
+  uint32_t next_job_index;
+
+  /* State of the random generator picking steal victims. */
+  uint32_t random_state;
+
+  /* Thread handle. Not used for the engine thread. */
+  pthread_t thread;
+
+  /* Whether the worker thread was started. */
+  bool is_started;
+} Moss__JobThread;
+
+/*
+  @brief Job system state.
+*/
+typedef struct
+{
+  /* Per-thread states. */
+  Moss__JobThread *threads;
+
+  /* Number of threads, including the engine thread. */
+  uint32_t thread_count;
+
+  /* Whether worker threads should keep running. Atomic. */
+  bool is_running;
+
+  /* Number of jobs sitting in deques. Atomic. */
+  uint32_t queued_job_count;
+
+  /* Number of workers sleeping on the condition. Atomic. */
+  uint32_t sleeping_thread_count;
+
+  /* Mutex guarding the sleep condition. */
+  pthread_mutex_t mutex;
+
+  /* Condition signaled when jobs are queued or workers are stopped. */
+  pthread_cond_t condition;
+} Moss__JobSystem;
+
+/*
+  @brief Global job system state.
+*/
+static Moss__JobSystem g_job_system = {
+  .threads               = NULL,
+  .thread_count          = 0,
+  .is_running            = false,
+  .queued_job_count      = 0,
+  .sleeping_thread_count = 0,
+};
+
+/*
+  @brief Index of the calling thread in the job system.
+*/
+static __thread uint32_t g_job_thread_index = MOSS__JOB_INVALID_THREAD_INDEX;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Pushes job to the bottom of the deque. Owner thread only.
+  @return True on success, false if the deque is full.
+*/
+inline static bool moss__push_job (Moss__JobDeque *deque, MossJob *job);
+
+/*
+  @brief Pops job from the bottom of the deque. Owner thread only.
+  @return Job, or NULL if the deque is empty.
+*/
+inline static MossJob *moss__pop_job (Moss__JobDeque *deque);
+
+/*
+  @brief Steals job from the top of the deque. Any thread.
+  @return Job, or NULL if the deque is empty or the steal lost a race.
+*/
+inline static MossJob *moss__steal_job (Moss__JobDeque *deque);
+
+/*
+  @brief Allocates job from the calling thread's pool.
+  @param is_exhaustion_reported Whether to log an error if the pool is exhausted.
+  @return Job, or NULL if the calling thread doesn't belong to the job system or
+          all jobs of its pool are unfinished.
+*/
+inline static MossJob *moss__allocate_job (bool is_exhaustion_reported);
+
+/*
+  @brief Queues job on the calling thread, or executes it in place if the
+         deque is full.
+*/
+inline static void moss__queue_job (MossJob *job);
+
+/*
+  @brief Finds a job to execute: own deque first, then other threads' deques.
+  @return Job, or NULL if there's nothing to do.
+*/
+inline static MossJob *moss__find_job (uint32_t thread_index);
+
+/*
+  @brief Executes job and marks it as finished.
+*/
+inline static void moss__execute_job (MossJob *job);
+
+/*
+  @brief Marks one part of the job as finished, releasing dependent jobs and the
+         parent when the whole job is done.
+*/
+static void moss__finish_job (MossJob *job);
+
+/*
+  @brief Pins thread to a CPU.
+*/
+inline static void moss__set_thread_affinity (pthread_t thread, uint32_t cpu_index);
+
+/*
+  @brief Worker thread entry point.
+  @param arg Thread index casted to pointer.
+*/
+static void *moss__job_worker (void *arg);
+
+/*=============================================================================
+    PUBLIC API FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossJob *moss_job_create (const MossJobFunction function, void *const user_data)
+{
+  MossJob *const job = moss__allocate_job (true);
+  if (job == NULL) { return NULL; }
+
+  job->function  = function;
+  job->user_data = user_data;
+  return job;
+}
+
+MossJob *moss_job_create_child (
+  MossJob *const        parent,
+  const MossJobFunction function,
+  void *const           user_data
+)
+{
+  MossJob *const job = moss_job_create (function, user_data);
+  if (job == NULL) { return NULL; }
+
+  job->parent = parent;
+  __atomic_add_fetch (&parent->unfinished_count, 1, __ATOMIC_RELAXED);
+  return job;
+}
+
+MossResult moss_job_add_dependency (MossJob *const job, MossJob *const dependency)
+{
+  if (dependency->continuation_count >= MOSS__JOB_MAX_CONTINUATIONS)
+  {
+    moss__error ("Job has too many dependent jobs.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  dependency->continuations[ dependency->continuation_count++ ] = job;
+  __atomic_add_fetch (&job->blocker_count, 1, __ATOMIC_RELAXED);
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss_job_submit (MossJob *const job)
+{
+  if (job == NULL) { return; }
+
+  // Drop the "not submitted" blocker, queue the job if nothing else blocks it
+  if (__atomic_sub_fetch (&job->blocker_count, 1, __ATOMIC_ACQ_REL) == 0)
+  {
+    moss__queue_job (job);
+  }
+}
+
+void moss_job_wait (const MossJob *const job)
+{
+  if (job == NULL) { return; }
+
+  const uint32_t thread_index = g_job_thread_index;
+
+  while (__atomic_load_n (&job->unfinished_count, __ATOMIC_ACQUIRE) != 0)
+  {
+    MossJob *const next_job = moss__find_job (thread_index);
+    if (next_job != NULL) { moss__execute_job (next_job); }
+    else { sched_yield ( ); }
+  }
+}
+
+void moss_job_parallel_for (
+  const uint32_t             count,
+  uint32_t                   batch_size,
+  const MossJobRangeFunction function,
+  void *const                user_data
+)
+{
+  if (count == 0) { return; }
+
+  if (batch_size == 0)
+  {
+    const uint32_t thread_count =
+      (g_job_system.thread_count == 0) ? 1 : g_job_system.thread_count;
+    batch_size = count / (thread_count * MOSS__JOB_BATCHES_PER_THREAD);
+    if (batch_size == 0) { batch_size = 1; }
+  }
+
+  // Run inline if there's nothing to spread the work over, before taking a pool slot
+  if (count <= batch_size || g_job_system.thread_count <= 1)
+  {
+    function (user_data, 0, count);
+    return;
+  }
+
+  MossJob *const root = moss_job_create (NULL, NULL);
+  if (root == NULL)
+  {
+    function (user_data, 0, count);
+    return;
+  }
+
+  for (uint32_t begin = 0; begin < count; begin += batch_size)
+  {
+    const uint32_t end = (count - begin > batch_size) ? begin + batch_size : count;
+
+    // Pool is full of unfinished jobs, do the batch here instead of waiting for one
+    MossJob *const job = moss__allocate_job (false);
+    if (job == NULL)
+    {
+      function (user_data, begin, end);
+      continue;
+    }
+
+    job->parent = root;
+    __atomic_add_fetch (&root->unfinished_count, 1, __ATOMIC_RELAXED);
+
+    job->user_data      = user_data;
+    job->range_function = function;
+    job->range_begin    = begin;
+    job->range_end      = end;
+    moss_job_submit (job);
+  }
+
+  moss_job_submit (root);
+  moss_job_wait (root);
+}
+
+uint32_t moss_job_get_thread_count (void) { return g_job_system.thread_count; }
+
+/*=============================================================================
+    INTERNAL API FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__init_job_system (const MossJobSystemConfig *const config)
+{
+  uint32_t thread_count = (config != NULL) ? config->thread_count : 0;
+  if (thread_count == 0)
+  {
+    const long cpu_count = sysconf (_SC_NPROCESSORS_ONLN);
+    thread_count         = (cpu_count > 0) ? (uint32_t)cpu_count : 1;
+  }
+  if (thread_count > MOSS__JOB_MAX_THREADS) { thread_count = MOSS__JOB_MAX_THREADS; }
+
+  g_job_system.threads = calloc (thread_count, sizeof (Moss__JobThread));
+  if (g_job_system.threads == NULL)
+  {
+    moss__error ("Failed to allocate job system threads.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < thread_count; ++i)
+  {
+    g_job_system.threads[ i ].random_state = 0x9E3779B9U * (i + 1);
+  }
+
+  pthread_mutex_init (&g_job_system.mutex, NULL);
+  pthread_cond_init (&g_job_system.condition, NULL);
+
+  // Workers may look into deques of threads that aren't started yet, those are empty
+  g_job_system.thread_count = thread_count;
+  g_job_system.is_running   = true;
+  g_job_thread_index        = 0;
+
+  const bool pin_threads = (config != NULL && config->cpu_affinity != NULL);
+  if (pin_threads)
+  {
+    moss__set_thread_affinity (pthread_self ( ), config->cpu_affinity[ 0 ]);
+  }
+
+  for (uint32_t i = 1; i < thread_count; ++i)
+  {
+    Moss__JobThread *const thread = &g_job_system.threads[ i ];
+
+    void *const worker_arg = (void *)(uintptr_t)i;
+    if (pthread_create (&thread->thread, NULL, moss__job_worker, worker_arg) != 0)
+    {
+      moss__error ("Failed to create job worker thread %u.\n", i);
+      moss__deinit_job_system ( );
+      return MOSS_RESULT_ERROR;
+    }
+    thread->is_started = true;
+
+    if (pin_threads)
+    {
+      moss__set_thread_affinity (thread->thread, config->cpu_affinity[ i ]);
+    }
+  }
+
+  moss__info ("Job system started with %u threads.\n", g_job_system.thread_count);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__deinit_job_system (void)
+{
+  if (g_job_system.threads == NULL) { return; }
+
+  // Drain own deque, workers drain theirs before they exit
+  while (moss__run_pending_job ( )) { }
+
+  pthread_mutex_lock (&g_job_system.mutex);
+  __atomic_store_n (&g_job_system.is_running, false, __ATOMIC_SEQ_CST);
+  pthread_cond_broadcast (&g_job_system.condition);
+  pthread_mutex_unlock (&g_job_system.mutex);
+
+  for (uint32_t i = 1; i < g_job_system.thread_count; ++i)
+  {
+    if (g_job_system.threads[ i ].is_started)
+    {
+      pthread_join (g_job_system.threads[ i ].thread, NULL);
+    }
+  }
+
+  pthread_cond_destroy (&g_job_system.condition);
+  pthread_mutex_destroy (&g_job_system.mutex);
+
+  free (g_job_system.threads);
+  g_job_system.threads               = NULL;
+  g_job_system.thread_count          = 0;
+  g_job_system.queued_job_count      = 0;
+  g_job_system.sleeping_thread_count = 0;
+  g_job_thread_index                 = MOSS__JOB_INVALID_THREAD_INDEX;
+}
+
+bool moss__run_pending_job (void)
+{
+  const uint32_t thread_index = g_job_thread_index;
+  if (thread_index == MOSS__JOB_INVALID_THREAD_INDEX) { return false; }
+
+  MossJob *const job = moss__find_job (thread_index);
+  if (job == NULL) { return false; }
+
+  moss__execute_job (job);
+  return true;
+}
+
+/*=============================================================================
+    INTERNAL FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+inline static bool moss__push_job (Moss__JobDeque *const deque, MossJob *const job)
+{
+  const int64_t bottom = __atomic_load_n (&deque->bottom, __ATOMIC_RELAXED);
+  const int64_t top    = __atomic_load_n (&deque->top, __ATOMIC_ACQUIRE);
+
+  if (bottom - top >= (int64_t)MOSS__JOB_DEQUE_CAPACITY) { return false; }
+
+  __atomic_store_n (
+    &deque->jobs[ bottom & (MOSS__JOB_DEQUE_CAPACITY - 1) ],
+    job,
+    __ATOMIC_RELAXED
+  );
+  __atomic_store_n (&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+inline static MossJob *moss__pop_job (Moss__JobDeque *const deque)
+{
+  const int64_t bottom = __atomic_load_n (&deque->bottom, __ATOMIC_RELAXED) - 1;
+  __atomic_store_n (&deque->bottom, bottom, __ATOMIC_RELAXED);
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  int64_t top = __atomic_load_n (&deque->top, __ATOMIC_RELAXED);
+
+  if (top > bottom)
+  {
+    // Deque is empty
+    __atomic_store_n (&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    return NULL;
+  }
+
+  MossJob *job = __atomic_load_n (
+    &deque->jobs[ bottom & (MOSS__JOB_DEQUE_CAPACITY - 1) ],
+    __ATOMIC_RELAXED
+  );
+
+  if (top == bottom)
+  {
+    // Last job, race against thieves for it
+    if (!__atomic_compare_exchange_n (
+          &deque->top,
+          &top,
+          top + 1,
+          false,
+          __ATOMIC_SEQ_CST,
+          __ATOMIC_RELAXED
+        ))
+    {
+      job = NULL;
+    }
+    __atomic_store_n (&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+  }
+
+  return job;
+}
+
+inline static MossJob *moss__steal_job (Moss__JobDeque *const deque)
+{
+  int64_t top = __atomic_load_n (&deque->top, __ATOMIC_ACQUIRE);
+  __atomic_thread_fence (__ATOMIC_SEQ_CST);
+  const int64_t bottom = __atomic_load_n (&deque->bottom, __ATOMIC_ACQUIRE);
+
+  if (top >= bottom) { return NULL; }
+
+  MossJob *const job = __atomic_load_n (
+    &deque->jobs[ top & (MOSS__JOB_DEQUE_CAPACITY - 1) ],
+    __ATOMIC_RELAXED
+  );
+
+  if (!__atomic_compare_exchange_n (
+        &deque->top,
+        &top,
+        top + 1,
+        false,
+        __ATOMIC_SEQ_CST,
+        __ATOMIC_RELAXED
+      ))
+  {
+    return NULL;
+  }
+
+  return job;
+}
+
+inline static MossJob *moss__allocate_job (const bool is_exhaustion_reported)
+{
+  const uint32_t thread_index = g_job_thread_index;
+  if (thread_index == MOSS__JOB_INVALID_THREAD_INDEX)
+  {
+    moss__error ("Jobs can only be created on the engine thread or within jobs.\n");
+    return NULL;
+  }
+
+  Moss__JobThread *const thread = &g_job_system.threads[ thread_index ];
+
+  // Slots are handed out in order, so the next one has usually finished long ago
+  MossJob *job = NULL;
+  for (uint32_t i = 0; i < MOSS_JOB_POOL_SIZE && job == NULL; ++i)
+  {
+    MossJob *const slot =
+      &thread->jobs[ thread->next_job_index++ & (MOSS_JOB_POOL_SIZE - 1) ];
+    if (!__atomic_load_n (&slot->is_in_use, __ATOMIC_ACQUIRE)) { job = slot; }
+  }
+
+  if (job == NULL)
+  {
+    if (is_exhaustion_reported)
+    {
+      moss__error ("Job pool is exhausted, all jobs are unfinished.\n");
+    }
+    return NULL;
+  }
+
+  job->is_in_use          = true;
+  job->function           = NULL;
+  job->user_data          = NULL;
+  job->parent             = NULL;
+  job->unfinished_count   = 1;
+  job->blocker_count      = 1;
+  job->continuation_count = 0;
+  job->range_function     = NULL;
+  job->range_begin        = 0;
+  job->range_end          = 0;
+
+  return job;
+}
+
+inline static void moss__queue_job (MossJob *const job)
+{
+  Moss__JobThread *const thread = &g_job_system.threads[ g_job_thread_index ];
+
+  if (!moss__push_job (&thread->deque, job))
+  {
+    moss__execute_job (job);
+    return;
+  }
+
+  __atomic_add_fetch (&g_job_system.queued_job_count, 1, __ATOMIC_SEQ_CST);
+
+  if (__atomic_load_n (&g_job_system.sleeping_thread_count, __ATOMIC_SEQ_CST) != 0)
+  {
+    pthread_mutex_lock (&g_job_system.mutex);
+    pthread_cond_signal (&g_job_system.condition);
+    pthread_mutex_unlock (&g_job_system.mutex);
+  }
+}
+
+inline static MossJob *moss__find_job (const uint32_t thread_index)
+{
+  if (thread_index == MOSS__JOB_INVALID_THREAD_INDEX) { return NULL; }
+
+  Moss__JobThread *const thread = &g_job_system.threads[ thread_index ];
+
+  MossJob *job = moss__pop_job (&thread->deque);
+
+  if (job == NULL && g_job_system.thread_count > 1)
+  {
+    // xorshift32, picks a random victim to start stealing from
+    uint32_t random = thread->random_state;
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    thread->random_state = random;
+
+    const uint32_t first_victim = random % g_job_system.thread_count;
+    for (uint32_t i = 0; i < g_job_system.thread_count && job == NULL; ++i)
+    {
+      const uint32_t victim = (first_victim + i) % g_job_system.thread_count;
+      if (victim == thread_index) { continue; }
+
+      job = moss__steal_job (&g_job_system.threads[ victim ].deque);
+    }
+  }
+
+  if (job != NULL)
+  {
+    __atomic_sub_fetch (&g_job_system.queued_job_count, 1, __ATOMIC_SEQ_CST);
+  }
+
+  return job;
+}
+
+inline static void moss__execute_job (MossJob *const job)
+{
+  if (job->range_function != NULL)
+  {
+    job->range_function (job->user_data, job->range_begin, job->range_end);
+  }
+  else if (job->function != NULL) { job->function (job->user_data); }
+
+  moss__finish_job (job);
+}
+
+static void moss__finish_job (MossJob *const job)
+{
+  if (__atomic_sub_fetch (&job->unfinished_count, 1, __ATOMIC_ACQ_REL) != 0) { return; }
+
+  for (uint32_t i = 0; i < job->continuation_count; ++i)
+  {
+    MossJob *const continuation = job->continuations[ i ];
+    if (__atomic_sub_fetch (&continuation->blocker_count, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+      moss__queue_job (continuation);
+    }
+  }
+
+  MossJob *const parent = job->parent;
+
+  // Nothing reads the job past this point, its slot may be reused right away
+  __atomic_store_n (&job->is_in_use, false, __ATOMIC_RELEASE);
+
+  if (parent != NULL) { moss__finish_job (parent); }
+}
+
+inline static void
+moss__set_thread_affinity (const pthread_t thread, const uint32_t cpu_index)
+{
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO (&cpu_set);
+  CPU_SET (cpu_index, &cpu_set);
+  if (pthread_setaffinity_np (thread, sizeof (cpu_set), &cpu_set) != 0)
+  {
+    moss__warning ("Failed to pin job thread to CPU %u.\n", cpu_index);
+  }
+#elif defined(__APPLE__)
+  // macOS has no hard pinning, threads with the same tag are kept on the same L2
+  thread_affinity_policy_data_t policy = { .affinity_tag = (integer_t)(cpu_index + 1) };
+  if (thread_policy_set (
+        pthread_mach_thread_np (thread),
+        THREAD_AFFINITY_POLICY,
+        (thread_policy_t)&policy,
+        THREAD_AFFINITY_POLICY_COUNT
+      ) != KERN_SUCCESS)
+  {
+    moss__info ("Thread affinity is not supported, CPU %u hint ignored.\n", cpu_index);
+  }
+#else
+  (void)(thread);
+  moss__info ("Thread affinity is not supported, CPU %u hint ignored.\n", cpu_index);
+#endif
+}
+
+static void *moss__job_worker (void *const arg)
+{
+  const uint32_t thread_index = (uint32_t)(uintptr_t)arg;
+  g_job_thread_index          = thread_index;
+
+  while (true)
+  {
+    MossJob *const job = moss__find_job (thread_index);
+    if (job != NULL)
+    {
+      moss__execute_job (job);
+      continue;
+    }
+
+    pthread_mutex_lock (&g_job_system.mutex);
+    __atomic_add_fetch (&g_job_system.sleeping_thread_count, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n (&g_job_system.is_running, __ATOMIC_SEQ_CST) &&
+           __atomic_load_n (&g_job_system.queued_job_count, __ATOMIC_SEQ_CST) == 0)
+    {
+      pthread_cond_wait (&g_job_system.condition, &g_job_system.mutex);
+    }
+
+    __atomic_sub_fetch (&g_job_system.sleeping_thread_count, 1, __ATOMIC_SEQ_CST);
+    const bool is_running = __atomic_load_n (&g_job_system.is_running, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock (&g_job_system.mutex);
+
+    if (!is_running)
+    {
+      // Finish what's left in own deque, nobody else will
+      MossJob *left_job;
+      while ((left_job = moss__pop_job (&g_job_system.threads[ thread_index ].deque)) !=
+             NULL)
+      {
+        __atomic_sub_fetch (&g_job_system.queued_job_count, 1, __ATOMIC_SEQ_CST);
+        moss__execute_job (left_job);
+      }
+      break;
+    }
+  }
+
+  return NULL;
+}
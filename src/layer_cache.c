@@ -0,0 +1,971 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/layer_cache.c
+  @brief Cached sprite layers implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/layer.h"
+#include "moss/result.h"
+#include "moss/vertex.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/layer_cache.h"
+#include "src/internal/log.h"
+#include "src/internal/memory_utils.h"
+#include "src/internal/scene_target.h"
+#include "src/internal/shaders.h"
+#include "src/internal/sprite_kernels.h"
+#include "src/internal/vk_shader_utils.h"
+#include "src/internal/vram_tracker.h"
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates layer render pass, mirroring attachments of the scene pass.
+  @param cache Layer cache.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_layer_render_pass (Moss__LayerCache *cache);
+
+/*
+  @brief Creates sampler, composite set layout and pipeline.
+  @param cache Layer cache.
+  @param info Creation information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_layer_composite_pipeline (
+  Moss__LayerCache                 *cache,
+  const Moss__LayerCacheCreateInfo *info
+);
+
+/*
+  @brief Creates device local image of the cache extent and its view.
+  @param cache Layer cache with extent set.
+  @param format Image format.
+  @param usage Image usage.
+  @param out_image Output image.
+  @param out_memory Output image memory.
+  @param out_image_view Output image view.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_layer_attachment (
+  const Moss__LayerCache *cache,
+  VkFormat                format,
+  VkImageUsageFlags       usage,
+  VkImage                *out_image,
+  VkDeviceMemory         *out_memory,
+  VkImageView            *out_image_view
+);
+
+/*
+  @brief Destroys image created by @ref moss__create_layer_attachment.
+  @param cache Layer cache.
+  @param image Image, reset to NULL.
+  @param memory Image memory, reset to NULL.
+  @param image_view Image view, reset to NULL.
+*/
+inline static void moss__destroy_layer_attachment (
+  const Moss__LayerCache *cache,
+  VkImage                *image,
+  VkDeviceMemory         *memory,
+  VkImageView            *image_view
+);
+
+/*
+  @brief Creates cached render image and framebuffer of a layer.
+  @param cache Layer cache.
+  @param layer Layer.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__create_layer_image (const Moss__LayerCache *cache, Moss__Layer *layer);
+
+/*
+  @brief Destroys cached render image and framebuffer of a layer.
+  @param cache Layer cache.
+  @param layer Layer.
+*/
+inline static void
+moss__destroy_layer_image (const Moss__LayerCache *cache, Moss__Layer *layer);
+
+/*
+  @brief Grows layer vertex crate to fit a number of sprites.
+  @param cache Layer cache.
+  @param layer Layer.
+  @param sprite_count Number of sprites to fit.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__reserve_layer_vertices (
+  const Moss__LayerCache *cache,
+  Moss__Layer            *layer,
+  uint32_t                sprite_count
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_layer_cache (
+  const Moss__LayerCacheCreateInfo *const info,
+  Moss__LayerCache *const                 out_cache
+)
+{
+  *out_cache = (Moss__LayerCache) {
+    .physical_device        = info->physical_device,
+    .device                 = info->device,
+    .format                 = info->format,
+    .extent                 = info->extent,
+    .color_attachment_count = info->color_attachment_count,
+  };
+
+  if (moss__create_layer_render_pass (out_cache) != MOSS_RESULT_SUCCESS ||
+      moss__create_layer_composite_pipeline (out_cache, info) != MOSS_RESULT_SUCCESS ||
+      moss__resize_layer_cache (out_cache, info->extent) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_layer_cache (out_cache);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_layer_cache (Moss__LayerCache *const cache)
+{
+  if (cache->device == VK_NULL_HANDLE) { return; }
+
+  for (uint32_t i = 0; i < MOSS_MAX_LAYER_COUNT; ++i)
+  {
+    Moss__Layer *const layer = &cache->layers[ i ];
+
+    moss__destroy_layer_image (cache, layer);
+
+    // Freeing crate memory unmaps it as well
+    moss__destroy_crate (&layer->vertex_crate);
+  }
+
+  moss__destroy_layer_attachment (
+    cache,
+    &cache->id_image,
+    &cache->id_memory,
+    &cache->id_image_view
+  );
+
+  if (cache->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (cache->device, cache->pipeline, NULL);
+  }
+
+  if (cache->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (cache->device, cache->pipeline_layout, NULL);
+  }
+
+  if (cache->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (cache->device, cache->descriptor_set_layout, NULL);
+  }
+
+  if (cache->sampler != VK_NULL_HANDLE)
+  {
+    vkDestroySampler (cache->device, cache->sampler, NULL);
+  }
+
+  if (cache->render_pass != VK_NULL_HANDLE)
+  {
+    vkDestroyRenderPass (cache->device, cache->render_pass, NULL);
+  }
+
+  *cache = (Moss__LayerCache) {0};
+}
+
+MossResult
+moss__resize_layer_cache (Moss__LayerCache *const cache, const VkExtent2D extent)
+{
+  for (uint32_t i = 0; i < MOSS_MAX_LAYER_COUNT; ++i)
+  {
+    moss__destroy_layer_image (cache, &cache->layers[ i ]);
+  }
+
+  moss__destroy_layer_attachment (
+    cache,
+    &cache->id_image,
+    &cache->id_memory,
+    &cache->id_image_view
+  );
+
+  cache->extent = extent;
+
+  // Layer sprites aren't pickable, pick IDs are only there to match the scene pass
+  if (cache->color_attachment_count > 1 &&
+      moss__create_layer_attachment (
+        cache,
+        MOSS__PICK_ID_FORMAT,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+        &cache->id_image,
+        &cache->id_memory,
+        &cache->id_image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Layers that never had sprites keep waiting for their first ones
+  for (uint32_t i = 0; i < MOSS_MAX_LAYER_COUNT; ++i)
+  {
+    Moss__Layer *const layer = &cache->layers[ i ];
+    if (layer->sprite_count == 0) { continue; }
+
+    if (moss__create_layer_image (cache, layer) != MOSS_RESULT_SUCCESS)
+    {
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+MossResult moss__write_layer_sprites (
+  Moss__LayerCache *const      cache,
+  const uint32_t               layer_index,
+  const Moss__SpriteSoA *const sprites
+)
+{
+  if (layer_index >= MOSS_MAX_LAYER_COUNT)
+  {
+    moss__error (
+      "Layer %u is out of range, there are %u layers.\n",
+      layer_index,
+      MOSS_MAX_LAYER_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  Moss__Layer *const layer = &cache->layers[ layer_index ];
+
+  if (moss__reserve_layer_vertices (cache, layer, sprites->count) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Images are created on first use, so unused layers take no VRAM
+  if (sprites->count > 0 && layer->image == VK_NULL_HANDLE &&
+      moss__create_layer_image (cache, layer) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (sprites->count > 0)
+  {
+    moss__generate_sprite_vertices_parallel (sprites, layer->vertices);
+  }
+
+  layer->sprite_count = sprites->count;
+  layer->is_dirty     = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+bool moss__begin_layer_pass (
+  Moss__LayerCache *const cache,
+  const uint32_t          layer_index,
+  const VkCommandBuffer   command_buffer,
+  const VkExtent2D        render_extent
+)
+{
+  const Moss__Layer *const layer = &cache->layers[ layer_index ];
+  if (layer->sprite_count == 0) { return false; }
+
+  // Render scale changes move every pixel, so the cached render can't be reused
+  const bool is_extent_changed = layer->rendered_extent.width != render_extent.width ||
+                                 layer->rendered_extent.height != render_extent.height;
+  if (!layer->is_dirty && !is_extent_changed) { return false; }
+
+  const VkRenderPassBeginInfo pass_info = {
+    .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+    .renderPass  = cache->render_pass,
+    .framebuffer = layer->framebuffer,
+    .renderArea =
+      {
+                   .offset = {0, 0},
+                   .extent = render_extent,
+                   },
+    .clearValueCount = cache->color_attachment_count,
+    .pClearValues    = (const VkClearValue[]) {
+                   {.color = {{0.0F, 0.0F, 0.0F, 0.0F}}},
+                   {.color = {.uint32 = {0, 0, 0, 0}}},
+                   },
+  };
+
+  vkCmdBeginRenderPass (command_buffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE);
+
+  return true;
+}
+
+void moss__end_layer_pass (
+  Moss__LayerCache *const cache,
+  const uint32_t          layer_index,
+  const VkCommandBuffer   command_buffer,
+  const VkExtent2D        render_extent
+)
+{
+  vkCmdEndRenderPass (command_buffer);
+
+  Moss__Layer *const layer = &cache->layers[ layer_index ];
+  layer->is_dirty          = false;
+  layer->rendered_extent   = render_extent;
+}
+
+void moss__record_layer_composite (
+  const Moss__LayerCache *const               cache,
+  const Moss__RecordLayerCompositeInfo *const info
+)
+{
+  bool is_pipeline_bound = false;
+
+  for (uint32_t i = 0; i < MOSS_MAX_LAYER_COUNT; ++i)
+  {
+    const Moss__Layer *const layer = &cache->layers[ i ];
+    if (layer->sprite_count == 0) { continue; }
+
+    if (!is_pipeline_bound)
+    {
+      vkCmdBindPipeline (
+        info->command_buffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        cache->pipeline
+      );
+
+      const VkViewport viewport = {
+        .x        = 0.0F,
+        .y        = 0.0F,
+        .width    = (float)info->render_extent.width,
+        .height   = (float)info->render_extent.height,
+        .minDepth = 0.0F,
+        .maxDepth = 1.0F,
+      };
+
+      const VkRect2D scissor = {
+        .offset = { 0, 0 },
+        .extent = info->render_extent,
+      };
+
+      vkCmdSetViewport (info->command_buffer, 0, 1, &viewport);
+      vkCmdSetScissor (info->command_buffer, 0, 1, &scissor);
+
+      is_pipeline_bound = true;
+    }
+
+    const Moss__DescriptorBinding binding = {
+      .binding      = 0,
+      .type         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .sampler      = cache->sampler,
+      .image_view   = layer->image_view,
+      .image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    };
+
+    if (moss__bind_descriptors (
+          info->descriptor_cache,
+          info->descriptor_cache_frame,
+          info->command_buffer,
+          VK_PIPELINE_BIND_POINT_GRAPHICS,
+          cache->pipeline_layout,
+          0,
+          cache->descriptor_set_layout,
+          &binding,
+          1
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to bind layer %u, skipping it.\n", i);
+      continue;
+    }
+
+    // Fullscreen triangle, see upscale.vert
+    vkCmdDraw (info->command_buffer, 3, 1, 0, 0);
+  }
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_layer_render_pass (Moss__LayerCache *const cache)
+{
+  const VkAttachmentDescription attachments[ 2 ] = {
+    {
+     .format         = cache->format,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+     },
+    // Only keeps the pass compatible with the sprite pipeline, nothing is stored
+    {
+     .format         = MOSS__PICK_ID_FORMAT,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+  };
+
+  const VkAttachmentReference color_attachment_refs[ 2 ] = {
+    {
+     .attachment = 0,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+    {
+     .attachment = 1,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+  };
+
+  const VkSubpassDescription subpass = {
+    .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    .colorAttachmentCount = cache->color_attachment_count,
+    .pColorAttachments    = color_attachment_refs,
+  };
+
+  const VkSubpassDependency dependencies[ 2 ] = {
+    // Composites of earlier frames must finish reading before the layer is redrawn
+    {
+     .srcSubpass    = VK_SUBPASS_EXTERNAL,
+     .dstSubpass    = 0,
+     .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+     .srcAccessMask = 0,
+     .dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     },
+    // Composite reads the layer only once it's written
+    {
+     .srcSubpass    = 0,
+     .dstSubpass    = VK_SUBPASS_EXTERNAL,
+     .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     .dstStageMask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+     .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+     },
+  };
+
+  const VkRenderPassCreateInfo render_pass_info = {
+    .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+    .attachmentCount = cache->color_attachment_count,
+    .pAttachments    = attachments,
+    .subpassCount    = 1,
+    .pSubpasses      = &subpass,
+    .dependencyCount = 2,
+    .pDependencies   = dependencies,
+  };
+
+  const VkResult result =
+    vkCreateRenderPass (cache->device, &render_pass_info, NULL, &cache->render_pass);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer render pass. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    cache->device,
+    VK_OBJECT_TYPE_RENDER_PASS,
+    cache->render_pass,
+    "layer render pass"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_layer_composite_pipeline (
+  Moss__LayerCache *const                 cache,
+  const Moss__LayerCacheCreateInfo *const info
+)
+{
+  // Layers match the scene pixel for pixel, filtering never kicks in
+  const VkSamplerCreateInfo sampler_info = {
+    .sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+    .magFilter    = VK_FILTER_NEAREST,
+    .minFilter    = VK_FILTER_NEAREST,
+    .mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+    .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .maxLod       = 0.0F,
+  };
+
+  VkResult result = vkCreateSampler (cache->device, &sampler_info, NULL, &cache->sampler);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer sampler. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetLayoutBinding binding = {
+    .binding         = 0,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .descriptorCount = 1,
+    .stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT,
+  };
+
+  if (moss__create_cached_descriptor_set_layout (
+        info->descriptor_cache,
+        &binding,
+        1,
+        &cache->descriptor_set_layout
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create layer composite descriptor set layout.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount = 1,
+    .pSetLayouts    = &cache->descriptor_set_layout,
+  };
+
+  result = vkCreatePipelineLayout (
+    cache->device,
+    &pipeline_layout_info,
+    NULL,
+    &cache->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create layer composite pipeline layout. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        cache->device,
+        MOSS__UPSCALE_VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_shader_module_from_file (
+        cache->device,
+        MOSS__LAYER_COMPOSITE_FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (cache->device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = {
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+     .module = vert_shader_module,
+     .pName  = "main",
+     },
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .module = frag_shader_module,
+     .pName  = "main",
+     },
+  };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+  };
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_NONE,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  // Layers are cleared to transparent, so uncovered pixels keep what's beneath
+  const VkPipelineColorBlendAttachmentState color_blend_attachments[ 2 ] = {
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                       VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+     .blendEnable         = VK_TRUE,
+     .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+     .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+     .colorBlendOp        = VK_BLEND_OP_ADD,
+     .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+     .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+     .alphaBlendOp        = VK_BLEND_OP_ADD,
+     },
+    // Pick IDs of whatever is beneath are kept
+    {
+     .colorWriteMask = 0,
+     .blendEnable    = VK_FALSE,
+     },
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = info->color_attachment_count,
+    .pAttachments    = color_blend_attachments,
+  };
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = cache->pipeline_layout,
+    .renderPass          = info->scene_render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  result = vkCreateGraphicsPipelines (
+    cache->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &cache->pipeline
+  );
+
+  vkDestroyShaderModule (cache->device, frag_shader_module, NULL);
+  vkDestroyShaderModule (cache->device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer composite pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    cache->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    cache->pipeline,
+    "layer composite pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_layer_attachment (
+  const Moss__LayerCache *const cache,
+  const VkFormat                format,
+  const VkImageUsageFlags       usage,
+  VkImage *const                out_image,
+  VkDeviceMemory *const         out_memory,
+  VkImageView *const            out_image_view
+)
+{
+  const VkImageCreateInfo image_info = {
+    .sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format    = format,
+    .extent =
+      {
+               .width  = cache->extent.width,
+               .height = cache->extent.height,
+               .depth  = 1,
+               },
+    .mipLevels     = 1,
+    .arrayLayers   = 1,
+    .samples       = VK_SAMPLE_COUNT_1_BIT,
+    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+    .usage         = usage,
+    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkResult result = vkCreateImage (cache->device, &image_info, NULL, out_image);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer image. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (cache->device, VK_OBJECT_TYPE_IMAGE, *out_image, "layer image");
+
+  VkMemoryRequirements memory_requirements;
+  vkGetImageMemoryRequirements (cache->device, *out_image, &memory_requirements);
+
+  uint32_t memory_type;
+  if (moss__select_suitable_memory_type (
+        cache->physical_device,
+        memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memory_type
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to find suitable memory type for layer image.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkMemoryAllocateInfo alloc_info = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .allocationSize  = memory_requirements.size,
+    .memoryTypeIndex = memory_type,
+  };
+
+  result = vkAllocateMemory (cache->device, &alloc_info, NULL, out_memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate layer image memory. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__track_vram_allocation (
+    cache->physical_device,
+    *out_memory,
+    MOSS_VRAM_CATEGORY_RENDER_TARGETS,
+    memory_type,
+    memory_requirements.size,
+    memory_requirements.size
+  );
+
+  vkBindImageMemory (cache->device, *out_image, *out_memory, 0);
+
+  const VkImageViewCreateInfo view_info = {
+    .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .image    = *out_image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format   = format,
+    .subresourceRange =
+      {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .baseMipLevel   = 0,
+                  .levelCount     = 1,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+                  },
+  };
+
+  result = vkCreateImageView (cache->device, &view_info, NULL, out_image_view);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer image view. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__destroy_layer_attachment (
+  const Moss__LayerCache *const cache,
+  VkImage *const                image,
+  VkDeviceMemory *const         memory,
+  VkImageView *const            image_view
+)
+{
+  if (*image_view != VK_NULL_HANDLE)
+  {
+    vkDestroyImageView (cache->device, *image_view, NULL);
+    *image_view = VK_NULL_HANDLE;
+  }
+
+  if (*image != VK_NULL_HANDLE)
+  {
+    vkDestroyImage (cache->device, *image, NULL);
+    *image = VK_NULL_HANDLE;
+  }
+
+  if (*memory != VK_NULL_HANDLE)
+  {
+    moss__untrack_vram_allocation (*memory);
+    vkFreeMemory (cache->device, *memory, NULL);
+    *memory = VK_NULL_HANDLE;
+  }
+}
+
+inline static MossResult
+moss__create_layer_image (const Moss__LayerCache *const cache, Moss__Layer *const layer)
+{
+  if (moss__create_layer_attachment (
+        cache,
+        cache->format,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        &layer->image,
+        &layer->memory,
+        &layer->image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_layer_image (cache, layer);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkImageView framebuffer_attachments[] = {
+    layer->image_view,
+    cache->id_image_view,
+  };
+
+  const VkFramebufferCreateInfo framebuffer_info = {
+    .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+    .renderPass      = cache->render_pass,
+    .attachmentCount = cache->color_attachment_count,
+    .pAttachments    = framebuffer_attachments,
+    .width           = cache->extent.width,
+    .height          = cache->extent.height,
+    .layers          = 1,
+  };
+
+  const VkResult result =
+    vkCreateFramebuffer (cache->device, &framebuffer_info, NULL, &layer->framebuffer);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create layer framebuffer. Error code: %d.\n", result);
+    moss__destroy_layer_image (cache, layer);
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Fresh image holds nothing yet
+  layer->is_dirty = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void
+moss__destroy_layer_image (const Moss__LayerCache *const cache, Moss__Layer *const layer)
+{
+  if (layer->framebuffer != VK_NULL_HANDLE)
+  {
+    vkDestroyFramebuffer (cache->device, layer->framebuffer, NULL);
+    layer->framebuffer = VK_NULL_HANDLE;
+  }
+
+  moss__destroy_layer_attachment (
+    cache,
+    &layer->image,
+    &layer->memory,
+    &layer->image_view
+  );
+}
+
+inline static MossResult moss__reserve_layer_vertices (
+  const Moss__LayerCache *const cache,
+  Moss__Layer *const            layer,
+  const uint32_t                sprite_count
+)
+{
+  if (sprite_count <= layer->sprite_capacity) { return MOSS_RESULT_SUCCESS; }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&layer->vertex_crate);
+  layer->vertices        = NULL;
+  layer->sprite_capacity = 0;
+
+  const Moss__CrateCreateInfo crate_info = {
+    .size = (VkDeviceSize)sprite_count * MOSS__SPRITE_VERTEX_COUNT * sizeof (MossVertex),
+    .usage             = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = cache->device,
+    .physical_device                 = cache->physical_device,
+    .debug_name                      = "layer vertex crate",
+  };
+
+  if (moss__create_crate (&crate_info, &layer->vertex_crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create layer vertex crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void          *mapped_memory;
+  const VkResult result = vkMapMemory (
+    cache->device,
+    layer->vertex_crate.memory,
+    0,
+    layer->vertex_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map layer vertex crate. Error code: %d.\n", result);
+    moss__destroy_crate (&layer->vertex_crate);
+    return MOSS_RESULT_ERROR;
+  }
+
+  layer->vertices        = mapped_memory;
+  layer->sprite_capacity = sprite_count;
+
+  return MOSS_RESULT_SUCCESS;
+}
@@ -0,0 +1,490 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/light_culling.c
+  @brief Tile-based 2D light culling implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <math.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/light.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/light_culling.h"
+#include "src/internal/log.h"
+#include "src/internal/shaders.h"
+#include "src/internal/vk_shader_utils.h"
+
+/* Number of bindings of the light descriptor set. */
+#define MOSS__LIGHT_CULLING_BINDING_COUNT (uint32_t)(2)
+
+/* Binding of the light crate. */
+#define MOSS__LIGHT_BINDING (uint32_t)(0)
+
+/* Binding of the tile crate. */
+#define MOSS__LIGHT_TILE_BINDING (uint32_t)(1)
+
+/*
+  @brief Push constants of the culling shader.
+*/
+typedef struct
+{
+  uint32_t tile_count_x;   /* Number of tile columns. */
+  uint32_t tile_count_y;   /* Number of tile rows. */
+  uint32_t light_count;    /* Number of lights. */
+  uint32_t padding;        /* Aligns tile size to 8 bytes. */
+  float    tile_size[ 2 ]; /* Tile size in sprite coordinates. */
+} Moss__LightCullingPushConstants;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates tile crate for the info's extent and binds it to the frame's set.
+  @param info Creation information.
+  @param frame Frame resources with descriptor set allocated.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_light_tile_crate (
+  const Moss__LightCullingCreateInfo *info,
+  Moss__LightCullingFrame            *frame
+);
+
+/*
+  @brief Writes a storage buffer descriptor.
+  @param device Device the set was allocated on.
+  @param set Descriptor set to update.
+  @param binding Binding to write.
+  @param buffer Buffer to bind.
+*/
+inline static void moss__write_light_descriptor (
+  VkDevice        device,
+  VkDescriptorSet set,
+  uint32_t        binding,
+  VkBuffer        buffer
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__pack_gpu_light (const MossLight *const light, Moss__GpuLight *const out_light)
+{
+  *out_light = (Moss__GpuLight) {
+    .position  = { light->x, light->y },
+    .radius    = light->radius,
+    .intensity = light->intensity,
+    .color     = {
+      (float)((light->color >> 0) & 0xFF) / 255.0F,
+      (float)((light->color >> 8) & 0xFF) / 255.0F,
+      (float)((light->color >> 16) & 0xFF) / 255.0F,
+      (float)((light->color >> 24) & 0xFF) / 255.0F,
+    },
+    .direction = { cosf (light->direction), sinf (light->direction) },
+    .cos_cone  = light->cone_angle > 0.0F ? cosf (light->cone_angle) : -1.0F,
+    .height    = light->height,
+  };
+}
+
+MossResult moss__create_light_culling (
+  const Moss__LightCullingCreateInfo *const info,
+  Moss__LightCulling *const                 out_culling
+)
+{
+  *out_culling        = (Moss__LightCulling) {0};
+  out_culling->device = info->device;
+
+  VkDescriptorSetLayoutBinding bindings[ MOSS__LIGHT_CULLING_BINDING_COUNT ];
+  for (uint32_t i = 0; i < MOSS__LIGHT_CULLING_BINDING_COUNT; ++i)
+  {
+    bindings[ i ] = (VkDescriptorSetLayoutBinding) {
+      .binding         = i,
+      .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 1,
+      .stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+    };
+  }
+
+  const VkDescriptorSetLayoutCreateInfo set_layout_info = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .bindingCount = MOSS__LIGHT_CULLING_BINDING_COUNT,
+    .pBindings    = bindings,
+  };
+
+  VkResult result = vkCreateDescriptorSetLayout (
+    info->device,
+    &set_layout_info,
+    NULL,
+    &out_culling->descriptor_set_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create light descriptor set layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_light_culling (out_culling);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__LightCullingPushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &out_culling->descriptor_set_layout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  result = vkCreatePipelineLayout (
+    info->device,
+    &pipeline_layout_info,
+    NULL,
+    &out_culling->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create light culling pipeline layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_light_culling (out_culling);
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule shader_module;
+  if (moss__create_shader_module_from_file (
+        info->device,
+        MOSS__LIGHT_CULLING_SHADER_PATH,
+        &shader_module
+      ) != VK_SUCCESS)
+  {
+    moss__destroy_light_culling (out_culling);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkComputePipelineCreateInfo pipeline_info = {
+    .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+    .stage =
+      {
+              .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+              .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
+              .module = shader_module,
+              .pName  = "main",
+              },
+    .layout = out_culling->pipeline_layout,
+  };
+
+  result = vkCreateComputePipelines (
+    info->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &out_culling->pipeline
+  );
+
+  vkDestroyShaderModule (info->device, shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create light culling pipeline. Error code: %d.\n", result);
+    moss__destroy_light_culling (out_culling);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    info->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    out_culling->pipeline,
+    "light culling pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_light_culling (Moss__LightCulling *const culling)
+{
+  if (culling->device == VK_NULL_HANDLE) { return; }
+
+  if (culling->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (culling->device, culling->pipeline, NULL);
+  }
+
+  if (culling->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (culling->device, culling->pipeline_layout, NULL);
+  }
+
+  if (culling->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (culling->device, culling->descriptor_set_layout, NULL);
+  }
+
+  *culling = (Moss__LightCulling) {0};
+}
+
+MossResult moss__create_light_culling_frame (
+  const Moss__LightCulling *const           culling,
+  const Moss__LightCullingCreateInfo *const info,
+  Moss__LightCullingFrame *const            out_frame
+)
+{
+  *out_frame = (Moss__LightCullingFrame) {0};
+
+  const Moss__CrateCreateInfo light_crate_info = {
+    .size              = (VkDeviceSize)MOSS_MAX_LIGHT_COUNT * sizeof (Moss__GpuLight),
+    .usage             = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "light crate",
+  };
+
+  if (moss__create_crate (&light_crate_info, &out_frame->light_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create light crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void    *mapped_memory;
+  VkResult result = vkMapMemory (
+    info->device,
+    out_frame->light_crate.memory,
+    0,
+    out_frame->light_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map light crate. Error code: %d.\n", result);
+    moss__destroy_light_culling_frame (culling, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->lights = mapped_memory;
+
+  const VkDescriptorPoolSize pool_size = {
+    .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .descriptorCount = MOSS__LIGHT_CULLING_BINDING_COUNT,
+  };
+
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = 1,
+    .poolSizeCount = 1,
+    .pPoolSizes    = &pool_size,
+  };
+
+  result =
+    vkCreateDescriptorPool (info->device, &pool_info, NULL, &out_frame->descriptor_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create light descriptor pool. Error code: %d.\n", result);
+    moss__destroy_light_culling_frame (culling, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetAllocateInfo set_info = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .descriptorPool     = out_frame->descriptor_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &culling->descriptor_set_layout,
+  };
+
+  result = vkAllocateDescriptorSets (info->device, &set_info, &out_frame->descriptor_set);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate light descriptor set. Error code: %d.\n", result);
+    moss__destroy_light_culling_frame (culling, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_light_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__LIGHT_BINDING,
+    out_frame->light_crate.buffer
+  );
+
+  if (moss__create_light_tile_crate (info, out_frame) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_light_culling_frame (culling, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+MossResult moss__resize_light_culling_frame (
+  const Moss__LightCulling *const           culling,
+  const Moss__LightCullingCreateInfo *const info,
+  Moss__LightCullingFrame *const            frame
+)
+{
+  (void)culling;
+
+  moss__destroy_crate (&frame->tile_crate);
+
+  return moss__create_light_tile_crate (info, frame);
+}
+
+void moss__destroy_light_culling_frame (
+  const Moss__LightCulling *const culling,
+  Moss__LightCullingFrame *const  frame
+)
+{
+  if (frame->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (culling->device, frame->descriptor_pool, NULL);
+  }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->light_crate);
+  moss__destroy_crate (&frame->tile_crate);
+
+  *frame = (Moss__LightCullingFrame) {0};
+}
+
+void moss__record_light_culling (
+  const Moss__LightCulling *const      culling,
+  const Moss__LightCullingFrame *const frame,
+  const VkCommandBuffer                command_buffer,
+  const uint32_t                       light_count
+)
+{
+  // Sprite coordinates span [-1, 1] over the whole framebuffer
+  const Moss__LightCullingPushConstants push_constants = {
+    .tile_count_x = frame->tile_count_x,
+    .tile_count_y = frame->tile_count_y,
+    .light_count  = light_count,
+    .padding      = 0,
+    .tile_size    = {
+      2.0F * (float)MOSS__LIGHT_TILE_SIZE / (float)frame->extent.width,
+      2.0F * (float)MOSS__LIGHT_TILE_SIZE / (float)frame->extent.height,
+    },
+  };
+
+  vkCmdBindPipeline (command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling->pipeline);
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    culling->pipeline_layout,
+    0,
+    1,
+    &frame->descriptor_set,
+    0,
+    NULL
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    culling->pipeline_layout,
+    VK_SHADER_STAGE_COMPUTE_BIT,
+    0,
+    sizeof (push_constants),
+    &push_constants
+  );
+
+  vkCmdDispatch (command_buffer, frame->tile_count_x, frame->tile_count_y, 1);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_light_tile_crate (
+  const Moss__LightCullingCreateInfo *const info,
+  Moss__LightCullingFrame *const            frame
+)
+{
+  frame->extent = info->extent;
+  frame->tile_count_x =
+    (info->extent.width + MOSS__LIGHT_TILE_SIZE - 1) / MOSS__LIGHT_TILE_SIZE;
+  frame->tile_count_y =
+    (info->extent.height + MOSS__LIGHT_TILE_SIZE - 1) / MOSS__LIGHT_TILE_SIZE;
+
+  const Moss__CrateCreateInfo create_info = {
+    .size = (VkDeviceSize)frame->tile_count_x * frame->tile_count_y *
+            MOSS__LIGHT_TILE_STRIDE * sizeof (uint32_t),
+    .usage                           = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "light tile crate",
+  };
+
+  if (moss__create_crate (&create_info, &frame->tile_crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create light tile crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_light_descriptor (
+    info->device,
+    frame->descriptor_set,
+    MOSS__LIGHT_TILE_BINDING,
+    frame->tile_crate.buffer
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__write_light_descriptor (
+  const VkDevice        device,
+  const VkDescriptorSet set,
+  const uint32_t        binding,
+  const VkBuffer        buffer
+)
+{
+  const VkDescriptorBufferInfo buffer_info = {
+    .buffer = buffer,
+    .offset = 0,
+    .range  = VK_WHOLE_SIZE,
+  };
+
+  const VkWriteDescriptorSet write = {
+    .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .dstSet          = set,
+    .dstBinding      = binding,
+    .descriptorCount = 1,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .pBufferInfo     = &buffer_info,
+  };
+
+  vkUpdateDescriptorSets (device, 1, &write, 0, NULL);
+}
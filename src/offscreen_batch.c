@@ -0,0 +1,700 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/offscreen_batch.c
+  @brief Offscreen batch implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/offscreen.h"
+#include "moss/result.h"
+#include "moss/vertex.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/log.h"
+#include "src/internal/memory_utils.h"
+#include "src/internal/offscreen_batch.h"
+#include "src/internal/scene_target.h"
+#include "src/internal/sprite_kernels.h"
+#include "src/internal/vram_tracker.h"
+
+/* Number of bytes per offscreen pixel. */
+#define MOSS__OFFSCREEN_PIXEL_SIZE (uint32_t)(4)
+
+/* Max number of scenes drawn per pass, bounds copy regions recorded at once. */
+#define MOSS__MAX_OFFSCREEN_PASS_SCENE_COUNT (uint32_t)(256)
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates offscreen render pass.
+  @param batch Offscreen batch with format and attachment count set.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_offscreen_render_pass (Moss__OffscreenBatch *batch);
+
+/*
+  @brief Creates offscreen image, scratch pick ID image and framebuffer.
+  @param batch Offscreen batch.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_offscreen_images (Moss__OffscreenBatch *batch);
+
+/*
+  @brief Creates image of the offscreen target size with its view.
+  @param batch Offscreen batch.
+  @param format Image format.
+  @param usage Image usage.
+  @param out_image Output image.
+  @param out_memory Output image memory.
+  @param out_image_view Output image view.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_offscreen_attachment (
+  const Moss__OffscreenBatch *batch,
+  VkFormat                    format,
+  VkImageUsageFlags           usage,
+  VkImage                    *out_image,
+  VkDeviceMemory             *out_memory,
+  VkImageView                *out_image_view
+);
+
+/*
+  @brief Destroys image with its view and memory.
+  @param batch Offscreen batch.
+  @param image Image to destroy.
+  @param memory Image memory to free.
+  @param image_view Image view to destroy.
+*/
+inline static void moss__destroy_offscreen_attachment (
+  const Moss__OffscreenBatch *batch,
+  VkImage                    *image,
+  VkDeviceMemory             *memory,
+  VkImageView                *image_view
+);
+
+/*
+  @brief Recreates host visible crate with a new size and maps it.
+  @param batch Offscreen batch.
+  @param size Crate size in bytes.
+  @param usage Crate usage.
+  @param crate Crate to recreate.
+  @param out_memory Output mapped memory.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__recreate_offscreen_crate (
+  const Moss__OffscreenBatch *batch,
+  VkDeviceSize                size,
+  VkBufferUsageFlags          usage,
+  Moss__Crate                *crate,
+  void                      **out_memory
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_offscreen_batch (
+  const Moss__OffscreenBatchCreateInfo *const info,
+  Moss__OffscreenBatch *const                 out_batch
+)
+{
+  *out_batch = (Moss__OffscreenBatch) {
+    .physical_device        = info->physical_device,
+    .device                 = info->device,
+    .format                 = info->format,
+    .color_attachment_count = info->color_attachment_count,
+  };
+
+  if (moss__create_offscreen_render_pass (out_batch) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_offscreen_batch (out_batch);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_offscreen_batch (Moss__OffscreenBatch *const batch)
+{
+  if (batch->device == VK_NULL_HANDLE) { return; }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&batch->readback_crate);
+  moss__destroy_crate (&batch->vertex_crate);
+
+  if (batch->framebuffer != VK_NULL_HANDLE)
+  {
+    vkDestroyFramebuffer (batch->device, batch->framebuffer, NULL);
+  }
+
+  moss__destroy_offscreen_attachment (
+    batch,
+    &batch->id_image,
+    &batch->id_memory,
+    &batch->id_image_view
+  );
+  moss__destroy_offscreen_attachment (
+    batch,
+    &batch->image,
+    &batch->memory,
+    &batch->image_view
+  );
+
+  if (batch->render_pass != VK_NULL_HANDLE)
+  {
+    vkDestroyRenderPass (batch->device, batch->render_pass, NULL);
+  }
+
+  *batch = (Moss__OffscreenBatch) {0};
+}
+
+Moss__OffscreenGrid moss__get_offscreen_grid (const uint32_t width, const uint32_t height)
+{
+  const uint32_t column_count = MOSS_OFFSCREEN_TARGET_SIZE / width;
+  const uint32_t row_count    = MOSS_OFFSCREEN_TARGET_SIZE / height;
+
+  uint32_t scenes_per_pass = column_count * row_count;
+  if (scenes_per_pass > MOSS__MAX_OFFSCREEN_PASS_SCENE_COUNT)
+  {
+    scenes_per_pass = MOSS__MAX_OFFSCREEN_PASS_SCENE_COUNT;
+  }
+
+  return (Moss__OffscreenGrid) {
+    .column_count    = column_count,
+    .scenes_per_pass = scenes_per_pass,
+  };
+}
+
+MossResult moss__reserve_offscreen_batch (
+  Moss__OffscreenBatch *const batch,
+  const uint32_t              sprite_count,
+  const VkDeviceSize          pixel_size
+)
+{
+  // Images are created on first use, so the target takes no VRAM until needed
+  if (batch->image == VK_NULL_HANDLE &&
+      moss__create_offscreen_images (batch) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (sprite_count > batch->sprite_capacity)
+  {
+    void *mapped_memory;
+    if (moss__recreate_offscreen_crate (
+          batch,
+          (VkDeviceSize)sprite_count * MOSS__SPRITE_VERTEX_COUNT * sizeof (MossVertex),
+          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+          &batch->vertex_crate,
+          &mapped_memory
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      batch->vertices        = NULL;
+      batch->sprite_capacity = 0;
+      return MOSS_RESULT_ERROR;
+    }
+
+    batch->vertices        = mapped_memory;
+    batch->sprite_capacity = sprite_count;
+  }
+
+  if (pixel_size > batch->pixel_capacity)
+  {
+    void *mapped_memory;
+    if (moss__recreate_offscreen_crate (
+          batch,
+          pixel_size,
+          VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          &batch->readback_crate,
+          &mapped_memory
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      batch->pixels         = NULL;
+      batch->pixel_capacity = 0;
+      return MOSS_RESULT_ERROR;
+    }
+
+    batch->pixels         = mapped_memory;
+    batch->pixel_capacity = pixel_size;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__begin_offscreen_pass (
+  const Moss__OffscreenBatch *const batch,
+  const VkCommandBuffer             command_buffer,
+  const VkExtent2D                  render_extent
+)
+{
+  const VkRenderPassBeginInfo pass_info = {
+    .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+    .renderPass  = batch->render_pass,
+    .framebuffer = batch->framebuffer,
+    .renderArea =
+      {
+                   .offset = {0, 0},
+                   .extent = render_extent,
+                   },
+    .clearValueCount = batch->color_attachment_count,
+    .pClearValues    = (const VkClearValue[]) {
+                   {.color = {{0.0F, 0.0F, 0.0F, 0.0F}}},
+                   {.color = {.uint32 = {0, 0, 0, 0}}},
+                   },
+  };
+
+  vkCmdBeginRenderPass (command_buffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void moss__record_offscreen_readback (
+  const Moss__OffscreenBatch *const batch,
+  const VkCommandBuffer             command_buffer,
+  const Moss__OffscreenGrid *const  grid,
+  const MossOffscreenBatch *const   batch_info,
+  const uint32_t                    first_scene,
+  const uint32_t                    scene_count
+)
+{
+  const VkDeviceSize scene_size = (VkDeviceSize)batch_info->width * batch_info->height *
+                                  MOSS__OFFSCREEN_PIXEL_SIZE;
+
+  // One region per scene packs scenes tightly, still a single copy command
+  VkBufferImageCopy regions[ MOSS__MAX_OFFSCREEN_PASS_SCENE_COUNT ];
+  for (uint32_t i = 0; i < scene_count; ++i)
+  {
+    const uint32_t column = i % grid->column_count;
+    const uint32_t row    = i / grid->column_count;
+
+    regions[ i ] = (VkBufferImageCopy) {
+      .bufferOffset      = (first_scene + i) * scene_size,
+      .bufferRowLength   = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource =
+        {
+                            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .mipLevel       = 0,
+                            .baseArrayLayer = 0,
+                            .layerCount     = 1,
+                            },
+      .imageOffset =
+        {
+                            .x = (int32_t)(column * batch_info->width),
+                            .y = (int32_t)(row * batch_info->height),
+                            .z = 0,
+                            },
+      .imageExtent =
+        {
+                            .width  = batch_info->width,
+                            .height = batch_info->height,
+                            .depth  = 1,
+                            },
+    };
+  }
+
+  vkCmdCopyImageToBuffer (
+    command_buffer,
+    batch->image,
+    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    batch->readback_crate.buffer,
+    scene_count,
+    regions
+  );
+
+  // Host reads the pixels once the batch's fence signals
+  const VkBufferMemoryBarrier barrier = {
+    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+    .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+    .dstAccessMask       = VK_ACCESS_HOST_READ_BIT,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .buffer              = batch->readback_crate.buffer,
+    .offset              = first_scene * scene_size,
+    .size                = scene_count * scene_size,
+  };
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_HOST_BIT,
+    0,
+    0,
+    NULL,
+    1,
+    &barrier,
+    0,
+    NULL
+  );
+}
+
+void moss__read_offscreen_pixels (
+  const Moss__OffscreenBatch *const batch,
+  const VkDeviceSize                pixel_size,
+  uint8_t *const                    out_pixels
+)
+{
+  const bool is_bgra =
+    batch->format == VK_FORMAT_B8G8R8A8_SRGB || batch->format == VK_FORMAT_B8G8R8A8_UNORM;
+
+  if (!is_bgra)
+  {
+    memcpy (out_pixels, batch->pixels, (size_t)pixel_size);
+    return;
+  }
+
+  // Swap chain formats are usually BGRA, callers always get RGBA
+  for (VkDeviceSize i = 0; i < pixel_size; i += MOSS__OFFSCREEN_PIXEL_SIZE)
+  {
+    out_pixels[ i + 0 ] = batch->pixels[ i + 2 ];
+    out_pixels[ i + 1 ] = batch->pixels[ i + 1 ];
+    out_pixels[ i + 2 ] = batch->pixels[ i + 0 ];
+    out_pixels[ i + 3 ] = batch->pixels[ i + 3 ];
+  }
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult
+moss__create_offscreen_render_pass (Moss__OffscreenBatch *const batch)
+{
+  const VkAttachmentDescription attachments[ 2 ] = {
+    {
+     .format         = batch->format,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+     },
+    // Only keeps the pass compatible with the sprite pipeline, nothing is stored
+    {
+     .format         = MOSS__PICK_ID_FORMAT,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+  };
+
+  const VkAttachmentReference color_attachment_refs[ 2 ] = {
+    {
+     .attachment = 0,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+    {
+     .attachment = 1,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+  };
+
+  const VkSubpassDescription subpass = {
+    .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    .colorAttachmentCount = batch->color_attachment_count,
+    .pColorAttachments    = color_attachment_refs,
+  };
+
+  const VkSubpassDependency dependencies[ 2 ] = {
+    // Copies of the previous pass must finish reading before the image is cleared
+    {
+     .srcSubpass    = VK_SUBPASS_EXTERNAL,
+     .dstSubpass    = 0,
+     .srcStageMask  = VK_PIPELINE_STAGE_TRANSFER_BIT,
+     .srcAccessMask = 0,
+     .dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     },
+    // Readback copies the scenes only once they're written
+    {
+     .srcSubpass    = 0,
+     .dstSubpass    = VK_SUBPASS_EXTERNAL,
+     .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     .dstStageMask  = VK_PIPELINE_STAGE_TRANSFER_BIT,
+     .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+     },
+  };
+
+  const VkRenderPassCreateInfo render_pass_info = {
+    .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+    .attachmentCount = batch->color_attachment_count,
+    .pAttachments    = attachments,
+    .subpassCount    = 1,
+    .pSubpasses      = &subpass,
+    .dependencyCount = 2,
+    .pDependencies   = dependencies,
+  };
+
+  const VkResult result =
+    vkCreateRenderPass (batch->device, &render_pass_info, NULL, &batch->render_pass);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen render pass. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    batch->device,
+    VK_OBJECT_TYPE_RENDER_PASS,
+    batch->render_pass,
+    "offscreen render pass"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_offscreen_images (Moss__OffscreenBatch *const batch)
+{
+  if (moss__create_offscreen_attachment (
+        batch,
+        batch->format,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+        &batch->image,
+        &batch->memory,
+        &batch->image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (batch->color_attachment_count > 1 &&
+      moss__create_offscreen_attachment (
+        batch,
+        MOSS__PICK_ID_FORMAT,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+        &batch->id_image,
+        &batch->id_memory,
+        &batch->id_image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkImageView framebuffer_attachments[] = {
+    batch->image_view,
+    batch->id_image_view,
+  };
+
+  const VkFramebufferCreateInfo framebuffer_info = {
+    .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+    .renderPass      = batch->render_pass,
+    .attachmentCount = batch->color_attachment_count,
+    .pAttachments    = framebuffer_attachments,
+    .width           = MOSS_OFFSCREEN_TARGET_SIZE,
+    .height          = MOSS_OFFSCREEN_TARGET_SIZE,
+    .layers          = 1,
+  };
+
+  const VkResult result =
+    vkCreateFramebuffer (batch->device, &framebuffer_info, NULL, &batch->framebuffer);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen framebuffer. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_offscreen_attachment (
+  const Moss__OffscreenBatch *const batch,
+  const VkFormat                    format,
+  const VkImageUsageFlags           usage,
+  VkImage *const                    out_image,
+  VkDeviceMemory *const             out_memory,
+  VkImageView *const                out_image_view
+)
+{
+  const VkImageCreateInfo image_info = {
+    .sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format    = format,
+    .extent =
+      {
+               .width  = MOSS_OFFSCREEN_TARGET_SIZE,
+               .height = MOSS_OFFSCREEN_TARGET_SIZE,
+               .depth  = 1,
+               },
+    .mipLevels     = 1,
+    .arrayLayers   = 1,
+    .samples       = VK_SAMPLE_COUNT_1_BIT,
+    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+    .usage         = usage,
+    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkResult result = vkCreateImage (batch->device, &image_info, NULL, out_image);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen image. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    batch->device,
+    VK_OBJECT_TYPE_IMAGE,
+    *out_image,
+    "offscreen attachment"
+  );
+
+  VkMemoryRequirements memory_requirements;
+  vkGetImageMemoryRequirements (batch->device, *out_image, &memory_requirements);
+
+  uint32_t memory_type;
+  if (moss__select_suitable_memory_type (
+        batch->physical_device,
+        memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memory_type
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to find suitable memory type for offscreen image.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkMemoryAllocateInfo alloc_info = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .allocationSize  = memory_requirements.size,
+    .memoryTypeIndex = memory_type,
+  };
+
+  result = vkAllocateMemory (batch->device, &alloc_info, NULL, out_memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate offscreen image memory. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__track_vram_allocation (
+    batch->physical_device,
+    *out_memory,
+    MOSS_VRAM_CATEGORY_RENDER_TARGETS,
+    memory_type,
+    memory_requirements.size,
+    memory_requirements.size
+  );
+
+  vkBindImageMemory (batch->device, *out_image, *out_memory, 0);
+
+  const VkImageViewCreateInfo view_info = {
+    .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .image    = *out_image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format   = format,
+    .subresourceRange =
+      {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .baseMipLevel   = 0,
+                  .levelCount     = 1,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+                  },
+  };
+
+  result = vkCreateImageView (batch->device, &view_info, NULL, out_image_view);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen image view. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__destroy_offscreen_attachment (
+  const Moss__OffscreenBatch *const batch,
+  VkImage *const                    image,
+  VkDeviceMemory *const             memory,
+  VkImageView *const                image_view
+)
+{
+  if (*image_view != VK_NULL_HANDLE)
+  {
+    vkDestroyImageView (batch->device, *image_view, NULL);
+    *image_view = VK_NULL_HANDLE;
+  }
+
+  if (*image != VK_NULL_HANDLE)
+  {
+    vkDestroyImage (batch->device, *image, NULL);
+    *image = VK_NULL_HANDLE;
+  }
+
+  if (*memory != VK_NULL_HANDLE)
+  {
+    moss__untrack_vram_allocation (*memory);
+    vkFreeMemory (batch->device, *memory, NULL);
+    *memory = VK_NULL_HANDLE;
+  }
+}
+
+inline static MossResult moss__recreate_offscreen_crate (
+  const Moss__OffscreenBatch *const batch,
+  const VkDeviceSize                size,
+  const VkBufferUsageFlags          usage,
+  Moss__Crate *const                crate,
+  void **const                      out_memory
+)
+{
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (crate);
+
+  const Moss__CrateCreateInfo crate_info = {
+    .size              = size,
+    .usage             = usage,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = batch->device,
+    .physical_device                 = batch->physical_device,
+    .debug_name                      = "offscreen crate",
+  };
+
+  if (moss__create_crate (&crate_info, crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create offscreen crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkResult result =
+    vkMapMemory (batch->device, crate->memory, 0, crate->size, 0, out_memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map offscreen crate. Error code: %d.\n", result);
+    moss__destroy_crate (crate);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
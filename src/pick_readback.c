@@ -0,0 +1,184 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/pick_readback.c
+  @brief Asynchronous pick ID readback implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/picking.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/log.h"
+#include "src/internal/pick_readback.h"
+
+MossResult moss__create_pick_readback (
+  const Moss__PickReadbackCreateInfo *const info,
+  Moss__PickReadback *const                 out_readback
+)
+{
+  *out_readback = (Moss__PickReadback) {0};
+
+  if (info->frame_count > MOSS__PICK_READBACK_MAX_FRAME_COUNT)
+  {
+    moss__error (
+      "Pick readback can't track more than %u frames.\n",
+      MOSS__PICK_READBACK_MAX_FRAME_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__CrateCreateInfo crate_info = {
+    .size              = sizeof (uint32_t) * info->frame_count,
+    .usage             = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "pick readback crate",
+  };
+
+  if (moss__create_crate (&crate_info, &out_readback->crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create pick readback crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void          *mapped_memory;
+  const VkResult result = vkMapMemory (
+    info->device,
+    out_readback->crate.memory,
+    0,
+    out_readback->crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map pick readback crate. Error code: %d.\n", result);
+    moss__destroy_pick_readback (out_readback);
+    return MOSS_RESULT_ERROR;
+  }
+
+  out_readback->ids         = mapped_memory;
+  out_readback->frame_count = info->frame_count;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_pick_readback (Moss__PickReadback *const readback)
+{
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&readback->crate);
+
+  *readback = (Moss__PickReadback) {0};
+}
+
+void moss__record_pick (
+  Moss__PickReadback *const         readback,
+  const Moss__RecordPickInfo *const info
+)
+{
+  const VkBufferImageCopy region = {
+    .bufferOffset      = sizeof (uint32_t) * info->frame,
+    .bufferRowLength   = 0,
+    .bufferImageHeight = 0,
+    .imageSubresource =
+      {
+                          .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                          .mipLevel       = 0,
+                          .baseArrayLayer = 0,
+                          .layerCount     = 1,
+                          },
+    .imageOffset = { info->texel.x, info->texel.y, 0 },
+    .imageExtent = { 1, 1, 1 },
+  };
+
+  vkCmdCopyImageToBuffer (
+    info->command_buffer,
+    info->id_image,
+    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    readback->crate.buffer,
+    1,
+    &region
+  );
+
+  // Make the copied ID visible to the host once the fence is signaled
+  const VkBufferMemoryBarrier barrier = {
+    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+    .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+    .dstAccessMask       = VK_ACCESS_HOST_READ_BIT,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .buffer              = readback->crate.buffer,
+    .offset              = region.bufferOffset,
+    .size                = sizeof (uint32_t),
+  };
+
+  vkCmdPipelineBarrier (
+    info->command_buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_HOST_BIT,
+    0,
+    0,
+    NULL,
+    1,
+    &barrier,
+    0,
+    NULL
+  );
+
+  readback->is_frame_pending[ info->frame ] = true;
+  readback->positions[ info->frame ][ 0 ]   = info->x;
+  readback->positions[ info->frame ][ 1 ]   = info->y;
+}
+
+bool moss__read_pick (
+  Moss__PickReadback *const readback,
+  const uint32_t            frame,
+  MossPickResult *const     out_result
+)
+{
+  if (!readback->is_frame_pending[ frame ]) { return false; }
+
+  readback->is_frame_pending[ frame ] = false;
+
+  const uint32_t id = readback->ids[ frame ];
+
+  *out_result = (MossPickResult) {
+    .target = MOSS_PICK_TARGET_NONE,
+    .index  = 0,
+    .x      = readback->positions[ frame ][ 0 ],
+    .y      = readback->positions[ frame ][ 1 ],
+  };
+
+  if (id == 0) { return true; }
+
+  out_result->target = (id & MOSS__PICK_SKINNED_MESH_BIT) != 0
+                       ? MOSS_PICK_TARGET_SKINNED_MESH
+                       : MOSS_PICK_TARGET_SPRITE;
+  out_result->index  = (id & ~MOSS__PICK_SKINNED_MESH_BIT) - 1;
+
+  return true;
+}
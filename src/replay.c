@@ -0,0 +1,786 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/replay.c
+  @brief Capture replay implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "moss/animation.h"
+#include "moss/app_info.h"
+#include "moss/capture.h"
+#include "moss/engine.h"
+#include "moss/offscreen.h"
+#include "moss/result.h"
+#include "moss/skeleton.h"
+#include "moss/sprite.h"
+#include "moss/video.h"
+#include "moss/window_config.h"
+
+#include "src/internal/capture.h"
+#include "src/internal/engine.h"
+#include "src/internal/log.h"
+#include "src/internal/wake_signal.h"
+
+/*
+  @brief Cursor over the payload of a captured call.
+*/
+typedef struct
+{
+  const uint8_t *payload; /* Payload bytes. */
+  uint32_t       size;    /* Payload size. */
+  uint32_t       offset;  /* Offset of the next unread byte. */
+} Moss__CaptureReader;
+
+/*
+  @brief Replay state.
+*/
+typedef struct
+{
+  /* Capture file. */
+  FILE *file;
+
+  /* Buffer payloads are read into. */
+  uint8_t *payload;
+
+  /* Size of the payload buffer. */
+  uint32_t payload_capacity;
+
+  /* Information of the open video, used to split captured frames into planes. */
+  MossVideoCreateInfo video_info;
+
+  /* Number of frames drawn. */
+  uint32_t frame_count;
+} Moss__Replay;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Reads the next captured call.
+  @param replay Replay state.
+  @param out_op Output captured call.
+  @param out_reader Output payload reader.
+  @param out_is_end Output whether the end of the file was reached instead.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__read_capture_record (
+  Moss__Replay        *replay,
+  Moss__CaptureOp     *out_op,
+  Moss__CaptureReader *out_reader,
+  bool                *out_is_end
+);
+
+/*
+  @brief Issues a captured call.
+  @param replay Replay state.
+  @param op Captured call.
+  @param reader Payload reader.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__replay_call (Moss__Replay *replay, Moss__CaptureOp op, Moss__CaptureReader *reader);
+
+/*
+  @brief Takes the next bytes of a payload.
+  @param reader Payload reader.
+  @param size Number of bytes.
+  @return Pointer to the bytes, NULL if the payload is too short.
+*/
+inline static const void *
+moss__take_capture_bytes (Moss__CaptureReader *reader, uint64_t size);
+
+/*
+  @brief Takes a 32-bit value of a payload.
+  @param reader Payload reader.
+  @param out_value Output value.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the payload is too
+          short.
+*/
+inline static MossResult
+moss__take_capture_u32 (Moss__CaptureReader *reader, uint32_t *out_value);
+
+/*
+  @brief Takes a captured sprite batch, its arrays point into the payload.
+  @param reader Payload reader.
+  @param out_batch Output sprite batch.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the batch is malformed.
+*/
+inline static MossResult
+moss__take_capture_sprites (Moss__CaptureReader *reader, MossSpriteBatch *out_batch);
+
+/*
+  @brief Replays a captured animation clip upload.
+  @param reader Payload reader.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the payload is malformed.
+*/
+inline static MossResult moss__replay_animation_clips (Moss__CaptureReader *reader);
+
+/*
+  @brief Replays a captured skinned mesh creation.
+  @param reader Payload reader.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the payload is malformed.
+*/
+inline static MossResult moss__replay_skinned_mesh (Moss__CaptureReader *reader);
+
+/*
+  @brief Replays a captured video frame upload.
+  @param replay Replay state.
+  @param reader Payload reader.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the payload is malformed.
+*/
+inline static MossResult
+moss__replay_video_frame (const Moss__Replay *replay, Moss__CaptureReader *reader);
+
+/*
+  @brief Replays a captured offscreen batch rendering.
+  @param reader Payload reader.
+  @return MOSS_RESULT_SUCCESS on success, MOSS_RESULT_ERROR if the payload is malformed.
+*/
+inline static MossResult moss__replay_offscreen_batch (Moss__CaptureReader *reader);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss_replay_capture (const char *const path, MossReplayStats *const out_stats)
+{
+  Moss__Replay replay = {0};
+
+  replay.file = fopen (path, "rb");
+  if (replay.file == NULL)
+  {
+    moss__error ("Failed to open capture file \"%s\".\n", path);
+    return MOSS_RESULT_ERROR;
+  }
+
+  Moss__CaptureHeader header;
+  if (fread (&header, sizeof (header), 1, replay.file) != 1 ||
+      header.magic != MOSS_CAPTURE_MAGIC)
+  {
+    moss__error ("\"%s\" isn't a capture file.\n", path);
+    fclose (replay.file);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (header.version != MOSS_CAPTURE_VERSION)
+  {
+    moss__error (
+      "Capture file version %u isn't supported, expected %u.\n",
+      header.version,
+      MOSS_CAPTURE_VERSION
+    );
+    fclose (replay.file);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const MossAppInfo app_info = {
+    .app_name    = "Moss Replay",
+    .app_version = {0, 1, 0},
+  };
+
+  const MossWindowConfig window_config = {
+    .title  = "Moss Replay",
+    .width  = header.window_width,
+    .height = header.window_height,
+  };
+
+  const MossEngineConfig engine_config = {
+    .app_info       = &app_info,
+    .window_config  = &window_config,
+    .enable_picking = header.enable_picking != 0,
+  };
+
+  if (moss_engine_init (&engine_config) != MOSS_RESULT_SUCCESS)
+  {
+    fclose (replay.file);
+    return MOSS_RESULT_ERROR;
+  }
+
+  MossResult   result     = MOSS_RESULT_SUCCESS;
+  const double start_time = moss__get_monotonic_time ( );
+
+  while (result == MOSS_RESULT_SUCCESS)
+  {
+    Moss__CaptureOp     op;
+    Moss__CaptureReader reader;
+    bool                is_end;
+
+    result = moss__read_capture_record (&replay, &op, &reader, &is_end);
+    if (result != MOSS_RESULT_SUCCESS || is_end) { break; }
+
+    result = moss__replay_call (&replay, op, &reader);
+  }
+
+  // Submitted frames are part of the replay until the GPU is done with them
+  moss__wait_engine_idle ( );
+  const double seconds = moss__get_monotonic_time ( ) - start_time;
+
+  moss_engine_deinit ( );
+  free (replay.payload);
+  fclose (replay.file);
+
+  if (out_stats != NULL)
+  {
+    *out_stats = (MossReplayStats) {
+      .frame_count = replay.frame_count,
+      .seconds     = seconds,
+    };
+  }
+
+  return result;
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__read_capture_record (
+  Moss__Replay *const        replay,
+  Moss__CaptureOp *const     out_op,
+  Moss__CaptureReader *const out_reader,
+  bool *const                out_is_end
+)
+{
+  Moss__CaptureRecordHeader record_header;
+
+  const size_t read_count =
+    fread (&record_header, sizeof (record_header), 1, replay->file);
+  *out_is_end = read_count != 1 && feof (replay->file);
+  if (*out_is_end) { return MOSS_RESULT_SUCCESS; }
+
+  if (read_count != 1)
+  {
+    moss__error ("Failed to read capture file.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (record_header.size > replay->payload_capacity)
+  {
+    uint8_t *const payload = realloc (replay->payload, record_header.size);
+    if (payload == NULL)
+    {
+      moss__error (
+        "Failed to allocate %u bytes for a captured call.\n",
+        record_header.size
+      );
+      return MOSS_RESULT_ERROR;
+    }
+
+    replay->payload          = payload;
+    replay->payload_capacity = record_header.size;
+  }
+
+  if (record_header.size != 0 &&
+      fread (replay->payload, record_header.size, 1, replay->file) != 1)
+  {
+    moss__error ("Capture file ends in the middle of a call.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  *out_op     = (Moss__CaptureOp)record_header.op;
+  *out_reader = (Moss__CaptureReader) {
+    .payload = replay->payload,
+    .size    = record_header.size,
+    .offset  = 0,
+  };
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__replay_call (
+  Moss__Replay *const        replay,
+  const Moss__CaptureOp      op,
+  Moss__CaptureReader *const reader
+)
+{
+  // Results of calls are ignored, calls that failed during capture fail again
+  switch (op)
+  {
+    case MOSS__CAPTURE_OP_DRAW_FRAME:
+    {
+      // Keeps the window responsive, closing it cuts the replay short
+      if (moss_engine_should_close ( ))
+      {
+        moss__error ("Replay window was closed before the last frame.\n");
+        return MOSS_RESULT_ERROR;
+      }
+
+      replay->frame_count += 1;
+      return moss_engine_draw_frame ( );
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_SPRITES:
+    {
+      MossSpriteBatch batch;
+      if (moss__take_capture_sprites (reader, &batch) != MOSS_RESULT_SUCCESS) { break; }
+
+      moss_engine_submit_sprites (&batch);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_DRAW:
+    {
+      MossDrawCommand command;
+      const void     *data = moss__take_capture_bytes (reader, sizeof (command));
+      if (data == NULL) { break; }
+
+      memcpy (&command, data, sizeof (command));
+      moss_engine_submit_draw (&command);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_LIGHTS:
+    {
+      uint32_t count;
+      if (moss__take_capture_u32 (reader, &count) != MOSS_RESULT_SUCCESS) { break; }
+
+      const MossLight *const lights =
+        moss__take_capture_bytes (reader, (uint64_t)count * sizeof (*lights));
+      if (lights == NULL) { break; }
+
+      moss_engine_submit_lights (lights, count);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_OCCLUDERS:
+    {
+      uint32_t count;
+      if (moss__take_capture_u32 (reader, &count) != MOSS_RESULT_SUCCESS) { break; }
+
+      const MossOccluder *const occluders =
+        moss__take_capture_bytes (reader, (uint64_t)count * sizeof (*occluders));
+      if (occluders == NULL) { break; }
+
+      moss_engine_submit_occluders (occluders, count);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SET_AMBIENT_LIGHT:
+    {
+      uint32_t color;
+      if (moss__take_capture_u32 (reader, &color) != MOSS_RESULT_SUCCESS) { break; }
+
+      moss_engine_set_ambient_light (color);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SET_TARGET_FRAME_TIME:
+    case MOSS__CAPTURE_OP_SET_ANIMATION_TIME:
+    {
+      float       seconds;
+      const void *data = moss__take_capture_bytes (reader, sizeof (seconds));
+      if (data == NULL) { break; }
+
+      memcpy (&seconds, data, sizeof (seconds));
+      if (op == MOSS__CAPTURE_OP_SET_TARGET_FRAME_TIME)
+      {
+        moss_engine_set_target_frame_time (seconds);
+      }
+      else { moss_engine_set_animation_time (seconds); }
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_UPLOAD_ANIMATION_CLIPS:
+    {
+      return moss__replay_animation_clips (reader);
+    }
+
+    case MOSS__CAPTURE_OP_CREATE_SKINNED_MESH:
+    {
+      return moss__replay_skinned_mesh (reader);
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_SKINNED_MESH:
+    {
+      uint32_t mesh;
+      uint32_t bone_count;
+      if (moss__take_capture_u32 (reader, &mesh) != MOSS_RESULT_SUCCESS ||
+          moss__take_capture_u32 (reader, &bone_count) != MOSS_RESULT_SUCCESS)
+      {
+        break;
+      }
+
+      const MossBone *const pose =
+        moss__take_capture_bytes (reader, (uint64_t)bone_count * sizeof (*pose));
+      if (pose == NULL) { break; }
+
+      moss_engine_submit_skinned_mesh (mesh, pose);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_REQUEST_PICK:
+    {
+      float       position[ 2 ];
+      const void *data = moss__take_capture_bytes (reader, sizeof (position));
+      if (data == NULL) { break; }
+
+      memcpy (position, data, sizeof (position));
+      moss_engine_request_pick (position[ 0 ], position[ 1 ]);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_OPEN_VIRTUAL_TEXTURE:
+    {
+      uint32_t path_length;
+      if (moss__take_capture_u32 (reader, &path_length) != MOSS_RESULT_SUCCESS) { break; }
+
+      // Zero padding terminates the path
+      const char *const path =
+        moss__take_capture_bytes (reader, (uint64_t)path_length + 1);
+      if (path == NULL || path[ path_length ] != '\0') { break; }
+
+      moss_engine_open_virtual_texture (path);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_CLOSE_VIRTUAL_TEXTURE:
+    {
+      moss_engine_close_virtual_texture ( );
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_VIRTUAL_TEXTURE:
+    {
+      MossVirtualTextureView view;
+      const void            *data = moss__take_capture_bytes (reader, sizeof (view));
+      if (data == NULL) { break; }
+
+      memcpy (&view, data, sizeof (view));
+      moss_engine_submit_virtual_texture (&view);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_SET_LAYER_SPRITES:
+    {
+      uint32_t        layer;
+      MossSpriteBatch batch;
+      if (moss__take_capture_u32 (reader, &layer) != MOSS_RESULT_SUCCESS ||
+          moss__take_capture_sprites (reader, &batch) != MOSS_RESULT_SUCCESS)
+      {
+        break;
+      }
+
+      moss_engine_set_layer_sprites (layer, &batch);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_INVALIDATE_LAYER:
+    {
+      uint32_t layer;
+      if (moss__take_capture_u32 (reader, &layer) != MOSS_RESULT_SUCCESS) { break; }
+
+      moss_engine_invalidate_layer (layer);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_OPEN_VIDEO:
+    {
+      const uint32_t *const fields =
+        moss__take_capture_bytes (reader, 5 * sizeof (*fields));
+      if (fields == NULL) { break; }
+
+      replay->video_info = (MossVideoCreateInfo) {
+        .format        = (MossVideoFormat)fields[ 0 ],
+        .color_space   = (MossVideoColorSpace)fields[ 1 ],
+        .is_full_range = fields[ 2 ] != 0,
+        .width         = fields[ 3 ],
+        .height        = fields[ 4 ],
+      };
+
+      moss_engine_open_video (&replay->video_info);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_CLOSE_VIDEO:
+    {
+      moss_engine_close_video ( );
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_UPLOAD_VIDEO_FRAME:
+    {
+      return moss__replay_video_frame (replay, reader);
+    }
+
+    case MOSS__CAPTURE_OP_SUBMIT_VIDEO:
+    {
+      MossVideoView view;
+      const void   *data = moss__take_capture_bytes (reader, sizeof (view));
+      if (data == NULL) { break; }
+
+      memcpy (&view, data, sizeof (view));
+      moss_engine_submit_video (&view);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    case MOSS__CAPTURE_OP_RENDER_OFFSCREEN_BATCH:
+    {
+      return moss__replay_offscreen_batch (reader);
+    }
+
+    default:
+    {
+      moss__error ("Unknown captured call %u.\n", (uint32_t)op);
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  moss__error ("Captured call %u is malformed.\n", (uint32_t)op);
+  return MOSS_RESULT_ERROR;
+}
+
+inline static const void *
+moss__take_capture_bytes (Moss__CaptureReader *const reader, const uint64_t size)
+{
+  if (size > reader->size - reader->offset) { return NULL; }
+
+  const void *const bytes = reader->payload + reader->offset;
+  reader->offset += (uint32_t)size;
+
+  return bytes;
+}
+
+inline static MossResult
+moss__take_capture_u32 (Moss__CaptureReader *const reader, uint32_t *const out_value)
+{
+  const void *const data = moss__take_capture_bytes (reader, sizeof (*out_value));
+  if (data == NULL) { return MOSS_RESULT_ERROR; }
+
+  memcpy (out_value, data, sizeof (*out_value));
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__take_capture_sprites (
+  Moss__CaptureReader *const reader,
+  MossSpriteBatch *const     out_batch
+)
+{
+  const Moss__CaptureSpriteBatchHeader *const batch_header =
+    moss__take_capture_bytes (reader, sizeof (*batch_header));
+  if (batch_header == NULL) { return MOSS_RESULT_ERROR; }
+
+  // Every array element takes 4 bytes
+  const void *arrays[ MOSS__CAPTURE_SPRITE_ARRAY_COUNT ] = {0};
+  for (uint32_t i = 0; i < MOSS__CAPTURE_SPRITE_ARRAY_COUNT; ++i)
+  {
+    if ((batch_header->mask & (1U << i)) == 0) { continue; }
+
+    arrays[ i ] = moss__take_capture_bytes (reader, (uint64_t)batch_header->count * 4);
+    if (arrays[ i ] == NULL) { return MOSS_RESULT_ERROR; }
+  }
+
+  *out_batch = (MossSpriteBatch) {
+    .x                    = arrays[ 0 ],
+    .y                    = arrays[ 1 ],
+    .rotation             = arrays[ 2 ],
+    .scale_x              = arrays[ 3 ],
+    .scale_y              = arrays[ 4 ],
+    .texture_index        = arrays[ 5 ],
+    .color                = arrays[ 6 ],
+    .depth                = arrays[ 7 ],
+    .animation_clip       = arrays[ 8 ],
+    .animation_start_time = arrays[ 9 ],
+    .count                = batch_header->count,
+  };
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__replay_animation_clips (Moss__CaptureReader *const reader)
+{
+  uint32_t count;
+  if (moss__take_capture_u32 (reader, &count) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Captured animation clips are malformed.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  MossAnimationClip *const clips = malloc ((size_t)count * sizeof (*clips) + 1);
+  if (clips == NULL)
+  {
+    moss__error ("Failed to allocate %u replayed animation clips.\n", count);
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    uint32_t loop_mode;
+    uint32_t frame_count;
+    if (moss__take_capture_u32 (reader, &loop_mode) != MOSS_RESULT_SUCCESS ||
+        moss__take_capture_u32 (reader, &frame_count) != MOSS_RESULT_SUCCESS)
+    {
+      free (clips);
+      moss__error ("Captured animation clips are malformed.\n");
+      return MOSS_RESULT_ERROR;
+    }
+
+    clips[ i ] = (MossAnimationClip) {
+      .frames      = moss__take_capture_bytes (
+        reader,
+        (uint64_t)frame_count * sizeof (MossAnimationFrame)
+      ),
+      .frame_count = frame_count,
+      .loop_mode   = (MossAnimationLoopMode)loop_mode,
+    };
+
+    if (clips[ i ].frames == NULL)
+    {
+      free (clips);
+      moss__error ("Captured animation clips are malformed.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  moss_engine_upload_animation_clips (clips, count);
+  free (clips);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__replay_skinned_mesh (Moss__CaptureReader *const reader)
+{
+  MossSkinnedMeshCreateInfo info;
+  if (moss__take_capture_u32 (reader, &info.vertex_count) != MOSS_RESULT_SUCCESS ||
+      moss__take_capture_u32 (reader, &info.index_count) != MOSS_RESULT_SUCCESS ||
+      moss__take_capture_u32 (reader, &info.bone_count) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Captured skinned mesh is malformed.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  info.vertices = moss__take_capture_bytes (
+    reader,
+    (uint64_t)info.vertex_count * sizeof (*info.vertices)
+  );
+  info.indices = moss__take_capture_bytes (
+    reader,
+    (uint64_t)info.index_count * sizeof (*info.indices)
+  );
+  info.bind_pose = moss__take_capture_bytes (
+    reader,
+    (uint64_t)info.bone_count * sizeof (*info.bind_pose)
+  );
+
+  if (info.vertices == NULL || info.indices == NULL || info.bind_pose == NULL)
+  {
+    moss__error ("Captured skinned mesh is malformed.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Meshes get the same IDs they got during capture, as they're created in order
+  uint32_t mesh;
+  moss_engine_create_skinned_mesh (&info, &mesh);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__replay_video_frame (
+  const Moss__Replay *const  replay,
+  Moss__CaptureReader *const reader
+)
+{
+  const MossVideoCreateInfo *const info = &replay->video_info;
+
+  // Planes were captured tightly packed, back to back
+  const uint64_t luma_size = (uint64_t)info->width * info->height;
+  const uint64_t chroma_size = (uint64_t)(info->width / 2) * (info->height / 2);
+  const bool     is_nv12       = info->format == MOSS_VIDEO_FORMAT_NV12;
+  const uint32_t plane_count   = is_nv12 ? 2 : 3;
+  const uint64_t plane_sizes[] = {
+    luma_size,
+    is_nv12 ? chroma_size * 2 : chroma_size,
+    chroma_size,
+  };
+
+  MossVideoFrame frame = {
+    .planes          = {NULL},
+    .strides         = {0},
+    .file_descriptor = -1,
+    .offsets         = {0},
+  };
+
+  for (uint32_t i = 0; i < plane_count; ++i)
+  {
+    frame.planes[ i ] = moss__take_capture_bytes (reader, plane_sizes[ i ]);
+    if (frame.planes[ i ] == NULL)
+    {
+      moss__error ("Captured video frame doesn't match the open video.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  moss_engine_upload_video_frame (&frame);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__replay_offscreen_batch (Moss__CaptureReader *const reader)
+{
+  MossOffscreenBatch batch;
+  if (moss__take_capture_u32 (reader, &batch.scene_count) != MOSS_RESULT_SUCCESS ||
+      moss__take_capture_u32 (reader, &batch.width) != MOSS_RESULT_SUCCESS ||
+      moss__take_capture_u32 (reader, &batch.height) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Captured offscreen batch is malformed.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  MossSpriteBatch *const scenes =
+    malloc ((size_t)batch.scene_count * sizeof (*scenes) + 1);
+  if (scenes == NULL)
+  {
+    moss__error ("Failed to allocate %u replayed scenes.\n", batch.scene_count);
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < batch.scene_count; ++i)
+  {
+    if (moss__take_capture_sprites (reader, &scenes[ i ]) != MOSS_RESULT_SUCCESS)
+    {
+      free (scenes);
+      moss__error ("Captured offscreen batch is malformed.\n");
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  batch.scenes = scenes;
+
+  // Pixels are read back as they were during capture, then thrown away
+  void *const pixels =
+    malloc ((size_t)batch.scene_count * batch.width * batch.height * 4 + 1);
+  if (pixels == NULL)
+  {
+    free (scenes);
+    moss__error ("Failed to allocate replayed offscreen pixels.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss_engine_render_offscreen_batch (&batch, pixels);
+
+  free (pixels);
+  free (scenes);
+
+  return MOSS_RESULT_SUCCESS;
+}
@@ -0,0 +1,864 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/scene_target.c
+  @brief Offscreen scene render target implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+
+#include "src/internal/debug_utils.h"
+#include "src/internal/log.h"
+#include "src/internal/memory_utils.h"
+#include "src/internal/scene_target.h"
+#include "src/internal/shaders.h"
+#include "src/internal/vk_shader_utils.h"
+#include "src/internal/vram_tracker.h"
+
+/*
+  @brief Push constants of the upscale shader.
+*/
+typedef struct
+{
+  float uv_scale[ 2 ];   /* Share of the target image covered by the scene. */
+  float texel_size[ 2 ]; /* Size of a target image texel in UV units. */
+  float sharpness;       /* Sharpening strength. */
+} Moss__UpscalePushConstants;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates scene render pass.
+  @param target Scene target with device and format set.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_scene_render_pass (Moss__SceneTarget *target);
+
+/*
+  @brief Creates target images, their views and framebuffer.
+  @param target Scene target with render pass and extent set.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_scene_image (Moss__SceneTarget *target);
+
+/*
+  @brief Destroys target images, their views and framebuffer.
+  @param target Scene target.
+*/
+inline static void moss__destroy_scene_image (Moss__SceneTarget *target);
+
+/*
+  @brief Creates device local image of the target extent and its view.
+  @param target Scene target with extent set.
+  @param format Image format.
+  @param usage Image usage.
+  @param out_image Output image.
+  @param out_memory Output image memory.
+  @param out_image_view Output image view.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_scene_attachment (
+  const Moss__SceneTarget *target,
+  VkFormat                 format,
+  VkImageUsageFlags        usage,
+  VkImage                 *out_image,
+  VkDeviceMemory          *out_memory,
+  VkImageView             *out_image_view
+);
+
+/*
+  @brief Destroys image created by @ref moss__create_scene_attachment.
+  @param target Scene target.
+  @param image Image, reset to NULL.
+  @param memory Image memory, reset to NULL.
+  @param image_view Image view, reset to NULL.
+*/
+inline static void moss__destroy_scene_attachment (
+  const Moss__SceneTarget *target,
+  VkImage                 *image,
+  VkDeviceMemory          *memory,
+  VkImageView             *image_view
+);
+
+/*
+  @brief Creates sampler and upscale input set.
+  @param target Scene target.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_upscale_descriptors (Moss__SceneTarget *target);
+
+/*
+  @brief Points upscale input set to the current target image.
+  @param target Scene target.
+*/
+inline static void moss__write_upscale_descriptor (const Moss__SceneTarget *target);
+
+/*
+  @brief Creates upscale pipeline.
+  @param target Scene target.
+  @param present_render_pass Render pass the pipeline is used in.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_upscale_pipeline (
+  Moss__SceneTarget *target,
+  VkRenderPass       present_render_pass
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_scene_target (
+  const Moss__SceneTargetCreateInfo *const info,
+  Moss__SceneTarget *const                 out_target
+)
+{
+  *out_target                 = (Moss__SceneTarget) {0};
+  out_target->physical_device = info->physical_device;
+  out_target->device          = info->device;
+  out_target->format          = info->format;
+  out_target->extent          = info->extent;
+
+  out_target->is_picking_enabled     = info->is_picking_enabled;
+  out_target->color_attachment_count = info->is_picking_enabled ? 2 : 1;
+
+  if (moss__create_scene_render_pass (out_target) != MOSS_RESULT_SUCCESS ||
+      moss__create_scene_image (out_target) != MOSS_RESULT_SUCCESS ||
+      moss__create_upscale_descriptors (out_target) != MOSS_RESULT_SUCCESS ||
+      moss__create_upscale_pipeline (out_target, info->present_render_pass) !=
+        MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_scene_target (out_target);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_upscale_descriptor (out_target);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_scene_target (Moss__SceneTarget *const target)
+{
+  if (target->device == VK_NULL_HANDLE) { return; }
+
+  if (target->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (target->device, target->pipeline, NULL);
+  }
+
+  if (target->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (target->device, target->pipeline_layout, NULL);
+  }
+
+  if (target->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (target->device, target->descriptor_pool, NULL);
+  }
+
+  if (target->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (target->device, target->descriptor_set_layout, NULL);
+  }
+
+  if (target->sampler != VK_NULL_HANDLE)
+  {
+    vkDestroySampler (target->device, target->sampler, NULL);
+  }
+
+  moss__destroy_scene_image (target);
+
+  if (target->render_pass != VK_NULL_HANDLE)
+  {
+    vkDestroyRenderPass (target->device, target->render_pass, NULL);
+  }
+
+  *target = (Moss__SceneTarget) {0};
+}
+
+MossResult
+moss__resize_scene_target (Moss__SceneTarget *const target, const VkExtent2D extent)
+{
+  moss__destroy_scene_image (target);
+
+  target->extent = extent;
+  if (moss__create_scene_image (target) != MOSS_RESULT_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_upscale_descriptor (target);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__record_scene_upscale (
+  const Moss__SceneTarget *const target,
+  const VkCommandBuffer          command_buffer,
+  const VkExtent2D               render_extent,
+  const float                    sharpness
+)
+{
+  const float width  = (float)target->extent.width;
+  const float height = (float)target->extent.height;
+
+  const Moss__UpscalePushConstants push_constants = {
+    .uv_scale   = { (float)render_extent.width / width,
+                   (float)render_extent.height / height },
+    .texel_size = { 1.0F / width, 1.0F / height },
+    .sharpness  = sharpness,
+  };
+
+  const VkViewport viewport = {
+    .x        = 0.0F,
+    .y        = 0.0F,
+    .width    = width,
+    .height   = height,
+    .minDepth = 0.0F,
+    .maxDepth = 1.0F,
+  };
+
+  const VkRect2D scissor = {
+    .offset = { 0, 0 },
+    .extent = target->extent,
+  };
+
+  vkCmdBindPipeline (command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, target->pipeline);
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    target->pipeline_layout,
+    0,
+    1,
+    &target->descriptor_set,
+    0,
+    NULL
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    target->pipeline_layout,
+    VK_SHADER_STAGE_FRAGMENT_BIT,
+    0,
+    sizeof (push_constants),
+    &push_constants
+  );
+
+  vkCmdSetViewport (command_buffer, 0, 1, &viewport);
+  vkCmdSetScissor (command_buffer, 0, 1, &scissor);
+
+  // A single triangle covering the whole screen, positions come from vertex index
+  vkCmdDraw (command_buffer, 3, 1, 0, 0);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_scene_render_pass (Moss__SceneTarget *const target)
+{
+  const VkAttachmentDescription attachments[ 2 ] = {
+    {
+     .format         = target->format,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+     },
+    // Pick IDs are only ever copied out, never sampled
+    {
+     .format         = MOSS__PICK_ID_FORMAT,
+     .samples        = VK_SAMPLE_COUNT_1_BIT,
+     .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+     .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+     .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+     .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+     .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+     .finalLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+     },
+  };
+
+  const VkAttachmentReference color_attachment_refs[ 2 ] = {
+    {
+     .attachment = 0,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+    {
+     .attachment = 1,
+     .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+     },
+  };
+
+  const VkSubpassDescription subpass = {
+    .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
+    .colorAttachmentCount = target->color_attachment_count,
+    .pColorAttachments    = color_attachment_refs,
+  };
+
+  const VkSubpassDependency dependencies[ 2 ] = {
+    // Previous frame's upscale and pick copy must finish reading before the images
+    // are overwritten
+    {
+     .srcSubpass    = VK_SUBPASS_EXTERNAL,
+     .dstSubpass    = 0,
+     .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                      VK_PIPELINE_STAGE_TRANSFER_BIT,
+     .srcAccessMask = 0,
+     .dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     },
+    // Upscale and pick copy read the images only once the scene is written
+    {
+     .srcSubpass    = 0,
+     .dstSubpass    = VK_SUBPASS_EXTERNAL,
+     .srcStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+     .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+     .dstStageMask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                      VK_PIPELINE_STAGE_TRANSFER_BIT,
+     .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT,
+     },
+  };
+
+  const VkRenderPassCreateInfo render_pass_info = {
+    .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+    .attachmentCount = target->color_attachment_count,
+    .pAttachments    = attachments,
+    .subpassCount    = 1,
+    .pSubpasses      = &subpass,
+    .dependencyCount = 2,
+    .pDependencies   = dependencies,
+  };
+
+  const VkResult result =
+    vkCreateRenderPass (target->device, &render_pass_info, NULL, &target->render_pass);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create scene render pass. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    target->device,
+    VK_OBJECT_TYPE_RENDER_PASS,
+    target->render_pass,
+    "scene render pass"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_scene_image (Moss__SceneTarget *const target)
+{
+  if (moss__create_scene_attachment (
+        target,
+        target->format,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        &target->image,
+        &target->memory,
+        &target->image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_scene_image (target);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (target->is_picking_enabled &&
+      moss__create_scene_attachment (
+        target,
+        MOSS__PICK_ID_FORMAT,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+        &target->id_image,
+        &target->id_memory,
+        &target->id_image_view
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_scene_image (target);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkImageView framebuffer_attachments[] = {
+    target->image_view,
+    target->id_image_view,
+  };
+
+  const VkFramebufferCreateInfo framebuffer_info = {
+    .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+    .renderPass      = target->render_pass,
+    .attachmentCount = target->color_attachment_count,
+    .pAttachments    = framebuffer_attachments,
+    .width           = target->extent.width,
+    .height          = target->extent.height,
+    .layers          = 1,
+  };
+
+  const VkResult result =
+    vkCreateFramebuffer (target->device, &framebuffer_info, NULL, &target->framebuffer);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create scene framebuffer. Error code: %d.\n", result);
+    moss__destroy_scene_image (target);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__destroy_scene_image (Moss__SceneTarget *const target)
+{
+  if (target->framebuffer != VK_NULL_HANDLE)
+  {
+    vkDestroyFramebuffer (target->device, target->framebuffer, NULL);
+    target->framebuffer = VK_NULL_HANDLE;
+  }
+
+  moss__destroy_scene_attachment (
+    target,
+    &target->id_image,
+    &target->id_memory,
+    &target->id_image_view
+  );
+
+  moss__destroy_scene_attachment (
+    target,
+    &target->image,
+    &target->memory,
+    &target->image_view
+  );
+}
+
+inline static MossResult moss__create_scene_attachment (
+  const Moss__SceneTarget *const target,
+  const VkFormat                 format,
+  const VkImageUsageFlags        usage,
+  VkImage *const                 out_image,
+  VkDeviceMemory *const          out_memory,
+  VkImageView *const             out_image_view
+)
+{
+  const VkImageCreateInfo image_info = {
+    .sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format    = format,
+    .extent =
+      {
+               .width  = target->extent.width,
+               .height = target->extent.height,
+               .depth  = 1,
+               },
+    .mipLevels     = 1,
+    .arrayLayers   = 1,
+    .samples       = VK_SAMPLE_COUNT_1_BIT,
+    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+    .usage         = usage,
+    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkResult result = vkCreateImage (target->device, &image_info, NULL, out_image);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create scene image. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    target->device,
+    VK_OBJECT_TYPE_IMAGE,
+    *out_image,
+    "scene attachment"
+  );
+
+  VkMemoryRequirements memory_requirements;
+  vkGetImageMemoryRequirements (target->device, *out_image, &memory_requirements);
+
+  uint32_t memory_type;
+  if (moss__select_suitable_memory_type (
+        target->physical_device,
+        memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memory_type
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to find suitable memory type for scene image.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkMemoryAllocateInfo alloc_info = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .allocationSize  = memory_requirements.size,
+    .memoryTypeIndex = memory_type,
+  };
+
+  result = vkAllocateMemory (target->device, &alloc_info, NULL, out_memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate scene image memory. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__track_vram_allocation (
+    target->physical_device,
+    *out_memory,
+    MOSS_VRAM_CATEGORY_RENDER_TARGETS,
+    memory_type,
+    memory_requirements.size,
+    memory_requirements.size
+  );
+
+  vkBindImageMemory (target->device, *out_image, *out_memory, 0);
+
+  const VkImageViewCreateInfo view_info = {
+    .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .image    = *out_image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format   = format,
+    .subresourceRange =
+      {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .baseMipLevel   = 0,
+                  .levelCount     = 1,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+                  },
+  };
+
+  result = vkCreateImageView (target->device, &view_info, NULL, out_image_view);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create scene image view. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__destroy_scene_attachment (
+  const Moss__SceneTarget *const target,
+  VkImage *const                 image,
+  VkDeviceMemory *const          memory,
+  VkImageView *const             image_view
+)
+{
+  if (*image_view != VK_NULL_HANDLE)
+  {
+    vkDestroyImageView (target->device, *image_view, NULL);
+    *image_view = VK_NULL_HANDLE;
+  }
+
+  if (*image != VK_NULL_HANDLE)
+  {
+    vkDestroyImage (target->device, *image, NULL);
+    *image = VK_NULL_HANDLE;
+  }
+
+  if (*memory != VK_NULL_HANDLE)
+  {
+    moss__untrack_vram_allocation (*memory);
+    vkFreeMemory (target->device, *memory, NULL);
+    *memory = VK_NULL_HANDLE;
+  }
+}
+
+inline static MossResult
+moss__create_upscale_descriptors (Moss__SceneTarget *const target)
+{
+  const VkSamplerCreateInfo sampler_info = {
+    .sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+    .magFilter    = VK_FILTER_LINEAR,
+    .minFilter    = VK_FILTER_LINEAR,
+    .mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+    .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .maxLod       = 0.0F,
+  };
+
+  VkResult result =
+    vkCreateSampler (target->device, &sampler_info, NULL, &target->sampler);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create scene sampler. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetLayoutBinding binding = {
+    .binding         = 0,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .descriptorCount = 1,
+    .stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT,
+  };
+
+  const VkDescriptorSetLayoutCreateInfo set_layout_info = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .bindingCount = 1,
+    .pBindings    = &binding,
+  };
+
+  result = vkCreateDescriptorSetLayout (
+    target->device,
+    &set_layout_info,
+    NULL,
+    &target->descriptor_set_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create upscale descriptor set layout. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorPoolSize pool_size = {
+    .type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .descriptorCount = 1,
+  };
+
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = 1,
+    .poolSizeCount = 1,
+    .pPoolSizes    = &pool_size,
+  };
+
+  result =
+    vkCreateDescriptorPool (target->device, &pool_info, NULL, &target->descriptor_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create upscale descriptor pool. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetAllocateInfo set_info = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .descriptorPool     = target->descriptor_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &target->descriptor_set_layout,
+  };
+
+  result = vkAllocateDescriptorSets (target->device, &set_info, &target->descriptor_set);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate upscale descriptor set. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static void moss__write_upscale_descriptor (const Moss__SceneTarget *const target)
+{
+  const VkDescriptorImageInfo image_info = {
+    .sampler     = target->sampler,
+    .imageView   = target->image_view,
+    .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+  };
+
+  const VkWriteDescriptorSet write = {
+    .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .dstSet          = target->descriptor_set,
+    .dstBinding      = 0,
+    .descriptorCount = 1,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .pImageInfo      = &image_info,
+  };
+
+  vkUpdateDescriptorSets (target->device, 1, &write, 0, NULL);
+}
+
+inline static MossResult moss__create_upscale_pipeline (
+  Moss__SceneTarget *const target,
+  const VkRenderPass       present_render_pass
+)
+{
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__UpscalePushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &target->descriptor_set_layout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  VkResult result = vkCreatePipelineLayout (
+    target->device,
+    &pipeline_layout_info,
+    NULL,
+    &target->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create upscale pipeline layout. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        target->device,
+        MOSS__UPSCALE_VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_shader_module_from_file (
+        target->device,
+        MOSS__UPSCALE_FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (target->device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = {
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+     .module = vert_shader_module,
+     .pName  = "main",
+     },
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .module = frag_shader_module,
+     .pName  = "main",
+     },
+  };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+  };
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_NONE,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  const VkPipelineColorBlendAttachmentState color_blend_attachment = {
+    .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                      VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+    .blendEnable = VK_FALSE,
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = 1,
+    .pAttachments    = &color_blend_attachment,
+  };
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = target->pipeline_layout,
+    .renderPass          = present_render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  result = vkCreateGraphicsPipelines (
+    target->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &target->pipeline
+  );
+
+  vkDestroyShaderModule (target->device, frag_shader_module, NULL);
+  vkDestroyShaderModule (target->device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create upscale pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    target->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    target->pipeline,
+    "upscale pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
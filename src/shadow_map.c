@@ -0,0 +1,432 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/shadow_map.c
+  @brief 1D polar shadow maps implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdint.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/light.h"
+#include "moss/occluder.h"
+#include "moss/result.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/log.h"
+#include "src/internal/shaders.h"
+#include "src/internal/shadow_map.h"
+#include "src/internal/vk_shader_utils.h"
+
+/* Number of bindings of the shadow descriptor set. */
+#define MOSS__SHADOW_MAP_BINDING_COUNT (uint32_t)(2)
+
+/* Binding of the occluder crate. */
+#define MOSS__OCCLUDER_BINDING (uint32_t)(0)
+
+/* Binding of the shadow map crate. */
+#define MOSS__SHADOW_MAP_BINDING (uint32_t)(1)
+
+/*
+  @brief Push constants of the shadow map shader.
+*/
+typedef struct
+{
+  uint32_t light_count;    /* Number of lights. */
+  uint32_t occluder_count; /* Number of occluders. */
+} Moss__ShadowMapPushConstants;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Writes a storage buffer descriptor.
+  @param device Device the set was allocated on.
+  @param set Descriptor set to update.
+  @param binding Binding to write.
+  @param buffer Buffer to bind.
+*/
+inline static void moss__write_shadow_descriptor (
+  VkDevice        device,
+  VkDescriptorSet set,
+  uint32_t        binding,
+  VkBuffer        buffer
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_shadow_maps (
+  const Moss__ShadowMapCreateInfo *const info,
+  Moss__ShadowMaps *const                out_maps
+)
+{
+  *out_maps        = (Moss__ShadowMaps) {0};
+  out_maps->device = info->device;
+
+  const VkDescriptorSetLayoutBinding bindings[ MOSS__SHADOW_MAP_BINDING_COUNT ] = {
+    {
+     .binding         = MOSS__OCCLUDER_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT,
+     },
+    {
+     .binding         = MOSS__SHADOW_MAP_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+     },
+  };
+
+  const VkDescriptorSetLayoutCreateInfo set_layout_info = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .bindingCount = MOSS__SHADOW_MAP_BINDING_COUNT,
+    .pBindings    = bindings,
+  };
+
+  VkResult result = vkCreateDescriptorSetLayout (
+    info->device,
+    &set_layout_info,
+    NULL,
+    &out_maps->descriptor_set_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create shadow descriptor set layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_shadow_maps (out_maps);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetLayout set_layouts[ 2 ] = {
+    info->light_descriptor_set_layout,
+    out_maps->descriptor_set_layout,
+  };
+
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__ShadowMapPushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 2,
+    .pSetLayouts            = set_layouts,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  result = vkCreatePipelineLayout (
+    info->device,
+    &pipeline_layout_info,
+    NULL,
+    &out_maps->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create shadow map pipeline layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_shadow_maps (out_maps);
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule shader_module;
+  if (moss__create_shader_module_from_file (
+        info->device,
+        MOSS__SHADOW_MAP_SHADER_PATH,
+        &shader_module
+      ) != VK_SUCCESS)
+  {
+    moss__destroy_shadow_maps (out_maps);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkComputePipelineCreateInfo pipeline_info = {
+    .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+    .stage =
+      {
+              .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+              .stage  = VK_SHADER_STAGE_COMPUTE_BIT,
+              .module = shader_module,
+              .pName  = "main",
+              },
+    .layout = out_maps->pipeline_layout,
+  };
+
+  result = vkCreateComputePipelines (
+    info->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &out_maps->pipeline
+  );
+
+  vkDestroyShaderModule (info->device, shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create shadow map pipeline. Error code: %d.\n", result);
+    moss__destroy_shadow_maps (out_maps);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    info->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    out_maps->pipeline,
+    "shadow map pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_shadow_maps (Moss__ShadowMaps *const maps)
+{
+  if (maps->device == VK_NULL_HANDLE) { return; }
+
+  if (maps->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (maps->device, maps->pipeline, NULL);
+  }
+
+  if (maps->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (maps->device, maps->pipeline_layout, NULL);
+  }
+
+  if (maps->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (maps->device, maps->descriptor_set_layout, NULL);
+  }
+
+  *maps = (Moss__ShadowMaps) {0};
+}
+
+MossResult moss__create_shadow_map_frame (
+  const Moss__ShadowMaps *const          maps,
+  const Moss__ShadowMapCreateInfo *const info,
+  Moss__ShadowMapFrame *const            out_frame
+)
+{
+  *out_frame = (Moss__ShadowMapFrame) {0};
+
+  const Moss__CrateCreateInfo occluder_crate_info = {
+    .size = (VkDeviceSize)MOSS_MAX_OCCLUDER_COUNT * sizeof (Moss__GpuOccluder),
+    .usage             = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "occluder crate",
+  };
+
+  const Moss__CrateCreateInfo shadow_map_crate_info = {
+    .size = (VkDeviceSize)MOSS_MAX_LIGHT_COUNT * MOSS__SHADOW_MAP_RESOLUTION *
+            sizeof (float),
+    .usage                           = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "shadow map crate",
+  };
+
+  if (moss__create_crate (&occluder_crate_info, &out_frame->occluder_crate) !=
+        MOSS_RESULT_SUCCESS ||
+      moss__create_crate (&shadow_map_crate_info, &out_frame->shadow_map_crate) !=
+        MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create shadow map crates.\n");
+    moss__destroy_shadow_map_frame (maps, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  void    *mapped_memory;
+  VkResult result = vkMapMemory (
+    info->device,
+    out_frame->occluder_crate.memory,
+    0,
+    out_frame->occluder_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map occluder crate. Error code: %d.\n", result);
+    moss__destroy_shadow_map_frame (maps, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->occluders = mapped_memory;
+
+  const VkDescriptorPoolSize pool_size = {
+    .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .descriptorCount = MOSS__SHADOW_MAP_BINDING_COUNT,
+  };
+
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = 1,
+    .poolSizeCount = 1,
+    .pPoolSizes    = &pool_size,
+  };
+
+  result =
+    vkCreateDescriptorPool (info->device, &pool_info, NULL, &out_frame->descriptor_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create shadow descriptor pool. Error code: %d.\n", result);
+    moss__destroy_shadow_map_frame (maps, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetAllocateInfo set_info = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .descriptorPool     = out_frame->descriptor_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &maps->descriptor_set_layout,
+  };
+
+  result = vkAllocateDescriptorSets (info->device, &set_info, &out_frame->descriptor_set);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate shadow descriptor set. Error code: %d.\n", result);
+    moss__destroy_shadow_map_frame (maps, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_shadow_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__OCCLUDER_BINDING,
+    out_frame->occluder_crate.buffer
+  );
+
+  moss__write_shadow_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__SHADOW_MAP_BINDING,
+    out_frame->shadow_map_crate.buffer
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_shadow_map_frame (
+  const Moss__ShadowMaps *const maps,
+  Moss__ShadowMapFrame *const   frame
+)
+{
+  if (frame->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (maps->device, frame->descriptor_pool, NULL);
+  }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->occluder_crate);
+  moss__destroy_crate (&frame->shadow_map_crate);
+
+  *frame = (Moss__ShadowMapFrame) {0};
+}
+
+void moss__record_shadow_maps (
+  const Moss__ShadowMaps *const     maps,
+  const Moss__ShadowMapFrame *const frame,
+  const VkDescriptorSet             light_descriptor_set,
+  const VkCommandBuffer             command_buffer,
+  const uint32_t                    light_count,
+  const uint32_t                    occluder_count
+)
+{
+  const Moss__ShadowMapPushConstants push_constants = {
+    .light_count    = light_count,
+    .occluder_count = occluder_count,
+  };
+
+  const VkDescriptorSet descriptor_sets[ 2 ] = {
+    light_descriptor_set,
+    frame->descriptor_set,
+  };
+
+  vkCmdBindPipeline (command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, maps->pipeline);
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_COMPUTE,
+    maps->pipeline_layout,
+    0,
+    2,
+    descriptor_sets,
+    0,
+    NULL
+  );
+
+  vkCmdPushConstants (
+    command_buffer,
+    maps->pipeline_layout,
+    VK_SHADER_STAGE_COMPUTE_BIT,
+    0,
+    sizeof (push_constants),
+    &push_constants
+  );
+
+  // One workgroup casts all rays of a single light
+  vkCmdDispatch (command_buffer, light_count, 1, 1);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static void moss__write_shadow_descriptor (
+  const VkDevice        device,
+  const VkDescriptorSet set,
+  const uint32_t        binding,
+  const VkBuffer        buffer
+)
+{
+  const VkDescriptorBufferInfo buffer_info = {
+    .buffer = buffer,
+    .offset = 0,
+    .range  = VK_WHOLE_SIZE,
+  };
+
+  const VkWriteDescriptorSet write = {
+    .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .dstSet          = set,
+    .dstBinding      = binding,
+    .descriptorCount = 1,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .pBufferInfo     = &buffer_info,
+  };
+
+  vkUpdateDescriptorSets (device, 1, &write, 0, NULL);
+}
@@ -0,0 +1,791 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/skinning.c
+  @brief GPU skinned skeletal mesh implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/skeleton.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/light_culling.h"
+#include "src/internal/log.h"
+#include "src/internal/shaders.h"
+#include "src/internal/skeleton_utils.h"
+#include "src/internal/skinning.h"
+#include "src/internal/vk_shader_utils.h"
+
+/* Binding of the bone matrix crate. */
+#define MOSS__BONE_BINDING (uint32_t)(0)
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates skinning set layout and pipeline.
+  @param skinning Skinning to create the pipeline for.
+  @param info Creation information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_skinning_pipeline (
+  Moss__Skinning                 *skinning,
+  const Moss__SkinningCreateInfo *info
+);
+
+/*
+  @brief Checks that mesh creation information describes a valid mesh.
+  @param info Mesh creation information.
+  @return Returns true if the mesh can be uploaded, false otherwise.
+*/
+inline static bool moss__validate_skinned_mesh (const MossSkinnedMeshCreateInfo *info);
+
+/*
+  @brief Destroys uploaded skinned mesh.
+  @param mesh Mesh. Safe to call on a zeroed struct.
+*/
+inline static void moss__destroy_skinned_mesh (Moss__SkinnedMesh *mesh);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_skinning (
+  const Moss__SkinningCreateInfo *const info,
+  Moss__Skinning *const                 out_skinning
+)
+{
+  *out_skinning                                 = (Moss__Skinning) {0};
+  out_skinning->physical_device                 = info->physical_device;
+  out_skinning->device                          = info->device;
+  out_skinning->sharing_mode                    = info->sharing_mode;
+  out_skinning->shared_queue_family_index_count = info->shared_queue_family_index_count;
+
+  for (uint32_t i = 0; i < info->shared_queue_family_index_count; ++i)
+  {
+    out_skinning->shared_queue_family_indices[ i ] =
+      info->shared_queue_family_indices[ i ];
+  }
+
+  if (moss__create_skinning_pipeline (out_skinning, info) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_skinning (out_skinning);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_skinning (Moss__Skinning *const skinning)
+{
+  if (skinning->device == VK_NULL_HANDLE) { return; }
+
+  for (uint32_t i = 0; i < skinning->mesh_count; ++i)
+  {
+    moss__destroy_skinned_mesh (&skinning->meshes[ i ]);
+  }
+
+  if (skinning->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (skinning->device, skinning->pipeline, NULL);
+  }
+
+  if (skinning->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (skinning->device, skinning->pipeline_layout, NULL);
+  }
+
+  if (skinning->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (
+      skinning->device,
+      skinning->descriptor_set_layout,
+      NULL
+    );
+  }
+
+  *skinning = (Moss__Skinning) {0};
+}
+
+MossResult moss__create_skinning_frame (
+  const Moss__Skinning *const skinning,
+  Moss__SkinningFrame *const  out_frame
+)
+{
+  *out_frame = (Moss__SkinningFrame) {0};
+
+  const Moss__CrateCreateInfo bone_crate_info = {
+    .size              = (VkDeviceSize)MOSS_MAX_BONE_COUNT * sizeof (Moss__GpuBoneMatrix),
+    .usage             = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = skinning->device,
+    .physical_device                 = skinning->physical_device,
+    .debug_name                      = "skinning bone crate",
+  };
+
+  if (moss__create_crate (&bone_crate_info, &out_frame->bone_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create bone crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void          *mapped_memory;
+  const VkResult result = vkMapMemory (
+    skinning->device,
+    out_frame->bone_crate.memory,
+    0,
+    out_frame->bone_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map bone crate. Error code: %d.\n", result);
+    moss__destroy_skinning_frame (skinning, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->bones = mapped_memory;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_skinning_frame (
+  const Moss__Skinning *const skinning,
+  Moss__SkinningFrame *const  frame
+)
+{
+  (void)skinning;
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->bone_crate);
+
+  *frame = (Moss__SkinningFrame) {0};
+}
+
+MossResult moss__create_skinned_mesh (
+  Moss__Skinning *const                  skinning,
+  const MossSkinnedMeshCreateInfo *const info,
+  const VkQueue                          transfer_queue,
+  const VkCommandPool                    command_pool,
+  uint32_t *const                        out_mesh
+)
+{
+  if (skinning->mesh_count == MOSS_MAX_SKINNED_MESH_COUNT)
+  {
+    moss__error (
+      "Can't create more than %u skinned meshes.\n",
+      MOSS_MAX_SKINNED_MESH_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (!moss__validate_skinned_mesh (info)) { return MOSS_RESULT_ERROR; }
+
+  Moss__SkinnedMesh *const mesh = &skinning->meshes[ skinning->mesh_count ];
+  *mesh                         = (Moss__SkinnedMesh) {0};
+
+  mesh->index_count  = info->index_count;
+  mesh->bone_count   = info->bone_count;
+  mesh->parents      = malloc (sizeof (uint32_t) * info->bone_count);
+  mesh->inverse_bind = malloc (sizeof (Moss__BoneMatrix) * info->bone_count);
+  if (mesh->parents == NULL || mesh->inverse_bind == NULL)
+  {
+    moss__error ("Failed to allocate memory for skinned mesh bones.\n");
+    moss__destroy_skinned_mesh (mesh);
+    return MOSS_RESULT_ERROR;
+  }
+
+  for (uint32_t i = 0; i < info->bone_count; ++i)
+  {
+    mesh->parents[ i ] = info->bind_pose[ i ].parent;
+  }
+
+  // Inverse bind matrices move vertices from the bind pose into bone space
+  Moss__BoneMatrix bind_world[ MOSS_MAX_SKINNED_MESH_BONE_COUNT ];
+  moss__evaluate_skeleton (info->bind_pose, mesh->parents, info->bone_count, bind_world);
+
+  for (uint32_t i = 0; i < info->bone_count; ++i)
+  {
+    if (!moss__invert_bone_matrix (&bind_world[ i ], &mesh->inverse_bind[ i ]))
+    {
+      moss__error ("Bind pose of bone %u has zero scale.\n", i);
+      moss__destroy_skinned_mesh (mesh);
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  const Moss__CrateCreateInfo vertex_crate_info = {
+    .size  = sizeof (MossSkinnedVertex) * info->vertex_count,
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = skinning->sharing_mode,
+    .shared_queue_family_index_count = skinning->shared_queue_family_index_count,
+    .shared_queue_family_indices     = skinning->shared_queue_family_indices,
+    .device                          = skinning->device,
+    .physical_device                 = skinning->physical_device,
+    .debug_name                      = "skinned mesh vertex crate",
+  };
+
+  const Moss__CrateCreateInfo index_crate_info = {
+    .size  = sizeof (uint32_t) * info->index_count,
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = skinning->sharing_mode,
+    .shared_queue_family_index_count = skinning->shared_queue_family_index_count,
+    .shared_queue_family_indices     = skinning->shared_queue_family_indices,
+    .device                          = skinning->device,
+    .physical_device                 = skinning->physical_device,
+    .debug_name                      = "skinned mesh index crate",
+  };
+
+  if (moss__create_crate (&vertex_crate_info, &mesh->vertex_crate) !=
+        MOSS_RESULT_SUCCESS ||
+      moss__create_crate (&index_crate_info, &mesh->index_crate) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create skinned mesh crates.\n");
+    moss__destroy_skinned_mesh (mesh);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__FillCrateInfo vertex_fill_info = {
+    .destination_crate = &mesh->vertex_crate,
+    .source_memory     = (void *)info->vertices,
+    .size              = vertex_crate_info.size,
+    .transfer_queue    = transfer_queue,
+    .command_pool      = command_pool,
+  };
+
+  const Moss__FillCrateInfo index_fill_info = {
+    .destination_crate = &mesh->index_crate,
+    .source_memory     = (void *)info->indices,
+    .size              = index_crate_info.size,
+    .transfer_queue    = transfer_queue,
+    .command_pool      = command_pool,
+  };
+
+  if (moss__fill_crate (&vertex_fill_info) != MOSS_RESULT_SUCCESS ||
+      moss__fill_crate (&index_fill_info) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to upload skinned mesh.\n");
+    moss__destroy_skinned_mesh (mesh);
+    return MOSS_RESULT_ERROR;
+  }
+
+  *out_mesh = skinning->mesh_count++;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+MossResult moss__push_skinned_mesh_draw (
+  const Moss__Skinning *const skinning,
+  Moss__SkinningFrame *const  frame,
+  const uint32_t              mesh_id,
+  const MossBone *const       pose
+)
+{
+  if (mesh_id >= skinning->mesh_count)
+  {
+    moss__error ("Skinned mesh %u doesn't exist.\n", mesh_id);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__SkinnedMesh *const mesh = &skinning->meshes[ mesh_id ];
+
+  if (frame->draw_count == MOSS_MAX_SKINNED_MESH_DRAW_COUNT ||
+      mesh->bone_count > MOSS_MAX_BONE_COUNT - frame->bone_count)
+  {
+    moss__error ("Skinned mesh %u doesn't fit into the frame.\n", mesh_id);
+    return MOSS_RESULT_ERROR;
+  }
+
+  Moss__BoneMatrix world[ MOSS_MAX_SKINNED_MESH_BONE_COUNT ];
+  moss__evaluate_skeleton (pose, mesh->parents, mesh->bone_count, world);
+
+  Moss__GpuBoneMatrix *const bones = frame->bones + frame->bone_count;
+  for (uint32_t i = 0; i < mesh->bone_count; ++i)
+  {
+    const Moss__BoneMatrix skin =
+      moss__multiply_bone_matrices (&world[ i ], &mesh->inverse_bind[ i ]);
+
+    bones[ i ] = (Moss__GpuBoneMatrix) {
+      .rows = {
+        { skin.a, skin.c, skin.tx, 0.0F },
+        { skin.b, skin.d, skin.ty, 0.0F },
+      },
+    };
+  }
+
+  frame->draws[ frame->draw_count++ ] = (Moss__SkinnedMeshDraw) {
+    .mesh       = mesh_id,
+    .first_bone = frame->bone_count,
+  };
+  frame->bone_count += mesh->bone_count;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__record_skinned_meshes (
+  const Moss__Skinning *const                  skinning,
+  const Moss__SkinningFrame *const             frame,
+  const Moss__DescriptorCache *const           descriptor_cache,
+  Moss__DescriptorCacheFrame *const            descriptor_cache_frame,
+  const VkCommandBuffer                        command_buffer,
+  const VkDescriptorSet                        light_descriptor_set,
+  const VkDescriptorSet                        shadow_map_descriptor_set,
+  const Moss__LightShadingPushConstants *const shading_constants
+)
+{
+  if (frame->draw_count == 0) { return; }
+
+  const Moss__DescriptorBinding bone_binding = {
+    .binding = MOSS__BONE_BINDING,
+    .type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .buffer  = frame->bone_crate.buffer,
+    .offset  = 0,
+    .range   = VK_WHOLE_SIZE,
+  };
+
+  vkCmdBindPipeline (command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, skinning->pipeline);
+
+  const VkDescriptorSet sets[] = {
+    light_descriptor_set,
+    shadow_map_descriptor_set,
+  };
+
+  vkCmdBindDescriptorSets (
+    command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    skinning->pipeline_layout,
+    0,
+    sizeof (sets) / sizeof (sets[ 0 ]),
+    sets,
+    0,
+    NULL
+  );
+
+  // Bone crate never changes, so after the first frame this binds a cached set
+  if (moss__bind_descriptors (
+        descriptor_cache,
+        descriptor_cache_frame,
+        command_buffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        skinning->pipeline_layout,
+        2,
+        skinning->descriptor_set_layout,
+        &bone_binding,
+        1
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to bind bone crate, skipping skinned meshes.\n");
+    return;
+  }
+
+  vkCmdPushConstants (
+    command_buffer,
+    skinning->pipeline_layout,
+    VK_SHADER_STAGE_FRAGMENT_BIT,
+    0,
+    sizeof (*shading_constants),
+    shading_constants
+  );
+
+  const VkDeviceSize vertex_buffer_offset = 0;
+
+  for (uint32_t i = 0; i < frame->draw_count; ++i)
+  {
+    const Moss__SkinnedMeshDraw *const draw = &frame->draws[ i ];
+    const Moss__SkinnedMesh *const     mesh = &skinning->meshes[ draw->mesh ];
+
+    const Moss__SkinningPushConstants skinning_constants = {
+      .first_bone = draw->first_bone,
+      .draw_index = i,
+    };
+
+    vkCmdPushConstants (
+      command_buffer,
+      skinning->pipeline_layout,
+      VK_SHADER_STAGE_VERTEX_BIT,
+      sizeof (Moss__LightShadingPushConstants),
+      sizeof (skinning_constants),
+      &skinning_constants
+    );
+
+    vkCmdBindVertexBuffers (
+      command_buffer,
+      0,
+      1,
+      &mesh->vertex_crate.buffer,
+      &vertex_buffer_offset
+    );
+
+    vkCmdBindIndexBuffer (
+      command_buffer,
+      mesh->index_crate.buffer,
+      0,
+      VK_INDEX_TYPE_UINT32
+    );
+
+    vkCmdDrawIndexed (command_buffer, mesh->index_count, 1, 0, 0, 0);
+  }
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_skinning_pipeline (
+  Moss__Skinning *const                 skinning,
+  const Moss__SkinningCreateInfo *const info
+)
+{
+  const VkDescriptorSetLayoutBinding binding = {
+    .binding         = MOSS__BONE_BINDING,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .descriptorCount = 1,
+    .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT,
+  };
+
+  if (moss__create_cached_descriptor_set_layout (
+        info->descriptor_cache,
+        &binding,
+        1,
+        &skinning->descriptor_set_layout
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create bone descriptor set layout.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPushConstantRange push_constant_ranges[] = {
+    {
+     .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .offset     = 0,
+     .size       = sizeof (Moss__LightShadingPushConstants),
+     },
+    {
+     .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+     .offset     = sizeof (Moss__LightShadingPushConstants),
+     .size       = sizeof (Moss__SkinningPushConstants),
+     },
+  };
+
+  const VkDescriptorSetLayout set_layouts[] = {
+    info->light_descriptor_set_layout,
+    info->shadow_map_descriptor_set_layout,
+    skinning->descriptor_set_layout,
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = sizeof (set_layouts) / sizeof (set_layouts[ 0 ]),
+    .pSetLayouts            = set_layouts,
+    .pushConstantRangeCount =
+      sizeof (push_constant_ranges) / sizeof (push_constant_ranges[ 0 ]),
+    .pPushConstantRanges = push_constant_ranges,
+  };
+
+  VkResult result = vkCreatePipelineLayout (
+    skinning->device,
+    &pipeline_layout_info,
+    NULL,
+    &skinning->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create skinning pipeline layout. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        skinning->device,
+        MOSS__SKINNING_VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Skinned meshes are shaded exactly like sprites
+  if (moss__create_shader_module_from_file (
+        skinning->device,
+        MOSS__FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (skinning->device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = {
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+     .module = vert_shader_module,
+     .pName  = "main",
+     },
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .module = frag_shader_module,
+     .pName  = "main",
+     },
+  };
+
+  const VkVertexInputBindingDescription vertex_binding = {
+    .binding   = 0,
+    .stride    = sizeof (MossSkinnedVertex),
+    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+  };
+
+  const VkVertexInputAttributeDescription vertex_attributes[] = {
+    {
+     .binding  = 0,
+     .location = 0,
+     .format   = VK_FORMAT_R32G32_SFLOAT,
+     .offset   = offsetof (MossSkinnedVertex, position),
+     },
+    {
+     .binding  = 0,
+     .location = 1,
+     .format   = VK_FORMAT_R8G8B8A8_UNORM,
+     .offset   = offsetof (MossSkinnedVertex, color),
+     },
+    {
+     .binding  = 0,
+     .location = 2,
+     .format   = VK_FORMAT_R32G32_SFLOAT,
+     .offset   = offsetof (MossSkinnedVertex, texture_coordinates),
+     },
+    {
+     .binding  = 0,
+     .location = 3,
+     .format   = VK_FORMAT_R32_UINT,
+     .offset   = offsetof (MossSkinnedVertex, texture_index),
+     },
+    {
+     .binding  = 0,
+     .location = 4,
+     .format   = VK_FORMAT_R8G8B8A8_UINT,
+     .offset   = offsetof (MossSkinnedVertex, bone_indices),
+     },
+    {
+     .binding  = 0,
+     .location = 5,
+     .format   = VK_FORMAT_R32G32B32A32_SFLOAT,
+     .offset   = offsetof (MossSkinnedVertex, bone_weights),
+     },
+  };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+    .vertexBindingDescriptionCount = 1,
+    .pVertexBindingDescriptions    = &vertex_binding,
+    .vertexAttributeDescriptionCount =
+      sizeof (vertex_attributes) / sizeof (vertex_attributes[ 0 ]),
+    .pVertexAttributeDescriptions = vertex_attributes,
+  };
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  // Mesh winding is up to the authoring tool and bones may mirror triangles
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_NONE,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  // Second attachment receives pick IDs when picking is enabled
+  const VkPipelineColorBlendAttachmentState color_blend_attachments[ 2 ] = {
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                       VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+     .blendEnable = VK_FALSE,
+     },
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT,
+     .blendEnable    = VK_FALSE,
+     },
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = info->color_attachment_count,
+    .pAttachments    = color_blend_attachments,
+  };
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = skinning->pipeline_layout,
+    .renderPass          = info->render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  result = vkCreateGraphicsPipelines (
+    skinning->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &skinning->pipeline
+  );
+
+  vkDestroyShaderModule (skinning->device, frag_shader_module, NULL);
+  vkDestroyShaderModule (skinning->device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create skinning pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    skinning->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    skinning->pipeline,
+    "skinning pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static bool
+moss__validate_skinned_mesh (const MossSkinnedMeshCreateInfo *const info)
+{
+  if (info->vertex_count == 0 || info->index_count == 0)
+  {
+    moss__error ("Skinned mesh has no vertices or indices.\n");
+    return false;
+  }
+
+  if (info->bone_count == 0 || info->bone_count > MOSS_MAX_SKINNED_MESH_BONE_COUNT)
+  {
+    moss__error (
+      "Skinned mesh bone count must be in [1, %u] range, got %u.\n",
+      MOSS_MAX_SKINNED_MESH_BONE_COUNT,
+      info->bone_count
+    );
+    return false;
+  }
+
+  for (uint32_t i = 0; i < info->bone_count; ++i)
+  {
+    const uint32_t parent = info->bind_pose[ i ].parent;
+    if (parent != MOSS_BONE_PARENT_NONE && parent >= i)
+    {
+      moss__error ("Parent of bone %u must precede it, got %u.\n", i, parent);
+      return false;
+    }
+  }
+
+  // Out of range indices would read past the mesh's bones in the shader
+  for (uint32_t i = 0; i < info->vertex_count; ++i)
+  {
+    for (uint32_t j = 0; j < MOSS_BONE_INFLUENCE_COUNT; ++j)
+    {
+      if (info->vertices[ i ].bone_indices[ j ] >= info->bone_count)
+      {
+        moss__error ("Vertex %u references missing bone.\n", i);
+        return false;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < info->index_count; ++i)
+  {
+    if (info->indices[ i ] >= info->vertex_count)
+    {
+      moss__error ("Index %u references missing vertex.\n", i);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline static void moss__destroy_skinned_mesh (Moss__SkinnedMesh *const mesh)
+{
+  moss__destroy_crate (&mesh->index_crate);
+  moss__destroy_crate (&mesh->vertex_crate);
+
+  free (mesh->inverse_bind);
+  free (mesh->parents);
+
+  *mesh = (Moss__SkinnedMesh) {0};
+}
@@ -0,0 +1,522 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/sprite_animation.c
+  @brief GPU evaluated sprite sheet animation implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/animation.h"
+#include "moss/result.h"
+#include "moss/sprite.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/log.h"
+#include "src/internal/sprite_animation.h"
+
+/* Number of bindings of the sprite animation descriptor set. */
+#define MOSS__SPRITE_ANIMATION_BINDING_COUNT (uint32_t)(3)
+
+/* Binding of the clip crate. */
+#define MOSS__ANIMATION_CLIP_BINDING (uint32_t)(0)
+
+/* Binding of the frame crate. */
+#define MOSS__ANIMATION_FRAME_BINDING (uint32_t)(1)
+
+/* Binding of the per-sprite animation state crate. */
+#define MOSS__SPRITE_ANIMATION_BINDING (uint32_t)(2)
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Writes a storage buffer descriptor.
+  @param device Device the set was allocated on.
+  @param set Descriptor set to update.
+  @param binding Binding to write.
+  @param buffer Buffer to bind.
+*/
+inline static void moss__write_animation_descriptor (
+  VkDevice        device,
+  VkDescriptorSet set,
+  uint32_t        binding,
+  VkBuffer        buffer
+);
+
+/*
+  @brief Frees clips waiting for an inline update.
+  @param animation Sprite animation.
+*/
+inline static void moss__discard_pending_clip_update (Moss__SpriteAnimation *animation);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_sprite_animation (
+  const Moss__SpriteAnimationCreateInfo *const info,
+  Moss__SpriteAnimation *const                 out_animation
+)
+{
+  *out_animation        = (Moss__SpriteAnimation) {0};
+  out_animation->device = info->device;
+
+  const VkDescriptorSetLayoutBinding bindings[ MOSS__SPRITE_ANIMATION_BINDING_COUNT ] = {
+    {
+     .binding         = MOSS__ANIMATION_CLIP_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT,
+     },
+    {
+     .binding         = MOSS__ANIMATION_FRAME_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT,
+     },
+    {
+     .binding         = MOSS__SPRITE_ANIMATION_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_VERTEX_BIT,
+     },
+  };
+
+  const VkDescriptorSetLayoutCreateInfo set_layout_info = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .bindingCount = MOSS__SPRITE_ANIMATION_BINDING_COUNT,
+    .pBindings    = bindings,
+  };
+
+  const VkResult result = vkCreateDescriptorSetLayout (
+    info->device,
+    &set_layout_info,
+    NULL,
+    &out_animation->descriptor_set_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create sprite animation descriptor set layout. Error code: %d.\n",
+      result
+    );
+    moss__destroy_sprite_animation (out_animation);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__CrateCreateInfo clip_crate_info = {
+    .size = (VkDeviceSize)MOSS_MAX_ANIMATION_CLIP_COUNT * sizeof (Moss__GpuAnimationClip),
+    .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "animation clip crate",
+  };
+
+  const Moss__CrateCreateInfo frame_crate_info = {
+    .size =
+      (VkDeviceSize)MOSS_MAX_ANIMATION_FRAME_COUNT * sizeof (Moss__GpuAnimationFrame),
+    .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = info->sharing_mode,
+    .shared_queue_family_index_count = info->shared_queue_family_index_count,
+    .shared_queue_family_indices     = info->shared_queue_family_indices,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "animation frame crate",
+  };
+
+  if (moss__create_crate (&clip_crate_info, &out_animation->clip_crate) !=
+        MOSS_RESULT_SUCCESS ||
+      moss__create_crate (&frame_crate_info, &out_animation->frame_crate) !=
+        MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create animation clip crates.\n");
+    moss__destroy_sprite_animation (out_animation);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_sprite_animation (Moss__SpriteAnimation *const animation)
+{
+  if (animation->device == VK_NULL_HANDLE) { return; }
+
+  moss__discard_pending_clip_update (animation);
+
+  moss__destroy_crate (&animation->frame_crate);
+  moss__destroy_crate (&animation->clip_crate);
+
+  if (animation->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (
+      animation->device,
+      animation->descriptor_set_layout,
+      NULL
+    );
+  }
+
+  *animation = (Moss__SpriteAnimation) {0};
+}
+
+MossResult moss__create_sprite_animation_frame (
+  const Moss__SpriteAnimation *const           animation,
+  const Moss__SpriteAnimationCreateInfo *const info,
+  Moss__SpriteAnimationFrame *const            out_frame
+)
+{
+  *out_frame = (Moss__SpriteAnimationFrame) {0};
+
+  const Moss__CrateCreateInfo sprite_crate_info = {
+    .size = (VkDeviceSize)MOSS_MAX_SPRITE_COUNT * sizeof (Moss__GpuSpriteAnimation),
+    .usage             = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "sprite animation crate",
+  };
+
+  if (moss__create_crate (&sprite_crate_info, &out_frame->sprite_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create sprite animation crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void    *mapped_memory;
+  VkResult result = vkMapMemory (
+    info->device,
+    out_frame->sprite_crate.memory,
+    0,
+    out_frame->sprite_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to map sprite animation crate. Error code: %d.\n", result);
+    moss__destroy_sprite_animation_frame (animation, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->sprites = mapped_memory;
+
+  const VkDescriptorPoolSize pool_size = {
+    .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .descriptorCount = MOSS__SPRITE_ANIMATION_BINDING_COUNT,
+  };
+
+  const VkDescriptorPoolCreateInfo pool_info = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .maxSets       = 1,
+    .poolSizeCount = 1,
+    .pPoolSizes    = &pool_size,
+  };
+
+  result =
+    vkCreateDescriptorPool (info->device, &pool_info, NULL, &out_frame->descriptor_pool);
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create sprite animation descriptor pool. Error code: %d.\n",
+      result
+    );
+    moss__destroy_sprite_animation_frame (animation, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDescriptorSetAllocateInfo set_info = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .descriptorPool     = out_frame->descriptor_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &animation->descriptor_set_layout,
+  };
+
+  result = vkAllocateDescriptorSets (info->device, &set_info, &out_frame->descriptor_set);
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to allocate sprite animation descriptor set. Error code: %d.\n",
+      result
+    );
+    moss__destroy_sprite_animation_frame (animation, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__write_animation_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__ANIMATION_CLIP_BINDING,
+    animation->clip_crate.buffer
+  );
+
+  moss__write_animation_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__ANIMATION_FRAME_BINDING,
+    animation->frame_crate.buffer
+  );
+
+  moss__write_animation_descriptor (
+    info->device,
+    out_frame->descriptor_set,
+    MOSS__SPRITE_ANIMATION_BINDING,
+    out_frame->sprite_crate.buffer
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_sprite_animation_frame (
+  const Moss__SpriteAnimation *const animation,
+  Moss__SpriteAnimationFrame *const  frame
+)
+{
+  if (frame->descriptor_pool != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorPool (animation->device, frame->descriptor_pool, NULL);
+  }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->sprite_crate);
+
+  *frame = (Moss__SpriteAnimationFrame) {0};
+}
+
+MossResult moss__upload_animation_clips (
+  Moss__SpriteAnimation *const   animation,
+  const MossAnimationClip *const clips,
+  const uint32_t                 count,
+  const VkQueue                  transfer_queue,
+  const VkCommandPool            command_pool
+)
+{
+  if (count == 0 || count > MOSS_MAX_ANIMATION_CLIP_COUNT)
+  {
+    moss__error (
+      "Animation clip count must be in [1, %u] range, got %u.\n",
+      MOSS_MAX_ANIMATION_CLIP_COUNT,
+      count
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  uint32_t frame_count = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    if (clips[ i ].frame_count == 0)
+    {
+      moss__error ("Animation clip %u has no frames.\n", i);
+      return MOSS_RESULT_ERROR;
+    }
+
+    if (clips[ i ].frame_count > MOSS_MAX_ANIMATION_FRAME_COUNT - frame_count)
+    {
+      moss__error (
+        "Animation clips have more than %u frames.\n",
+        MOSS_MAX_ANIMATION_FRAME_COUNT
+      );
+      return MOSS_RESULT_ERROR;
+    }
+
+    frame_count += clips[ i ].frame_count;
+  }
+
+  Moss__GpuAnimationClip *const gpu_clips =
+    malloc (sizeof (Moss__GpuAnimationClip) * count);
+  Moss__GpuAnimationFrame *const gpu_frames =
+    malloc (sizeof (Moss__GpuAnimationFrame) * frame_count);
+  if (gpu_clips == NULL || gpu_frames == NULL)
+  {
+    moss__error ("Failed to allocate memory for animation clips.\n");
+    free (gpu_frames);
+    free (gpu_clips);
+    return MOSS_RESULT_ERROR;
+  }
+
+  uint32_t first_frame = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const MossAnimationClip *const clip = &clips[ i ];
+
+    // Frames store end times, so the shader finds the current one with a binary search
+    float end_time = 0.0F;
+    for (uint32_t j = 0; j < clip->frame_count; ++j)
+    {
+      const MossAnimationFrame *const frame = &clip->frames[ j ];
+
+      end_time += frame->duration;
+      gpu_frames[ first_frame + j ] = (Moss__GpuAnimationFrame) {
+        .uv       = { frame->uv_left, frame->uv_top, frame->uv_right, frame->uv_bottom },
+        .end_time = end_time,
+      };
+    }
+
+    gpu_clips[ i ] = (Moss__GpuAnimationClip) {
+      .first_frame = first_frame,
+      .frame_count = clip->frame_count,
+      .loop_mode   = (uint32_t)clip->loop_mode,
+      .duration    = end_time,
+    };
+
+    first_frame += clip->frame_count;
+  }
+
+  moss__discard_pending_clip_update (animation);
+
+  const VkDeviceSize clip_size  = sizeof (Moss__GpuAnimationClip) * count;
+  const VkDeviceSize frame_size = sizeof (Moss__GpuAnimationFrame) * frame_count;
+
+  // Small clip sets ride along with the next frame instead of a staging upload
+  if (clip_size <= MOSS__MAX_CRATE_UPDATE_SIZE &&
+      frame_size <= MOSS__MAX_CRATE_UPDATE_SIZE)
+  {
+    animation->pending_clips       = gpu_clips;
+    animation->pending_frames      = gpu_frames;
+    animation->pending_frame_count = frame_count;
+    animation->clip_count          = count;
+    return MOSS_RESULT_SUCCESS;
+  }
+
+  // Frames in flight may still read the previous clips
+  vkDeviceWaitIdle (animation->device);
+
+  const Moss__FillCrateInfo clip_fill_info = {
+    .destination_crate = &animation->clip_crate,
+    .source_memory     = gpu_clips,
+    .size              = clip_size,
+    .transfer_queue    = transfer_queue,
+    .command_pool      = command_pool,
+  };
+
+  const Moss__FillCrateInfo frame_fill_info = {
+    .destination_crate = &animation->frame_crate,
+    .source_memory     = gpu_frames,
+    .size              = frame_size,
+    .transfer_queue    = transfer_queue,
+    .command_pool      = command_pool,
+  };
+
+  const MossResult result = moss__fill_crate (&clip_fill_info) == MOSS_RESULT_SUCCESS &&
+                                moss__fill_crate (&frame_fill_info) == MOSS_RESULT_SUCCESS
+                              ? MOSS_RESULT_SUCCESS
+                              : MOSS_RESULT_ERROR;
+
+  free (gpu_frames);
+  free (gpu_clips);
+
+  if (result != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to upload animation clips.\n");
+    animation->clip_count = 0;
+    return MOSS_RESULT_ERROR;
+  }
+
+  animation->clip_count = count;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__record_animation_clip_update (
+  Moss__SpriteAnimation *const animation,
+  const VkCommandBuffer        command_buffer
+)
+{
+  if (animation->pending_clips == NULL) { return; }
+
+  const Moss__UpdateCrateInfo clip_update_info = {
+    .destination_crate = &animation->clip_crate,
+    .offset            = 0,
+    .source_memory     = animation->pending_clips,
+    .size              = sizeof (Moss__GpuAnimationClip) * animation->clip_count,
+    .command_buffer    = command_buffer,
+    .stage_mask        = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+    .access_mask       = VK_ACCESS_SHADER_READ_BIT,
+  };
+
+  const Moss__UpdateCrateInfo frame_update_info = {
+    .destination_crate = &animation->frame_crate,
+    .offset            = 0,
+    .source_memory     = animation->pending_frames,
+    .size =
+      sizeof (Moss__GpuAnimationFrame) * animation->pending_frame_count,
+    .command_buffer = command_buffer,
+    .stage_mask     = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+    .access_mask    = VK_ACCESS_SHADER_READ_BIT,
+  };
+
+  if (moss__record_crate_update (&clip_update_info) != MOSS_RESULT_SUCCESS ||
+      moss__record_crate_update (&frame_update_info) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to record animation clip update.\n");
+    animation->clip_count = 0;
+  }
+
+  // Update data is copied into the command buffer, so it's not needed anymore
+  moss__discard_pending_clip_update (animation);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static void moss__write_animation_descriptor (
+  const VkDevice        device,
+  const VkDescriptorSet set,
+  const uint32_t        binding,
+  const VkBuffer        buffer
+)
+{
+  const VkDescriptorBufferInfo buffer_info = {
+    .buffer = buffer,
+    .offset = 0,
+    .range  = VK_WHOLE_SIZE,
+  };
+
+  const VkWriteDescriptorSet write = {
+    .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .dstSet          = set,
+    .dstBinding      = binding,
+    .descriptorCount = 1,
+    .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .pBufferInfo     = &buffer_info,
+  };
+
+  vkUpdateDescriptorSets (device, 1, &write, 0, NULL);
+}
+
+inline static void
+moss__discard_pending_clip_update (Moss__SpriteAnimation *const animation)
+{
+  free (animation->pending_frames);
+  free (animation->pending_clips);
+
+  animation->pending_clips       = NULL;
+  animation->pending_frames      = NULL;
+  animation->pending_frame_count = 0;
+}
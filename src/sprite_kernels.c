@@ -0,0 +1,983 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/sprite_kernels.c
+  @brief Sprite vertex generation kernels implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details SIMD kernels compute every output float of N sprites as a vector of N lanes
+           (32 vectors per N sprites), then transpose groups of four vectors so that
+           each sprite's vertices are written with contiguous 16 byte stores.
+*/
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#  include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#  include <arm_neon.h>
+#endif
+
+#include "moss/job.h"
+#include "moss/vertex.h"
+
+#include "src/internal/sprite_kernels.h"
+
+/* Number of floats in a vertex. */
+#define MOSS__VERTEX_FLOAT_COUNT (uint32_t)(8)
+
+/* Number of floats generated per sprite. */
+#define MOSS__SPRITE_FLOAT_COUNT (MOSS__VERTEX_FLOAT_COUNT * MOSS__SPRITE_VERTEX_COUNT)
+
+/* Kernels write vertices as a flat array of 32 bit values. */
+typedef char Moss__SpriteVertexLayoutCheck
+  [ (sizeof (MossVertex) == MOSS__VERTEX_FLOAT_COUNT * sizeof (float)) ? 1 : -1 ];
+
+/* Sine and cosine polynomial coefficients (Taylor series, reduced to [-pi/2, pi/2]). */
+#define MOSS__SIN_C3  (-1.6666667163e-01F)
+#define MOSS__SIN_C5  (8.3333337680e-03F)
+#define MOSS__SIN_C7  (-1.9841270114e-04F)
+#define MOSS__SIN_C9  (2.7557314297e-06F)
+#define MOSS__SIN_C11 (-2.5052108385e-08F)
+#define MOSS__COS_C2  (-5.0000000000e-01F)
+#define MOSS__COS_C4  (4.1666667908e-02F)
+#define MOSS__COS_C6  (-1.3888889225e-03F)
+#define MOSS__COS_C8  (2.4801587642e-05F)
+#define MOSS__COS_C10 (-2.7557319223e-07F)
+#define MOSS__COS_C12 (2.0876756988e-09F)
+
+#define MOSS__INV_TWO_PI (1.5915493667e-01F)
+#define MOSS__TWO_PI_HI  (6.28125F)
+#define MOSS__TWO_PI_LO  (1.9353071795864769e-03F)
+#define MOSS__PI         (3.1415927410e+00F)
+#define MOSS__HALF_PI    (1.5707963705e+00F)
+
+/* Min number of sprites worth splitting between job threads. */
+#define MOSS__SPRITE_PARALLEL_THRESHOLD (uint32_t)(4096)
+
+/* Number of sprites expanded by one job. Multiple of every SIMD width. */
+#define MOSS__SPRITE_JOB_BATCH_SIZE (uint32_t)(1024)
+
+/*
+  @brief Parallel sprite expansion job data.
+*/
+typedef struct
+{
+  const Moss__SpriteSoA *sprites;      /* Sprites to expand. */
+  MossVertex            *out_vertices; /* Destination for all vertices. */
+} Moss__SpriteVertexJobData;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Returns value of an optional array, or the fallback if array is NULL.
+  @param array Array. May be NULL.
+  @param index Element index.
+  @param fallback Value to return if array is NULL.
+  @return Array element or fallback.
+*/
+inline static float
+moss__optional_float (const float *array, uint32_t index, float fallback);
+
+/*
+  @brief Writes vertices of a single sprite.
+  @param sprites Sprites.
+  @param index Sprite index.
+  @param sine Sine of the sprite rotation.
+  @param cosine Cosine of the sprite rotation.
+  @param out_vertices Destination for 4 vertices.
+*/
+inline static void moss__write_sprite_vertices (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               index,
+  float                  sine,
+  float                  cosine,
+  MossVertex            *out_vertices
+);
+
+/*
+  @brief Finishes sprites a SIMD kernel couldn't process in full vectors.
+  @details Uses the same polynomial as SIMD kernels, so results don't depend on
+           sprite position within a batch.
+  @param sprites Sprites.
+  @param first Index of the first sprite.
+  @param count Number of sprites.
+  @param out_vertices Destination for count * 4 vertices.
+*/
+inline static void moss__generate_sprite_vertices_tail (
+  const Moss__SpriteSoA *sprites,
+  uint32_t               first,
+  uint32_t               count,
+  MossVertex            *out_vertices
+);
+
+/*
+  @brief Computes sine and cosine with the polynomial used by SIMD kernels.
+  @param angle Angle in radians.
+  @param out_sine Sine output.
+  @param out_cosine Cosine output.
+*/
+inline static void moss__sincos (float angle, float *out_sine, float *out_cosine);
+
+/*
+  @brief Expands a range of sprites.
+  @note Satisfies @ref MossJobRangeFunction signature.
+*/
+static void
+moss__generate_sprite_vertices_range (void *user_data, uint32_t begin, uint32_t end);
+
+/*=============================================================================
+    SCALAR KERNEL
+  =============================================================================*/
+
+void moss__generate_sprite_vertices_scalar (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const float angle = moss__optional_float (sprites->rotation, first + i, 0.0F);
+    moss__write_sprite_vertices (
+      sprites,
+      first + i,
+      sinf (angle),
+      cosf (angle),
+      out_vertices + (size_t)i * MOSS__SPRITE_VERTEX_COUNT
+    );
+  }
+}
+
+/*=============================================================================
+    SSE2 KERNEL
+  =============================================================================*/
+
+#if defined(__x86_64__)
+
+/*
+  @brief Computes sine and cosine of 4 angles.
+*/
+inline static void
+moss__sincos_sse2 (const __m128 angle, __m128 *const out_sine, __m128 *const out_cosine)
+{
+  const __m128 sign_mask = _mm_set1_ps (-0.0F);
+
+  /* Reduce to [-pi, pi]. */
+  const __m128 turns = _mm_cvtepi32_ps (
+    _mm_cvtps_epi32 (_mm_mul_ps (angle, _mm_set1_ps (MOSS__INV_TWO_PI)))
+  );
+  __m128 x = _mm_sub_ps (angle, _mm_mul_ps (turns, _mm_set1_ps (MOSS__TWO_PI_HI)));
+  x        = _mm_sub_ps (x, _mm_mul_ps (turns, _mm_set1_ps (MOSS__TWO_PI_LO)));
+
+  /* Fold to [-pi/2, pi/2]: sin (x) = sin (pi - x), cos (x) = -cos (pi - x). */
+  const __m128 x_sign    = _mm_and_ps (x, sign_mask);
+  const __m128 x_abs     = _mm_andnot_ps (sign_mask, x);
+  const __m128 is_folded = _mm_cmpgt_ps (x_abs, _mm_set1_ps (MOSS__HALF_PI));
+  const __m128 folded    = _mm_sub_ps (_mm_set1_ps (MOSS__PI), x_abs);
+  const __m128 r_abs =
+    _mm_or_ps (_mm_and_ps (is_folded, folded), _mm_andnot_ps (is_folded, x_abs));
+  const __m128 r  = _mm_or_ps (r_abs, x_sign);
+  const __m128 r2 = _mm_mul_ps (r, r);
+
+  __m128 s = _mm_set1_ps (MOSS__SIN_C11);
+  s        = _mm_add_ps (_mm_mul_ps (s, r2), _mm_set1_ps (MOSS__SIN_C9));
+  s        = _mm_add_ps (_mm_mul_ps (s, r2), _mm_set1_ps (MOSS__SIN_C7));
+  s        = _mm_add_ps (_mm_mul_ps (s, r2), _mm_set1_ps (MOSS__SIN_C5));
+  s        = _mm_add_ps (_mm_mul_ps (s, r2), _mm_set1_ps (MOSS__SIN_C3));
+  s        = _mm_add_ps (_mm_mul_ps (_mm_mul_ps (s, r2), r), r);
+
+  __m128 c = _mm_set1_ps (MOSS__COS_C12);
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (MOSS__COS_C10));
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (MOSS__COS_C8));
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (MOSS__COS_C6));
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (MOSS__COS_C4));
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (MOSS__COS_C2));
+  c        = _mm_add_ps (_mm_mul_ps (c, r2), _mm_set1_ps (1.0F));
+
+  *out_sine   = s;
+  *out_cosine = _mm_xor_ps (c, _mm_and_ps (is_folded, sign_mask));
+}
+
+/*
+  @brief Transposes 4 vectors and stores them as the same 4 floats of 4 sprites.
+  @details Lane i of every vector goes to out + i * MOSS__SPRITE_FLOAT_COUNT.
+*/
+inline static void moss__store_transposed_sse2 (
+  float *const out,
+  const __m128 a,
+  const __m128 b,
+  const __m128 c,
+  const __m128 d
+)
+{
+  const __m128 ab_low  = _mm_unpacklo_ps (a, b);
+  const __m128 ab_high = _mm_unpackhi_ps (a, b);
+  const __m128 cd_low  = _mm_unpacklo_ps (c, d);
+  const __m128 cd_high = _mm_unpackhi_ps (c, d);
+
+  _mm_storeu_ps (out, _mm_movelh_ps (ab_low, cd_low));
+  _mm_storeu_ps (out + MOSS__SPRITE_FLOAT_COUNT, _mm_movehl_ps (cd_low, ab_low));
+  _mm_storeu_ps (out + 2 * MOSS__SPRITE_FLOAT_COUNT, _mm_movelh_ps (ab_high, cd_high));
+  _mm_storeu_ps (out + 3 * MOSS__SPRITE_FLOAT_COUNT, _mm_movehl_ps (cd_high, ab_high));
+}
+
+/*
+  @brief Loads 4 floats of an optional array, or broadcasts fallback.
+*/
+inline static __m128 moss__load_optional_sse2 (
+  const float *const array,
+  const uint32_t     index,
+  const float        fallback
+)
+{
+  return array != NULL ? _mm_loadu_ps (array + index) : _mm_set1_ps (fallback);
+}
+
+void moss__generate_sprite_vertices_sse2 (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  const uint32_t vector_count = count / 4;
+  float *const   out          = (float *)out_vertices;
+
+  for (uint32_t v = 0; v < vector_count; ++v)
+  {
+    const uint32_t index = first + v * 4;
+
+    const __m128 half = _mm_set1_ps (0.5F);
+    const __m128 x    = _mm_loadu_ps (sprites->x + index);
+    const __m128 y    = _mm_loadu_ps (sprites->y + index);
+    const __m128 sx   = _mm_mul_ps (_mm_loadu_ps (sprites->scale_x + index), half);
+    const __m128 sy   = _mm_mul_ps (_mm_loadu_ps (sprites->scale_y + index), half);
+
+    __m128 sine, cosine;
+    if (sprites->rotation != NULL)
+    {
+      moss__sincos_sse2 (_mm_loadu_ps (sprites->rotation + index), &sine, &cosine);
+    }
+    else {
+      sine   = _mm_setzero_ps ( );
+      cosine = _mm_set1_ps (1.0F);
+    }
+
+    /* Half extents along rotated X (a) and Y (b) axes. */
+    const __m128 ax = _mm_mul_ps (sx, cosine);
+    const __m128 ay = _mm_mul_ps (sx, sine);
+    const __m128 bx = _mm_sub_ps (_mm_setzero_ps ( ), _mm_mul_ps (sy, sine));
+    const __m128 by = _mm_mul_ps (sy, cosine);
+
+    const __m128 u0 = moss__load_optional_sse2 (sprites->uv_left, index, 0.0F);
+    const __m128 v0 = moss__load_optional_sse2 (sprites->uv_top, index, 0.0F);
+    const __m128 u1 = moss__load_optional_sse2 (sprites->uv_right, index, 1.0F);
+    const __m128 v1 = moss__load_optional_sse2 (sprites->uv_bottom, index, 1.0F);
+
+    const __m128 t =
+      sprites->texture_index != NULL
+        ? _mm_castsi128_ps (
+            _mm_loadu_si128 ((const __m128i *)(sprites->texture_index + index))
+          )
+        : _mm_setzero_ps ( );
+
+    __m128 r, g, b;
+    if (sprites->color != NULL)
+    {
+      const __m128i color = _mm_loadu_si128 ((const __m128i *)(sprites->color + index));
+      const __m128i byte  = _mm_set1_epi32 (0xFF);
+      const __m128  scale = _mm_set1_ps (1.0F / 255.0F);
+      r = _mm_mul_ps (_mm_cvtepi32_ps (_mm_and_si128 (color, byte)), scale);
+      g = _mm_mul_ps (
+        _mm_cvtepi32_ps (_mm_and_si128 (_mm_srli_epi32 (color, 8), byte)), scale
+      );
+      b = _mm_mul_ps (
+        _mm_cvtepi32_ps (_mm_and_si128 (_mm_srli_epi32 (color, 16), byte)), scale
+      );
+    }
+    else {
+      r = g = b = _mm_set1_ps (1.0F);
+    }
+
+    const __m128 x_minus = _mm_sub_ps (x, ax), x_plus = _mm_add_ps (x, ax);
+    const __m128 y_minus = _mm_sub_ps (y, ay), y_plus = _mm_add_ps (y, ay);
+
+    /* Every vertex is transposed and stored right away, so few vectors stay live. */
+    float *const   sprite_out  = out + (size_t)v * 4 * MOSS__SPRITE_FLOAT_COUNT;
+    const uint32_t vertex_size = MOSS__VERTEX_FLOAT_COUNT;
+
+    const __m128 x0 = _mm_sub_ps (x_minus, bx), y0 = _mm_sub_ps (y_minus, by);
+    moss__store_transposed_sse2 (sprite_out, x0, y0, r, g);
+    moss__store_transposed_sse2 (sprite_out + 4, b, u0, v0, t);
+
+    const __m128 x1 = _mm_sub_ps (x_plus, bx), y1 = _mm_sub_ps (y_plus, by);
+    moss__store_transposed_sse2 (sprite_out + vertex_size, x1, y1, r, g);
+    moss__store_transposed_sse2 (sprite_out + vertex_size + 4, b, u1, v0, t);
+
+    const __m128 x2 = _mm_add_ps (x_plus, bx), y2 = _mm_add_ps (y_plus, by);
+    moss__store_transposed_sse2 (sprite_out + 2 * vertex_size, x2, y2, r, g);
+    moss__store_transposed_sse2 (sprite_out + 2 * vertex_size + 4, b, u1, v1, t);
+
+    const __m128 x3 = _mm_add_ps (x_minus, bx), y3 = _mm_add_ps (y_minus, by);
+    moss__store_transposed_sse2 (sprite_out + 3 * vertex_size, x3, y3, r, g);
+    moss__store_transposed_sse2 (sprite_out + 3 * vertex_size + 4, b, u0, v1, t);
+  }
+
+  moss__generate_sprite_vertices_tail (
+    sprites,
+    first + vector_count * 4,
+    count - vector_count * 4,
+    out_vertices + (size_t)vector_count * 4 * MOSS__SPRITE_VERTEX_COUNT
+  );
+}
+
+/*=============================================================================
+    AVX2 KERNEL
+  =============================================================================*/
+
+#  define MOSS__AVX2 __attribute__ ((target ("avx2")))
+
+/*
+  @brief Computes sine and cosine of 8 angles.
+*/
+MOSS__AVX2 inline static void
+moss__sincos_avx2 (const __m256 angle, __m256 *const out_sine, __m256 *const out_cosine)
+{
+  const __m256 sign_mask = _mm256_set1_ps (-0.0F);
+
+  /* Reduce to [-pi, pi]. */
+  const __m256 turns = _mm256_round_ps (
+    _mm256_mul_ps (angle, _mm256_set1_ps (MOSS__INV_TWO_PI)),
+    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+  );
+  __m256 x =
+    _mm256_sub_ps (angle, _mm256_mul_ps (turns, _mm256_set1_ps (MOSS__TWO_PI_HI)));
+  x = _mm256_sub_ps (x, _mm256_mul_ps (turns, _mm256_set1_ps (MOSS__TWO_PI_LO)));
+
+  /* Fold to [-pi/2, pi/2]: sin (x) = sin (pi - x), cos (x) = -cos (pi - x). */
+  const __m256 x_sign = _mm256_and_ps (x, sign_mask);
+  const __m256 x_abs  = _mm256_andnot_ps (sign_mask, x);
+  const __m256 is_folded =
+    _mm256_cmp_ps (x_abs, _mm256_set1_ps (MOSS__HALF_PI), _CMP_GT_OQ);
+  const __m256 folded = _mm256_sub_ps (_mm256_set1_ps (MOSS__PI), x_abs);
+  const __m256 r =
+    _mm256_or_ps (_mm256_blendv_ps (x_abs, folded, is_folded), x_sign);
+  const __m256 r2 = _mm256_mul_ps (r, r);
+
+  __m256 s = _mm256_set1_ps (MOSS__SIN_C11);
+  s        = _mm256_add_ps (_mm256_mul_ps (s, r2), _mm256_set1_ps (MOSS__SIN_C9));
+  s        = _mm256_add_ps (_mm256_mul_ps (s, r2), _mm256_set1_ps (MOSS__SIN_C7));
+  s        = _mm256_add_ps (_mm256_mul_ps (s, r2), _mm256_set1_ps (MOSS__SIN_C5));
+  s        = _mm256_add_ps (_mm256_mul_ps (s, r2), _mm256_set1_ps (MOSS__SIN_C3));
+  s        = _mm256_add_ps (_mm256_mul_ps (_mm256_mul_ps (s, r2), r), r);
+
+  __m256 c = _mm256_set1_ps (MOSS__COS_C12);
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (MOSS__COS_C10));
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (MOSS__COS_C8));
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (MOSS__COS_C6));
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (MOSS__COS_C4));
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (MOSS__COS_C2));
+  c        = _mm256_add_ps (_mm256_mul_ps (c, r2), _mm256_set1_ps (1.0F));
+
+  *out_sine   = s;
+  *out_cosine = _mm256_xor_ps (c, _mm256_and_ps (is_folded, sign_mask));
+}
+
+/*
+  @brief Stores the same vertex of 8 sprites, a single 32 byte store per sprite.
+  @details Vertex floats come in pairs interleaved by unpack low and high, so pairs
+           shared between vertices of a sprite are interleaved only once. Vectors
+           are passed by value, arrays of them get spilled to the stack.
+  @param out Vertex of the first sprite, sprites are MOSS__SPRITE_FLOAT_COUNT apart.
+  @param xy_low Positions, low interleave.
+  @param xy_high Positions, high interleave.
+  @param rg_low Red and green, low interleave.
+  @param rg_high Red and green, high interleave.
+  @param bu_low Blue and texture U, low interleave.
+  @param bu_high Blue and texture U, high interleave.
+  @param vt_low Texture V and texture index, low interleave.
+  @param vt_high Texture V and texture index, high interleave.
+*/
+MOSS__AVX2 inline static void moss__store_vertex_avx2 (
+  float *const out,
+  const __m256 xy_low,
+  const __m256 xy_high,
+  const __m256 rg_low,
+  const __m256 rg_high,
+  const __m256 bu_low,
+  const __m256 bu_high,
+  const __m256 vt_low,
+  const __m256 vt_high
+)
+{
+  /* 4x4 transposes within 128 bit halves: low halves hold sprites 0-3, high halves
+     hold sprites 4-7. Position and color make the first half of a vertex. */
+  const __m256 first_0  = _mm256_shuffle_ps (xy_low, rg_low, _MM_SHUFFLE (1, 0, 1, 0));
+  const __m256 first_1  = _mm256_shuffle_ps (xy_low, rg_low, _MM_SHUFFLE (3, 2, 3, 2));
+  const __m256 first_2  = _mm256_shuffle_ps (xy_high, rg_high, _MM_SHUFFLE (1, 0, 1, 0));
+  const __m256 first_3  = _mm256_shuffle_ps (xy_high, rg_high, _MM_SHUFFLE (3, 2, 3, 2));
+  const __m256 second_0 = _mm256_shuffle_ps (bu_low, vt_low, _MM_SHUFFLE (1, 0, 1, 0));
+  const __m256 second_1 = _mm256_shuffle_ps (bu_low, vt_low, _MM_SHUFFLE (3, 2, 3, 2));
+  const __m256 second_2 = _mm256_shuffle_ps (bu_high, vt_high, _MM_SHUFFLE (1, 0, 1, 0));
+  const __m256 second_3 = _mm256_shuffle_ps (bu_high, vt_high, _MM_SHUFFLE (3, 2, 3, 2));
+
+  const uint32_t stride = MOSS__SPRITE_FLOAT_COUNT;
+
+  _mm256_storeu_ps (out, _mm256_permute2f128_ps (first_0, second_0, 0x20));
+  _mm256_storeu_ps (out + stride, _mm256_permute2f128_ps (first_1, second_1, 0x20));
+  _mm256_storeu_ps (out + 2 * stride, _mm256_permute2f128_ps (first_2, second_2, 0x20));
+  _mm256_storeu_ps (out + 3 * stride, _mm256_permute2f128_ps (first_3, second_3, 0x20));
+  _mm256_storeu_ps (out + 4 * stride, _mm256_permute2f128_ps (first_0, second_0, 0x31));
+  _mm256_storeu_ps (out + 5 * stride, _mm256_permute2f128_ps (first_1, second_1, 0x31));
+  _mm256_storeu_ps (out + 6 * stride, _mm256_permute2f128_ps (first_2, second_2, 0x31));
+  _mm256_storeu_ps (out + 7 * stride, _mm256_permute2f128_ps (first_3, second_3, 0x31));
+}
+
+/*
+  @brief Loads 8 floats of an optional array, or broadcasts fallback.
+*/
+MOSS__AVX2 inline static __m256 moss__load_optional_avx2 (
+  const float *const array,
+  const uint32_t     index,
+  const float        fallback
+)
+{
+  return array != NULL ? _mm256_loadu_ps (array + index) : _mm256_set1_ps (fallback);
+}
+
+MOSS__AVX2 void moss__generate_sprite_vertices_avx2 (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  const uint32_t vector_count = count / 8;
+  float *const   out          = (float *)out_vertices;
+
+  for (uint32_t v = 0; v < vector_count; ++v)
+  {
+    const uint32_t index = first + v * 8;
+
+    const __m256 half = _mm256_set1_ps (0.5F);
+    const __m256 x    = _mm256_loadu_ps (sprites->x + index);
+    const __m256 y    = _mm256_loadu_ps (sprites->y + index);
+    const __m256 sx   = _mm256_mul_ps (_mm256_loadu_ps (sprites->scale_x + index), half);
+    const __m256 sy   = _mm256_mul_ps (_mm256_loadu_ps (sprites->scale_y + index), half);
+
+    __m256 sine, cosine;
+    if (sprites->rotation != NULL)
+    {
+      moss__sincos_avx2 (_mm256_loadu_ps (sprites->rotation + index), &sine, &cosine);
+    }
+    else {
+      sine   = _mm256_setzero_ps ( );
+      cosine = _mm256_set1_ps (1.0F);
+    }
+
+    /* Half extents along rotated X (a) and Y (b) axes. */
+    const __m256 ax = _mm256_mul_ps (sx, cosine);
+    const __m256 ay = _mm256_mul_ps (sx, sine);
+    const __m256 bx = _mm256_sub_ps (_mm256_setzero_ps ( ), _mm256_mul_ps (sy, sine));
+    const __m256 by = _mm256_mul_ps (sy, cosine);
+
+    const __m256 u0 = moss__load_optional_avx2 (sprites->uv_left, index, 0.0F);
+    const __m256 v0 = moss__load_optional_avx2 (sprites->uv_top, index, 0.0F);
+    const __m256 u1 = moss__load_optional_avx2 (sprites->uv_right, index, 1.0F);
+    const __m256 v1 = moss__load_optional_avx2 (sprites->uv_bottom, index, 1.0F);
+
+    const __m256 t =
+      sprites->texture_index != NULL
+        ? _mm256_castsi256_ps (
+            _mm256_loadu_si256 ((const __m256i *)(sprites->texture_index + index))
+          )
+        : _mm256_setzero_ps ( );
+
+    __m256 r, g, b;
+    if (sprites->color != NULL)
+    {
+      const __m256i color =
+        _mm256_loadu_si256 ((const __m256i *)(sprites->color + index));
+      const __m256i byte  = _mm256_set1_epi32 (0xFF);
+      const __m256  scale = _mm256_set1_ps (1.0F / 255.0F);
+      r = _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_and_si256 (color, byte)), scale);
+      g = _mm256_mul_ps (
+        _mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srli_epi32 (color, 8), byte)), scale
+      );
+      b = _mm256_mul_ps (
+        _mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srli_epi32 (color, 16), byte)), scale
+      );
+    }
+    else {
+      r = g = b = _mm256_set1_ps (1.0F);
+    }
+
+    const __m256 x_minus = _mm256_sub_ps (x, ax), x_plus = _mm256_add_ps (x, ax);
+    const __m256 y_minus = _mm256_sub_ps (y, ay), y_plus = _mm256_add_ps (y, ay);
+
+    /* Every vertex is transposed and stored right away, so few vectors stay live. */
+    float *const   sprite_out  = out + (size_t)v * 8 * MOSS__SPRITE_FLOAT_COUNT;
+    const uint32_t vertex_size = MOSS__VERTEX_FLOAT_COUNT;
+
+    const __m256 rg_low   = _mm256_unpacklo_ps (r, g);
+    const __m256 rg_high  = _mm256_unpackhi_ps (r, g);
+    const __m256 bu0_low  = _mm256_unpacklo_ps (b, u0);
+    const __m256 bu0_high = _mm256_unpackhi_ps (b, u0);
+    const __m256 bu1_low  = _mm256_unpacklo_ps (b, u1);
+    const __m256 bu1_high = _mm256_unpackhi_ps (b, u1);
+    const __m256 v0t_low  = _mm256_unpacklo_ps (v0, t);
+    const __m256 v0t_high = _mm256_unpackhi_ps (v0, t);
+    const __m256 v1t_low  = _mm256_unpacklo_ps (v1, t);
+    const __m256 v1t_high = _mm256_unpackhi_ps (v1, t);
+
+    const __m256 x0 = _mm256_sub_ps (x_minus, bx), y0 = _mm256_sub_ps (y_minus, by);
+    moss__store_vertex_avx2 (
+      sprite_out,
+      _mm256_unpacklo_ps (x0, y0),
+      _mm256_unpackhi_ps (x0, y0),
+      rg_low,
+      rg_high,
+      bu0_low,
+      bu0_high,
+      v0t_low,
+      v0t_high
+    );
+
+    const __m256 x1 = _mm256_sub_ps (x_plus, bx), y1 = _mm256_sub_ps (y_plus, by);
+    moss__store_vertex_avx2 (
+      sprite_out + vertex_size,
+      _mm256_unpacklo_ps (x1, y1),
+      _mm256_unpackhi_ps (x1, y1),
+      rg_low,
+      rg_high,
+      bu1_low,
+      bu1_high,
+      v0t_low,
+      v0t_high
+    );
+
+    const __m256 x2 = _mm256_add_ps (x_plus, bx), y2 = _mm256_add_ps (y_plus, by);
+    moss__store_vertex_avx2 (
+      sprite_out + 2 * vertex_size,
+      _mm256_unpacklo_ps (x2, y2),
+      _mm256_unpackhi_ps (x2, y2),
+      rg_low,
+      rg_high,
+      bu1_low,
+      bu1_high,
+      v1t_low,
+      v1t_high
+    );
+
+    const __m256 x3 = _mm256_add_ps (x_minus, bx), y3 = _mm256_add_ps (y_minus, by);
+    moss__store_vertex_avx2 (
+      sprite_out + 3 * vertex_size,
+      _mm256_unpacklo_ps (x3, y3),
+      _mm256_unpackhi_ps (x3, y3),
+      rg_low,
+      rg_high,
+      bu0_low,
+      bu0_high,
+      v1t_low,
+      v1t_high
+    );
+  }
+
+  moss__generate_sprite_vertices_tail (
+    sprites,
+    first + vector_count * 8,
+    count - vector_count * 8,
+    out_vertices + (size_t)vector_count * 8 * MOSS__SPRITE_VERTEX_COUNT
+  );
+}
+
+#endif /* x86 */
+
+/*=============================================================================
+    NEON KERNEL
+  =============================================================================*/
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+
+/*
+  @brief Computes sine and cosine of 4 angles.
+*/
+inline static void moss__sincos_neon (
+  const float32x4_t  angle,
+  float32x4_t *const out_sine,
+  float32x4_t *const out_cosine
+)
+{
+  /* Reduce to [-pi, pi]. */
+  const float32x4_t turns = vcvtq_f32_s32 (
+    vcvtq_s32_f32 (vaddq_f32 (
+      vmulq_n_f32 (angle, MOSS__INV_TWO_PI),
+      vbslq_f32 (vdupq_n_u32 (0x80000000U), angle, vdupq_n_f32 (0.5F))
+    ))
+  );
+  float32x4_t x = vsubq_f32 (angle, vmulq_n_f32 (turns, MOSS__TWO_PI_HI));
+  x             = vsubq_f32 (x, vmulq_n_f32 (turns, MOSS__TWO_PI_LO));
+
+  /* Fold to [-pi/2, pi/2]: sin (x) = sin (pi - x), cos (x) = -cos (pi - x). */
+  const float32x4_t x_abs     = vabsq_f32 (x);
+  const uint32x4_t  is_folded = vcgtq_f32 (x_abs, vdupq_n_f32 (MOSS__HALF_PI));
+  const float32x4_t r_abs =
+    vbslq_f32 (is_folded, vsubq_f32 (vdupq_n_f32 (MOSS__PI), x_abs), x_abs);
+  const float32x4_t r  = vbslq_f32 (vdupq_n_u32 (0x80000000U), x, r_abs);
+  const float32x4_t r2 = vmulq_f32 (r, r);
+
+  float32x4_t s = vdupq_n_f32 (MOSS__SIN_C11);
+  s             = vaddq_f32 (vmulq_f32 (s, r2), vdupq_n_f32 (MOSS__SIN_C9));
+  s             = vaddq_f32 (vmulq_f32 (s, r2), vdupq_n_f32 (MOSS__SIN_C7));
+  s             = vaddq_f32 (vmulq_f32 (s, r2), vdupq_n_f32 (MOSS__SIN_C5));
+  s             = vaddq_f32 (vmulq_f32 (s, r2), vdupq_n_f32 (MOSS__SIN_C3));
+  s             = vaddq_f32 (vmulq_f32 (vmulq_f32 (s, r2), r), r);
+
+  float32x4_t c = vdupq_n_f32 (MOSS__COS_C12);
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (MOSS__COS_C10));
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (MOSS__COS_C8));
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (MOSS__COS_C6));
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (MOSS__COS_C4));
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (MOSS__COS_C2));
+  c             = vaddq_f32 (vmulq_f32 (c, r2), vdupq_n_f32 (1.0F));
+
+  *out_sine   = s;
+  *out_cosine = vbslq_f32 (is_folded, vnegq_f32 (c), c);
+}
+
+/*
+  @brief Loads 4 floats of an optional array, or broadcasts fallback.
+*/
+inline static float32x4_t moss__load_optional_neon (
+  const float *const array,
+  const uint32_t     index,
+  const float        fallback
+)
+{
+  return array != NULL ? vld1q_f32 (array + index) : vdupq_n_f32 (fallback);
+}
+
+void moss__generate_sprite_vertices_neon (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  const uint32_t vector_count = count / 4;
+  float *const   out          = (float *)out_vertices;
+
+  for (uint32_t v = 0; v < vector_count; ++v)
+  {
+    const uint32_t index = first + v * 4;
+
+    const float32x4_t x  = vld1q_f32 (sprites->x + index);
+    const float32x4_t y  = vld1q_f32 (sprites->y + index);
+    const float32x4_t sx = vmulq_n_f32 (vld1q_f32 (sprites->scale_x + index), 0.5F);
+    const float32x4_t sy = vmulq_n_f32 (vld1q_f32 (sprites->scale_y + index), 0.5F);
+
+    float32x4_t sine, cosine;
+    if (sprites->rotation != NULL)
+    {
+      moss__sincos_neon (vld1q_f32 (sprites->rotation + index), &sine, &cosine);
+    }
+    else {
+      sine   = vdupq_n_f32 (0.0F);
+      cosine = vdupq_n_f32 (1.0F);
+    }
+
+    /* Half extents along rotated X (a) and Y (b) axes. */
+    const float32x4_t ax = vmulq_f32 (sx, cosine);
+    const float32x4_t ay = vmulq_f32 (sx, sine);
+    const float32x4_t bx = vnegq_f32 (vmulq_f32 (sy, sine));
+    const float32x4_t by = vmulq_f32 (sy, cosine);
+
+    const float32x4_t u0 = moss__load_optional_neon (sprites->uv_left, index, 0.0F);
+    const float32x4_t v0 = moss__load_optional_neon (sprites->uv_top, index, 0.0F);
+    const float32x4_t u1 = moss__load_optional_neon (sprites->uv_right, index, 1.0F);
+    const float32x4_t v1 = moss__load_optional_neon (sprites->uv_bottom, index, 1.0F);
+
+    const float32x4_t t =
+      sprites->texture_index != NULL
+        ? vreinterpretq_f32_u32 (vld1q_u32 (sprites->texture_index + index))
+        : vdupq_n_f32 (0.0F);
+
+    float32x4_t r, g, b;
+    if (sprites->color != NULL)
+    {
+      const uint32x4_t color = vld1q_u32 (sprites->color + index);
+      const uint32x4_t byte  = vdupq_n_u32 (0xFF);
+      r = vmulq_n_f32 (vcvtq_f32_u32 (vandq_u32 (color, byte)), 1.0F / 255.0F);
+      g = vmulq_n_f32 (
+        vcvtq_f32_u32 (vandq_u32 (vshrq_n_u32 (color, 8), byte)), 1.0F / 255.0F
+      );
+      b = vmulq_n_f32 (
+        vcvtq_f32_u32 (vandq_u32 (vshrq_n_u32 (color, 16), byte)), 1.0F / 255.0F
+      );
+    }
+    else {
+      r = g = b = vdupq_n_f32 (1.0F);
+    }
+
+    const float32x4_t x_minus = vsubq_f32 (x, ax), x_plus = vaddq_f32 (x, ax);
+    const float32x4_t y_minus = vsubq_f32 (y, ay), y_plus = vaddq_f32 (y, ay);
+
+    const float32x4_t floats[ MOSS__SPRITE_FLOAT_COUNT ] = {
+      vsubq_f32 (x_minus, bx), vsubq_f32 (y_minus, by), r, g, b, u0, v0, t,
+      vsubq_f32 (x_plus, bx),  vsubq_f32 (y_plus, by),  r, g, b, u1, v0, t,
+      vaddq_f32 (x_plus, bx),  vaddq_f32 (y_plus, by),  r, g, b, u1, v1, t,
+      vaddq_f32 (x_minus, bx), vaddq_f32 (y_minus, by), r, g, b, u0, v1, t,
+    };
+
+    float *const sprite_out = out + (size_t)v * 4 * MOSS__SPRITE_FLOAT_COUNT;
+    for (uint32_t i = 0; i < MOSS__SPRITE_FLOAT_COUNT; i += 4)
+    {
+      const float32x4x2_t t01 = vtrnq_f32 (floats[ i ], floats[ i + 1 ]);
+      const float32x4x2_t t23 = vtrnq_f32 (floats[ i + 2 ], floats[ i + 3 ]);
+
+      const float32x4_t rows[ 4 ] = {
+        vcombine_f32 (vget_low_f32 (t01.val[ 0 ]), vget_low_f32 (t23.val[ 0 ])),
+        vcombine_f32 (vget_low_f32 (t01.val[ 1 ]), vget_low_f32 (t23.val[ 1 ])),
+        vcombine_f32 (vget_high_f32 (t01.val[ 0 ]), vget_high_f32 (t23.val[ 0 ])),
+        vcombine_f32 (vget_high_f32 (t01.val[ 1 ]), vget_high_f32 (t23.val[ 1 ])),
+      };
+
+      for (uint32_t lane = 0; lane < 4; ++lane)
+      {
+        vst1q_f32 (sprite_out + lane * MOSS__SPRITE_FLOAT_COUNT + i, rows[ lane ]);
+      }
+    }
+  }
+
+  moss__generate_sprite_vertices_tail (
+    sprites,
+    first + vector_count * 4,
+    count - vector_count * 4,
+    out_vertices + (size_t)vector_count * 4 * MOSS__SPRITE_VERTEX_COUNT
+  );
+}
+
+#endif /* NEON */
+
+/*=============================================================================
+    DISPATCH
+  =============================================================================*/
+
+Moss__SpriteVertexKernel moss__select_sprite_vertex_kernel (void)
+{
+#if defined(__x86_64__)
+  __builtin_cpu_init ( );
+  if (__builtin_cpu_supports ("avx2")) { return moss__generate_sprite_vertices_avx2; }
+  return moss__generate_sprite_vertices_sse2;
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+  return moss__generate_sprite_vertices_neon;
+#endif
+
+  return moss__generate_sprite_vertices_scalar;
+}
+
+void moss__generate_sprite_vertices (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  static Moss__SpriteVertexKernel kernel = NULL;
+
+  /* Selection is idempotent, so racing threads store the same pointer. */
+  Moss__SpriteVertexKernel selected = __atomic_load_n (&kernel, __ATOMIC_RELAXED);
+  if (selected == NULL)
+  {
+    selected = moss__select_sprite_vertex_kernel ( );
+    __atomic_store_n (&kernel, selected, __ATOMIC_RELAXED);
+  }
+
+  selected (sprites, first, count, out_vertices);
+}
+
+void moss__generate_sprite_vertices_parallel (
+  const Moss__SpriteSoA *const sprites,
+  MossVertex *const            out_vertices
+)
+{
+  if (sprites->count < MOSS__SPRITE_PARALLEL_THRESHOLD)
+  {
+    moss__generate_sprite_vertices (sprites, 0, sprites->count, out_vertices);
+    return;
+  }
+
+  Moss__SpriteVertexJobData job_data = {
+    .sprites      = sprites,
+    .out_vertices = out_vertices,
+  };
+
+  moss_job_parallel_for (
+    sprites->count,
+    MOSS__SPRITE_JOB_BATCH_SIZE,
+    moss__generate_sprite_vertices_range,
+    &job_data
+  );
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+static void moss__generate_sprite_vertices_range (
+  void *const    user_data,
+  const uint32_t begin,
+  const uint32_t end
+)
+{
+  const Moss__SpriteVertexJobData *const job_data = user_data;
+
+  moss__generate_sprite_vertices (
+    job_data->sprites,
+    begin,
+    end - begin,
+    job_data->out_vertices + (size_t)begin * MOSS__SPRITE_VERTEX_COUNT
+  );
+}
+
+inline static float moss__optional_float (
+  const float *const array,
+  const uint32_t     index,
+  const float        fallback
+)
+{
+  return array != NULL ? array[ index ] : fallback;
+}
+
+inline static void moss__write_sprite_vertices (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               index,
+  const float                  sine,
+  const float                  cosine,
+  MossVertex *const            out_vertices
+)
+{
+  const float x  = sprites->x[ index ];
+  const float y  = sprites->y[ index ];
+  const float sx = sprites->scale_x[ index ] * 0.5F;
+  const float sy = sprites->scale_y[ index ] * 0.5F;
+
+  const float ax = sx * cosine, ay = sx * sine;
+  const float bx = -(sy * sine), by = sy * cosine;
+
+  const float u0 = moss__optional_float (sprites->uv_left, index, 0.0F);
+  const float v0 = moss__optional_float (sprites->uv_top, index, 0.0F);
+  const float u1 = moss__optional_float (sprites->uv_right, index, 1.0F);
+  const float v1 = moss__optional_float (sprites->uv_bottom, index, 1.0F);
+
+  const uint32_t texture_index =
+    sprites->texture_index != NULL ? sprites->texture_index[ index ] : 0;
+
+  float r = 1.0F, g = 1.0F, b = 1.0F;
+  if (sprites->color != NULL)
+  {
+    const uint32_t color = sprites->color[ index ];
+    r                    = (float)(color & 0xFF) * (1.0F / 255.0F);
+    g                    = (float)((color >> 8) & 0xFF) * (1.0F / 255.0F);
+    b                    = (float)((color >> 16) & 0xFF) * (1.0F / 255.0F);
+  }
+
+  const float corner_x[ 4 ] = { -1.0F, 1.0F, 1.0F, -1.0F };
+  const float corner_y[ 4 ] = { -1.0F, -1.0F, 1.0F, 1.0F };
+  const float corner_u[ 4 ] = { u0, u1, u1, u0 };
+  const float corner_v[ 4 ] = { v0, v0, v1, v1 };
+
+  for (uint32_t i = 0; i < MOSS__SPRITE_VERTEX_COUNT; ++i)
+  {
+    MossVertex *const vertex = &out_vertices[ i ];
+
+    vertex->position[ 0 ] = (x + corner_x[ i ] * ax) + corner_y[ i ] * bx;
+    vertex->position[ 1 ] = (y + corner_x[ i ] * ay) + corner_y[ i ] * by;
+
+    vertex->color[ 0 ] = r;
+    vertex->color[ 1 ] = g;
+    vertex->color[ 2 ] = b;
+
+    vertex->texture_coordinates[ 0 ] = corner_u[ i ];
+    vertex->texture_coordinates[ 1 ] = corner_v[ i ];
+
+    vertex->texture_index = texture_index;
+  }
+}
+
+inline static void moss__generate_sprite_vertices_tail (
+  const Moss__SpriteSoA *const sprites,
+  const uint32_t               first,
+  const uint32_t               count,
+  MossVertex *const            out_vertices
+)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    float sine = 0.0F, cosine = 1.0F;
+    if (sprites->rotation != NULL)
+    {
+      moss__sincos (sprites->rotation[ first + i ], &sine, &cosine);
+    }
+
+    moss__write_sprite_vertices (
+      sprites,
+      first + i,
+      sine,
+      cosine,
+      out_vertices + (size_t)i * MOSS__SPRITE_VERTEX_COUNT
+    );
+  }
+}
+
+inline static void
+moss__sincos (const float angle, float *const out_sine, float *const out_cosine)
+{
+  /* Reduce to [-pi, pi]. */
+  const float turns = rintf (angle * MOSS__INV_TWO_PI);
+  float       x     = angle - turns * MOSS__TWO_PI_HI;
+  x                 = x - turns * MOSS__TWO_PI_LO;
+
+  /* Fold to [-pi/2, pi/2]: sin (x) = sin (pi - x), cos (x) = -cos (pi - x). */
+  const float x_abs     = fabsf (x);
+  const int   is_folded = x_abs > MOSS__HALF_PI;
+  const float r         = copysignf (is_folded ? MOSS__PI - x_abs : x_abs, x);
+  const float r2        = r * r;
+
+  float s = MOSS__SIN_C11;
+  s       = s * r2 + MOSS__SIN_C9;
+  s       = s * r2 + MOSS__SIN_C7;
+  s       = s * r2 + MOSS__SIN_C5;
+  s       = s * r2 + MOSS__SIN_C3;
+  s       = (s * r2) * r + r;
+
+  float c = MOSS__COS_C12;
+  c       = c * r2 + MOSS__COS_C10;
+  c       = c * r2 + MOSS__COS_C8;
+  c       = c * r2 + MOSS__COS_C6;
+  c       = c * r2 + MOSS__COS_C4;
+  c       = c * r2 + MOSS__COS_C2;
+  c       = c * r2 + 1.0F;
+
+  *out_sine   = s;
+  *out_cosine = is_folded ? -c : c;
+}
@@ -0,0 +1,978 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/video_texture.c
+  @brief Multi-planar YUV video texture implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/video.h"
+
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/log.h"
+#include "src/internal/memory_utils.h"
+#include "src/internal/shaders.h"
+#include "src/internal/video_texture.h"
+#include "src/internal/vk_shader_utils.h"
+#include "src/internal/vram_tracker.h"
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Fills plane layout of the open video.
+  @param texture Video texture.
+  @param info Video information.
+*/
+inline static void
+moss__init_video_planes (Moss__VideoTexture *texture, const MossVideoCreateInfo *info);
+
+/*
+  @brief Creates Ycbcr conversion and immutable sampler for the open video.
+  @param texture Video texture with format set.
+  @param info Video information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_video_conversion (
+  Moss__VideoTexture        *texture,
+  const MossVideoCreateInfo *info
+);
+
+/*
+  @brief Creates multi-planar image and its view.
+  @param texture Video texture with conversion created.
+  @param info Video information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__create_video_image (Moss__VideoTexture *texture, const MossVideoCreateInfo *info);
+
+/*
+  @brief Creates set layout and video pipeline.
+  @param texture Video texture with sampler created.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_video_pipeline (Moss__VideoTexture *texture);
+
+/*
+  @brief Copies plane rows into staging memory.
+  @param texture Video texture.
+  @param video_frame Decoded video frame.
+  @param plane Plane index.
+  @param destination Staging memory of the plane.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__write_video_plane (
+  const Moss__VideoTexture *texture,
+  const MossVideoFrame     *video_frame,
+  uint32_t                  plane,
+  uint8_t                  *destination
+);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__create_video_texture (
+  const Moss__VideoTextureCreateInfo *const info,
+  Moss__VideoTexture *const                 out_texture
+)
+{
+  *out_texture = (Moss__VideoTexture) {
+    .physical_device        = info->physical_device,
+    .device                 = info->device,
+    .is_supported           = info->is_ycbcr_conversion_enabled,
+    .descriptor_cache       = info->descriptor_cache,
+    .render_pass            = info->render_pass,
+    .color_attachment_count = info->color_attachment_count,
+  };
+}
+
+void moss__close_video_texture (Moss__VideoTexture *const texture)
+{
+  if (texture->device == VK_NULL_HANDLE) { return; }
+
+  if (texture->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (texture->device, texture->pipeline, NULL);
+    texture->pipeline = VK_NULL_HANDLE;
+  }
+
+  if (texture->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (texture->device, texture->pipeline_layout, NULL);
+    texture->pipeline_layout = VK_NULL_HANDLE;
+  }
+
+  if (texture->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (texture->device, texture->descriptor_set_layout, NULL);
+    texture->descriptor_set_layout = VK_NULL_HANDLE;
+  }
+
+  if (texture->image_view != VK_NULL_HANDLE)
+  {
+    vkDestroyImageView (texture->device, texture->image_view, NULL);
+    texture->image_view = VK_NULL_HANDLE;
+  }
+
+  if (texture->image != VK_NULL_HANDLE)
+  {
+    vkDestroyImage (texture->device, texture->image, NULL);
+    texture->image = VK_NULL_HANDLE;
+  }
+
+  if (texture->memory != VK_NULL_HANDLE)
+  {
+    moss__untrack_vram_allocation (texture->memory);
+    vkFreeMemory (texture->device, texture->memory, NULL);
+    texture->memory = VK_NULL_HANDLE;
+  }
+
+  if (texture->sampler != VK_NULL_HANDLE)
+  {
+    vkDestroySampler (texture->device, texture->sampler, NULL);
+    texture->sampler = VK_NULL_HANDLE;
+  }
+
+  if (texture->conversion != VK_NULL_HANDLE)
+  {
+    vkDestroySamplerYcbcrConversion (texture->device, texture->conversion, NULL);
+    texture->conversion = VK_NULL_HANDLE;
+  }
+
+  texture->is_open              = false;
+  texture->is_image_initialized = false;
+}
+
+MossResult moss__open_video_texture (
+  Moss__VideoTexture *const        texture,
+  const MossVideoCreateInfo *const info
+)
+{
+  if (!texture->is_supported)
+  {
+    moss__error ("Video textures need sampler Ycbcr conversion support.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (info->width == 0 || info->height == 0)
+  {
+    moss__error ("Video size must not be zero.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  // 4:2:0 multi-planar images must have even extents
+  if (info->width % 2 != 0 || info->height % 2 != 0)
+  {
+    moss__error ("Video size must be even, got %ux%u.\n", info->width, info->height);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__close_video_texture (texture);
+  moss__init_video_planes (texture, info);
+
+  if (moss__create_video_conversion (texture, info) != MOSS_RESULT_SUCCESS ||
+      moss__create_video_image (texture, info) != MOSS_RESULT_SUCCESS ||
+      moss__create_video_pipeline (texture) != MOSS_RESULT_SUCCESS)
+  {
+    moss__close_video_texture (texture);
+    return MOSS_RESULT_ERROR;
+  }
+
+  texture->is_open = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_video_texture_frame (Moss__VideoTextureFrame *const frame)
+{
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->staging_crate);
+
+  *frame = (Moss__VideoTextureFrame) {0};
+}
+
+MossResult moss__write_video_frame (
+  const Moss__VideoTexture *const texture,
+  Moss__VideoTextureFrame *const  frame,
+  const MossVideoFrame *const     video_frame
+)
+{
+  if (!texture->is_open)
+  {
+    moss__error ("Can't upload video frame, no video is open.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Staging crates grow to the largest video opened so far
+  if (frame->staging_crate.size < texture->frame_size)
+  {
+    moss__destroy_video_texture_frame (frame);
+
+    const Moss__CrateCreateInfo staging_info = {
+      .size              = texture->frame_size,
+      .usage             = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+      .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+      .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+      .shared_queue_family_index_count = 0,
+      .shared_queue_family_indices     = NULL,
+      .device                          = texture->device,
+      .physical_device                 = texture->physical_device,
+      .debug_name                      = "video staging crate",
+    };
+
+    if (moss__create_crate (&staging_info, &frame->staging_crate) !=
+        MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to create video staging crate.\n");
+      return MOSS_RESULT_ERROR;
+    }
+
+    void          *mapped_memory;
+    const VkResult result = vkMapMemory (
+      texture->device,
+      frame->staging_crate.memory,
+      0,
+      frame->staging_crate.size,
+      0,
+      &mapped_memory
+    );
+    if (result != VK_SUCCESS)
+    {
+      moss__error ("Failed to map video staging crate. Error code: %d.\n", result);
+      moss__destroy_video_texture_frame (frame);
+      return MOSS_RESULT_ERROR;
+    }
+    frame->staging = mapped_memory;
+  }
+
+  for (uint32_t i = 0; i < texture->plane_count; ++i)
+  {
+    if (moss__write_video_plane (
+          texture,
+          video_frame,
+          i,
+          frame->staging + texture->plane_offsets[ i ]
+        ) != MOSS_RESULT_SUCCESS)
+    {
+      frame->is_upload_pending = false;
+      return MOSS_RESULT_ERROR;
+    }
+  }
+
+  frame->is_upload_pending = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__record_video_upload (
+  Moss__VideoTexture *const      texture,
+  Moss__VideoTextureFrame *const frame,
+  const VkCommandBuffer          command_buffer
+)
+{
+  if (!frame->is_upload_pending) { return; }
+  frame->is_upload_pending = false;
+
+  if (!texture->is_open) { return; }
+
+  static const VkImageAspectFlagBits plane_aspects[ MOSS_MAX_VIDEO_PLANE_COUNT ] = {
+    VK_IMAGE_ASPECT_PLANE_0_BIT,
+    VK_IMAGE_ASPECT_PLANE_1_BIT,
+    VK_IMAGE_ASPECT_PLANE_2_BIT,
+  };
+
+  VkBufferImageCopy regions[ MOSS_MAX_VIDEO_PLANE_COUNT ];
+  for (uint32_t i = 0; i < texture->plane_count; ++i)
+  {
+    regions[ i ] = (VkBufferImageCopy) {
+      .bufferOffset      = texture->plane_offsets[ i ],
+      .bufferRowLength   = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource =
+        {
+                            .aspectMask     = plane_aspects[ i ],
+                            .mipLevel       = 0,
+                            .baseArrayLayer = 0,
+                            .layerCount     = 1,
+                            },
+      .imageOffset = { 0, 0, 0 },
+      .imageExtent =
+        {
+                            .width  = texture->plane_widths[ i ],
+                            .height = texture->plane_heights[ i ],
+                            .depth  = 1,
+                            },
+    };
+  }
+
+  // Earlier frames may still sample the previous video frame
+  VkImageMemoryBarrier barrier = {
+    .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+    .srcAccessMask       = 0,
+    .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+    .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
+    .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .image               = texture->image,
+    .subresourceRange =
+      {
+                           .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                           .baseMipLevel   = 0,
+                           .levelCount     = 1,
+                           .baseArrayLayer = 0,
+                           .layerCount     = 1,
+                           },
+  };
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0,
+    0,
+    NULL,
+    0,
+    NULL,
+    1,
+    &barrier
+  );
+
+  vkCmdCopyBufferToImage (
+    command_buffer,
+    frame->staging_crate.buffer,
+    texture->image,
+    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    texture->plane_count,
+    regions
+  );
+
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+  barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    0,
+    0,
+    NULL,
+    0,
+    NULL,
+    1,
+    &barrier
+  );
+
+  texture->is_image_initialized = true;
+}
+
+void moss__record_video (
+  const Moss__VideoTexture *const    texture,
+  const Moss__RecordVideoInfo *const info
+)
+{
+  if (!texture->is_open || !texture->is_image_initialized || info->view == NULL)
+  {
+    return;
+  }
+
+  const MossVideoView *const view = info->view;
+
+  const Moss__VideoPushConstants push_constants = {
+    .rect = { view->x, view->y, view->width, view->height },
+  };
+
+  // Immutable sampler comes from the set layout
+  const Moss__DescriptorBinding binding = {
+    .binding      = 0,
+    .type         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .sampler      = texture->sampler,
+    .image_view   = texture->image_view,
+    .image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+  };
+
+  vkCmdBindPipeline (
+    info->command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    texture->pipeline
+  );
+
+  if (moss__bind_descriptors (
+        info->descriptor_cache,
+        info->descriptor_cache_frame,
+        info->command_buffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        texture->pipeline_layout,
+        0,
+        texture->descriptor_set_layout,
+        &binding,
+        1
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to bind video, skipping it.\n");
+    return;
+  }
+
+  vkCmdPushConstants (
+    info->command_buffer,
+    texture->pipeline_layout,
+    VK_SHADER_STAGE_VERTEX_BIT,
+    0,
+    sizeof (push_constants),
+    &push_constants
+  );
+
+  const VkViewport viewport = {
+    .x        = 0.0F,
+    .y        = 0.0F,
+    .width    = (float)info->render_extent.width,
+    .height   = (float)info->render_extent.height,
+    .minDepth = 0.0F,
+    .maxDepth = 1.0F,
+  };
+
+  const VkRect2D scissor = {
+    .offset = { 0, 0 },
+    .extent = info->render_extent,
+  };
+
+  vkCmdSetViewport (info->command_buffer, 0, 1, &viewport);
+  vkCmdSetScissor (info->command_buffer, 0, 1, &scissor);
+
+  // A single quad, corners come from vertex index
+  vkCmdDraw (info->command_buffer, 4, 1, 0, 0);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static void moss__init_video_planes (
+  Moss__VideoTexture *const        texture,
+  const MossVideoCreateInfo *const info
+)
+{
+  const uint32_t chroma_width  = info->width / 2;
+  const uint32_t chroma_height = info->height / 2;
+
+  const bool is_nv12 = info->format == MOSS_VIDEO_FORMAT_NV12;
+
+  texture->format      = is_nv12 ? VK_FORMAT_G8_B8R8_2PLANE_420_UNORM
+                                 : VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM;
+  texture->plane_count = is_nv12 ? 2 : 3;
+
+  texture->plane_widths[ 0 ]      = info->width;
+  texture->plane_heights[ 0 ]     = info->height;
+  texture->plane_texel_sizes[ 0 ] = 1;
+
+  // Interleaved CbCr texels of NV12 take 2 bytes
+  for (uint32_t i = 1; i < texture->plane_count; ++i)
+  {
+    texture->plane_widths[ i ]      = chroma_width;
+    texture->plane_heights[ i ]     = chroma_height;
+    texture->plane_texel_sizes[ i ] = is_nv12 ? 2 : 1;
+  }
+
+  VkDeviceSize offset = 0;
+  for (uint32_t i = 0; i < texture->plane_count; ++i)
+  {
+    // Copy offsets must be multiples of the plane's texel size, 4 keeps them safe
+    offset = (offset + 3) & ~(VkDeviceSize)3;
+
+    texture->plane_offsets[ i ] = offset;
+    offset += (VkDeviceSize)texture->plane_widths[ i ] * texture->plane_heights[ i ] *
+              texture->plane_texel_sizes[ i ];
+  }
+
+  texture->frame_size = offset;
+}
+
+inline static MossResult moss__create_video_conversion (
+  Moss__VideoTexture *const        texture,
+  const MossVideoCreateInfo *const info
+)
+{
+  VkFormatProperties format_properties;
+  vkGetPhysicalDeviceFormatProperties (
+    texture->physical_device,
+    texture->format,
+    &format_properties
+  );
+
+  const VkFormatFeatureFlags features = format_properties.optimalTilingFeatures;
+  const VkFormatFeatureFlags required_features =
+    VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+
+  if ((features & required_features) != required_features)
+  {
+    moss__error ("Video format isn't supported by the device.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Devices must support at least one of the chroma sitings
+  const VkChromaLocation chroma_location =
+    (features & VK_FORMAT_FEATURE_MIDPOINT_CHROMA_SAMPLES_BIT) != 0
+      ? VK_CHROMA_LOCATION_MIDPOINT
+      : VK_CHROMA_LOCATION_COSITED_EVEN;
+
+  const VkFilter chroma_filter =
+    (features & VK_FORMAT_FEATURE_SAMPLED_IMAGE_YCBCR_CONVERSION_LINEAR_FILTER_BIT) != 0
+      ? VK_FILTER_LINEAR
+      : VK_FILTER_NEAREST;
+
+  const VkSamplerYcbcrConversionCreateInfo conversion_info = {
+    .sType      = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_CREATE_INFO,
+    .format     = texture->format,
+    .ycbcrModel = info->color_space == MOSS_VIDEO_COLOR_SPACE_BT709
+                  ? VK_SAMPLER_YCBCR_MODEL_CONVERSION_YCBCR_709
+                  : VK_SAMPLER_YCBCR_MODEL_CONVERSION_YCBCR_601,
+    .ycbcrRange = info->is_full_range ? VK_SAMPLER_YCBCR_RANGE_ITU_FULL
+                                      : VK_SAMPLER_YCBCR_RANGE_ITU_NARROW,
+    .components =
+      {
+                    .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    .a = VK_COMPONENT_SWIZZLE_IDENTITY,
+                    },
+    .xChromaOffset               = chroma_location,
+    .yChromaOffset               = chroma_location,
+    .chromaFilter                = chroma_filter,
+    .forceExplicitReconstruction = VK_FALSE,
+  };
+
+  VkResult result = vkCreateSamplerYcbcrConversion (
+    texture->device,
+    &conversion_info,
+    NULL,
+    &texture->conversion
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video Ycbcr conversion. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkSamplerYcbcrConversionInfo sampler_conversion_info = {
+    .sType      = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_INFO,
+    .conversion = texture->conversion,
+  };
+
+  // Sampler filter must match the chroma filter the format supports
+  const VkSamplerCreateInfo sampler_info = {
+    .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+    .pNext                   = &sampler_conversion_info,
+    .magFilter               = chroma_filter,
+    .minFilter               = chroma_filter,
+    .mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+    .addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .anisotropyEnable        = VK_FALSE,
+    .unnormalizedCoordinates = VK_FALSE,
+    .maxLod                  = 0.0F,
+  };
+
+  result = vkCreateSampler (texture->device, &sampler_info, NULL, &texture->sampler);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video sampler. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_video_image (
+  Moss__VideoTexture *const        texture,
+  const MossVideoCreateInfo *const info
+)
+{
+  const VkImageCreateInfo image_info = {
+    .sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format    = texture->format,
+    .extent =
+      {
+               .width  = info->width,
+               .height = info->height,
+               .depth  = 1,
+               },
+    .mipLevels     = 1,
+    .arrayLayers   = 1,
+    .samples       = VK_SAMPLE_COUNT_1_BIT,
+    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+    .usage         = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkResult result = vkCreateImage (texture->device, &image_info, NULL, &texture->image);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video image. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    texture->device,
+    VK_OBJECT_TYPE_IMAGE,
+    texture->image,
+    "video image"
+  );
+
+  VkMemoryRequirements memory_requirements;
+  vkGetImageMemoryRequirements (texture->device, texture->image, &memory_requirements);
+
+  uint32_t memory_type;
+  if (moss__select_suitable_memory_type (
+        texture->physical_device,
+        memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memory_type
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to find suitable memory type for video image.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkMemoryAllocateInfo alloc_info = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .allocationSize  = memory_requirements.size,
+    .memoryTypeIndex = memory_type,
+  };
+
+  result = vkAllocateMemory (texture->device, &alloc_info, NULL, &texture->memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to allocate video image memory. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__track_vram_allocation (
+    texture->physical_device,
+    texture->memory,
+    MOSS_VRAM_CATEGORY_TEXTURES,
+    memory_type,
+    memory_requirements.size,
+    memory_requirements.size
+  );
+
+  vkBindImageMemory (texture->device, texture->image, texture->memory, 0);
+
+  const VkSamplerYcbcrConversionInfo conversion_info = {
+    .sType      = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_INFO,
+    .conversion = texture->conversion,
+  };
+
+  const VkImageViewCreateInfo view_info = {
+    .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .pNext    = &conversion_info,
+    .image    = texture->image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format   = texture->format,
+    .subresourceRange =
+      {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .baseMipLevel   = 0,
+                  .levelCount     = 1,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+                  },
+  };
+
+  result = vkCreateImageView (texture->device, &view_info, NULL, &texture->image_view);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video image view. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__create_video_pipeline (Moss__VideoTexture *const texture)
+{
+  const VkDescriptorSetLayoutBinding binding = {
+    .binding            = 0,
+    .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    .descriptorCount    = 1,
+    .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
+    .pImmutableSamplers = &texture->sampler,
+  };
+
+  if (moss__create_cached_descriptor_set_layout (
+        texture->descriptor_cache,
+        &binding,
+        1,
+        &texture->descriptor_set_layout
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create video descriptor set layout.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__VideoPushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &texture->descriptor_set_layout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  VkResult result = vkCreatePipelineLayout (
+    texture->device,
+    &pipeline_layout_info,
+    NULL,
+    &texture->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video pipeline layout. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        texture->device,
+        MOSS__VIDEO_VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_shader_module_from_file (
+        texture->device,
+        MOSS__VIDEO_FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (texture->device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = {
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+     .module = vert_shader_module,
+     .pName  = "main",
+     },
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .module = frag_shader_module,
+     .pName  = "main",
+     },
+  };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+  };
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_NONE,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  // Second attachment receives pick IDs when picking is enabled
+  const VkPipelineColorBlendAttachmentState color_blend_attachments[ 2 ] = {
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                       VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+     .blendEnable = VK_FALSE,
+     },
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT,
+     .blendEnable    = VK_FALSE,
+     },
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = texture->color_attachment_count,
+    .pAttachments    = color_blend_attachments,
+  };
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = texture->pipeline_layout,
+    .renderPass          = texture->render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  result = vkCreateGraphicsPipelines (
+    texture->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &texture->pipeline
+  );
+
+  vkDestroyShaderModule (texture->device, frag_shader_module, NULL);
+  vkDestroyShaderModule (texture->device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create video pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    texture->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    texture->pipeline,
+    "video pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult moss__write_video_plane (
+  const Moss__VideoTexture *const texture,
+  const MossVideoFrame *const     video_frame,
+  const uint32_t                  plane,
+  uint8_t *const                  destination
+)
+{
+  const size_t row_size = (size_t)texture->plane_widths[ plane ] *
+                          texture->plane_texel_sizes[ plane ];
+  const uint32_t row_count = texture->plane_heights[ plane ];
+  const size_t   stride    = video_frame->strides[ plane ] == 0
+                             ? row_size
+                             : video_frame->strides[ plane ];
+
+  const uint8_t *const source = video_frame->planes[ plane ];
+  if (source != NULL)
+  {
+    if (stride == row_size)
+    {
+      memcpy (destination, source, row_size * row_count);
+      return MOSS_RESULT_SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < row_count; ++i)
+    {
+      memcpy (destination + row_size * i, source + stride * i, row_size);
+    }
+
+    return MOSS_RESULT_SUCCESS;
+  }
+
+  // Rows are read straight into upload memory, one read per plane when packed
+  const uint32_t read_count = stride == row_size ? 1 : row_count;
+  const size_t   read_size  = stride == row_size ? row_size * row_count : row_size;
+
+  for (uint32_t i = 0; i < read_count; ++i)
+  {
+    size_t bytes_read = 0;
+    while (bytes_read < read_size)
+    {
+      const ssize_t result = pread (
+        video_frame->file_descriptor,
+        destination + read_size * i + bytes_read,
+        read_size - bytes_read,
+        (off_t)(video_frame->offsets[ plane ] + stride * i + bytes_read)
+      );
+      if (result <= 0)
+      {
+        moss__error ("Failed to read video plane %u.\n", plane);
+        return MOSS_RESULT_ERROR;
+      }
+
+      bytes_read += (size_t)result;
+    }
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
@@ -0,0 +1,1441 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/virtual_texture.c
+  @brief Software virtual texturing implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/result.h"
+#include "moss/virtual_texture.h"
+
+#include "src/internal/async_io.h"
+#include "src/internal/crate.h"
+#include "src/internal/debug_utils.h"
+#include "src/internal/descriptor_cache.h"
+#include "src/internal/log.h"
+#include "src/internal/memory_utils.h"
+#include "src/internal/shaders.h"
+#include "src/internal/virtual_texture.h"
+#include "src/internal/vk_shader_utils.h"
+#include "src/internal/vram_tracker.h"
+
+/* Bindings of the virtual texture set. */
+#define MOSS__PAGE_TABLE_BINDING (uint32_t)(0)
+#define MOSS__ATLAS_BINDING      (uint32_t)(1)
+#define MOSS__FEEDBACK_BINDING   (uint32_t)(2)
+
+/* Size of the atlas per axis in texels. */
+#define MOSS__ATLAS_SIZE \
+  (uint32_t)(MOSS__VIRTUAL_TEXTURE_ATLAS_PAGES_PER_ROW * MOSS_VIRTUAL_TEXTURE_PAGE_SIZE)
+
+/* Size of the level layouts at the start of the page table crate. */
+#define MOSS__PAGE_TABLE_HEADER_SIZE \
+  (VkDeviceSize)(sizeof (Moss__VirtualTextureLevel) * \
+                 MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT)
+
+/* Tile page of a tile being read from the file. */
+#define MOSS__TILE_PAGE_LOADING UINT16_MAX
+
+/* Last use of pages that are never evicted. */
+#define MOSS__PAGE_PINNED UINT32_MAX
+
+/* Marks atlas pages without a tile. */
+#define MOSS__PAGE_FREE UINT32_MAX
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Creates virtual texture set layout and pipeline.
+  @param texture Virtual texture to create the pipeline for.
+  @param info Creation information.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult moss__create_virtual_texture_pipeline (
+  Moss__VirtualTexture                 *texture,
+  const Moss__VirtualTextureCreateInfo *info
+);
+
+/*
+  @brief Creates page atlas, its view and sampler.
+  @param texture Virtual texture.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__create_virtual_texture_atlas (Moss__VirtualTexture *texture);
+
+/*
+  @brief Reads and validates header of the file, fills level layouts.
+  @param texture Virtual texture with the file descriptor set.
+  @return MOSS_RESULT_SUCCESS on success, otherwise MOSS_RESULT_ERROR.
+*/
+inline static MossResult
+moss__read_virtual_texture_header (Moss__VirtualTexture *texture);
+
+/*
+  @brief Finds level of a tile.
+  @param texture Virtual texture.
+  @param tile Tile index.
+  @return Level index.
+*/
+inline static uint32_t
+moss__get_tile_level (const Moss__VirtualTexture *texture, uint32_t tile);
+
+/*
+  @brief Marks tile and its ancestors as requested, starts loading the coarsest
+         missing one.
+  @param texture Virtual texture.
+  @param async_io Reader tiles are streamed with.
+  @param tile Tile index.
+*/
+inline static void moss__request_virtual_texture_tile (
+  Moss__VirtualTexture *texture,
+  Moss__AsyncIo        *async_io,
+  uint32_t              tile
+);
+
+/*
+  @brief Starts reading tile into a free read slot.
+  @param texture Virtual texture.
+  @param async_io Reader tiles are streamed with.
+  @param tile Tile index.
+  @return Returns true if the read was submitted, false otherwise.
+*/
+inline static bool moss__load_virtual_texture_tile (
+  Moss__VirtualTexture *texture,
+  Moss__AsyncIo        *async_io,
+  uint32_t              tile
+);
+
+/*
+  @brief Async read callback of tile read slots.
+  @param user_data Read slot.
+  @param result Read result.
+  @param bytes_read Number of bytes read.
+*/
+static void moss__virtual_texture_load_callback (
+  void      *user_data,
+  MossResult result,
+  size_t     bytes_read
+);
+
+/*
+  @brief Finds atlas page for a new tile, evicting the least recently used one.
+  @param texture Virtual texture.
+  @param out_page Output page index.
+  @return Returns true if a page is available, false if all pages are in use.
+*/
+inline static bool
+moss__acquire_virtual_texture_page (Moss__VirtualTexture *texture, uint32_t *out_page);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+MossResult moss__create_virtual_texture (
+  const Moss__VirtualTextureCreateInfo *const info,
+  Moss__VirtualTexture *const                 out_texture
+)
+{
+  *out_texture                                 = (Moss__VirtualTexture) {0};
+  out_texture->physical_device                 = info->physical_device;
+  out_texture->device                          = info->device;
+  out_texture->sharing_mode                    = info->sharing_mode;
+  out_texture->shared_queue_family_index_count = info->shared_queue_family_index_count;
+  out_texture->file_descriptor                 = -1;
+
+  for (uint32_t i = 0; i < info->shared_queue_family_index_count; ++i)
+  {
+    out_texture->shared_queue_family_indices[ i ] =
+      info->shared_queue_family_indices[ i ];
+  }
+
+  // Feedback is written from the fragment shader, nothing works without it
+  if (!info->is_fragment_store_enabled) { return MOSS_RESULT_SUCCESS; }
+
+  if (moss__create_virtual_texture_pipeline (out_texture, info) != MOSS_RESULT_SUCCESS ||
+      moss__create_virtual_texture_atlas (out_texture) != MOSS_RESULT_SUCCESS)
+  {
+    moss__destroy_virtual_texture (out_texture);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const Moss__CrateCreateInfo staging_info = {
+    .size = (VkDeviceSize)MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE *
+            MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT,
+    .usage             = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = info->device,
+    .physical_device                 = info->physical_device,
+    .debug_name                      = "virtual texture staging crate",
+  };
+
+  if (moss__create_crate (&staging_info, &out_texture->staging_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture staging crate.\n");
+    moss__destroy_virtual_texture (out_texture);
+    return MOSS_RESULT_ERROR;
+  }
+
+  void          *mapped_memory;
+  const VkResult result = vkMapMemory (
+    info->device,
+    out_texture->staging_crate.memory,
+    0,
+    out_texture->staging_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to map virtual texture staging crate. Error code: %d.\n",
+      result
+    );
+    moss__destroy_virtual_texture (out_texture);
+    return MOSS_RESULT_ERROR;
+  }
+  out_texture->staging = mapped_memory;
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT; ++i)
+  {
+    out_texture->loads[ i ] = (Moss__VirtualTextureLoad) {
+      .owner = out_texture,
+      .state = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE,
+    };
+  }
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT; ++i)
+  {
+    out_texture->atlas_tiles[ i ] = MOSS__PAGE_FREE;
+  }
+
+  out_texture->is_supported = true;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_virtual_texture (Moss__VirtualTexture *const texture)
+{
+  if (texture->device == VK_NULL_HANDLE) { return; }
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&texture->staging_crate);
+
+  if (texture->sampler != VK_NULL_HANDLE)
+  {
+    vkDestroySampler (texture->device, texture->sampler, NULL);
+  }
+
+  if (texture->atlas_image_view != VK_NULL_HANDLE)
+  {
+    vkDestroyImageView (texture->device, texture->atlas_image_view, NULL);
+  }
+
+  if (texture->atlas_image != VK_NULL_HANDLE)
+  {
+    vkDestroyImage (texture->device, texture->atlas_image, NULL);
+  }
+
+  if (texture->atlas_memory != VK_NULL_HANDLE)
+  {
+    moss__untrack_vram_allocation (texture->atlas_memory);
+    vkFreeMemory (texture->device, texture->atlas_memory, NULL);
+  }
+
+  if (texture->pipeline != VK_NULL_HANDLE)
+  {
+    vkDestroyPipeline (texture->device, texture->pipeline, NULL);
+  }
+
+  if (texture->pipeline_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyPipelineLayout (texture->device, texture->pipeline_layout, NULL);
+  }
+
+  if (texture->descriptor_set_layout != VK_NULL_HANDLE)
+  {
+    vkDestroyDescriptorSetLayout (texture->device, texture->descriptor_set_layout, NULL);
+  }
+
+  *texture = (Moss__VirtualTexture) {0};
+}
+
+MossResult moss__create_virtual_texture_frame (
+  const Moss__VirtualTexture *const texture,
+  Moss__VirtualTextureFrame *const  out_frame
+)
+{
+  *out_frame = (Moss__VirtualTextureFrame) {0};
+
+  if (!texture->is_supported) { return MOSS_RESULT_SUCCESS; }
+
+  const Moss__CrateCreateInfo feedback_info = {
+    .size = sizeof (uint32_t) * MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE *
+            MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE,
+    .usage             = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    .sharing_mode                    = VK_SHARING_MODE_EXCLUSIVE,
+    .shared_queue_family_index_count = 0,
+    .shared_queue_family_indices     = NULL,
+    .device                          = texture->device,
+    .physical_device                 = texture->physical_device,
+    .debug_name                      = "virtual texture feedback crate",
+  };
+
+  if (moss__create_crate (&feedback_info, &out_frame->feedback_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture feedback crate.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  void          *mapped_memory;
+  const VkResult result = vkMapMemory (
+    texture->device,
+    out_frame->feedback_crate.memory,
+    0,
+    out_frame->feedback_crate.size,
+    0,
+    &mapped_memory
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to map virtual texture feedback crate. Error code: %d.\n",
+      result
+    );
+    moss__destroy_virtual_texture_frame (texture, out_frame);
+    return MOSS_RESULT_ERROR;
+  }
+  out_frame->feedback = mapped_memory;
+
+  // 0 means the feedback texel requests nothing
+  memset (out_frame->feedback, 0, (size_t)out_frame->feedback_crate.size);
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__destroy_virtual_texture_frame (
+  const Moss__VirtualTexture *const texture,
+  Moss__VirtualTextureFrame *const  frame
+)
+{
+  (void)texture;
+
+  // Freeing crate memory unmaps it as well
+  moss__destroy_crate (&frame->feedback_crate);
+
+  *frame = (Moss__VirtualTextureFrame) {0};
+}
+
+MossResult moss__open_virtual_texture (
+  Moss__VirtualTexture *const texture,
+  const char *const           path,
+  Moss__AsyncIo *const        async_io,
+  const VkQueue               transfer_queue,
+  const VkCommandPool         command_pool
+)
+{
+  if (!texture->is_supported)
+  {
+    moss__error ("Virtual textures need fragment shader stores.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__close_virtual_texture (texture, async_io);
+
+  texture->file_descriptor = open (path, O_RDONLY);
+  if (texture->file_descriptor < 0)
+  {
+    moss__error ("Failed to open virtual texture file \"%s\".\n", path);
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__read_virtual_texture_header (texture) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Virtual texture file \"%s\" is malformed.\n", path);
+    moss__close_virtual_texture (texture, async_io);
+    return MOSS_RESULT_ERROR;
+  }
+
+  texture->page_table          = calloc (texture->tile_count, sizeof (uint32_t));
+  texture->tile_pages          = calloc (texture->tile_count, sizeof (uint16_t));
+  texture->tile_request_frames = calloc (texture->tile_count, sizeof (uint32_t));
+  if (texture->page_table == NULL || texture->tile_pages == NULL ||
+      texture->tile_request_frames == NULL)
+  {
+    moss__error ("Failed to allocate memory for virtual texture tiles.\n");
+    moss__close_virtual_texture (texture, async_io);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkDeviceSize page_table_size =
+    MOSS__PAGE_TABLE_HEADER_SIZE + sizeof (uint32_t) * texture->tile_count;
+
+  const Moss__CrateCreateInfo page_table_info = {
+    .size  = page_table_size,
+    .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    .memory_properties               = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .sharing_mode                    = texture->sharing_mode,
+    .shared_queue_family_index_count = texture->shared_queue_family_index_count,
+    .shared_queue_family_indices     = texture->shared_queue_family_indices,
+    .device                          = texture->device,
+    .physical_device                 = texture->physical_device,
+    .debug_name                      = "virtual texture page table crate",
+  };
+
+  if (moss__create_crate (&page_table_info, &texture->page_table_crate) !=
+      MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture page table crate.\n");
+    moss__close_virtual_texture (texture, async_io);
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Level layouts followed by entries of tiles, none of which is resident yet
+  uint8_t *const initial_page_table = calloc (1, (size_t)page_table_size);
+  if (initial_page_table == NULL)
+  {
+    moss__error ("Failed to allocate memory for virtual texture page table.\n");
+    moss__close_virtual_texture (texture, async_io);
+    return MOSS_RESULT_ERROR;
+  }
+  memcpy (initial_page_table, texture->levels, sizeof (texture->levels));
+
+  const Moss__FillCrateInfo fill_info = {
+    .destination_crate = &texture->page_table_crate,
+    .source_memory     = initial_page_table,
+    .size              = page_table_size,
+    .transfer_queue    = transfer_queue,
+    .command_pool      = command_pool,
+  };
+
+  const MossResult fill_result = moss__fill_crate (&fill_info);
+  free (initial_page_table);
+
+  if (fill_result != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to upload virtual texture page table.\n");
+    moss__close_virtual_texture (texture, async_io);
+    return MOSS_RESULT_ERROR;
+  }
+
+  texture->is_open = true;
+
+  // Request frames start zeroed, a new frame number keeps them from deduping
+  ++texture->frame_number;
+
+  // Coarsest level is always resident, so the shader always has a fallback
+  const Moss__VirtualTextureLevel *const root =
+    &texture->levels[ texture->header.level_count - 1 ];
+  for (uint32_t i = 0; i < root->tile_count_x * root->tile_count_y; ++i)
+  {
+    moss__request_virtual_texture_tile (texture, async_io, root->first_tile + i);
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+void moss__close_virtual_texture (
+  Moss__VirtualTexture *const texture,
+  Moss__AsyncIo *const        async_io
+)
+{
+  if (!texture->is_supported) { return; }
+
+  // Read callbacks touch tile state, so they must be over before it's freed
+  moss__wait_async_io_idle (async_io);
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT; ++i)
+  {
+    texture->loads[ i ].state = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE;
+  }
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT; ++i)
+  {
+    texture->atlas_tiles[ i ]     = MOSS__PAGE_FREE;
+    texture->atlas_last_used[ i ] = 0;
+  }
+
+  moss__destroy_crate (&texture->page_table_crate);
+
+  free (texture->tile_request_frames);
+  free (texture->tile_pages);
+  free (texture->page_table);
+  texture->tile_request_frames = NULL;
+  texture->tile_pages          = NULL;
+  texture->page_table          = NULL;
+
+  if (texture->file_descriptor >= 0) { close (texture->file_descriptor); }
+  texture->file_descriptor = -1;
+
+  texture->is_open     = false;
+  texture->is_refining = false;
+  texture->tile_count  = 0;
+}
+
+void moss__begin_virtual_texture_frame (
+  Moss__VirtualTexture *const      texture,
+  Moss__VirtualTextureFrame *const frame,
+  Moss__AsyncIo *const             async_io
+)
+{
+  if (!texture->is_supported) { return; }
+
+  ++texture->frame_number;
+
+  // Copies out of these slots are finished once the frame's fence is signaled
+  for (uint32_t i = 0; i < frame->uploaded_load_count; ++i)
+  {
+    texture->loads[ frame->uploaded_loads[ i ] ].state =
+      MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE;
+  }
+  frame->uploaded_load_count = 0;
+
+  const uint32_t feedback_count = frame->feedback_width * frame->feedback_height;
+  frame->feedback_width         = 0;
+  frame->feedback_height        = 0;
+  texture->is_refining          = false;
+
+  for (uint32_t i = 0; i < feedback_count; ++i)
+  {
+    const uint32_t request = frame->feedback[ i ];
+    if (request == 0) { continue; }
+
+    frame->feedback[ i ] = 0;
+
+    if (texture->is_open && request - 1 < texture->tile_count)
+    {
+      moss__request_virtual_texture_tile (texture, async_io, request - 1);
+    }
+  }
+}
+
+bool moss__is_virtual_texture_streaming (const Moss__VirtualTexture *const texture)
+{
+  if (texture->is_refining) { return true; }
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT; ++i)
+  {
+    if (texture->loads[ i ].state != MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void moss__record_virtual_texture_uploads (
+  Moss__VirtualTexture *const      texture,
+  Moss__VirtualTextureFrame *const frame,
+  const VkCommandBuffer            command_buffer
+)
+{
+  if (!texture->is_open) { return; }
+
+  VkBufferImageCopy regions[ MOSS__VIRTUAL_TEXTURE_MAX_UPLOAD_COUNT ];
+  uint32_t          changed_tiles[ MOSS__VIRTUAL_TEXTURE_MAX_UPLOAD_COUNT * 2 ];
+  uint32_t          changed_tile_count = 0;
+
+  const uint32_t max_upload_count = MOSS__VIRTUAL_TEXTURE_MAX_UPLOAD_COUNT;
+  const uint32_t pages_per_row    = MOSS__VIRTUAL_TEXTURE_ATLAS_PAGES_PER_ROW;
+  const uint32_t page_size        = MOSS_VIRTUAL_TEXTURE_PAGE_SIZE;
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT &&
+                       frame->uploaded_load_count < max_upload_count;
+       ++i)
+  {
+    Moss__VirtualTextureLoad *const load = &texture->loads[ i ];
+    if (load->state != MOSS__VIRTUAL_TEXTURE_LOAD_STATE_LOADED) { continue; }
+
+    uint32_t page;
+    if (!moss__acquire_virtual_texture_page (texture, &page)) { break; }
+
+    const uint32_t evicted_tile = texture->atlas_tiles[ page ];
+    if (evicted_tile != MOSS__PAGE_FREE)
+    {
+      texture->tile_pages[ evicted_tile ]      = 0;
+      texture->page_table[ evicted_tile ]      = 0;
+      changed_tiles[ changed_tile_count++ ] = evicted_tile;
+    }
+
+    const uint32_t level = moss__get_tile_level (texture, load->tile);
+    texture->atlas_tiles[ page ]     = load->tile;
+    texture->atlas_last_used[ page ] = level == texture->header.level_count - 1
+                                       ? MOSS__PAGE_PINNED
+                                       : texture->frame_number;
+    texture->tile_pages[ load->tile ]   = (uint16_t)(page + 1);
+    texture->page_table[ load->tile ]   = page + 1;
+    changed_tiles[ changed_tile_count++ ] = load->tile;
+
+    regions[ frame->uploaded_load_count ] = (VkBufferImageCopy) {
+      .bufferOffset      = (VkDeviceSize)MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE * i,
+      .bufferRowLength   = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource =
+        {
+                            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .mipLevel       = 0,
+                            .baseArrayLayer = 0,
+                            .layerCount     = 1,
+                            },
+      .imageOffset =
+        {
+                            .x = (int32_t)((page % pages_per_row) * page_size),
+                            .y = (int32_t)((page / pages_per_row) * page_size),
+                            .z = 0,
+                            },
+      .imageExtent =
+        {
+                            .width  = page_size,
+                            .height = page_size,
+                            .depth  = 1,
+                            },
+    };
+
+    load->state = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_UPLOADING;
+    frame->uploaded_loads[ frame->uploaded_load_count++ ] = i;
+  }
+
+  if (frame->uploaded_load_count == 0) { return; }
+
+  // Earlier frames may still sample pages that are about to be overwritten
+  VkImageMemoryBarrier atlas_barrier = {
+    .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+    .srcAccessMask       = 0,
+    .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+    .oldLayout           = texture->is_atlas_initialized
+                           ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                           : VK_IMAGE_LAYOUT_UNDEFINED,
+    .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .image               = texture->atlas_image,
+    .subresourceRange =
+      {
+                           .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                           .baseMipLevel   = 0,
+                           .levelCount     = 1,
+                           .baseArrayLayer = 0,
+                           .layerCount     = 1,
+                           },
+  };
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0,
+    0,
+    NULL,
+    0,
+    NULL,
+    1,
+    &atlas_barrier
+  );
+
+  vkCmdCopyBufferToImage (
+    command_buffer,
+    texture->staging_crate.buffer,
+    texture->atlas_image,
+    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    frame->uploaded_load_count,
+    regions
+  );
+
+  atlas_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  atlas_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+  atlas_barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  atlas_barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    0,
+    0,
+    NULL,
+    0,
+    NULL,
+    1,
+    &atlas_barrier
+  );
+
+  texture->is_atlas_initialized = true;
+
+  // Changed entries usually sit close together, so a single update covers them
+  uint32_t first_changed = changed_tiles[ 0 ];
+  uint32_t last_changed  = changed_tiles[ 0 ];
+  for (uint32_t i = 1; i < changed_tile_count; ++i)
+  {
+    if (changed_tiles[ i ] < first_changed) { first_changed = changed_tiles[ i ]; }
+    if (changed_tiles[ i ] > last_changed) { last_changed = changed_tiles[ i ]; }
+  }
+
+  const VkDeviceSize changed_size =
+    sizeof (uint32_t) * (VkDeviceSize)(last_changed - first_changed + 1);
+  const bool     is_single_update = changed_size <= MOSS__MAX_CRATE_UPDATE_SIZE;
+  const uint32_t update_count     = is_single_update ? 1 : changed_tile_count;
+
+  for (uint32_t i = 0; i < update_count; ++i)
+  {
+    const uint32_t first_tile = is_single_update ? first_changed : changed_tiles[ i ];
+
+    const Moss__UpdateCrateInfo update_info = {
+      .destination_crate = &texture->page_table_crate,
+      .offset         = MOSS__PAGE_TABLE_HEADER_SIZE + sizeof (uint32_t) * first_tile,
+      .source_memory  = &texture->page_table[ first_tile ],
+      .size           = is_single_update ? changed_size : sizeof (uint32_t),
+      .command_buffer = command_buffer,
+      .stage_mask     = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+      .access_mask    = VK_ACCESS_SHADER_READ_BIT,
+    };
+
+    if (moss__record_crate_update (&update_info) != MOSS_RESULT_SUCCESS)
+    {
+      moss__error ("Failed to record virtual texture page table update.\n");
+    }
+  }
+}
+
+void moss__record_virtual_texture (
+  const Moss__VirtualTexture *const           texture,
+  Moss__VirtualTextureFrame *const            frame,
+  const Moss__RecordVirtualTextureInfo *const info
+)
+{
+  frame->feedback_width  = 0;
+  frame->feedback_height = 0;
+
+  if (!texture->is_open || !texture->is_atlas_initialized || info->view == NULL)
+  {
+    return;
+  }
+
+  const uint32_t stride          = MOSS__VIRTUAL_TEXTURE_FEEDBACK_STRIDE;
+  uint32_t       feedback_width  = (info->render_extent.width + stride - 1) / stride;
+  uint32_t       feedback_height = (info->render_extent.height + stride - 1) / stride;
+
+  if (feedback_width > MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE)
+  {
+    feedback_width = MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE;
+  }
+  if (feedback_height > MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE)
+  {
+    feedback_height = MOSS__VIRTUAL_TEXTURE_MAX_FEEDBACK_SIZE;
+  }
+
+  const MossVirtualTextureView *const view = info->view;
+
+  const Moss__VirtualTexturePushConstants push_constants = {
+    .rect            = { view->x, view->y, view->width, view->height },
+    .uv_rect         = { view->uv_left, view->uv_top, view->uv_right, view->uv_bottom },
+    .image_size      = { texture->header.width, texture->header.height },
+    .level_count     = texture->header.level_count,
+    .feedback_width  = feedback_width,
+    .feedback_height = feedback_height,
+    .feedback_phase  = texture->frame_number % (stride * stride),
+  };
+
+  const Moss__DescriptorBinding bindings[] = {
+    {
+     .binding = MOSS__PAGE_TABLE_BINDING,
+     .type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .buffer  = texture->page_table_crate.buffer,
+     .offset  = 0,
+     .range   = VK_WHOLE_SIZE,
+     },
+    {
+     .binding      = MOSS__ATLAS_BINDING,
+     .type         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+     .sampler      = texture->sampler,
+     .image_view   = texture->atlas_image_view,
+     .image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+     },
+    {
+     .binding = MOSS__FEEDBACK_BINDING,
+     .type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .buffer  = frame->feedback_crate.buffer,
+     .offset  = 0,
+     .range   = VK_WHOLE_SIZE,
+     },
+  };
+
+  vkCmdBindPipeline (
+    info->command_buffer,
+    VK_PIPELINE_BIND_POINT_GRAPHICS,
+    texture->pipeline
+  );
+
+  if (moss__bind_descriptors (
+        info->descriptor_cache,
+        info->descriptor_cache_frame,
+        info->command_buffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        texture->pipeline_layout,
+        0,
+        texture->descriptor_set_layout,
+        bindings,
+        sizeof (bindings) / sizeof (bindings[ 0 ])
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to bind virtual texture, skipping it.\n");
+    return;
+  }
+
+  vkCmdPushConstants (
+    info->command_buffer,
+    texture->pipeline_layout,
+    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+    0,
+    sizeof (push_constants),
+    &push_constants
+  );
+
+  const VkViewport viewport = {
+    .x        = 0.0F,
+    .y        = 0.0F,
+    .width    = (float)info->render_extent.width,
+    .height   = (float)info->render_extent.height,
+    .minDepth = 0.0F,
+    .maxDepth = 1.0F,
+  };
+
+  const VkRect2D scissor = {
+    .offset = { 0, 0 },
+    .extent = info->render_extent,
+  };
+
+  vkCmdSetViewport (info->command_buffer, 0, 1, &viewport);
+  vkCmdSetScissor (info->command_buffer, 0, 1, &scissor);
+
+  // A single quad, corners come from vertex index
+  vkCmdDraw (info->command_buffer, 4, 1, 0, 0);
+
+  frame->feedback_width  = feedback_width;
+  frame->feedback_height = feedback_height;
+}
+
+void moss__record_virtual_texture_feedback_barrier (
+  const Moss__VirtualTextureFrame *const frame,
+  const VkCommandBuffer                  command_buffer
+)
+{
+  if (frame->feedback_width == 0) { return; }
+
+  const VkBufferMemoryBarrier barrier = {
+    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+    .srcAccessMask       = VK_ACCESS_SHADER_WRITE_BIT,
+    .dstAccessMask       = VK_ACCESS_HOST_READ_BIT,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .buffer              = frame->feedback_crate.buffer,
+    .offset              = 0,
+    .size                = VK_WHOLE_SIZE,
+  };
+
+  vkCmdPipelineBarrier (
+    command_buffer,
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    VK_PIPELINE_STAGE_HOST_BIT,
+    0,
+    0,
+    NULL,
+    1,
+    &barrier,
+    0,
+    NULL
+  );
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static MossResult moss__create_virtual_texture_pipeline (
+  Moss__VirtualTexture *const                 texture,
+  const Moss__VirtualTextureCreateInfo *const info
+)
+{
+  const VkDescriptorSetLayoutBinding bindings[] = {
+    {
+     .binding         = MOSS__PAGE_TABLE_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT,
+     },
+    {
+     .binding         = MOSS__ATLAS_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT,
+     },
+    {
+     .binding         = MOSS__FEEDBACK_BINDING,
+     .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+     .descriptorCount = 1,
+     .stageFlags      = VK_SHADER_STAGE_FRAGMENT_BIT,
+     },
+  };
+
+  if (moss__create_cached_descriptor_set_layout (
+        info->descriptor_cache,
+        bindings,
+        sizeof (bindings) / sizeof (bindings[ 0 ]),
+        &texture->descriptor_set_layout
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture descriptor set layout.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPushConstantRange push_constant_range = {
+    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+    .offset     = 0,
+    .size       = sizeof (Moss__VirtualTexturePushConstants),
+  };
+
+  const VkPipelineLayoutCreateInfo pipeline_layout_info = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &texture->descriptor_set_layout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &push_constant_range,
+  };
+
+  VkResult result = vkCreatePipelineLayout (
+    texture->device,
+    &pipeline_layout_info,
+    NULL,
+    &texture->pipeline_layout
+  );
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create virtual texture pipeline layout. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  VkShaderModule vert_shader_module;
+  VkShaderModule frag_shader_module;
+
+  if (moss__create_shader_module_from_file (
+        texture->device,
+        MOSS__VIRTUAL_TEXTURE_VERT_SHADER_PATH,
+        &vert_shader_module
+      ) != VK_SUCCESS)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  if (moss__create_shader_module_from_file (
+        texture->device,
+        MOSS__VIRTUAL_TEXTURE_FRAG_SHADER_PATH,
+        &frag_shader_module
+      ) != VK_SUCCESS)
+  {
+    vkDestroyShaderModule (texture->device, vert_shader_module, NULL);
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkPipelineShaderStageCreateInfo shader_stages[] = {
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_VERTEX_BIT,
+     .module = vert_shader_module,
+     .pName  = "main",
+     },
+    {
+     .sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+     .stage  = VK_SHADER_STAGE_FRAGMENT_BIT,
+     .module = frag_shader_module,
+     .pName  = "main",
+     },
+  };
+
+  const VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+  };
+
+  const VkPipelineInputAssemblyStateCreateInfo input_assembly = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+    .primitiveRestartEnable = VK_FALSE,
+  };
+
+  const VkPipelineViewportStateCreateInfo viewport_state = {
+    .sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+    .viewportCount = 1,
+    .pViewports    = NULL,  // Dynamic viewport
+    .scissorCount  = 1,
+    .pScissors     = NULL,  // Dynamic scissor
+  };
+
+  const VkPipelineRasterizationStateCreateInfo rasterizer = {
+    .sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+    .depthClampEnable        = VK_FALSE,
+    .rasterizerDiscardEnable = VK_FALSE,
+    .polygonMode             = VK_POLYGON_MODE_FILL,
+    .lineWidth               = 1.0F,
+    .cullMode                = VK_CULL_MODE_NONE,
+    .frontFace               = VK_FRONT_FACE_CLOCKWISE,
+    .depthBiasEnable         = VK_FALSE,
+  };
+
+  const VkPipelineMultisampleStateCreateInfo multisampling = {
+    .sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+    .sampleShadingEnable  = VK_FALSE,
+    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+  };
+
+  // Second attachment receives pick IDs when picking is enabled
+  const VkPipelineColorBlendAttachmentState color_blend_attachments[ 2 ] = {
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                       VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+     .blendEnable = VK_FALSE,
+     },
+    {
+     .colorWriteMask = VK_COLOR_COMPONENT_R_BIT,
+     .blendEnable    = VK_FALSE,
+     },
+  };
+
+  const VkPipelineColorBlendStateCreateInfo color_blending = {
+    .sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+    .logicOpEnable   = VK_FALSE,
+    .attachmentCount = info->color_attachment_count,
+    .pAttachments    = color_blend_attachments,
+  };
+
+  const VkDynamicState dynamic_states[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR,
+  };
+
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
+    .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+    .dynamicStateCount = sizeof (dynamic_states) / sizeof (dynamic_states[ 0 ]),
+    .pDynamicStates    = dynamic_states,
+  };
+
+  const VkGraphicsPipelineCreateInfo pipeline_info = {
+    .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    .stageCount          = 2,
+    .pStages             = shader_stages,
+    .pVertexInputState   = &vertex_input_info,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState      = &viewport_state,
+    .pRasterizationState = &rasterizer,
+    .pMultisampleState   = &multisampling,
+    .pColorBlendState    = &color_blending,
+    .pDynamicState       = &dynamic_state,
+    .layout              = texture->pipeline_layout,
+    .renderPass          = info->render_pass,
+    .subpass             = 0,
+    .basePipelineHandle  = VK_NULL_HANDLE,
+    .basePipelineIndex   = -1,
+  };
+
+  result = vkCreateGraphicsPipelines (
+    texture->device,
+    VK_NULL_HANDLE,
+    1,
+    &pipeline_info,
+    NULL,
+    &texture->pipeline
+  );
+
+  vkDestroyShaderModule (texture->device, frag_shader_module, NULL);
+  vkDestroyShaderModule (texture->device, vert_shader_module, NULL);
+
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture pipeline. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    texture->device,
+    VK_OBJECT_TYPE_PIPELINE,
+    texture->pipeline,
+    "virtual texture pipeline"
+  );
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult
+moss__create_virtual_texture_atlas (Moss__VirtualTexture *const texture)
+{
+  const VkImageCreateInfo image_info = {
+    .sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+    .imageType = VK_IMAGE_TYPE_2D,
+    .format    = VK_FORMAT_R8G8B8A8_UNORM,
+    .extent =
+      {
+               .width  = MOSS__ATLAS_SIZE,
+               .height = MOSS__ATLAS_SIZE,
+               .depth  = 1,
+               },
+    .mipLevels     = 1,
+    .arrayLayers   = 1,
+    .samples       = VK_SAMPLE_COUNT_1_BIT,
+    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+    .usage         = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+
+  VkResult result =
+    vkCreateImage (texture->device, &image_info, NULL, &texture->atlas_image);
+  if (result != VK_SUCCESS)
+  {
+    moss__error ("Failed to create virtual texture atlas. Error code: %d.\n", result);
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__set_debug_name (
+    texture->device,
+    VK_OBJECT_TYPE_IMAGE,
+    texture->atlas_image,
+    "virtual texture atlas"
+  );
+
+  VkMemoryRequirements memory_requirements;
+  vkGetImageMemoryRequirements (
+    texture->device,
+    texture->atlas_image,
+    &memory_requirements
+  );
+
+  uint32_t memory_type;
+  if (moss__select_suitable_memory_type (
+        texture->physical_device,
+        memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memory_type
+      ) != MOSS_RESULT_SUCCESS)
+  {
+    moss__error ("Failed to find suitable memory type for virtual texture atlas.\n");
+    return MOSS_RESULT_ERROR;
+  }
+
+  const VkMemoryAllocateInfo alloc_info = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .allocationSize  = memory_requirements.size,
+    .memoryTypeIndex = memory_type,
+  };
+
+  result = vkAllocateMemory (texture->device, &alloc_info, NULL, &texture->atlas_memory);
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to allocate virtual texture atlas memory. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  moss__track_vram_allocation (
+    texture->physical_device,
+    texture->atlas_memory,
+    MOSS_VRAM_CATEGORY_TEXTURES,
+    memory_type,
+    memory_requirements.size,
+    memory_requirements.size
+  );
+
+  vkBindImageMemory (texture->device, texture->atlas_image, texture->atlas_memory, 0);
+
+  const VkImageViewCreateInfo view_info = {
+    .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+    .image    = texture->atlas_image,
+    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+    .format   = VK_FORMAT_R8G8B8A8_UNORM,
+    .subresourceRange =
+      {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .baseMipLevel   = 0,
+                  .levelCount     = 1,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+                  },
+  };
+
+  result =
+    vkCreateImageView (texture->device, &view_info, NULL, &texture->atlas_image_view);
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create virtual texture atlas view. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  // Shader keeps lookups half a texel inside pages, so filtering never bleeds
+  const VkSamplerCreateInfo sampler_info = {
+    .sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+    .magFilter    = VK_FILTER_LINEAR,
+    .minFilter    = VK_FILTER_LINEAR,
+    .mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+    .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+    .maxLod       = 0.0F,
+  };
+
+  result = vkCreateSampler (texture->device, &sampler_info, NULL, &texture->sampler);
+  if (result != VK_SUCCESS)
+  {
+    moss__error (
+      "Failed to create virtual texture sampler. Error code: %d.\n",
+      result
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static MossResult
+moss__read_virtual_texture_header (Moss__VirtualTexture *const texture)
+{
+  MossVirtualTextureFileHeader *const header = &texture->header;
+
+  const ssize_t bytes_read =
+    pread (texture->file_descriptor, header, sizeof (*header), 0);
+  if (bytes_read != (ssize_t)sizeof (*header)) { return MOSS_RESULT_ERROR; }
+
+  if (header->magic != MOSS_VIRTUAL_TEXTURE_MAGIC ||
+      header->version != MOSS_VIRTUAL_TEXTURE_VERSION || header->width == 0 ||
+      header->height == 0 || header->level_count == 0 ||
+      header->level_count > MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT)
+  {
+    return MOSS_RESULT_ERROR;
+  }
+
+  const uint32_t page_size  = MOSS_VIRTUAL_TEXTURE_PAGE_SIZE;
+  uint64_t       tile_count = 0;
+
+  for (uint32_t i = 0; i < MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT; ++i)
+  {
+    texture->levels[ i ] = (Moss__VirtualTextureLevel) {0};
+    if (i >= header->level_count) { continue; }
+
+    const uint32_t width  = header->width >> i == 0 ? 1 : header->width >> i;
+    const uint32_t height = header->height >> i == 0 ? 1 : header->height >> i;
+
+    texture->levels[ i ] = (Moss__VirtualTextureLevel) {
+      .tile_count_x = (width + page_size - 1) / page_size,
+      .tile_count_y = (height + page_size - 1) / page_size,
+      .first_tile   = (uint32_t)tile_count,
+    };
+
+    tile_count +=
+      (uint64_t)texture->levels[ i ].tile_count_x * texture->levels[ i ].tile_count_y;
+  }
+
+  // Page table entries store tiles as indices plus one in 32 bits
+  if (tile_count >= UINT32_MAX) { return MOSS_RESULT_ERROR; }
+
+  const Moss__VirtualTextureLevel *const root =
+    &texture->levels[ header->level_count - 1 ];
+  if (root->tile_count_x * root->tile_count_y > MOSS__VIRTUAL_TEXTURE_MAX_ROOT_TILE_COUNT)
+  {
+    moss__error (
+      "Coarsest virtual texture level can't have more than %u tiles.\n",
+      MOSS__VIRTUAL_TEXTURE_MAX_ROOT_TILE_COUNT
+    );
+    return MOSS_RESULT_ERROR;
+  }
+
+  texture->tile_count = (uint32_t)tile_count;
+
+  return MOSS_RESULT_SUCCESS;
+}
+
+inline static uint32_t
+moss__get_tile_level (const Moss__VirtualTexture *const texture, const uint32_t tile)
+{
+  uint32_t level = 0;
+  while (level + 1 < texture->header.level_count &&
+         tile >= texture->levels[ level + 1 ].first_tile)
+  {
+    ++level;
+  }
+
+  return level;
+}
+
+inline static void moss__request_virtual_texture_tile (
+  Moss__VirtualTexture *const texture,
+  Moss__AsyncIo *const        async_io,
+  const uint32_t              tile
+)
+{
+  if (texture->tile_request_frames[ tile ] == texture->frame_number) { return; }
+
+  // Collect the tile and all of its ancestors, finest first
+  uint32_t chain[ MOSS_MAX_VIRTUAL_TEXTURE_LEVEL_COUNT ];
+  uint32_t chain_length = 0;
+
+  uint32_t level = moss__get_tile_level (texture, tile);
+  uint32_t local = tile - texture->levels[ level ].first_tile;
+  uint32_t x     = local % texture->levels[ level ].tile_count_x;
+  uint32_t y     = local / texture->levels[ level ].tile_count_x;
+
+  for (; level < texture->header.level_count; ++level, x /= 2, y /= 2)
+  {
+    const Moss__VirtualTextureLevel *const layout = &texture->levels[ level ];
+
+    const uint32_t chain_tile = layout->first_tile + y * layout->tile_count_x + x;
+    chain[ chain_length++ ]   = chain_tile;
+
+    texture->tile_request_frames[ chain_tile ] = texture->frame_number;
+
+    const uint16_t page = texture->tile_pages[ chain_tile ];
+    if (page != 0 && page != MOSS__TILE_PAGE_LOADING &&
+        texture->atlas_last_used[ page - 1 ] != MOSS__PAGE_PINNED)
+    {
+      texture->atlas_last_used[ page - 1 ] = texture->frame_number;
+    }
+  }
+
+  // Refine one level at a time, so coarse fallbacks show up first
+  for (uint32_t i = chain_length; i > 0; --i)
+  {
+    const uint16_t page = texture->tile_pages[ chain[ i - 1 ] ];
+    if (page != 0 && page != MOSS__TILE_PAGE_LOADING) { continue; }
+
+    // Frames keep coming until the whole chain is resident
+    texture->is_refining = true;
+    if (page == MOSS__TILE_PAGE_LOADING) { return; }
+
+    moss__load_virtual_texture_tile (texture, async_io, chain[ i - 1 ]);
+    return;
+  }
+}
+
+inline static bool moss__load_virtual_texture_tile (
+  Moss__VirtualTexture *const texture,
+  Moss__AsyncIo *const        async_io,
+  const uint32_t              tile
+)
+{
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_LOAD_SLOT_COUNT; ++i)
+  {
+    Moss__VirtualTextureLoad *const load = &texture->loads[ i ];
+    if (load->state != MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE) { continue; }
+
+    const Moss__AsyncReadInfo read_info = {
+      .file_descriptor = texture->file_descriptor,
+      .offset          = sizeof (MossVirtualTextureFileHeader) +
+                (uint64_t)MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE * tile,
+      .size        = MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE,
+      .destination = texture->staging + (size_t)MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE * i,
+      .callback    = moss__virtual_texture_load_callback,
+      .user_data   = load,
+    };
+
+    // Staying in the free state lets the next request retry
+    if (moss__submit_async_read (async_io, &read_info) != MOSS_RESULT_SUCCESS)
+    {
+      return false;
+    }
+
+    load->state                 = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_LOADING;
+    load->tile                  = tile;
+    texture->tile_pages[ tile ] = MOSS__TILE_PAGE_LOADING;
+
+    return true;
+  }
+
+  return false;
+}
+
+static void moss__virtual_texture_load_callback (
+  void *const      user_data,
+  const MossResult result,
+  const size_t     bytes_read
+)
+{
+  Moss__VirtualTextureLoad *const load = user_data;
+
+  if (result == MOSS_RESULT_SUCCESS && bytes_read == MOSS__VIRTUAL_TEXTURE_PAGE_BYTE_SIZE)
+  {
+    load->state = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_LOADED;
+    return;
+  }
+
+  moss__error ("Failed to read virtual texture tile %u.\n", load->tile);
+
+  load->owner->tile_pages[ load->tile ] = 0;
+  load->state                           = MOSS__VIRTUAL_TEXTURE_LOAD_STATE_FREE;
+}
+
+inline static bool moss__acquire_virtual_texture_page (
+  Moss__VirtualTexture *const texture,
+  uint32_t *const             out_page
+)
+{
+  uint32_t oldest_page = MOSS__PAGE_FREE;
+
+  for (uint32_t i = 0; i < MOSS__VIRTUAL_TEXTURE_ATLAS_PAGE_COUNT; ++i)
+  {
+    if (texture->atlas_tiles[ i ] == MOSS__PAGE_FREE)
+    {
+      *out_page = i;
+      return true;
+    }
+
+    if (oldest_page == MOSS__PAGE_FREE ||
+        texture->atlas_last_used[ i ] < texture->atlas_last_used[ oldest_page ])
+    {
+      oldest_page = i;
+    }
+  }
+
+  // Pages the latest feedback asked for are all needed on screen right now
+  if (texture->atlas_last_used[ oldest_page ] >= texture->frame_number) { return false; }
+
+  *out_page = oldest_page;
+  return true;
+}
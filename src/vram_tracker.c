@@ -0,0 +1,197 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/vram_tracker.c
+  @brief Device memory allocation tracking implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vulkan/vulkan.h>
+
+#include "moss/vram.h"
+
+#include "src/internal/log.h"
+#include "src/internal/vram_tracker.h"
+
+/* Number of tracked blocks storage is created with. */
+#define MOSS__INITIAL_VRAM_ALLOCATION_CAPACITY (uint32_t)(64)
+
+/*
+  @brief Tracked device memory block.
+*/
+typedef struct
+{
+  VkDeviceMemory   memory;        /* Device memory block. */
+  MossVramCategory category;      /* What the block is spent on. */
+  uint32_t         heap_index;    /* Heap the block is allocated from. */
+  VkDeviceSize     used_size;     /* Bytes the resource asked for. */
+  VkDeviceSize     reserved_size; /* Size of the block in bytes. */
+} Moss__VramAllocation;
+
+/* Tracked blocks, unordered. Every access goes through the mutex, since resources
+   may be created on any thread. */
+static pthread_mutex_t       g_vram_mutex               = PTHREAD_MUTEX_INITIALIZER;
+static Moss__VramAllocation *g_vram_allocations         = NULL;
+static uint32_t              g_vram_allocation_count    = 0;
+static uint32_t              g_vram_allocation_capacity = 0;
+
+/*=============================================================================
+    INTERNAL FUNCTION DECLARATIONS
+  =============================================================================*/
+
+/*
+  @brief Adds allocation to usage.
+  @param usage Usage to add to.
+  @param allocation Tracked block.
+*/
+inline static void
+moss__add_vram_usage (MossVramUsage *usage, const Moss__VramAllocation *allocation);
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__track_vram_allocation (
+  const VkPhysicalDevice physical_device,
+  const VkDeviceMemory   memory,
+  const MossVramCategory category,
+  const uint32_t         memory_type_index,
+  const VkDeviceSize     used_size,
+  const VkDeviceSize     reserved_size
+)
+{
+  VkPhysicalDeviceMemoryProperties memory_properties;
+  vkGetPhysicalDeviceMemoryProperties (physical_device, &memory_properties);
+
+  const Moss__VramAllocation allocation = {
+    .memory        = memory,
+    .category      = category,
+    .heap_index    = memory_properties.memoryTypes[ memory_type_index ].heapIndex,
+    .used_size     = used_size,
+    .reserved_size = reserved_size,
+  };
+
+  pthread_mutex_lock (&g_vram_mutex);
+
+  if (g_vram_allocation_count == g_vram_allocation_capacity)
+  {
+    const uint32_t capacity = g_vram_allocation_capacity == 0
+                              ? MOSS__INITIAL_VRAM_ALLOCATION_CAPACITY
+                              : g_vram_allocation_capacity * 2;
+
+    Moss__VramAllocation *const allocations =
+      realloc (g_vram_allocations, capacity * sizeof (Moss__VramAllocation));
+    if (allocations == NULL)
+    {
+      pthread_mutex_unlock (&g_vram_mutex);
+      moss__error ("Failed to grow VRAM allocation tracking storage.\n");
+      return;
+    }
+
+    g_vram_allocations         = allocations;
+    g_vram_allocation_capacity = capacity;
+  }
+
+  g_vram_allocations[ g_vram_allocation_count++ ] = allocation;
+
+  pthread_mutex_unlock (&g_vram_mutex);
+}
+
+void moss__untrack_vram_allocation (const VkDeviceMemory memory)
+{
+  pthread_mutex_lock (&g_vram_mutex);
+
+  for (uint32_t i = 0; i < g_vram_allocation_count; ++i)
+  {
+    if (g_vram_allocations[ i ].memory != memory) { continue; }
+
+    // Order doesn't matter, so the last block fills the gap
+    g_vram_allocations[ i ] = g_vram_allocations[ --g_vram_allocation_count ];
+    break;
+  }
+
+  // Release storage once everything is freed, so engine deinit leaves nothing behind
+  if (g_vram_allocation_count == 0)
+  {
+    free (g_vram_allocations);
+    g_vram_allocations         = NULL;
+    g_vram_allocation_capacity = 0;
+  }
+
+  pthread_mutex_unlock (&g_vram_mutex);
+}
+
+void moss__get_vram_report (
+  const VkPhysicalDevice physical_device,
+  MossVramReport *const  out_report
+)
+{
+  memset (out_report, 0, sizeof (MossVramReport));
+
+  VkPhysicalDeviceMemoryProperties memory_properties;
+  vkGetPhysicalDeviceMemoryProperties (physical_device, &memory_properties);
+
+  out_report->heap_count = memory_properties.memoryHeapCount;
+  if (out_report->heap_count > MOSS_MAX_VRAM_HEAP_COUNT)
+  {
+    out_report->heap_count = MOSS_MAX_VRAM_HEAP_COUNT;
+  }
+
+  for (uint32_t i = 0; i < out_report->heap_count; ++i)
+  {
+    const VkMemoryHeap heap = memory_properties.memoryHeaps[ i ];
+
+    out_report->heaps[ i ].size = heap.size;
+    out_report->heaps[ i ].is_device_local =
+      (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+  }
+
+  pthread_mutex_lock (&g_vram_mutex);
+
+  for (uint32_t i = 0; i < g_vram_allocation_count; ++i)
+  {
+    const Moss__VramAllocation *const allocation = &g_vram_allocations[ i ];
+
+    moss__add_vram_usage (&out_report->total, allocation);
+    moss__add_vram_usage (&out_report->categories[ allocation->category ], allocation);
+
+    if (allocation->heap_index < out_report->heap_count)
+    {
+      MossVramHeap *const heap = &out_report->heaps[ allocation->heap_index ];
+      moss__add_vram_usage (&heap->usage, allocation);
+    }
+  }
+
+  pthread_mutex_unlock (&g_vram_mutex);
+}
+
+/*=============================================================================
+    INTERNAL FUNCTION IMPLEMENTATIONS
+  =============================================================================*/
+
+inline static void moss__add_vram_usage (
+  MossVramUsage *const              usage,
+  const Moss__VramAllocation *const allocation
+)
+{
+  ++usage->allocation_count;
+  usage->used_size     += allocation->used_size;
+  usage->reserved_size += allocation->reserved_size;
+}
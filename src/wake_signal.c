@@ -0,0 +1,114 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file src/wake_signal.c
+  @brief Wake signal implementation.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "src/internal/wake_signal.h"
+
+/* Clock condition timeouts are measured with. */
+#ifdef __linux__
+#  define MOSS__WAKE_SIGNAL_CLOCK CLOCK_MONOTONIC
+#else
+#  define MOSS__WAKE_SIGNAL_CLOCK CLOCK_REALTIME
+#endif
+
+/*=============================================================================
+    FUNCTIONS IMPLEMENTATION
+  =============================================================================*/
+
+void moss__init_wake_signal (Moss__WakeSignal *const out_signal)
+{
+  *out_signal = (Moss__WakeSignal) {0};
+
+  pthread_condattr_t condition_attributes;
+  pthread_condattr_init (&condition_attributes);
+#ifdef __linux__
+  // Wall clock jumps must not stretch or cut short the sleep
+  pthread_condattr_setclock (&condition_attributes, MOSS__WAKE_SIGNAL_CLOCK);
+#endif
+
+  pthread_mutex_init (&out_signal->mutex, NULL);
+  pthread_cond_init (&out_signal->condition, &condition_attributes);
+  pthread_condattr_destroy (&condition_attributes);
+
+  out_signal->is_initialized = true;
+}
+
+void moss__deinit_wake_signal (Moss__WakeSignal *const signal)
+{
+  if (!signal->is_initialized) { return; }
+
+  pthread_cond_destroy (&signal->condition);
+  pthread_mutex_destroy (&signal->mutex);
+
+  *signal = (Moss__WakeSignal) {0};
+}
+
+void moss__raise_wake_signal (Moss__WakeSignal *const signal)
+{
+  if (!signal->is_initialized) { return; }
+
+  pthread_mutex_lock (&signal->mutex);
+  signal->is_raised = true;
+  pthread_cond_signal (&signal->condition);
+  pthread_mutex_unlock (&signal->mutex);
+}
+
+bool moss__wait_wake_signal (Moss__WakeSignal *const signal, const float seconds)
+{
+  struct timespec deadline;
+  clock_gettime (MOSS__WAKE_SIGNAL_CLOCK, &deadline);
+
+  // Whole seconds are added separately, nanoseconds alone overflow a 32-bit long
+  const double whole_seconds = (double)(time_t)seconds;
+  const long   nanoseconds =
+    deadline.tv_nsec + (long)(((double)seconds - whole_seconds) * 1e9);
+
+  deadline.tv_sec += (time_t)whole_seconds + nanoseconds / 1000000000L;
+  deadline.tv_nsec = nanoseconds % 1000000000L;
+
+  pthread_mutex_lock (&signal->mutex);
+
+  int result = 0;
+  while (!signal->is_raised && result != ETIMEDOUT)
+  {
+    result = pthread_cond_timedwait (&signal->condition, &signal->mutex, &deadline);
+  }
+
+  const bool is_raised = signal->is_raised;
+  signal->is_raised    = false;
+
+  pthread_mutex_unlock (&signal->mutex);
+
+  return is_raised;
+}
+
+double moss__get_monotonic_time (void)
+{
+  struct timespec time;
+  clock_gettime (CLOCK_MONOTONIC, &time);
+
+  return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
@@ -0,0 +1,119 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file tests/test_job_system.c
+  @brief Job system tests.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Checks that parallel for covers its whole range and gives every pool
+           slot back, whether it runs inline or spreads the work over threads.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <check.h>
+
+#include "moss/job.h"
+#include "moss/result.h"
+
+#include "src/internal/job_system.h"
+
+/* Number of indices every parallel for covers. */
+#define RANGE_SIZE (uint32_t)(1000)
+
+/*
+  @brief Adds every index of the range to the sum, user data is the sum.
+*/
+static void sum_range (void *const user_data, const uint32_t begin, const uint32_t end)
+{
+  uint64_t local_sum = 0;
+  for (uint32_t i = begin; i < end; ++i) { local_sum += i; }
+
+  __atomic_add_fetch ((uint64_t *)user_data, local_sum, __ATOMIC_RELAXED);
+}
+
+/*
+  @brief Does nothing, used for jobs that only occupy a pool slot.
+*/
+static void do_nothing (void *const user_data) { (void)user_data; }
+
+/*
+  @brief Runs parallel for more times than the pool has slots and checks every sum.
+*/
+static void run_parallel_for_past_pool_size (const uint32_t batch_size)
+{
+  const uint64_t expected_sum = (uint64_t)RANGE_SIZE * (RANGE_SIZE - 1) / 2;
+
+  for (uint32_t i = 0; i < MOSS_JOB_POOL_SIZE + 16; ++i)
+  {
+    uint64_t sum = 0;
+    moss_job_parallel_for (RANGE_SIZE, batch_size, sum_range, &sum);
+    ck_assert_uint_eq (sum, expected_sum);
+  }
+
+  // Every slot must be free again, so a new job still fits into the pool
+  MossJob *const job = moss_job_create (do_nothing, NULL);
+  ck_assert_ptr_nonnull (job);
+
+  moss_job_submit (job);
+  moss_job_wait (job);
+}
+
+START_TEST (test_inline_parallel_for_releases_pool_slots)
+{
+  const MossJobSystemConfig config = { .thread_count = 1 };
+  ck_assert_int_eq (moss__init_job_system (&config), MOSS_RESULT_SUCCESS);
+
+  run_parallel_for_past_pool_size (0);
+
+  moss__deinit_job_system ( );
+}
+END_TEST
+
+START_TEST (test_threaded_parallel_for_releases_pool_slots)
+{
+  const MossJobSystemConfig config = { .thread_count = 4 };
+  ck_assert_int_eq (moss__init_job_system (&config), MOSS_RESULT_SUCCESS);
+
+  // Small batches keep many children in flight at once
+  run_parallel_for_past_pool_size (7);
+
+  moss__deinit_job_system ( );
+}
+END_TEST
+
+static Suite *job_system_suite (void)
+{
+  Suite *const suite     = suite_create ("JobSystem");
+  TCase *const test_case = tcase_create ("Core");
+
+  tcase_set_timeout (test_case, 60);
+  tcase_add_test (test_case, test_inline_parallel_for_releases_pool_slots);
+  tcase_add_test (test_case, test_threaded_parallel_for_releases_pool_slots);
+  suite_add_tcase (suite, test_case);
+
+  return suite;
+}
+
+int main (void)
+{
+  SRunner *const runner = srunner_create (job_system_suite ( ));
+
+  srunner_run_all (runner, CK_NORMAL);
+  const int failed_count = srunner_ntests_failed (runner);
+  srunner_free (runner);
+
+  return (failed_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
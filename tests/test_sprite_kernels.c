@@ -0,0 +1,200 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file tests/test_sprite_kernels.c
+  @brief Sprite vertex kernel tests.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Compares the kernel selected for the running CPU against the scalar
+           reference kernel on the same input.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <check.h>
+
+#include "moss/vertex.h"
+
+#include "src/internal/sprite_kernels.h"
+
+/* Max difference allowed between the selected and the scalar kernel. */
+#define TOLERANCE 1e-5F
+
+/* Max number of sprites in a test input. */
+#define MAX_SPRITE_COUNT (uint32_t)(1031)
+
+/*
+  @brief Sprite arrays the test input points to.
+*/
+typedef struct
+{
+  float    x[ MAX_SPRITE_COUNT ];
+  float    y[ MAX_SPRITE_COUNT ];
+  float    rotation[ MAX_SPRITE_COUNT ];
+  float    scale_x[ MAX_SPRITE_COUNT ];
+  float    scale_y[ MAX_SPRITE_COUNT ];
+  float    uv_left[ MAX_SPRITE_COUNT ];
+  float    uv_top[ MAX_SPRITE_COUNT ];
+  float    uv_right[ MAX_SPRITE_COUNT ];
+  float    uv_bottom[ MAX_SPRITE_COUNT ];
+  uint32_t color[ MAX_SPRITE_COUNT ];
+  uint32_t texture_index[ MAX_SPRITE_COUNT ];
+} SpriteArrays;
+
+static SpriteArrays g_arrays;
+static MossVertex   g_expected[ MAX_SPRITE_COUNT * MOSS__SPRITE_VERTEX_COUNT ];
+static MossVertex   g_actual[ MAX_SPRITE_COUNT * MOSS__SPRITE_VERTEX_COUNT ];
+
+/*
+  @brief Returns pseudo-random number in [min, max), same sequence on every run.
+*/
+static float random_float (const float min, const float max)
+{
+  static uint32_t state = 0x12345678U;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return min + (max - min) * (float)(state >> 8) / (float)(1U << 24);
+}
+
+/*
+  @brief Fills sprite arrays with values in normalized device coordinate ranges.
+*/
+static void fill_arrays (void)
+{
+  for (uint32_t i = 0; i < MAX_SPRITE_COUNT; ++i)
+  {
+    g_arrays.x[ i ]             = random_float (-1.0F, 1.0F);
+    g_arrays.y[ i ]             = random_float (-1.0F, 1.0F);
+    g_arrays.rotation[ i ]      = random_float (-4.0F * 3.14159265F, 4.0F * 3.14159265F);
+    g_arrays.scale_x[ i ]       = random_float (0.01F, 0.5F);
+    g_arrays.scale_y[ i ]       = random_float (0.01F, 0.5F);
+    g_arrays.uv_left[ i ]       = random_float (0.0F, 0.5F);
+    g_arrays.uv_top[ i ]        = random_float (0.0F, 0.5F);
+    g_arrays.uv_right[ i ]      = random_float (0.5F, 1.0F);
+    g_arrays.uv_bottom[ i ]     = random_float (0.5F, 1.0F);
+    g_arrays.color[ i ]         = (uint32_t)(random_float (0.0F, 1.0F) * 4294967040.0F);
+    g_arrays.texture_index[ i ] = (uint32_t)(random_float (0.0F, 16.0F));
+  }
+}
+
+/*
+  @brief Returns sprites using every array, or only the required ones.
+*/
+static Moss__SpriteSoA make_sprites (const uint32_t count, const int is_full)
+{
+  return (Moss__SpriteSoA) {
+    .x             = g_arrays.x,
+    .y             = g_arrays.y,
+    .rotation      = is_full ? g_arrays.rotation : NULL,
+    .scale_x       = g_arrays.scale_x,
+    .scale_y       = g_arrays.scale_y,
+    .uv_left       = is_full ? g_arrays.uv_left : NULL,
+    .uv_top        = is_full ? g_arrays.uv_top : NULL,
+    .uv_right      = is_full ? g_arrays.uv_right : NULL,
+    .uv_bottom     = is_full ? g_arrays.uv_bottom : NULL,
+    .color         = is_full ? g_arrays.color : NULL,
+    .texture_index = is_full ? g_arrays.texture_index : NULL,
+    .count         = count,
+  };
+}
+
+/*
+  @brief Runs both kernels over [first, first + count) and compares their vertices.
+*/
+static void
+compare_kernels (const uint32_t first, const uint32_t count, const int is_full)
+{
+  const Moss__SpriteSoA          sprites = make_sprites (first + count, is_full);
+  const Moss__SpriteVertexKernel kernel  = moss__select_sprite_vertex_kernel ( );
+
+  moss__generate_sprite_vertices_scalar (&sprites, first, count, g_expected);
+  kernel (&sprites, first, count, g_actual);
+
+  for (uint32_t i = 0; i < count * MOSS__SPRITE_VERTEX_COUNT; ++i)
+  {
+    const MossVertex *const expected = &g_expected[ i ];
+    const MossVertex *const actual   = &g_actual[ i ];
+
+    for (uint32_t j = 0; j < 2; ++j)
+    {
+      ck_assert_float_eq_tol (actual->position[ j ], expected->position[ j ], TOLERANCE);
+      ck_assert_float_eq_tol (
+        actual->texture_coordinates[ j ],
+        expected->texture_coordinates[ j ],
+        TOLERANCE
+      );
+    }
+
+    for (uint32_t j = 0; j < 3; ++j)
+    {
+      ck_assert_float_eq_tol (actual->color[ j ], expected->color[ j ], TOLERANCE);
+    }
+
+    ck_assert_uint_eq (actual->texture_index, expected->texture_index);
+  }
+}
+
+START_TEST (test_kernel_matches_scalar_reference)
+{
+  fill_arrays ( );
+
+  // Every remainder of the 4 and 8 sprite vector widths, then a long batch
+  for (uint32_t count = 0; count <= 17; ++count)
+  {
+    compare_kernels (0, count, 1);
+    compare_kernels (3, count, 1);
+  }
+  compare_kernels (0, MAX_SPRITE_COUNT, 1);
+}
+END_TEST
+
+START_TEST (test_kernel_matches_scalar_reference_with_defaults)
+{
+  fill_arrays ( );
+
+  for (uint32_t count = 0; count <= 17; ++count)
+  {
+    compare_kernels (0, count, 0);
+    compare_kernels (5, count, 0);
+  }
+  compare_kernels (0, MAX_SPRITE_COUNT, 0);
+}
+END_TEST
+
+static Suite *sprite_kernels_suite (void)
+{
+  Suite *const suite     = suite_create ("SpriteKernels");
+  TCase *const test_case = tcase_create ("Core");
+
+  tcase_add_test (test_case, test_kernel_matches_scalar_reference);
+  tcase_add_test (test_case, test_kernel_matches_scalar_reference_with_defaults);
+  suite_add_tcase (suite, test_case);
+
+  return suite;
+}
+
+int main (void)
+{
+  SRunner *const runner = srunner_create (sprite_kernels_suite ( ));
+
+  srunner_run_all (runner, CK_NORMAL);
+  const int failed_count = srunner_ntests_failed (runner);
+  srunner_free (runner);
+
+  return (failed_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,543 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file tools/microbench.c
+  @brief Times CPU-side engine kernels over fixed datasets and prints JSON.
+  @author Ilya Buravov (ilburale@gmail.com)
+  @details Every benchmark is warmed up, then timed over a number of samples,
+           each running enough iterations to last about a millisecond. Datasets
+           are generated from a fixed seed, so runs are comparable across
+           commits. Usage: moss_microbench [name filter].
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "moss/draw_command.h"
+#include "moss/result.h"
+#include "moss/skeleton.h"
+#include "moss/vertex.h"
+
+#include "src/internal/draw_queue.h"
+#include "src/internal/radix_sort_utils.h"
+#include "src/internal/skeleton_utils.h"
+#include "src/internal/sprite_kernels.h"
+#include "src/internal/wake_signal.h"
+
+/* Number of untimed iterations before sampling. */
+#define WARMUP_ITERATION_COUNT (uint32_t)(8)
+
+/* Number of timed samples per benchmark. */
+#define SAMPLE_COUNT (uint32_t)(31)
+
+/* Time a single sample aims to take, in seconds. */
+#define TARGET_SAMPLE_TIME (double)(1e-3)
+
+/* Number of sprites vertex generation kernels expand. */
+#define SPRITE_COUNT (uint32_t)(16384)
+
+/* Number of keys radix sort sorts. */
+#define SORT_KEY_COUNT (uint32_t)(65536)
+
+/* Number of commands pushed to the draw queue before merging. */
+#define DRAW_COMMAND_COUNT (uint32_t)(32768)
+
+/* Number of skeletons evaluated. */
+#define SKELETON_COUNT (uint32_t)(256)
+
+/* Number of bones of every skeleton. */
+#define SKELETON_BONE_COUNT (uint32_t)(64)
+
+/*
+  @brief Benchmarked kernel.
+*/
+typedef struct
+{
+  const char *name;       /* Name printed in the report. */
+  uint32_t    item_count; /* Number of items a single iteration processes. */
+  void *(*create) (void); /* Creates the dataset, NULL if the kernel can't run. */
+  void (*run) (void *dataset);     /* Runs a single iteration. */
+  void (*destroy) (void *dataset); /* Frees the dataset. */
+} Benchmark;
+
+/*
+  @brief Timing results of a benchmark, times are per iteration in seconds.
+*/
+typedef struct
+{
+  uint32_t iterations_per_sample; /* Iterations every sample ran. */
+  double   min;                   /* Fastest sample. */
+  double   median;                /* Median sample. */
+  double   mean;                  /* Mean of samples. */
+  double   stddev;                /* Standard deviation of samples. */
+} BenchmarkStats;
+
+/*
+  @brief Sprite vertex generation dataset.
+*/
+typedef struct
+{
+  Moss__SpriteVertexKernel kernel;   /* Kernel to run. */
+  Moss__SpriteSoA          sprites;  /* Sprites to expand. */
+  float                   *floats;   /* Memory of all float arrays. */
+  uint32_t                *colors;   /* Sprite colors. */
+  MossVertex              *vertices; /* Output vertices. */
+} SpriteDataset;
+
+/*
+  @brief Radix sort dataset.
+*/
+typedef struct
+{
+  uint64_t *source_keys;    /* Unsorted keys every iteration starts from. */
+  uint64_t *keys;           /* Keys being sorted. */
+  uint32_t *values;         /* Values sorted along with keys. */
+  uint64_t *scratch_keys;   /* Scratch keys. */
+  uint32_t *scratch_values; /* Scratch values. */
+} SortDataset;
+
+/*
+  @brief Draw queue dataset.
+*/
+typedef struct
+{
+  Moss__DrawQueue queue;                          /* Queue commands go through. */
+  MossDrawCommand commands[ DRAW_COMMAND_COUNT ]; /* Commands of every iteration. */
+} DrawQueueDataset;
+
+/*
+  @brief Skeleton evaluation dataset.
+*/
+typedef struct
+{
+  MossBone         bones[ SKELETON_COUNT ][ SKELETON_BONE_COUNT ];
+  uint32_t         parents[ SKELETON_BONE_COUNT ];
+  Moss__BoneMatrix world[ SKELETON_COUNT ][ SKELETON_BONE_COUNT ];
+} SkeletonDataset;
+
+/* State of the dataset random number generator. */
+static uint64_t g_random_state;
+
+/*=============================================================================
+    DATASETS
+  =============================================================================*/
+
+/*
+  @brief Returns next pseudo-random number, xorshift64*.
+*/
+static uint64_t next_random (void)
+{
+  g_random_state ^= g_random_state >> 12;
+  g_random_state ^= g_random_state << 25;
+  g_random_state ^= g_random_state >> 27;
+  return g_random_state * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+  @brief Returns pseudo-random float in [min, max).
+*/
+static float next_random_float (const float min, const float max)
+{
+  const float unit = (float)(next_random ( ) >> 40) / (float)(1 << 24);
+  return min + unit * (max - min);
+}
+
+static void *create_sprite_dataset (const Moss__SpriteVertexKernel kernel)
+{
+  SpriteDataset *const dataset = calloc (1, sizeof (*dataset));
+  if (dataset == NULL) { return NULL; }
+
+  dataset->kernel   = kernel;
+  dataset->floats   = malloc (5 * SPRITE_COUNT * sizeof (float));
+  dataset->colors   = malloc (SPRITE_COUNT * sizeof (uint32_t));
+  dataset->vertices =
+    malloc (SPRITE_COUNT * MOSS__SPRITE_VERTEX_COUNT * sizeof (MossVertex));
+
+  if (dataset->floats == NULL || dataset->colors == NULL || dataset->vertices == NULL)
+  {
+    free (dataset->floats);
+    free (dataset->colors);
+    free (dataset->vertices);
+    free (dataset);
+    return NULL;
+  }
+
+  float *const x        = dataset->floats;
+  float *const y        = x + SPRITE_COUNT;
+  float *const rotation = y + SPRITE_COUNT;
+  float *const scale_x  = rotation + SPRITE_COUNT;
+  float *const scale_y  = scale_x + SPRITE_COUNT;
+
+  for (uint32_t i = 0; i < SPRITE_COUNT; ++i)
+  {
+    x[ i ]               = next_random_float (-1.0F, 1.0F);
+    y[ i ]               = next_random_float (-1.0F, 1.0F);
+    rotation[ i ]        = next_random_float (0.0F, 6.2831853F);
+    scale_x[ i ]         = next_random_float (0.01F, 0.1F);
+    scale_y[ i ]         = next_random_float (0.01F, 0.1F);
+    dataset->colors[ i ] = (uint32_t)next_random ( );
+  }
+
+  dataset->sprites = (Moss__SpriteSoA) {
+    .x        = x,
+    .y        = y,
+    .rotation = rotation,
+    .scale_x  = scale_x,
+    .scale_y  = scale_y,
+    .color    = dataset->colors,
+    .count    = SPRITE_COUNT,
+  };
+
+  return dataset;
+}
+
+static void *create_scalar_sprite_dataset (void)
+{
+  return create_sprite_dataset (moss__generate_sprite_vertices_scalar);
+}
+
+static void *create_simd_sprite_dataset (void)
+{
+  // The fastest kernel is what frames actually use
+  const Moss__SpriteVertexKernel kernel = moss__select_sprite_vertex_kernel ( );
+  if (kernel == moss__generate_sprite_vertices_scalar) { return NULL; }
+
+  return create_sprite_dataset (kernel);
+}
+
+static void run_sprite_dataset (void *const dataset)
+{
+  SpriteDataset *const sprites = dataset;
+  sprites->kernel (&sprites->sprites, 0, SPRITE_COUNT, sprites->vertices);
+}
+
+static void destroy_sprite_dataset (void *const dataset)
+{
+  SpriteDataset *const sprites = dataset;
+  free (sprites->floats);
+  free (sprites->colors);
+  free (sprites->vertices);
+  free (sprites);
+}
+
+static void *create_sort_dataset (void)
+{
+  SortDataset *const dataset = calloc (1, sizeof (*dataset));
+  if (dataset == NULL) { return NULL; }
+
+  dataset->source_keys    = malloc (SORT_KEY_COUNT * sizeof (uint64_t));
+  dataset->keys           = malloc (SORT_KEY_COUNT * sizeof (uint64_t));
+  dataset->values         = malloc (SORT_KEY_COUNT * sizeof (uint32_t));
+  dataset->scratch_keys   = malloc (SORT_KEY_COUNT * sizeof (uint64_t));
+  dataset->scratch_values = malloc (SORT_KEY_COUNT * sizeof (uint32_t));
+
+  if (dataset->source_keys == NULL || dataset->keys == NULL || dataset->values == NULL ||
+      dataset->scratch_keys == NULL || dataset->scratch_values == NULL)
+  {
+    free (dataset->source_keys);
+    free (dataset->keys);
+    free (dataset->values);
+    free (dataset->scratch_keys);
+    free (dataset->scratch_values);
+    free (dataset);
+    return NULL;
+  }
+
+  // Layer in the top byte and depth below it, like typical sort keys
+  for (uint32_t i = 0; i < SORT_KEY_COUNT; ++i)
+  {
+    dataset->source_keys[ i ] =
+      ((next_random ( ) & 0xF) << 56) | (next_random ( ) & 0xFFFFFFFFULL);
+  }
+
+  return dataset;
+}
+
+static void run_sort_dataset (void *const dataset)
+{
+  SortDataset *const sort = dataset;
+
+  // Restoring the input is part of every iteration, sorting sorted keys is cheaper
+  memcpy (sort->keys, sort->source_keys, SORT_KEY_COUNT * sizeof (uint64_t));
+  for (uint32_t i = 0; i < SORT_KEY_COUNT; ++i) { sort->values[ i ] = i; }
+
+  moss__radix_sort_u64 (
+    sort->keys,
+    sort->values,
+    sort->scratch_keys,
+    sort->scratch_values,
+    SORT_KEY_COUNT
+  );
+}
+
+static void destroy_sort_dataset (void *const dataset)
+{
+  SortDataset *const sort = dataset;
+  free (sort->source_keys);
+  free (sort->keys);
+  free (sort->values);
+  free (sort->scratch_keys);
+  free (sort->scratch_values);
+  free (sort);
+}
+
+static void *create_draw_queue_dataset (void)
+{
+  DrawQueueDataset *const dataset = calloc (1, sizeof (*dataset));
+  if (dataset == NULL) { return NULL; }
+
+  if (moss__init_draw_queue (&dataset->queue) != MOSS_RESULT_SUCCESS)
+  {
+    free (dataset);
+    return NULL;
+  }
+
+  for (uint32_t i = 0; i < DRAW_COMMAND_COUNT; ++i)
+  {
+    dataset->commands[ i ] = (MossDrawCommand) {
+      .sort_key      = next_random ( ) & 0xFFFFFFFFULL,
+      .x             = next_random_float (-1.0F, 1.0F),
+      .y             = next_random_float (-1.0F, 1.0F),
+      .rotation      = next_random_float (0.0F, 6.2831853F),
+      .scale_x       = next_random_float (0.01F, 0.1F),
+      .scale_y       = next_random_float (0.01F, 0.1F),
+      .texture_index = 0,
+      .color         = (uint32_t)next_random ( ),
+    };
+  }
+
+  return dataset;
+}
+
+static void run_draw_queue_dataset (void *const dataset)
+{
+  DrawQueueDataset *const draw_queue = dataset;
+
+  for (uint32_t i = 0; i < DRAW_COMMAND_COUNT; ++i)
+  {
+    moss__push_draw_command (&draw_queue->queue, &draw_queue->commands[ i ]);
+  }
+
+  Moss__SpriteSoA sprites;
+  moss__merge_draw_queue (&draw_queue->queue, &sprites);
+}
+
+static void destroy_draw_queue_dataset (void *const dataset)
+{
+  DrawQueueDataset *const draw_queue = dataset;
+  moss__deinit_draw_queue (&draw_queue->queue);
+  free (draw_queue);
+}
+
+static void *create_skeleton_dataset (void)
+{
+  SkeletonDataset *const dataset = calloc (1, sizeof (*dataset));
+  if (dataset == NULL) { return NULL; }
+
+  // Chains of four bones hanging off the root, like limbs
+  for (uint32_t i = 0; i < SKELETON_BONE_COUNT; ++i)
+  {
+    dataset->parents[ i ] = i == 0 ? MOSS_BONE_PARENT_NONE : (i % 4 == 1 ? 0 : i - 1);
+  }
+
+  for (uint32_t i = 0; i < SKELETON_COUNT; ++i)
+  {
+    for (uint32_t j = 0; j < SKELETON_BONE_COUNT; ++j)
+    {
+      dataset->bones[ i ][ j ] = (MossBone) {
+        .parent   = dataset->parents[ j ],
+        .x        = next_random_float (-1.0F, 1.0F),
+        .y        = next_random_float (-1.0F, 1.0F),
+        .rotation = next_random_float (0.0F, 6.2831853F),
+        .scale_x  = next_random_float (0.5F, 2.0F),
+        .scale_y  = next_random_float (0.5F, 2.0F),
+      };
+    }
+  }
+
+  return dataset;
+}
+
+static void run_skeleton_dataset (void *const dataset)
+{
+  SkeletonDataset *const skeletons = dataset;
+
+  for (uint32_t i = 0; i < SKELETON_COUNT; ++i)
+  {
+    moss__evaluate_skeleton (
+      skeletons->bones[ i ],
+      skeletons->parents,
+      SKELETON_BONE_COUNT,
+      skeletons->world[ i ]
+    );
+  }
+}
+
+static void destroy_skeleton_dataset (void *const dataset) { free (dataset); }
+
+/* Benchmarks in report order. */
+static const Benchmark g_benchmarks[] = {
+  {
+    .name       = "sprite_vertices_scalar",
+    .item_count = SPRITE_COUNT,
+    .create     = create_scalar_sprite_dataset,
+    .run        = run_sprite_dataset,
+    .destroy    = destroy_sprite_dataset,
+  },
+  {
+    .name       = "sprite_vertices_simd",
+    .item_count = SPRITE_COUNT,
+    .create     = create_simd_sprite_dataset,
+    .run        = run_sprite_dataset,
+    .destroy    = destroy_sprite_dataset,
+  },
+  {
+    .name       = "radix_sort_u64",
+    .item_count = SORT_KEY_COUNT,
+    .create     = create_sort_dataset,
+    .run        = run_sort_dataset,
+    .destroy    = destroy_sort_dataset,
+  },
+  {
+    .name       = "draw_queue_push_merge",
+    .item_count = DRAW_COMMAND_COUNT,
+    .create     = create_draw_queue_dataset,
+    .run        = run_draw_queue_dataset,
+    .destroy    = destroy_draw_queue_dataset,
+  },
+  {
+    .name       = "skeleton_evaluation",
+    .item_count = SKELETON_COUNT * SKELETON_BONE_COUNT,
+    .create     = create_skeleton_dataset,
+    .run        = run_skeleton_dataset,
+    .destroy    = destroy_skeleton_dataset,
+  },
+};
+
+/*=============================================================================
+    HARNESS
+  =============================================================================*/
+
+static int compare_doubles (const void *const a, const void *const b)
+{
+  const double lhs = *(const double *)a;
+  const double rhs = *(const double *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+/*
+  @brief Times a benchmark.
+  @param benchmark Benchmark to time.
+  @param dataset Dataset created by the benchmark.
+  @return Timing results.
+*/
+static BenchmarkStats
+time_benchmark (const Benchmark *const benchmark, void *const dataset)
+{
+  for (uint32_t i = 0; i < WARMUP_ITERATION_COUNT; ++i) { benchmark->run (dataset); }
+
+  // Fast kernels run several times per sample to stay well above timer resolution
+  const double calibration_start = moss__get_monotonic_time ( );
+  benchmark->run (dataset);
+  const double iteration_time = moss__get_monotonic_time ( ) - calibration_start;
+
+  BenchmarkStats stats = {
+    .iterations_per_sample =
+      iteration_time >= TARGET_SAMPLE_TIME
+        ? 1
+        : (uint32_t)(TARGET_SAMPLE_TIME / fmax (iteration_time, 1e-9)) + 1,
+  };
+
+  double samples[ SAMPLE_COUNT ];
+  for (uint32_t i = 0; i < SAMPLE_COUNT; ++i)
+  {
+    const double start = moss__get_monotonic_time ( );
+    for (uint32_t j = 0; j < stats.iterations_per_sample; ++j)
+    {
+      benchmark->run (dataset);
+    }
+    samples[ i ] = (moss__get_monotonic_time ( ) - start) / stats.iterations_per_sample;
+
+    stats.mean += samples[ i ] / SAMPLE_COUNT;
+  }
+
+  double variance = 0.0;
+  for (uint32_t i = 0; i < SAMPLE_COUNT; ++i)
+  {
+    variance += (samples[ i ] - stats.mean) * (samples[ i ] - stats.mean);
+  }
+  stats.stddev = sqrt (variance / (SAMPLE_COUNT - 1));
+
+  qsort (samples, SAMPLE_COUNT, sizeof (samples[ 0 ]), compare_doubles);
+  stats.min    = samples[ 0 ];
+  stats.median = samples[ SAMPLE_COUNT / 2 ];
+
+  return stats;
+}
+
+int main (int argc, char **argv)
+{
+  const char *const filter = argc > 1 ? argv[ 1 ] : NULL;
+
+  printf ("{\n");
+  printf ("  \"warmup_iterations\": %u,\n", WARMUP_ITERATION_COUNT);
+  printf ("  \"samples\": %u,\n", SAMPLE_COUNT);
+  printf ("  \"benchmarks\": [");
+
+  bool is_first = true;
+  for (uint32_t i = 0; i < sizeof (g_benchmarks) / sizeof (g_benchmarks[ 0 ]); ++i)
+  {
+    const Benchmark *const benchmark = &g_benchmarks[ i ];
+
+    if (filter != NULL && strstr (benchmark->name, filter) == NULL) { continue; }
+
+    // Every dataset is generated from the same seed, whatever runs before it
+    g_random_state = 0x9E3779B97F4A7C15ULL;
+
+    void *const dataset = benchmark->create ( );
+    if (dataset == NULL)
+    {
+      fprintf (stderr, "Skipping %s, it can't run here.\n", benchmark->name);
+      continue;
+    }
+
+    const BenchmarkStats stats = time_benchmark (benchmark, dataset);
+    benchmark->destroy (dataset);
+
+    printf ("%s\n    {\n", is_first ? "" : ",");
+    printf ("      \"name\": \"%s\",\n", benchmark->name);
+    printf ("      \"items\": %u,\n", benchmark->item_count);
+    printf ("      \"iterations_per_sample\": %u,\n", stats.iterations_per_sample);
+    printf ("      \"min_ns\": %.1f,\n", stats.min * 1e9);
+    printf ("      \"median_ns\": %.1f,\n", stats.median * 1e9);
+    printf ("      \"mean_ns\": %.1f,\n", stats.mean * 1e9);
+    printf ("      \"stddev_ns\": %.1f,\n", stats.stddev * 1e9);
+    printf (
+      "      \"median_ns_per_item\": %.3f\n",
+      stats.median * 1e9 / benchmark->item_count
+    );
+    printf ("    }");
+
+    is_first = false;
+  }
+
+  printf ("\n  ]\n}\n");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+/*
+  Copyright 2025 Osfabias
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @file tools/replay.c
+  @brief Replays capture files as fast as possible and reports frame times.
+  @author Ilya Buravov (ilburale@gmail.com)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <moss/capture.h>
+#include <moss/result.h>
+
+int main (int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    fprintf (stderr, "Usage: %s <capture file>\n", argv[ 0 ]);
+    return EXIT_FAILURE;
+  }
+
+  MossReplayStats stats;
+  if (moss_replay_capture (argv[ 1 ], &stats) != MOSS_RESULT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  const double frame_time =
+    stats.frame_count != 0 ? stats.seconds / stats.frame_count : 0.0;
+
+  printf ("frames:     %u\n", stats.frame_count);
+  printf ("total:      %.3f s\n", stats.seconds);
+  printf ("frame time: %.3f ms\n", frame_time * 1000.0);
+
+  return EXIT_SUCCESS;
+}